@@ -298,11 +298,64 @@ mkldnn_status_t MKLDNN_API mkldnn_primitive_attr_get_output_scales(
  *      responsibility to set proper values. The following formula must hold:
  *
  *      \f[count = \prod\limits_{d \in mask} output.dims[d]\f]
+ *
+ * If the scales are not known at the primitive descriptor creation time, set
+ * @p count to 1 and the only element of @p scales to #MKLDNN_RUNTIME_F32_VAL.
+ * In this case the actual scales must be passed at execution time as an f32
+ * memory argument #MKLDNN_ARG_ATTR_OUTPUT_SCALES with the number of elements
+ * defined by @p mask according to the formula above.
  */
 mkldnn_status_t MKLDNN_API mkldnn_primitive_attr_set_output_scales(
         mkldnn_primitive_attr_t attr, mkldnn_dim_t count, int mask,
         const float *scales);
 
+/** Returns @p count, correspondence zero point @p mask, and a pointer to a
+ * constant int32_t array of @p zero_points for given @p attr and memory
+ * argument (index), previously set by mkldnn_primitive_attr_set_zero_points.
+ *
+ * @warning
+ *      The @p zero_points array points to the internal @p attr field, so the
+ *      user should not modify or destroy @p zero_points.
+ *
+ * @warning
+ *      The lifetime of @p zero_points is the same as that of the @p attr to
+ *      which it belongs, so it is illegal to use @p zero_points after @p attr
+ *      is destroyed.
+ */
+mkldnn_status_t MKLDNN_API mkldnn_primitive_attr_get_zero_points(
+        const_mkldnn_primitive_attr_t attr, int arg, mkldnn_dim_t *count,
+        int *mask, const int32_t **zero_points);
+
+/** Sets quantization @p zero_points for primitive operations for a given
+ * memory argument (#MKLDNN_ARG_SRC or #MKLDNN_ARG_DST). The number of
+ * elements @p count and correspondence zero point @p mask are stored for
+ * future use.
+ *
+ * The @p mask argument has the same meaning as for output scales (see
+ * mkldnn_primitive_attr_set_output_scales). The source zero point must be
+ * common for the whole tensor (@p mask = 0), while the destination zero
+ * point may also be specified per output channel (@p mask = 1 << 1).
+ *
+ * Zero points make the quantization asymmetric. For instance, an int8
+ * convolution with zero points computes:
+ *
+ *      dst = zp_dst + post_ops(output_scales * (conv(src - zp_src, wei) + bias))
+ *
+ * where the source padding is treated as zero in the dequantized domain
+ * (that is, equals @p zp_src in the quantized one) and the sum post
+ * operation accumulates (dst - zp_dst).
+ *
+ * @note
+ *      Primitives that support non-zero zero points for the source require
+ *      the weights to carry the asymmetric compensation (see
+ *      #mkldnn_memory_extra_flag_compensation_conv_asymmetric_src), which is
+ *      the case for weights memory descriptors queried from the primitive
+ *      descriptor created with #mkldnn_format_tag_any.
+ */
+mkldnn_status_t MKLDNN_API mkldnn_primitive_attr_set_zero_points(
+        mkldnn_primitive_attr_t attr, int arg, mkldnn_dim_t count, int mask,
+        const int32_t *zero_points);
+
 /** Returns @p post_ops for given @p attr.
  *
  * @warning
@@ -388,6 +441,13 @@ mkldnn_status_t MKLDNN_API mkldnn_post_ops_get_params_sum(
  * computations would be:
  * dst[] <- scale * eltwise_op ( op(...) ) // instead of dst[] <- op(...)
  * where eltwise_op is configured with the given parameters.
+ *
+ * Either of @p alpha and @p beta might be #MKLDNN_RUNTIME_F32_VAL, meaning the
+ * value is not known at the primitive descriptor creation time. The values
+ * are then passed at execution time as an f32 memory argument
+ * #MKLDNN_ARG_ATTR_POST_OP_0 + index (where index is the position of the
+ * post operation in the sequence) holding 2 elements: alpha and beta. The
+ * elements that are not runtime values are ignored.
  */
 mkldnn_status_t MKLDNN_API mkldnn_post_ops_append_eltwise(
         mkldnn_post_ops_t post_ops, float scale, mkldnn_alg_kind_t alg,
@@ -437,9 +497,10 @@ mkldnn_status_t MKLDNN_API mkldnn_post_ops_get_params_eltwise(
  *      description (a memory descriptor). For CPU enigne, the data handle is
  *      simply a pointer to @c void. The data handle can be queried using
  *      mkldnn_memory_get_data_handle() and set using
- *      mkldnn_memory_set_data_handle(). The latter function always sets the
- *      memory in the padding region to zero, which is the invariant maintained
- *      by all the primitives in Intel MKL-DNN.
+ *      mkldnn_memory_set_data_handle(). The latter function sets the
+ *      memory in the padding region to zero (unless it is known to be zero
+ *      already), which is the invariant maintained by all the primitives in
+ *      Intel MKL-DNN.
  *      See @ref understanding_memory_formats for more details.
  *      A memory can be created using mkldnn_memory_create() function.
  *      A memory can also be queried for the underlying memory descriptor and
@@ -572,10 +633,23 @@ mkldnn_status_t MKLDNN_API mkldnn_memory_unmap_data(
 mkldnn_status_t MKLDNN_API mkldnn_memory_get_data_handle(
         const_mkldnn_memory_t memory, void **handle);
 
-/** For a @p memory, sets the data @p handle. */
+/** For a @p memory, sets the data @p handle.
+ *
+ * The padded area of the memory is filled with zeros, unless the @p handle
+ * is the current one and the padded area is known to be intact, i.e. the
+ * memory was last written by a primitive that keeps zeros in the padded area
+ * and the data was not accessed via mkldnn_memory_get_data_handle() or
+ * mkldnn_memory_map_data() since then. */
 mkldnn_status_t MKLDNN_API mkldnn_memory_set_data_handle(
         mkldnn_memory_t memory, void *handle);
 
+/** For a @p memory, sets the data @p handle pointing to the buffer with the
+ * padded area already filled with zeros (e.g. the buffer that was previously
+ * used with a memory of the same descriptor), so that zero padding is
+ * skipped. */
+mkldnn_status_t MKLDNN_API mkldnn_memory_set_zero_padded_data_handle(
+        mkldnn_memory_t memory, void *handle);
+
 /** Deletes a @p memory. */
 mkldnn_status_t MKLDNN_API mkldnn_memory_destroy(mkldnn_memory_t memory);
 
@@ -621,6 +695,14 @@ mkldnn_status_t MKLDNN_API mkldnn_reorder_primitive_desc_create(
  *
  * Outputs:
  *  - output (#mkldnn_query_dst_md, 0)
+ *
+ * The inputs might be the sub-memories of the output (see
+ * mkldnn_memory_desc_init_submemory()), so that the primitives producing
+ * them write directly into the output. In this case the input descriptors
+ * should be the corresponding sub-memory descriptors of @p output_desc, and
+ * the inputs and the output should share the same data handle. If the
+ * implementation does not copy such inputs, #mkldnn_query_concat_inplace_s32
+ * returns a non-zero value and the execution of the concat is a no-op.
  */
 mkldnn_status_t MKLDNN_API mkldnn_concat_primitive_desc_create(
         mkldnn_primitive_desc_t *concat_primitive_desc,
@@ -1641,6 +1723,98 @@ mkldnn_status_t MKLDNN_API mkldnn_rnn_backward_desc_init(
         const mkldnn_memory_desc_t *diff_dst_layer,
         const mkldnn_memory_desc_t *diff_dst_iter_desc);
 
+/** Initializes an LSTM descriptor @p rnn_desc for forward propagation using
+ * @p prop_kind, @p rnn_cell_desc, @p direction, and memory descriptors.
+ * Behaves like mkldnn_rnn_forward_desc_init() and additionally accepts
+ * the optional peephole and projection weights of the LSTM cell. The cell
+ * kind of @p rnn_cell_desc must be #mkldnn_vanilla_lstm.
+ *
+ * @p weights_peephole_desc is a (num_layers, num_directions, 3,
+ * output_channels) tensor holding the input, forget and output gate
+ * peephole weights. @p weights_projection_desc is a (num_layers,
+ * num_directions, output_channels, projection_channels) tensor that maps
+ * the hidden state to projection_channels before it is passed to the next
+ * layer and iteration. Both are always #mkldnn_f32 and are allowed to
+ * either be @c NULL or point to a zero memory descriptor, which would
+ * indicate that the cell should not use them.
+ *
+ * With projection, projection_channels must not exceed output_channels,
+ * dst_layer and weights_iter use projection_channels, and the src_iter and
+ * dst_iter tensors keep output_channels per state: the hidden state takes
+ * its first projection_channels channels, the rest are ignored on input
+ * and left untouched on output.
+ *
+ * Inputs:
+ *  - src_layer (#mkldnn_query_src_md, 0)
+ *  - src_iter (#mkldnn_query_src_md, 1), if used
+ *  - weights_layer (#mkldnn_query_weights_md, 0)
+ *  - weights_iter (#mkldnn_query_weights_md, 1)
+ *  - bias (#mkldnn_query_weights_md, 2), if used
+ *  - weights_peephole (#mkldnn_query_weights_md, 3), if used
+ *  - weights_projection (#mkldnn_query_weights_md, 4), if used
+ *
+ * Outputs:
+ *  - dst_layer (#mkldnn_query_dst_md, 0)
+ *  - dst_iter (#mkldnn_query_dst_md, 1), if used
+ *  - workspace (#mkldnn_query_workspace_md, 0),
+ *      if @p prop_kind equals #mkldnn_forward_training
+ */
+mkldnn_status_t MKLDNN_API mkldnn_lstm_forward_desc_init(
+        mkldnn_rnn_desc_t *rnn_desc, mkldnn_prop_kind_t prop_kind,
+        const mkldnn_rnn_cell_desc_t *rnn_cell_desc,
+        const mkldnn_rnn_direction_t direction,
+        const mkldnn_memory_desc_t *src_layer_desc,
+        const mkldnn_memory_desc_t *src_iter_desc,
+        const mkldnn_memory_desc_t *weights_layer_desc,
+        const mkldnn_memory_desc_t *weights_iter_desc,
+        const mkldnn_memory_desc_t *weights_peephole_desc,
+        const mkldnn_memory_desc_t *weights_projection_desc,
+        const mkldnn_memory_desc_t *bias_desc,
+        const mkldnn_memory_desc_t *dst_layer_desc,
+        const mkldnn_memory_desc_t *dst_iter_desc);
+
+/** Initializes an LSTM descriptor @p rnn_desc for backward propagation
+ * using @p prop_kind, @p rnn_cell_desc, @p direction, and memory
+ * descriptors. Behaves like mkldnn_rnn_backward_desc_init() and
+ * additionally accepts the optional peephole and projection weights, see
+ * mkldnn_lstm_forward_desc_init().
+ *
+ * @p weights_peephole_desc (simultaneously with
+ * @p diff_weights_peephole_desc) and @p weights_projection_desc
+ * (simultaneously with @p diff_weights_projection_desc) are allowed to
+ * either be @c NULL or point to a zero memory descriptor.
+ *
+ * Inputs are the ones of mkldnn_rnn_backward_desc_init() plus:
+ *  - weights_peephole (#mkldnn_query_weights_md, 3), if used
+ *  - weights_projection (#mkldnn_query_weights_md, 4), if used
+ *
+ * Outputs are the ones of mkldnn_rnn_backward_desc_init() plus:
+ *  - diff_weights_peephole (#mkldnn_query_diff_weights_md, 3), if used
+ *  - diff_weights_projection (#mkldnn_query_diff_weights_md, 4), if used
+ */
+mkldnn_status_t MKLDNN_API mkldnn_lstm_backward_desc_init(
+        mkldnn_rnn_desc_t *rnn_desc, mkldnn_prop_kind_t prop_kind,
+        const mkldnn_rnn_cell_desc_t *rnn_cell_desc,
+        const mkldnn_rnn_direction_t direction,
+        const mkldnn_memory_desc_t *src_layer_desc,
+        const mkldnn_memory_desc_t *src_iter_desc,
+        const mkldnn_memory_desc_t *weights_layer_desc,
+        const mkldnn_memory_desc_t *weights_iter_desc,
+        const mkldnn_memory_desc_t *weights_peephole_desc,
+        const mkldnn_memory_desc_t *weights_projection_desc,
+        const mkldnn_memory_desc_t *bias_desc,
+        const mkldnn_memory_desc_t *dst_layer_desc,
+        const mkldnn_memory_desc_t *dst_iter_desc,
+        const mkldnn_memory_desc_t *diff_src_layer_desc,
+        const mkldnn_memory_desc_t *diff_src_iter_desc,
+        const mkldnn_memory_desc_t *diff_weights_layer_desc,
+        const mkldnn_memory_desc_t *diff_weights_iter_desc,
+        const mkldnn_memory_desc_t *diff_weights_peephole_desc,
+        const mkldnn_memory_desc_t *diff_weights_projection_desc,
+        const mkldnn_memory_desc_t *diff_bias_desc,
+        const mkldnn_memory_desc_t *diff_dst_layer_desc,
+        const mkldnn_memory_desc_t *diff_dst_iter_desc);
+
 /** @} */
 
 /** @} */
@@ -1676,6 +1850,36 @@ mkldnn_status_t MKLDNN_API mkldnn_stream_destroy(mkldnn_stream_t stream);
 
 /** @} */
 
+/** @addtogroup c_api_plan Execution plans
+ * An execution plan runs a fixed sequence of primitives with fixed arguments.
+ * Consecutive primitives that are able to do so are executed in a single
+ * parallel section with a barrier between them, instead of opening a
+ * parallel section per primitive. The other primitives are executed as by
+ * mkldnn_primitive_execute().
+ *
+ * The plan keeps pointers to the primitives and the memories only, so they
+ * must outlive the plan.
+ * @{ */
+
+/** Creates an empty execution @p plan for @p engine. */
+mkldnn_status_t MKLDNN_API mkldnn_plan_create(mkldnn_plan_t *plan,
+        mkldnn_engine_t engine);
+
+/** Appends @p primitive with @p nargs arguments @p args to @p plan. The
+ * arguments are the same as for mkldnn_primitive_execute(). */
+mkldnn_status_t MKLDNN_API mkldnn_plan_append(mkldnn_plan_t plan,
+        const_mkldnn_primitive_t primitive, int nargs,
+        const mkldnn_exec_arg_t *args);
+
+/** Executes all the primitives of @p plan in order on @p stream. */
+mkldnn_status_t MKLDNN_API mkldnn_plan_execute(const_mkldnn_plan_t plan,
+        mkldnn_stream_t stream);
+
+/** Destroys an execution @p plan. */
+mkldnn_status_t MKLDNN_API mkldnn_plan_destroy(mkldnn_plan_t plan);
+
+/** @} */
+
 /** @addtogroup c_api_service Service functions
  * @{ */
 
@@ -292,6 +292,8 @@ enum query {
 
     impl_info_str = mkldnn_query_impl_info_str,
 
+    concat_inplace_s32 = mkldnn_query_concat_inplace_s32,
+
     op_d = mkldnn_query_op_d,
     convolution_d = mkldnn_query_convolution_d,
     deconvolution_d = mkldnn_query_deconvolution_d,
@@ -426,6 +428,30 @@ struct primitive_attr: public handle<mkldnn_primitive_attr_t> {
                 "could not set int output scales");
     }
 
+    void get_zero_points(int arg, int &mask,
+            std::vector<int32_t> &zero_points) const
+    {
+        mkldnn_dim_t count;
+        int c_mask;
+        const int32_t *c_zero_points;
+        error::wrap_c_api(mkldnn_primitive_attr_get_zero_points(get(), arg,
+                    &count, &c_mask, &c_zero_points),
+                "could not get zero points");
+        zero_points.resize(count);
+
+        mask = c_mask;
+        for (mkldnn_dim_t c = 0; c < count; ++c)
+            zero_points[c] = c_zero_points[c];
+    }
+
+    void set_zero_points(int arg, int mask,
+            const std::vector<int32_t> &zero_points)
+    {
+        error::wrap_c_api(mkldnn_primitive_attr_set_zero_points(get(), arg,
+                    (mkldnn_dim_t)zero_points.size(), mask, &zero_points[0]),
+                "could not set zero points");
+    }
+
     const post_ops get_post_ops() const {
         post_ops result;
         const_mkldnn_post_ops_t c_result;
@@ -566,6 +592,44 @@ struct stream: public handle<mkldnn_stream_t> {
 
 /// @}
 
+/// @addtogroup cpp_api_plan Execution plan
+/// A fixed sequence of primitives executed in as few parallel sections as
+/// possible
+///
+/// @sa @ref c_api_plan in @ref c_api
+/// @{
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+template <> struct handle_traits<mkldnn_plan_t> {
+    static constexpr auto destructor = &mkldnn_plan_destroy;
+};
+#endif
+
+struct plan: public handle<mkldnn_plan_t> {
+    using handle::handle;
+
+    /// Constructs an empty plan for @p aengine.
+    plan(const engine &aengine) {
+        mkldnn_plan_t aplan;
+        error::wrap_c_api(mkldnn_plan_create(&aplan, aengine.get()),
+                "could not create a plan");
+        reset(aplan);
+    }
+
+    /// Appends @p aprimitive with arguments @p args. The primitive and the
+    /// memories must outlive the plan.
+    void append(const primitive &aprimitive,
+            const std::unordered_map<int, memory> &args);
+
+    /// Executes the primitives of the plan in order.
+    void execute(stream &astream) const {
+        error::wrap_c_api(mkldnn_plan_execute(get(), astream.get()),
+                "plan execution fail");
+    }
+};
+
+/// @}
+
 /// @addtogroup cpp_api_memory_related Memory and memory related operations
 /// @{
 
@@ -739,6 +803,7 @@ struct memory: public handle<mkldnn_memory_t> {
         ldigo = mkldnn_ldigo,
         ldgoi = mkldnn_ldgoi,
         ldgo = mkldnn_ldgo,
+        ldio = mkldnn_ldio,
         nCdhw16c = mkldnn_nCdhw16c,
         nCdhw4c = mkldnn_nCdhw4c,
         nCdhw8c = mkldnn_nCdhw8c,
@@ -933,6 +998,15 @@ struct memory: public handle<mkldnn_memory_t> {
                 "could not set native handle");
     }
 
+    /// Sets the data handle. If @p is_zero_padded is true, the padded area
+    /// of the buffer is assumed to be filled with zeros already.
+    void set_data_handle(void *handle, bool is_zero_padded) const {
+        if (!is_zero_padded) return set_data_handle(handle);
+        error::wrap_c_api(
+                mkldnn_memory_set_zero_padded_data_handle(get(), handle),
+                "could not set native handle");
+    }
+
     /// Maps the data of the memory.
     ///
     /// Mapping allows to read/write directly from/to the memory contents for
@@ -1139,6 +1213,15 @@ struct concat : public primitive {
             return memory::desc(*cdesc);
         }
 
+        /// Returns true if the sources are the sub-memories of the
+        /// destination and the concat does not copy them.
+        bool is_inplace() const {
+            int res = 0;
+            mkldnn_status_t status = mkldnn_primitive_desc_query(get(),
+                    mkldnn::convert_to_c(concat_inplace_s32), 0, &res);
+            return status == mkldnn_success && res != 0;
+        }
+
         engine get_engine() { return engine::query(*this); }
     };
 
@@ -2460,6 +2543,30 @@ struct rnn_forward : public primitive {
                     "could not create an RNN forward descriptor");
         }
 
+        /// LSTM with optional peephole and projection weights, a zero
+        /// memory descriptor means the cell does not use them.
+        desc(prop_kind aprop_kind, rnn_cell::desc cell,
+                const rnn_direction direction,
+                const memory::desc &src_layer_desc,
+                const memory::desc &src_iter_desc,
+                const memory::desc &weights_layer_desc,
+                const memory::desc &weights_iter_desc,
+                const memory::desc &weights_peephole_desc,
+                const memory::desc &weights_projection_desc,
+                const memory::desc &bias_desc,
+                const memory::desc &dst_layer_desc,
+                const memory::desc &dst_iter_desc
+            ) {
+            error::wrap_c_api(mkldnn_lstm_forward_desc_init(&data,
+                        mkldnn::convert_to_c(aprop_kind), cell,
+                        mkldnn::convert_to_c(direction),
+                        &src_layer_desc.data, &src_iter_desc.data,
+                        &weights_layer_desc.data, &weights_iter_desc.data,
+                        &weights_peephole_desc.data,
+                        &weights_projection_desc.data, &bias_desc.data,
+                        &dst_layer_desc.data, &dst_iter_desc.data),
+                    "could not create an LSTM forward descriptor");
+        }
     };
 
     struct primitive_desc : public mkldnn::primitive_desc {
@@ -2474,6 +2581,8 @@ struct rnn_forward : public primitive {
         REG_QUERY_MD(weights_layer, weights, 0);
         REG_QUERY_MD(weights_iter, weights, 1);
         REG_QUERY_MD(bias, weights, 2);
+        REG_QUERY_MD(weights_peephole, weights, 3);
+        REG_QUERY_MD(weights_projection, weights, 4);
         REG_QUERY_MD(dst_layer, dst, 0);
         REG_QUERY_MD(dst_iter, dst, 1);
         REG_QUERY_MD(workspace, workspace, 0);
@@ -2516,6 +2625,45 @@ struct rnn_backward : public primitive {
                     "could not create an RNN backward descriptor");
         }
 
+        /// LSTM with optional peephole and projection weights, a zero
+        /// memory descriptor means the cell does not use them.
+        desc(prop_kind aprop_kind, rnn_cell::desc cell,
+                const rnn_direction direction,
+                const memory::desc &src_layer_desc,
+                const memory::desc &src_iter_desc,
+                const memory::desc &weights_layer_desc,
+                const memory::desc &weights_iter_desc,
+                const memory::desc &weights_peephole_desc,
+                const memory::desc &weights_projection_desc,
+                const memory::desc &bias_desc,
+                const memory::desc &dst_layer_desc,
+                const memory::desc &dst_iter_desc,
+                const memory::desc &diff_src_layer_desc,
+                const memory::desc &diff_src_iter_desc,
+                const memory::desc &diff_weights_layer_desc,
+                const memory::desc &diff_weights_iter_desc,
+                const memory::desc &diff_weights_peephole_desc,
+                const memory::desc &diff_weights_projection_desc,
+                const memory::desc &diff_bias_desc,
+                const memory::desc &diff_dst_layer_desc,
+                const memory::desc &diff_dst_iter_desc) {
+            error::wrap_c_api(mkldnn_lstm_backward_desc_init(&data,
+                        mkldnn::convert_to_c(aprop_kind), cell,
+                        mkldnn::convert_to_c(direction),
+                        &src_layer_desc.data, &src_iter_desc.data,
+                        &weights_layer_desc.data, &weights_iter_desc.data,
+                        &weights_peephole_desc.data,
+                        &weights_projection_desc.data, &bias_desc.data,
+                        &dst_layer_desc.data, &dst_iter_desc.data,
+                        &diff_src_layer_desc.data, &diff_src_iter_desc.data,
+                        &diff_weights_layer_desc.data,
+                        &diff_weights_iter_desc.data,
+                        &diff_weights_peephole_desc.data,
+                        &diff_weights_projection_desc.data,
+                        &diff_bias_desc.data,
+                        &diff_dst_layer_desc.data, &diff_dst_iter_desc.data),
+                    "could not create an LSTM backward descriptor");
+        }
     };
 
     struct primitive_desc : public mkldnn::primitive_desc {
@@ -2532,6 +2680,8 @@ struct rnn_backward : public primitive {
         REG_QUERY_MD(weights_layer, weights, 0);
         REG_QUERY_MD(weights_iter, weights, 1);
         REG_QUERY_MD(bias, weights, 2);
+        REG_QUERY_MD(weights_peephole, weights, 3);
+        REG_QUERY_MD(weights_projection, weights, 4);
         REG_QUERY_MD(dst_layer, dst, 0);
         REG_QUERY_MD(dst_iter, dst, 1);
         REG_QUERY_MD(workspace, workspace, 0);
@@ -2541,6 +2691,8 @@ struct rnn_backward : public primitive {
         REG_QUERY_MD(diff_weights_layer, diff_weights, 0);
         REG_QUERY_MD(diff_weights_iter, diff_weights, 1);
         REG_QUERY_MD(diff_bias, diff_weights, 2);
+        REG_QUERY_MD(diff_weights_peephole, diff_weights, 3);
+        REG_QUERY_MD(diff_weights_projection, diff_weights, 4);
         REG_QUERY_MD(diff_dst_layer, diff_dst, 0);
         REG_QUERY_MD(diff_dst_iter, diff_dst, 1);
         REG_QUERY_MD(scratchpad, scratchpad, 0);
@@ -2636,6 +2788,18 @@ inline void primitive::execute(stream &astream,
                 (int)c_args.size(), c_args.data()),
             "primitive execution fail");
 }
+
+inline void plan::append(const primitive &aprimitive,
+        const std::unordered_map<int, memory> &args) {
+    std::vector<mkldnn_exec_arg_t> c_args;
+    c_args.reserve(args.size());
+    for (const auto &a: args)
+        c_args.push_back({a.first, a.second.get()});
+
+    error::wrap_c_api(mkldnn_plan_append(get(), aprimitive.get(),
+                (int)c_args.size(), c_args.data()),
+            "could not append a primitive to a plan");
+}
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
 } // namespace mkldnn
@@ -331,6 +331,9 @@ typedef enum {
      *    and output gate.
      *  - For GRU cells, the gates order is update, reset and output gate. */
     mkldnn_ldgo = mkldnn_abcd,
+    /** 4D LSTM projection weights tensor in the format (num_layers,
+     * num_directions, output_channels, projection_channels). */
+    mkldnn_ldio = mkldnn_abcd,
 
     /* Opaque data types, are not to be used explicitly */
 
@@ -702,6 +705,17 @@ typedef enum {
      */
     mkldnn_memory_extra_flag_compensation_conv_s8s8 = 0x1U,
     mkldnn_memory_extra_flag_scale_adjust = 0x2U,
+    /** Indicates the weights have an additional buffer used to fold the
+     * source zero point into the accumulator. The buffer depends on the
+     * @p asymm_compensation_mask and follows the s8s8 compensation buffer
+     * (if any).
+     *
+     * For instance, in 4D case with the compensation mask equals (1 << 0)
+     * the additional buffer would consist of OC values:
+     * O[oc : 0,OC] =
+     *  -SUM(ic : 0,IC; kh : 0,KH; kw : 0,KW){ weights(oc, ic, kh, kw) }
+     */
+    mkldnn_memory_extra_flag_compensation_conv_asymmetric_src = 0x4U,
 } mkldnn_memory_extra_flags_t;
 
 /** Description of extra information stored in memory */
@@ -713,8 +727,10 @@ typedef struct {
     int compensation_mask;
     /** Scale applied to the data */
     float scale_adjust;
+    /** Compensation mask for asymmetric quantization */
+    int asymm_compensation_mask;
     /** For future backwards compatibility */
-    char reserved[64];
+    char reserved[60];
 } mkldnn_memory_extra_desc_t;
 
 /** Memory descriptor. The description is based on a number of dimensions,
@@ -782,6 +798,19 @@ typedef const struct mkldnn_memory *const_mkldnn_memory_t;
 #define MKLDNN_NATIVE_HANDLE_NONE (NULL)
 #define MKLDNN_NATIVE_HANDLE_ALLOCATE ((void *)(size_t)-1)
 
+/** A special floating point value that indicates the parameter (e.g. output
+ * scales or eltwise post-op alpha and beta) is unknown at the primitive
+ * descriptor creation time and is passed at execution time instead.
+ *
+ * @note
+ *      The value is a NaN, hence it cannot be detected by a floating point
+ *      comparison; compare the bit representations instead. */
+#define MKLDNN_RUNTIME_F32_VAL (MKLDNN_RUNTIME_F32_VAL_REP.f)
+static const union {
+    unsigned u;
+    float f;
+} MKLDNN_RUNTIME_F32_VAL_REP = { 0x7fc000d0 };
+
 /** @} */
 
 /** @addtogroup c_api_types_op_descs Operation descriptors
@@ -1105,6 +1134,14 @@ typedef struct {
     mkldnn_memory_desc_t diff_dst_layer_desc;
     /** Destination gradient iteration memory descriptor. */
     mkldnn_memory_desc_t diff_dst_iter_desc;
+    /** LSTM peephole weights memory descriptor (zero if not used). */
+    mkldnn_memory_desc_t weights_peephole_desc;
+    /** LSTM projection weights memory descriptor (zero if not used). */
+    mkldnn_memory_desc_t weights_projection_desc;
+    /** LSTM peephole weights gradient memory descriptor. */
+    mkldnn_memory_desc_t diff_weights_peephole_desc;
+    /** LSTM projection weights gradient memory descriptor. */
+    mkldnn_memory_desc_t diff_weights_projection_desc;
 } mkldnn_rnn_desc_t;
 
 /** @} */
@@ -1258,6 +1295,12 @@ typedef const struct mkldnn_primitive *const_mkldnn_primitive_t;
 #define MKLDNN_ARG_WEIGHTS_1            34
 #define MKLDNN_ARG_WEIGHTS_ITER         MKLDNN_ARG_WEIGHTS_1
 
+#define MKLDNN_ARG_WEIGHTS_2            35
+#define MKLDNN_ARG_WEIGHTS_PEEPHOLE     MKLDNN_ARG_WEIGHTS_2
+
+#define MKLDNN_ARG_WEIGHTS_3            36
+#define MKLDNN_ARG_WEIGHTS_PROJECTION   MKLDNN_ARG_WEIGHTS_3
+
 #define MKLDNN_ARG_BIAS                 41
 
 #define MKLDNN_ARG_MEAN                 49
@@ -1288,8 +1331,22 @@ typedef const struct mkldnn_primitive *const_mkldnn_primitive_t;
 #define MKLDNN_ARG_DIFF_WEIGHTS_1       162
 #define MKLDNN_ARG_DIFF_WEIGHTS_ITER    MKLDNN_ARG_DIFF_WEIGHTS_1
 
+#define MKLDNN_ARG_DIFF_WEIGHTS_2       163
+#define MKLDNN_ARG_DIFF_WEIGHTS_PEEPHOLE MKLDNN_ARG_DIFF_WEIGHTS_2
+
+#define MKLDNN_ARG_DIFF_WEIGHTS_3       164
+#define MKLDNN_ARG_DIFF_WEIGHTS_PROJECTION MKLDNN_ARG_DIFF_WEIGHTS_3
+
 #define MKLDNN_ARG_DIFF_BIAS            169
 
+/** Output scales passed at execution time (@sa MKLDNN_RUNTIME_F32_VAL) */
+#define MKLDNN_ARG_ATTR_OUTPUT_SCALES   513
+
+/** Parameters of the first post operation passed at execution time, use
+ * MKLDNN_ARG_ATTR_POST_OP_0 + i for the i-th post operation
+ * (@sa MKLDNN_RUNTIME_F32_VAL) */
+#define MKLDNN_ARG_ATTR_POST_OP_0       520
+
 #define MKLDNN_ARG_MULTIPLE_SRC         1024
 #define MKLDNN_ARG_MULTIPLE_DST         2048
 
@@ -1358,6 +1415,10 @@ typedef enum {
 
     mkldnn_query_impl_info_str, /**< implementation name */
 
+    mkldnn_query_concat_inplace_s32, /**< non-zero if the concat sources are
+                                        the sub-memories of the destination
+                                        and are not copied */
+
     /* memory and op descriptor section */
     mkldnn_query_some_d = 64, /**< stub */
     mkldnn_query_op_d, /**< op descriptor */
@@ -1403,6 +1464,20 @@ typedef struct mkldnn_stream *mkldnn_stream_t;
 /** A constant execution stream handle. */
 typedef const struct mkldnn_stream *const_mkldnn_stream_t;
 
+/** @} */
+
+/** @addtogroup c_api_types_plan Execution plan
+ * @{ */
+
+/** @struct mkldnn_plan
+ * An opaque structure to describe an execution plan: an ordered sequence of
+ * primitives together with their arguments. */
+struct mkldnn_plan;
+/** An execution plan handle. */
+typedef struct mkldnn_plan *mkldnn_plan_t;
+/** A constant execution plan handle. */
+typedef const struct mkldnn_plan *const_mkldnn_plan_t;
+
 /** @} */
 /** @} */
 /** @} */
@@ -258,6 +258,7 @@ namespace format_tag {
     const format_tag_t ldigo = mkldnn_ldigo;
     const format_tag_t ldgoi = mkldnn_ldgoi;
     const format_tag_t ldgo = mkldnn_ldgo;
+    const format_tag_t ldio = mkldnn_ldio;
     const format_tag_t nCdhw16c = mkldnn_nCdhw16c;
     const format_tag_t nCdhw4c = mkldnn_nCdhw4c;
     const format_tag_t nCdhw8c = mkldnn_nCdhw8c;
@@ -357,6 +358,7 @@ namespace memory_extra_flags {
     const memory_extra_flags_t none = mkldnn_memory_extra_flag_none;
     const memory_extra_flags_t compensation_conv_s8s8 = mkldnn_memory_extra_flag_compensation_conv_s8s8;
     const memory_extra_flags_t scale_adjust = mkldnn_memory_extra_flag_scale_adjust;
+    const memory_extra_flags_t compensation_conv_asymmetric_src = mkldnn_memory_extra_flag_compensation_conv_asymmetric_src;
 }
 
 using padding_kind_t = mkldnn_padding_kind_t;
@@ -405,6 +407,8 @@ namespace query {
 
     const query_t impl_info_str = mkldnn_query_impl_info_str;
 
+    const query_t concat_inplace_s32 = mkldnn_query_concat_inplace_s32;
+
     const query_t some_d = mkldnn_query_some_d;
     const query_t op_d = mkldnn_query_op_d;
     const query_t convolution_d = mkldnn_query_convolution_d;
@@ -506,6 +510,8 @@ namespace stream_flags {
 }
 using stream_t = mkldnn_stream;
 
+using plan_t = mkldnn_plan;
+
 /* forward declaration of the internal primitive_desc types */
 struct batch_normalization_bwd_pd_t;
 struct batch_normalization_fwd_pd_t;
@@ -40,6 +40,8 @@ status_t mkldnn_concat_primitive_desc_create(primitive_desc_t **concat_pd,
     const primitive_attr_t dummy_attr;
     if (attr == NULL)
         attr = &dummy_attr;
+    if (attr->has_runtime_params())
+        return unimplemented;
 
     const int ndims = src_mds[0].ndims;
     const dims_t &dims = src_mds[0].dims;
@@ -62,11 +62,30 @@ struct concat_pd_t: public primitive_desc_t {
     virtual int n_inputs() const override { return n_; }
     virtual int n_outputs() const override { return 1; }
 
+    virtual status_t query(query_t what, int idx, void *result) const override {
+        switch (what) {
+        case query::concat_inplace_s32: *(int *)result = is_inplace(); break;
+        default: return primitive_desc_t::query(what, idx, result);
+        }
+        return status::success;
+    }
+
     int concat_dim() const { return concat_dim_; }
 
     const memory_desc_t *src_image_md(int index = 0) const
     { return index < n_inputs() ? &src_image_mds_[index] : nullptr; }
 
+    /** returns true if every source coincides with its image in the
+     * destination and the implementation does not copy such sources */
+    bool is_inplace() const {
+        if (!skips_inplace_srcs() || (int)src_image_mds_.size() != n_)
+            return false;
+        for (int i = 0; i < n_; ++i)
+            if (memory_desc_wrapper(src_mds_[i]) != src_image_mds_[i])
+                return false;
+        return true;
+    }
+
 protected:
     int n_, concat_dim_;
     memory_desc_t dst_md_;
@@ -78,6 +97,10 @@ protected:
     nstl::vector<memory_desc_t> src_image_mds_;
 
 protected:
+    /* implementations that detect the sources residing in the destination
+     * (i.e. when the user passes the same memory) and skip copying them */
+    virtual bool skips_inplace_srcs() const { return false; }
+
     /* inits src_image_mds_ and dst_md_ in simple cases. The call may fail */
     status_t init() {
         bool ok = true
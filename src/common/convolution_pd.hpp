@@ -271,6 +271,7 @@ struct convolution_bwd_data_pd_t: public convolution_pd_t {
     virtual int n_outputs() const override { return 1; }
 
     virtual bool support_bias() const { return false; }
+    virtual bool support_post_ops() const { return false; }
 
 protected:
     memory_desc_t diff_src_md_;
@@ -56,7 +56,7 @@ bool memory_desc_sanity_check(const memory_desc_t *md) {
 
 mkldnn_memory::mkldnn_memory(mkldnn::impl::engine_t *engine,
         const mkldnn::impl::memory_desc_t *md, void *handle)
-    : engine_(engine), md_(*md) {
+    : engine_(engine), md_(*md), zero_padded_(false) {
     memory_storage_t *memory_storage_ptr;
     status_t status;
     if (handle == MKLDNN_NATIVE_HANDLE_ALLOCATE) {
@@ -241,6 +241,8 @@ status_t mkldnn_memory_get_data_handle(const memory_t *memory,
         *handle = nullptr;
         return success;
     }
+    /* the user may write to the padded area through the handle */
+    memory->set_zero_padded(false);
     return memory->get_data_handle(handle);
 }
 
@@ -249,11 +251,18 @@ status_t mkldnn_memory_set_data_handle(memory_t *memory, void *handle) {
     return memory->set_data_handle(handle);
 }
 
+status_t mkldnn_memory_set_zero_padded_data_handle(memory_t *memory,
+        void *handle) {
+    if (any_null(memory)) return invalid_arguments;
+    return memory->set_data_handle(handle, true);
+}
+
 status_t mkldnn_memory_map_data(const memory_t *memory, void **mapped_ptr) {
     bool args_ok = !any_null(memory, mapped_ptr);
     if (!args_ok)
         return invalid_arguments;
 
+    memory->set_zero_padded(false);
     return memory->memory_storage()->map_data(mapped_ptr);
 }
 
@@ -45,22 +45,43 @@ struct mkldnn_memory: public mkldnn::impl::c_compatible {
         return memory_storage()->get_data_handle(handle);
     }
 
-    /** sets data handle */
-    mkldnn::impl::status_t set_data_handle(void *handle) {
+    /** sets data handle and zeros padding, unless @p is_zero_padded is set
+     * or the handle is not changed and its padding is known to be zero */
+    mkldnn::impl::status_t set_data_handle(void *handle,
+            bool is_zero_padded = false) {
         using namespace mkldnn::impl;
 
-        status_t status = memory_storage()->set_data_handle(handle);
+        void *old_handle = nullptr;
+        status_t status = get_data_handle(&old_handle);
         if (status != status::success)
             return status;
+
+        status = memory_storage()->set_data_handle(handle);
+        if (status != status::success)
+            return status;
+
+        if (is_zero_padded || (handle == old_handle && zero_padded_)) {
+            zero_padded_ = true;
+            return status::success;
+        }
         return zero_pad();
     }
 
     /** zeros padding */
     mkldnn::impl::status_t zero_pad() const;
 
+    /** returns true if the padded area is known to be filled with zeros */
+    bool is_zero_padded() const { return zero_padded_; }
+    /** marks the padded area as filled with zeros or as spoiled, e.g. after
+     * a primitive wrote to the memory or the user got access to the data */
+    void set_zero_padded(bool zero_padded) const {
+        zero_padded_ = zero_padded;
+    }
+
 protected:
     mkldnn::impl::engine_t *engine_;
     const mkldnn::impl::memory_desc_t md_;
+    mutable bool zero_padded_;
 
 private:
     template <mkldnn::impl::data_type_t>
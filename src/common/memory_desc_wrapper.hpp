@@ -92,31 +92,51 @@ struct memory_desc_wrapper: public c_compatible {
     { return types::data_type_size(data_type()); }
 
     /** return the size of data type of additional buffer */
-    size_t additional_buffer_data_size() const {
-        if (extra().flags & memory_extra_flags::compensation_conv_s8s8)
+    size_t additional_buffer_data_size(memory_extra_flags_t flag) const {
+        using namespace memory_extra_flags;
+        if (flag & (compensation_conv_s8s8 | compensation_conv_asymmetric_src))
             return sizeof(int32_t);
         return 0;
     }
 
     /** return true if memory format has additional buffer */
     bool is_additional_buffer() const {
-        return (extra().flags & memory_extra_flags::compensation_conv_s8s8);
+        using namespace memory_extra_flags;
+        return (extra().flags
+                & (compensation_conv_s8s8 | compensation_conv_asymmetric_src));
     }
 
-    /** returns the size of additional buffer */
-    size_t additional_buffer_size() const {
-        if (extra().flags & memory_extra_flags::compensation_conv_s8s8) {
-            int cmask = extra().compensation_mask;
+    /** returns the size of additional buffer corresponding to the flag */
+    size_t additional_buffer_size(memory_extra_flags_t flag) const {
+        using namespace memory_extra_flags;
+
+        auto calculate_size = [=](int cmask, size_t buff_data_size) {
             assert(cmask == 1 || cmask == 3);
             dim_t prod = 1;
             for (int d = 0; d < ndims(); ++d)
                 if (cmask & (1<<d)) prod *= padded_dims()[d];
-            return prod * additional_buffer_data_size();
-        }
+            return prod * buff_data_size;
+        };
+
+        if (extra().flags & flag & compensation_conv_s8s8)
+            return calculate_size(extra().compensation_mask,
+                    additional_buffer_data_size(compensation_conv_s8s8));
+
+        if (extra().flags & flag & compensation_conv_asymmetric_src)
+            return calculate_size(extra().asymm_compensation_mask,
+                    additional_buffer_data_size(
+                        compensation_conv_asymmetric_src));
 
         return 0;
     }
 
+    /** returns the size of additional buffer */
+    size_t additional_buffer_size() const {
+        using namespace memory_extra_flags;
+        return additional_buffer_size(compensation_conv_s8s8)
+            + additional_buffer_size(compensation_conv_asymmetric_src);
+    }
+
     /** returns the size required to store described memory
      * note: if offset0 != 0 returns 0 (need to specify the behavior) */
     size_t size() const {
@@ -219,6 +239,15 @@ struct memory_desc_wrapper: public c_compatible {
         return memory_desc_matches_tag(*md_, tag, strides);
     }
 
+    /** returns true if the memory desc corresponds to the given format tag
+     * with an arbitrary stride along the minibatch. Such a memory might be a
+     * sub-memory of a bigger tensor along the channels, e.g. one of the
+     * sources of an in-place concat. */
+    bool matches_tag_any_mb_stride(format_tag_t tag) const {
+        const dims_t strides = {-1};
+        return matches_tag(tag, strides);
+    }
+
     /** returns matching tag (or undef if match is not found)
      * XXX: This is a workaround that eventually should go away! */
     template <typename... Tags>
@@ -0,0 +1,155 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include <algorithm>
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "memory_desc_wrapper.hpp"
+#include "memory_planner.hpp"
+#include "utils.hpp"
+
+using namespace mkldnn::impl;
+using namespace mkldnn::impl::status;
+using namespace mkldnn::impl::utils;
+
+status_t memory_planner_t::add_tensor(const memory_desc_t *md, int *tensor) {
+    if (any_null(md, tensor) || md->format_kind == format_kind::any)
+        return invalid_arguments;
+
+    const size_t size = rnd_up(memory_desc_wrapper(*md).size(),
+            (size_t)alignment);
+    tensors_.push_back({size, -1, -1, 0});
+    placed_ = false;
+
+    *tensor = (int)tensors_.size() - 1;
+    return success;
+}
+
+status_t memory_planner_t::append(int ntensors, const int *tensors) {
+    if (ntensors < 0 || (ntensors > 0 && tensors == nullptr))
+        return invalid_arguments;
+    for (int i = 0; i < ntensors; ++i)
+        if (tensors[i] < 0 || tensors[i] >= (int)tensors_.size())
+            return invalid_arguments;
+
+    const int step = nsteps_++;
+    for (int i = 0; i < ntensors; ++i) {
+        auto &t = tensors_[tensors[i]];
+        if (t.first_step == -1) t.first_step = step;
+        t.last_step = step;
+    }
+    placed_ = false;
+
+    return success;
+}
+
+status_t memory_planner_t::offset(int tensor, size_t *offset) {
+    if (offset == nullptr || tensor < 0 || tensor >= (int)tensors_.size())
+        return invalid_arguments;
+
+    place();
+    *offset = tensors_[tensor].offset;
+    return success;
+}
+
+void memory_planner_t::place() {
+    if (placed_) return;
+
+    /* the larger tensors first, the ties are broken by the first use to keep
+     * the placement independent of the sort implementation */
+    std::vector<int> order;
+    for (int i = 0; i < (int)tensors_.size(); ++i) {
+        tensors_[i].offset = 0;
+        if (tensors_[i].first_step != -1 && tensors_[i].size != 0)
+            order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        const auto &ta = tensors_[a], &tb = tensors_[b];
+        if (ta.size != tb.size) return ta.size > tb.size;
+        if (ta.first_step != tb.first_step)
+            return ta.first_step < tb.first_step;
+        return a < b;
+    });
+
+    arena_size_ = 0;
+    std::vector<int> alive; /* placed tensors that overlap the current one */
+    for (size_t o = 0; o < order.size(); ++o) {
+        auto &t = tensors_[order[o]];
+
+        alive.clear();
+        for (size_t p = 0; p < o; ++p)
+            if (tensors_[order[p]].overlaps(t))
+                alive.push_back(order[p]);
+        std::sort(alive.begin(), alive.end(), [&](int a, int b) {
+            return tensors_[a].offset < tensors_[b].offset;
+        });
+
+        /* the first gap between the alive tensors that is large enough */
+        size_t offset = 0;
+        for (int a: alive) {
+            const auto &ta = tensors_[a];
+            if (offset + t.size <= ta.offset) break;
+            offset = nstl::max(offset, ta.offset + ta.size);
+        }
+
+        t.offset = offset;
+        arena_size_ = nstl::max(arena_size_, offset + t.size);
+    }
+
+    placed_ = true;
+}
+
+/* API */
+
+status_t mkldnn_memory_planner_create(memory_planner_t **planner) {
+    if (planner == nullptr) return invalid_arguments;
+    return safe_ptr_assign<memory_planner_t>(*planner,
+            new memory_planner_t());
+}
+
+status_t mkldnn_memory_planner_add_tensor(memory_planner_t *planner,
+        const memory_desc_t *md, int *tensor) {
+    if (planner == nullptr) return invalid_arguments;
+    return planner->add_tensor(md, tensor);
+}
+
+status_t mkldnn_memory_planner_append(memory_planner_t *planner,
+        int ntensors, const int *tensors) {
+    if (planner == nullptr) return invalid_arguments;
+    return planner->append(ntensors, tensors);
+}
+
+status_t mkldnn_memory_planner_get_arena_size(memory_planner_t *planner,
+        size_t *size) {
+    if (any_null(planner, size)) return invalid_arguments;
+    *size = planner->arena_size();
+    return success;
+}
+
+status_t mkldnn_memory_planner_get_offset(memory_planner_t *planner,
+        int tensor, size_t *offset) {
+    if (planner == nullptr) return invalid_arguments;
+    return planner->offset(tensor, offset);
+}
+
+status_t mkldnn_memory_planner_destroy(memory_planner_t *planner) {
+    delete planner;
+    return success;
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,67 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef MEMORY_PLANNER_HPP
+#define MEMORY_PLANNER_HPP
+
+#include <vector>
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "utils.hpp"
+
+/** Places the tensors of a sequence of primitives in a single arena.
+ *
+ * A tensor lives from the first to the last step that uses it, and two
+ * tensors may share a part of the arena only if their lifetimes do not
+ * intersect. The tensors are placed greedily from the largest to the
+ * smallest one, each at the lowest aligned offset that does not intersect
+ * the already placed tensors that are alive at the same time. */
+struct mkldnn_memory_planner: public mkldnn::impl::c_compatible {
+    enum { alignment = 64 };
+
+    mkldnn_memory_planner(): nsteps_(0), arena_size_(0), placed_(true) {}
+
+    mkldnn::impl::status_t add_tensor(const mkldnn::impl::memory_desc_t *md,
+            int *tensor);
+    mkldnn::impl::status_t append(int ntensors, const int *tensors);
+
+    size_t arena_size() { place(); return arena_size_; }
+    mkldnn::impl::status_t offset(int tensor, size_t *offset);
+
+private:
+    struct tensor_t {
+        size_t size;
+        int first_step, last_step; /* first_step == -1 means unused */
+        size_t offset;
+
+        bool overlaps(const tensor_t &t) const {
+            return first_step <= t.last_step && t.first_step <= last_step;
+        }
+    };
+
+    void place();
+
+    std::vector<tensor_t> tensors_;
+    int nsteps_;
+    size_t arena_size_;
+    bool placed_;
+};
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -158,16 +158,20 @@ enum {
     key_conv_gemm_col,
     key_conv_gemm_imtr,
     key_conv_int_dat_in_acc_dt,
+    key_conv_nspc_batch,
     key_conv_padded_bias,
     key_conv_rtus_space,
     key_conv_tr_diff_dst,
     key_conv_tr_diff_dst_bctx,
     key_conv_tr_src,
     key_conv_tr_src_bctx,
+    key_conv_tr_wei,
     key_conv_wei_reduction,
     key_conv_wei_bia_reduction,
     key_conv_wei_bia_reduction_bctx,
+    key_conv_zp_compensation,
     key_iprod_int_dat_in_acc_dt,
+    key_iprod_zp_compensation,
     key_reducer_space,
     key_reducer_space_bctx,
     key_reorder_wino_plain,
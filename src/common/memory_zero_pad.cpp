@@ -81,8 +81,14 @@ void typed_zero_pad_blk(
                         = 0;
     };
 
+    /* a block holds a single row of the tail for the 1d blocked formats and
+     * blksize of them for the 2d ones */
+    const bool blk_1d = utils::one_of(blk_kind, a, b, c);
+    const size_t blk_cost = blk_1d ? blksize : blksize * blksize;
+
     if (c_tail_s) {
-        parallel_nd(A, B, D, E, F, [&](int a, int b, int d, int e, int f) {
+        parallel_nd_cost(blk_cost, A, B, D, E, F,
+                [&](int a, int b, int d, int e, int f) {
             auto x = &data[m_d.blk_off(a, b, C - 1, d, e, f)];
             if (blk_kind == c)
                 zeroize_tail(x, c_tail_s);
@@ -94,7 +100,8 @@ void typed_zero_pad_blk(
     }
 
     if (b_tail_s) {
-        parallel_nd(A, C, D, E, F, [&](int a, int c, int d, int e, int f) {
+        parallel_nd_cost(blk_cost, A, C, D, E, F,
+                [&](int a, int c, int d, int e, int f) {
             auto x = &data[m_d.blk_off(a, B - 1, c, d, e, f)];
             if (blk_kind == b)
                 zeroize_tail(x, b_tail_s);
@@ -106,7 +113,8 @@ void typed_zero_pad_blk(
     }
 
     if (a_tail_s) {
-        parallel_nd(B, C, D, E, F, [&](int b, int c, int d, int e, int f) {
+        parallel_nd_cost(blk_cost, B, C, D, E, F,
+                [&](int b, int c, int d, int e, int f) {
             auto x = &data[m_d.blk_off(A - 1, b, c, d, e, f)];
             if (blk_kind == a)
                 zeroize_tail(x, a_tail_s);
@@ -128,47 +136,39 @@ void typed_zero_pad_generic_blocked(
     const auto &dims = m_d.dims();
     const auto &pdims = m_d.padded_dims();
 
-    const ptrdiff_t nelems = (ptrdiff_t)m_d.nelems(true);
-
-    /* [D_0] .. [D_k][D_k+1] .. [D_ndim - 1]
-     *            |  \                     /
-     *            |   ---------------------
-     *           has        contiguous
-     *         padding
+    /* A point is in the padded area iff there is a dimension k such that
+     * dims[k] <= idx[k] < pdims[k]. Taking k the first such dimension, the
+     * padded area is a disjoint union of the slabs
      *
-     * step     <-- D_k+1 * ... * D_ndims-1
-     * step_dim <-- k
-     */
-
-    ptrdiff_t step = 1;
-    int step_dim = ndims - 1;
-    for (; step_dim >= 0; --step_dim) {
-        if (dims[step_dim] != pdims[step_dim])
-            break;
-        step *= dims[step_dim];
-    }
-
-    assert(step_dim >= 0 && "no zero padding is required");
-    if (step_dim < 0)
-        return;
-
-    parallel_nd(nelems / step, [&](ptrdiff_t e1) {
-        bool need_zero = false;
-
-        ptrdiff_t idx = e1;
-        for (int d = step_dim; d >= 0; --d) {
-            if (idx % pdims[d] >= dims[d]) {
-                need_zero = true;
-                break;
+     *      [D_0] .. [D_k-1] [dims[k] .. pdims[k]) [P_k+1] .. [P_ndims-1]
+     *      \_____________/                        \____________________/
+     *          outer                                       inner
+     *
+     * where D_i and P_i stand for dims[i] and pdims[i] respectively, so only
+     * the padded elements are visited */
+    for (int k = 0; k < ndims; ++k) {
+        if (dims[k] == pdims[k]) continue;
+
+        ptrdiff_t outer = 1, inner = 1;
+        for (int d = 0; d < k; ++d) outer *= dims[d];
+        for (int d = k + 1; d < ndims; ++d) inner *= pdims[d];
+        const ptrdiff_t tail = pdims[k] - dims[k];
+
+        /* off_l() is a division and a multiplication per dimension */
+        const size_t item_cost = (size_t)inner * ndims * 4;
+        parallel_nd_cost(item_cost, outer, tail, [&](ptrdiff_t o, ptrdiff_t t) {
+            ptrdiff_t l_off = 0, l_stride = 1, rem = o;
+            for (int d = k - 1; d >= 0; --d) {
+                l_off += (rem % dims[d]) * l_stride;
+                rem /= dims[d];
+                l_stride *= pdims[d];
             }
-            idx /= pdims[d];
-        }
+            l_off = (l_off * pdims[k] + dims[k] + t) * inner;
 
-        if (need_zero) {
-            for (ptrdiff_t e0 = 0; e0 < step; ++e0)
-                data[m_d.off_l(e1 * step + e0, true)] = 0;
-        }
-    });
+            for (ptrdiff_t i = 0; i < inner; ++i)
+                data[m_d.off_l(l_off + i, true)] = 0;
+        });
+    }
 }
 
 template <data_type_t dt>
@@ -268,12 +268,14 @@ status_t memory_t::zero_pad() const {
         || !mdw.is_blocking_desc();
     if (skip_zeroing) return success;
 
+    status_t status = unimplemented;
     switch (mdw.data_type()) {
-        case f32: return typed_zero_pad<f32>();
-        case s32: return typed_zero_pad<s32>();
-        case s8: return typed_zero_pad<s8>();
-        case u8: return typed_zero_pad<u8>();
+        case f32: status = typed_zero_pad<f32>(); break;
+        case s32: status = typed_zero_pad<s32>(); break;
+        case s8: status = typed_zero_pad<s8>(); break;
+        case u8: status = typed_zero_pad<u8>(); break;
         default: assert(!"memory is undefined"); return unimplemented;
     }
-    return unimplemented;
+    if (status == success) zero_padded_ = true;
+    return status;
 }
@@ -194,6 +194,7 @@ const char *mkldnn_fmt_tag2str(mkldnn_format_tag_t v) {
     if (v == mkldnn_ldigo) return "ldigo";
     if (v == mkldnn_ldgoi) return "ldgoi";
     if (v == mkldnn_ldgo) return "ldgo";
+    if (v == mkldnn_ldio) return "ldio";
     if (v == mkldnn_nCdhw16c) return "nCdhw16c";
     if (v == mkldnn_nCdhw4c) return "nCdhw4c";
     if (v == mkldnn_nCdhw8c) return "nCdhw8c";
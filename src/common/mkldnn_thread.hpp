@@ -17,6 +17,8 @@
 #ifndef MKLDNN_THREAD_HPP
 #define MKLDNN_THREAD_HPP
 
+#include <atomic>
+
 #include "utils.hpp"
 #include "z_magic.hpp"
 
@@ -30,6 +30,18 @@
  *                                     calls for_nd
  *  - parallel_nd_in_omp(dims..., f) - queries current nthr and ithr and then
  *                                     calls for_nd (mostly for convenience)
+ *  - parallel_nd_cost(item_cost, dims..., f)
+ *                                   - same as parallel_nd, but the number of
+ *                                     threads is chosen by the total amount
+ *                                     of work (see nthr_for_work). Runs f
+ *                                     without opening a parallel section if
+ *                                     the work is too small to be shared
+ *  - parallel_nd_dynamic(dims..., f)
+ *                                   - same as parallel_nd, but the threads
+ *                                     take the work in small chunks while any
+ *                                     is left (for the items of varying cost)
+ *  - work_scheduler_t               - static or dynamic distribution of the
+ *                                     work for hand-written parallel sections
  */
 
 namespace mkldnn {
@@ -150,6 +162,29 @@ template <typename T, typename ...Args>
 constexpr size_t get_work_amount(const T &v, Args &&...args)
 { return (size_t)v * get_work_amount(utils::forward<Args>(args)...); }
 
+/* Opening a parallel section costs a few microseconds on a machine with many
+ * cores, which is more than a thread spends on a few thousand simple
+ * operations. Hence a thread is added only when it gets at least
+ * parallel_min_work_per_thr elementary operations (a load, a store or an fma
+ * each). */
+constexpr size_t parallel_min_work_per_thr = 1 << 15;
+
+/* the number of threads worth spawning for work_amount items each costing
+ * item_cost elementary operations; at most nthr (0 means
+ * mkldnn_get_max_threads()) and 1 inside of a parallel section already */
+inline int nthr_for_work(size_t work_amount, size_t item_cost, int nthr = 0) {
+    if (nthr == 0) nthr = mkldnn_get_max_threads();
+    if (nthr <= 1 || work_amount <= 1 || mkldnn_in_parallel()) return 1;
+
+    if (item_cost == 0) item_cost = 1;
+    const size_t max_nthr = work_amount < (size_t)nthr
+        ? work_amount : (size_t)nthr;
+    if (work_amount > max_nthr * parallel_min_work_per_thr / item_cost)
+        return (int)max_nthr;
+    const size_t nthr_work = work_amount * item_cost / parallel_min_work_per_thr;
+    return nthr_work > 1 ? (int)nthr_work : 1;
+}
+
 /* parallel_nd and parallel_nd_in_omp section */
 
 #if MKLDNN_THR != MKLDNN_THR_TBB
@@ -225,6 +260,259 @@ void parallel_nd(const T0 &D0, const T1 &D1, const T2 &D2, const T3 &D3,
 }
 #endif
 
+/* parallel_nd_cost section */
+
+#if MKLDNN_THR != MKLDNN_THR_TBB
+template <typename ...Args>
+void parallel_nd_cost(size_t item_cost, Args &&...args) {
+#if MKLDNN_THR == MKLDNN_THR_SEQ
+    (void)item_cost;
+    for_nd(0, 1, utils::forward<Args>(args)...);
+#elif MKLDNN_THR == MKLDNN_THR_OMP
+    const int nthr = nthr_for_work(
+            get_work_amount(utils::forward<Args>(args)...), item_cost);
+    if (nthr == 1) {
+        for_nd(0, 1, utils::forward<Args>(args)...);
+        return;
+    }
+#   pragma omp parallel num_threads(nthr)
+    for_nd(mkldnn_get_thread_num(), mkldnn_get_num_threads(),
+            utils::forward<Args>(args)...);
+#endif
+}
+#else // MKLDNN_THR != MKLDNN_THR_TBB
+
+// See the comment on parallel_nd for TBB above.
+
+template <typename T0, typename F>
+void parallel_nd_cost(size_t item_cost, const T0 &D0, F f) {
+    const int nthr = nthr_for_work((size_t)D0, item_cost);
+    if (nthr == 1) { for_nd(0, 1, D0, f); return; }
+    tbb::parallel_for(0, nthr, [&](int ithr) {
+        for_nd(ithr, nthr, D0, f);
+    });
+}
+
+template <typename T0, typename T1, typename F>
+void parallel_nd_cost(size_t item_cost, const T0 &D0, const T1 &D1, F f) {
+    const int nthr = nthr_for_work((size_t)D0 * D1, item_cost);
+    if (nthr == 1) { for_nd(0, 1, D0, D1, f); return; }
+    tbb::parallel_for(0, nthr, [&](int ithr) {
+        for_nd(ithr, nthr, D0, D1, f);
+    });
+}
+
+template <typename T0, typename T1, typename T2, typename F>
+void parallel_nd_cost(size_t item_cost, const T0 &D0, const T1 &D1,
+        const T2 &D2, F f) {
+    const int nthr = nthr_for_work((size_t)D0 * D1 * D2, item_cost);
+    if (nthr == 1) { for_nd(0, 1, D0, D1, D2, f); return; }
+    tbb::parallel_for(0, nthr, [&](int ithr) {
+        for_nd(ithr, nthr, D0, D1, D2, f);
+    });
+}
+
+template <typename T0, typename T1, typename T2, typename T3, typename F>
+void parallel_nd_cost(size_t item_cost, const T0 &D0, const T1 &D1,
+        const T2 &D2, const T3 &D3, F f) {
+    const int nthr = nthr_for_work((size_t)D0 * D1 * D2 * D3, item_cost);
+    if (nthr == 1) { for_nd(0, 1, D0, D1, D2, D3, f); return; }
+    tbb::parallel_for(0, nthr, [&](int ithr) {
+        for_nd(ithr, nthr, D0, D1, D2, D3, f);
+    });
+}
+
+template <typename T0, typename T1, typename T2, typename T3, typename T4,
+         typename F>
+void parallel_nd_cost(size_t item_cost, const T0 &D0, const T1 &D1,
+        const T2 &D2, const T3 &D3, const T4 &D4, F f) {
+    const int nthr
+        = nthr_for_work((size_t)D0 * D1 * D2 * D3 * D4, item_cost);
+    if (nthr == 1) { for_nd(0, 1, D0, D1, D2, D3, D4, f); return; }
+    tbb::parallel_for(0, nthr, [&](int ithr) {
+        for_nd(ithr, nthr, D0, D1, D2, D3, D4, f);
+    });
+}
+
+template <typename T0, typename T1, typename T2, typename T3, typename T4,
+         typename T5, typename F>
+void parallel_nd_cost(size_t item_cost, const T0 &D0, const T1 &D1,
+        const T2 &D2, const T3 &D3, const T4 &D4, const T5 &D5, F f) {
+    const int nthr
+        = nthr_for_work((size_t)D0 * D1 * D2 * D3 * D4 * D5, item_cost);
+    if (nthr == 1) { for_nd(0, 1, D0, D1, D2, D3, D4, D5, f); return; }
+    tbb::parallel_for(0, nthr, [&](int ithr) {
+        for_nd(ithr, nthr, D0, D1, D2, D3, D4, D5, f);
+    });
+}
+#endif
+
+/* dynamic scheduling section */
+
+/* The static schedule gives every thread a single balance211() range, so the
+ * threads that got the cheap items (rows next to the padding, the last
+ * channel block, ...) wait for the others at the end of the parallel
+ * section. The dynamic one cuts the work into parallel_dynamic_chunks_per_thr
+ * balance211() chunks per thread and the threads take the chunks in order
+ * until none is left. */
+constexpr int parallel_dynamic_chunks_per_thr = 8;
+
+inline int parallel_dynamic_nchunks(size_t work_amount, int nthr) {
+    const size_t nchunks = (size_t)nthr * parallel_dynamic_chunks_per_thr;
+    return (int)(work_amount < nchunks ? work_amount : nchunks);
+}
+
+/* Hands the ranges [start, end) of work_amount items out to the threads of a
+ * parallel section either statically (a single balance211() range each) or
+ * dynamically:
+ *
+ *     work_scheduler_t sched(work_amount, nthr, dynamic);
+ *     parallel(nthr, [&](const int ithr, const int nthr) {
+ *         auto thr_sched = sched.thread(ithr, nthr);
+ *         int start{0}, end{0};
+ *         while (thr_sched.next(start, end)) { ... }
+ *     });
+ *
+ * The static schedule uses the nthr of the parallel section, so it is fine
+ * if the section gets fewer threads than asked for. */
+struct work_scheduler_t {
+    work_scheduler_t(size_t work_amount, int nthr, bool dynamic)
+        : work_amount_(work_amount)
+        , dynamic_(dynamic && nthr > 1)
+        , nchunks_(dynamic_ ? parallel_dynamic_nchunks(work_amount, nthr) : 0)
+        , next_chunk_(0) {}
+
+    struct thread_t {
+        thread_t(work_scheduler_t &sched, int ithr, int nthr)
+            : sched_(sched), ithr_(ithr), nthr_(nthr), done_(false) {}
+
+        template <typename T>
+        bool next(T &start, T &end) {
+            if (!sched_.dynamic_) {
+                if (done_) return false;
+                done_ = true;
+                balance211((T)sched_.work_amount_, nthr_, ithr_, start, end);
+                return true;
+            }
+            const int ichunk = sched_.next_chunk_++;
+            if (ichunk >= sched_.nchunks_) return false;
+            balance211((T)sched_.work_amount_, sched_.nchunks_, ichunk,
+                    start, end);
+            return true;
+        }
+
+    private:
+        work_scheduler_t &sched_;
+        int ithr_, nthr_;
+        bool done_;
+    };
+
+    thread_t thread(int ithr, int nthr) { return thread_t(*this, ithr, nthr); }
+
+private:
+    size_t work_amount_;
+    bool dynamic_;
+    int nchunks_;
+    std::atomic<int> next_chunk_;
+};
+
+/* parallel_nd_dynamic section */
+
+#if MKLDNN_THR != MKLDNN_THR_TBB
+template <typename ...Args>
+void parallel_nd_dynamic(Args &&...args) {
+#if MKLDNN_THR == MKLDNN_THR_SEQ
+    for_nd(0, 1, utils::forward<Args>(args)...);
+#elif MKLDNN_THR == MKLDNN_THR_OMP
+    const size_t work_amount = get_work_amount(utils::forward<Args>(args)...);
+    const int nthr = nthr_for_work(work_amount, parallel_min_work_per_thr);
+    if (nthr == 1) {
+        for_nd(0, 1, utils::forward<Args>(args)...);
+        return;
+    }
+    const int nchunks = parallel_dynamic_nchunks(work_amount, nthr);
+    std::atomic<int> next_chunk(0);
+#   pragma omp parallel num_threads(nthr)
+    for (int ichunk = next_chunk++; ichunk < nchunks; ichunk = next_chunk++)
+        for_nd(ichunk, nchunks, utils::forward<Args>(args)...);
+#endif
+}
+#else // MKLDNN_THR != MKLDNN_THR_TBB
+
+// See the comment on parallel_nd for TBB above. The chunks are spread over the
+// threads by the TBB work stealing scheduler.
+
+template <typename T0, typename F>
+void parallel_nd_dynamic(const T0 &D0, F f) {
+    const int nthr = nthr_for_work((size_t)D0, parallel_min_work_per_thr);
+    if (nthr == 1) { for_nd(0, 1, D0, f); return; }
+    const int nchunks = parallel_dynamic_nchunks((size_t)D0, nthr);
+    tbb::parallel_for(0, nchunks, [&](int ichunk) {
+        for_nd(ichunk, nchunks, D0, f);
+    });
+}
+
+template <typename T0, typename T1, typename F>
+void parallel_nd_dynamic(const T0 &D0, const T1 &D1, F f) {
+    const size_t work_amount = (size_t)D0 * D1;
+    const int nthr = nthr_for_work(work_amount, parallel_min_work_per_thr);
+    if (nthr == 1) { for_nd(0, 1, D0, D1, f); return; }
+    const int nchunks = parallel_dynamic_nchunks(work_amount, nthr);
+    tbb::parallel_for(0, nchunks, [&](int ichunk) {
+        for_nd(ichunk, nchunks, D0, D1, f);
+    });
+}
+
+template <typename T0, typename T1, typename T2, typename F>
+void parallel_nd_dynamic(const T0 &D0, const T1 &D1, const T2 &D2, F f) {
+    const size_t work_amount = (size_t)D0 * D1 * D2;
+    const int nthr = nthr_for_work(work_amount, parallel_min_work_per_thr);
+    if (nthr == 1) { for_nd(0, 1, D0, D1, D2, f); return; }
+    const int nchunks = parallel_dynamic_nchunks(work_amount, nthr);
+    tbb::parallel_for(0, nchunks, [&](int ichunk) {
+        for_nd(ichunk, nchunks, D0, D1, D2, f);
+    });
+}
+
+template <typename T0, typename T1, typename T2, typename T3, typename F>
+void parallel_nd_dynamic(const T0 &D0, const T1 &D1, const T2 &D2,
+        const T3 &D3, F f) {
+    const size_t work_amount = (size_t)D0 * D1 * D2 * D3;
+    const int nthr = nthr_for_work(work_amount, parallel_min_work_per_thr);
+    if (nthr == 1) { for_nd(0, 1, D0, D1, D2, D3, f); return; }
+    const int nchunks = parallel_dynamic_nchunks(work_amount, nthr);
+    tbb::parallel_for(0, nchunks, [&](int ichunk) {
+        for_nd(ichunk, nchunks, D0, D1, D2, D3, f);
+    });
+}
+
+template <typename T0, typename T1, typename T2, typename T3, typename T4,
+         typename F>
+void parallel_nd_dynamic(const T0 &D0, const T1 &D1, const T2 &D2,
+        const T3 &D3, const T4 &D4, F f) {
+    const size_t work_amount = (size_t)D0 * D1 * D2 * D3 * D4;
+    const int nthr = nthr_for_work(work_amount, parallel_min_work_per_thr);
+    if (nthr == 1) { for_nd(0, 1, D0, D1, D2, D3, D4, f); return; }
+    const int nchunks = parallel_dynamic_nchunks(work_amount, nthr);
+    tbb::parallel_for(0, nchunks, [&](int ichunk) {
+        for_nd(ichunk, nchunks, D0, D1, D2, D3, D4, f);
+    });
+}
+
+template <typename T0, typename T1, typename T2, typename T3, typename T4,
+         typename T5, typename F>
+void parallel_nd_dynamic(const T0 &D0, const T1 &D1, const T2 &D2,
+        const T3 &D3, const T4 &D4, const T5 &D5, F f) {
+    const size_t work_amount = (size_t)D0 * D1 * D2 * D3 * D4 * D5;
+    const int nthr = nthr_for_work(work_amount, parallel_min_work_per_thr);
+    if (nthr == 1) { for_nd(0, 1, D0, D1, D2, D3, D4, D5, f); return; }
+    const int nchunks = parallel_dynamic_nchunks(work_amount, nthr);
+    tbb::parallel_for(0, nchunks, [&](int ichunk) {
+        for_nd(ichunk, nchunks, D0, D1, D2, D3, D4, D5, f);
+    });
+}
+#endif
+
 template <typename ...Args>
 void parallel_nd_in_omp(Args &&...args) {
 #if MKLDNN_THR == MKLDNN_THR_SEQ
@@ -0,0 +1,140 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "engine.hpp"
+#include "mkldnn_thread.hpp"
+#include "plan.hpp"
+#include "primitive.hpp"
+#include "stream.hpp"
+#include "utils.hpp"
+#include "verbose.hpp"
+
+#include "cpu/cpu_barrier.hpp"
+
+using namespace mkldnn::impl;
+using namespace mkldnn::impl::status;
+
+status_t plan_t::append(const primitive_t *primitive, int nargs,
+        const mkldnn_exec_arg_t *c_args) {
+    bool ok = true
+        && primitive != nullptr
+        && primitive->engine() == engine_
+        && nargs >= 0
+        && IMPLICATION(nargs > 0, c_args != nullptr);
+    if (!ok) return invalid_arguments;
+
+    /* check the arguments once here rather than on every execution */
+    exec_args_t args;
+    status_t status = cvt_primtive_args(primitive->pd(), nargs, c_args, args);
+    if (status != success) return status;
+
+    steps_.push_back({primitive,
+            std::vector<mkldnn_exec_arg_t>(c_args, c_args + nargs)});
+    return success;
+}
+
+status_t plan_t::execute_step(stream_t *stream, const step_t &step) const {
+    return mkldnn_primitive_execute(step.primitive, stream,
+            (int)step.c_args.size(), step.c_args.data());
+}
+
+status_t plan_t::execute_thr(stream_t *stream, size_t begin,
+        size_t end) const {
+    std::vector<exec_ctx_t> ctxs;
+    ctxs.reserve(end - begin);
+    for (size_t s = begin; s < end; ++s) {
+        const auto &step = steps_[s];
+        exec_args_t args;
+        status_t status = cvt_primtive_args(step.primitive->pd(),
+                (int)step.c_args.size(), step.c_args.data(), args);
+        if (status != success) return status;
+        ctxs.emplace_back(stream, std::move(args));
+    }
+
+    cpu::simple_barrier::ctx_t barrier_ctx;
+    cpu::simple_barrier::ctx_init(&barrier_ctx);
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        for (size_t s = begin; s < end; ++s) {
+            if (s != begin)
+                cpu::simple_barrier::barrier(&barrier_ctx, nthr);
+            steps_[s].primitive->execute_thr(ctxs[s - begin], ithr, nthr);
+        }
+    });
+
+    for (size_t s = begin; s < end; ++s)
+        update_outputs_state(steps_[s].primitive->pd(), ctxs[s - begin].args(),
+                success);
+
+    return success;
+}
+
+status_t plan_t::execute(stream_t *stream) const {
+    /* the per primitive timings of the verbose mode need the primitives to
+     * be executed one by one */
+    const bool use_thr = mkldnn_thr_syncable() && !mkldnn_verbose()->level;
+
+    size_t s = 0;
+    while (s < steps_.size()) {
+        size_t e = s;
+        while (use_thr && e < steps_.size()
+                && steps_[e].primitive->has_execute_thr())
+            ++e;
+
+        status_t status = e == s
+            ? execute_step(stream, steps_[e++])
+            : execute_thr(stream, s, e);
+        if (status != success) return status;
+        s = e;
+    }
+
+    return success;
+}
+
+/* API */
+
+status_t mkldnn_plan_create(plan_t **plan, engine_t *engine) {
+    if (utils::any_null(plan, engine))
+        return invalid_arguments;
+
+    return safe_ptr_assign<plan_t>(*plan, new plan_t(engine));
+}
+
+status_t mkldnn_plan_append(plan_t *plan, const primitive_t *primitive,
+        int nargs, const mkldnn_exec_arg_t *args) {
+    if (plan == nullptr) return invalid_arguments;
+    return plan->append(primitive, nargs, args);
+}
+
+status_t mkldnn_plan_execute(const plan_t *plan, stream_t *stream) {
+    bool ok = true
+        && !utils::any_null(plan, stream)
+        && plan->engine() == stream->engine();
+    if (!ok) return invalid_arguments;
+
+    return plan->execute(stream);
+}
+
+status_t mkldnn_plan_destroy(plan_t *plan) {
+    delete plan;
+    return success;
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,66 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef PLAN_HPP
+#define PLAN_HPP
+
+#include <vector>
+
+#include "mkldnn.h"
+
+#include "c_types_map.hpp"
+#include "engine.hpp"
+#include "primitive.hpp"
+#include "primitive_exec_types.hpp"
+
+/** An ordered sequence of primitives with their arguments.
+ *
+ * Every primitive_t::execute() opens a parallel section of its own, and for
+ * small problems forking and joining the threads takes a noticeable part of
+ * the time. The plan executes the runs of consecutive primitives that support
+ * primitive_t::execute_thr() in a single parallel section and separates them
+ * with a barrier instead. The other primitives (and all of them if the
+ * threading runtime does not guarantee that the threads of a parallel section
+ * run concurrently, see mkldnn_thr_syncable()) are executed one by one. */
+struct mkldnn_plan: public mkldnn::impl::c_compatible {
+    mkldnn_plan(mkldnn::impl::engine_t *engine): engine_(engine) {}
+
+    /** returns plan's engine */
+    mkldnn::impl::engine_t *engine() const { return engine_; }
+
+    mkldnn::impl::status_t append(const mkldnn::impl::primitive_t *primitive,
+            int nargs, const mkldnn_exec_arg_t *c_args);
+
+    mkldnn::impl::status_t execute(mkldnn::impl::stream_t *stream) const;
+
+private:
+    struct step_t {
+        const mkldnn::impl::primitive_t *primitive;
+        std::vector<mkldnn_exec_arg_t> c_args;
+    };
+
+    mkldnn::impl::status_t execute_step(mkldnn::impl::stream_t *stream,
+            const step_t &step) const;
+    mkldnn::impl::status_t execute_thr(mkldnn::impl::stream_t *stream,
+            size_t begin, size_t end) const;
+
+    mkldnn::impl::engine_t *engine_;
+    std::vector<step_t> steps_;
+};
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -43,6 +43,31 @@ void unpoison_outputs(const exec_args_t &args) {
         msan_unpoison(p, s);
     }
 }
+
+/* Tracks whether the padded area of the outputs is still filled with zeros,
+ * so that a subsequent set_data_handle() with the same handle may skip
+ * zero padding */
+void update_zero_pad_state(const primitive_desc_t *pd,
+        const exec_args_t &args, bool executed) {
+    for (const auto &arg: args) {
+        if (arg.second.is_const) continue;
+        const bool zero_padded = executed && arg.first == MKLDNN_ARG_DST
+            && pd->zero_pads_dst();
+        arg.second.mem->set_zero_padded(zero_padded);
+    }
+}
+}
+
+namespace mkldnn {
+namespace impl {
+
+void update_outputs_state(const primitive_desc_t *pd, const exec_args_t &args,
+        status_t status) {
+    if (msan_enabled) unpoison_outputs(args);
+    update_zero_pad_state(pd, args, status == status::success);
+}
+
+}
 }
 
 status_t mkldnn_primitive_desc_destroy(primitive_desc_t *primitive_desc) {
@@ -81,7 +106,7 @@ status_t mkldnn_primitive_execute(const primitive_t *primitive,
         status = primitive->execute(ctx);
     }
 
-    if (msan_enabled) unpoison_outputs(ctx.args());
+    update_outputs_state(primitive->pd(), ctx.args(), status);
 
     return status;
 }
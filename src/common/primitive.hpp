@@ -60,6 +60,20 @@ struct mkldnn_primitive: public mkldnn::impl::c_compatible {
     virtual mkldnn::impl::status_t execute(const mkldnn::impl::exec_ctx_t &ctx)
         const = 0;
 
+    /** returns true if the primitive may be executed by execute_thr() from
+     * all the threads of a parallel section opened by the caller, e.g. by an
+     * execution plan. Such a primitive must not have serial parts and must
+     * not use the (thread local) global scratchpad */
+    virtual bool has_execute_thr() const { return false; }
+
+    /** executes the share of thread @p ithr out of @p nthr of the work; it
+     * is called by all the threads of the parallel section */
+    virtual void execute_thr(const mkldnn::impl::exec_ctx_t &ctx, int ithr,
+            int nthr) const {
+        UNUSED(ctx); UNUSED(ithr); UNUSED(nthr);
+        assert(!"execute_thr() is not supported");
+    }
+
 protected:
     const mkldnn::impl::primitive_desc_t *pd_;
 
@@ -71,6 +85,17 @@ private:
     mkldnn_primitive &operator=(mkldnn_primitive &&) = delete;
 };
 
+namespace mkldnn {
+namespace impl {
+
+/** updates the state of the outputs @p args of a primitive with @p pd after
+ * its execution finished with @p status */
+void update_outputs_state(const primitive_desc_t *pd, const exec_args_t &args,
+        status_t status);
+
+}
+}
+
 #endif
 
 // vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -49,6 +49,29 @@ status_t scales_t::set(dim_t count, int mask, const float *scales) {
     return status::success;
 }
 
+status_t zero_points_t::set(dim_t count, int mask,
+        const int32_t *zero_points) {
+    cleanup();
+
+    count_ = count;
+    mask_ = mask;
+
+    if (count_ == 1) {
+        zero_points_ = zero_points_buf_;
+        utils::array_set(zero_points_, zero_points[0], zero_points_buf_size);
+    } else {
+        zero_points_ = (int32_t *)impl::malloc(
+                count_ * sizeof(*zero_points_), 64);
+        if (zero_points_ == nullptr)
+            return status::out_of_memory;
+
+        for (dim_t c = 0; c < count_; ++c)
+            zero_points_[c] = zero_points[c];
+    }
+
+    return status::success;
+}
+
 }
 }
 
@@ -104,6 +127,22 @@ status_t primitive_attr_t::set_post_ops(const post_ops_t &post_ops) {
     return success;
 }
 
+status_t primitive_attr_t::set_zero_points(int arg, dim_t count, int mask,
+        const int32_t *zero_points) {
+    /* the source zero point is common for the whole tensor, while the
+     * destination one might be specified per output channel */
+    const bool ok = false
+        || (arg == MKLDNN_ARG_SRC && mask == 0 && count == 1)
+        || (arg == MKLDNN_ARG_DST && one_of(mask, 0, 1 << 1)
+                && IMPLICATION(mask == 0, count == 1));
+    if (!ok)
+        return invalid_arguments;
+
+    return arg == MKLDNN_ARG_SRC
+        ? zero_points_src_.set(count, mask, zero_points)
+        : zero_points_dst_.set(count, mask, zero_points);
+}
+
 /* Public C API */
 
 status_t mkldnn_primitive_attr_create(primitive_attr_t **attr) {
@@ -166,9 +205,39 @@ status_t mkldnn_primitive_attr_set_output_scales(primitive_attr_t *attr,
     if (!ok)
         return invalid_arguments;
 
+    /* runtime scales are specified with a single value */
+    for (dim_t c = 0; c < count; ++c)
+        if (is_runtime_value(scales[c]) && count != 1)
+            return invalid_arguments;
+
     return attr->output_scales_.set(count, mask, scales);
 }
 
+status_t mkldnn_primitive_attr_get_zero_points(const primitive_attr_t *attr,
+        int arg, dim_t *count, int *mask, const int32_t **zero_points) {
+    if (any_null(attr, count, mask, zero_points))
+        return invalid_arguments;
+
+    const zero_points_t *zp = attr->zero_points(arg);
+    if (zp == nullptr)
+        return invalid_arguments;
+
+    *count = zp->count_;
+    *mask = zp->mask_;
+    *zero_points = zp->zero_points_;
+
+    return success;
+}
+
+status_t mkldnn_primitive_attr_set_zero_points(primitive_attr_t *attr,
+        int arg, dim_t count, int mask, const int32_t *zero_points) {
+    bool ok = !any_null(attr, zero_points) && count > 0 && mask >= 0;
+    if (!ok)
+        return invalid_arguments;
+
+    return attr->set_zero_points(arg, count, mask, zero_points);
+}
+
 status_t mkldnn_primitive_attr_get_post_ops(const primitive_attr_t *attr,
         const post_ops_t **post_ops) {
     if (any_null(attr, post_ops))
@@ -274,7 +343,9 @@ status_t mkldnn_post_ops_get_params_eltwise(const post_ops_t *post_ops,
 
 status_t mkldnn_primitive_attr_set_rnn_data_qparams(
         primitive_attr_t *attr, const float scale, const float shift) {
-    if (attr == nullptr)
+    bool ok = attr != nullptr
+        && !is_runtime_value(scale) && !is_runtime_value(shift);
+    if (!ok)
         return invalid_arguments;
 
     return attr->rnn_data_qparams_.set(scale, shift);
@@ -286,5 +357,9 @@ status_t mkldnn_primitive_attr_set_rnn_weights_qparams(
     if (!ok)
         return invalid_arguments;
 
+    for (dim_t c = 0; c < count; ++c)
+        if (is_runtime_value(scales[c]))
+            return invalid_arguments;
+
     return attr->rnn_weights_qparams_.set(count, mask, scales);
 }
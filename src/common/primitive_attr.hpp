@@ -26,6 +26,14 @@
 namespace mkldnn {
 namespace impl {
 
+/** Returns true if @p val is MKLDNN_RUNTIME_F32_VAL, i.e. the value is passed
+ * at execution time */
+inline bool is_runtime_value(float val) {
+    union { float f; unsigned u; } cvt;
+    cvt.f = val;
+    return cvt.u == MKLDNN_RUNTIME_F32_VAL_REP.u;
+}
+
 struct rnn_data_qparams_t : public c_compatible {
     rnn_data_qparams_t() : scale_(1.), shift_(0.) {}
     bool has_default_values() const { return (scale_ == 1. && shift_ == 0.); }
@@ -65,6 +73,9 @@ struct scales_t: public c_compatible {
         return true;
     }
 
+    /** Returns false if the scales are passed at execution time */
+    bool defined() const { return !is_runtime_value(scales_[0]); }
+
     status_t set(dim_t count, int mask, const float *scales);
     status_t set(float single_scale) { return this->set(1, 0, &single_scale); }
 
@@ -86,6 +97,53 @@ private:
     }
 };
 
+struct zero_points_t: public c_compatible {
+    zero_points_t(): count_(1), mask_(0), zero_points_(zero_points_buf_)
+    { set(0); }
+
+    zero_points_t(const zero_points_t &rhs): zero_points_t()
+    { set(rhs.count_, rhs.mask_, rhs.zero_points_); }
+
+    ~zero_points_t() { cleanup(); }
+
+    zero_points_t &operator=(const zero_points_t &rhs) {
+        if (&rhs == this)
+            return *this;
+        status_t status = set(rhs.count_, rhs.mask_, rhs.zero_points_);
+        assert(status == status::success);
+        (void)status;
+        return *this;
+    }
+
+    bool has_default_values() const {
+        for (dim_t c = 0; c < count_; ++c) {
+            if (zero_points_[c] != 0) return false;
+        }
+        return true;
+    }
+
+    status_t set(dim_t count, int mask, const int32_t *zero_points);
+    status_t set(int32_t single_zero_point)
+    { return this->set(1, 0, &single_zero_point); }
+
+    dim_t count_;
+    int mask_;
+    int32_t *zero_points_;
+
+private:
+    enum { zero_points_buf_size = 16 };
+    int32_t zero_points_buf_[zero_points_buf_size];
+
+    void cleanup() {
+        if (zero_points_ != zero_points_buf_ && zero_points_ != nullptr)
+            impl::free(zero_points_);
+
+        count_ = 1;
+        mask_ = 0;
+        zero_points_ = zero_points_buf_;
+    }
+};
+
 }
 }
 
@@ -121,6 +179,14 @@ struct mkldnn_post_ops: public mkldnn::impl::c_compatible {
             return kind == primitive_kind::sum
                 && IMPLICATION(require_scale_one, sum.scale == 1.f);
         }
+
+        /** Returns false if the parameters are passed at execution time */
+        bool defined() const {
+            using namespace mkldnn::impl;
+            return !(kind == primitive_kind::eltwise
+                    && (is_runtime_value(eltwise.alpha)
+                        || is_runtime_value(eltwise.beta)));
+        }
     };
 
     mkldnn_post_ops(): len_(0) {}
@@ -140,6 +206,12 @@ struct mkldnn_post_ops: public mkldnn::impl::c_compatible {
 
     bool has_default_values() const { return len_ == 0; }
 
+    bool defined() const {
+        for (int idx = 0; idx < len_; ++idx)
+            if (!entry_[idx].defined()) return false;
+        return true;
+    }
+
     bool contain(mkldnn::impl::primitive_kind_t kind, int index) const
     { return find(kind, index, index + 1) == index; }
 
@@ -164,6 +236,8 @@ struct mkldnn_primitive_attr: public mkldnn::impl::c_compatible {
        return true
             && output_scales_.has_default_values()
             && post_ops_.has_default_values()
+            && zero_points_src_.has_default_values()
+            && zero_points_dst_.has_default_values()
             && rnn_data_qparams_.has_default_values()
             && rnn_weights_qparams_.has_default_values();
     }
@@ -172,10 +246,45 @@ struct mkldnn_primitive_attr: public mkldnn::impl::c_compatible {
             mkldnn::impl::scratchpad_mode_t scratchpad_mode);
     mkldnn::impl::status_t set_post_ops(
             const mkldnn::impl::post_ops_t &post_ops);
+    mkldnn::impl::status_t set_zero_points(int arg, mkldnn::impl::dim_t count,
+            int mask, const int32_t *zero_points);
+
+    /** Returns zero points for the memory argument @p arg or nullptr if the
+     * argument cannot have zero points */
+    const mkldnn::impl::zero_points_t *zero_points(int arg) const {
+        switch (arg) {
+        case MKLDNN_ARG_SRC: return &zero_points_src_;
+        case MKLDNN_ARG_DST: return &zero_points_dst_;
+        default: return nullptr;
+        }
+    }
+
+    /** Returns true if some of the parameters are passed at execution time
+     * (@sa MKLDNN_RUNTIME_F32_VAL) */
+    bool has_runtime_params() const {
+        return !output_scales_.defined() || !post_ops_.defined();
+    }
+
+    /** Returns the number of execution arguments required to pass the
+     * runtime parameters */
+    int n_runtime_params() const {
+        int n = !output_scales_.defined();
+        for (int idx = 0; idx < post_ops_.len_; ++idx)
+            n += !post_ops_.entry_[idx].defined();
+        return n;
+    }
+
+    /** Returns true if zero points for all the memory arguments are zero */
+    bool zero_points_default() const {
+        return zero_points_src_.has_default_values()
+            && zero_points_dst_.has_default_values();
+    }
 
     mkldnn::impl::scratchpad_mode_t scratchpad_mode_;
     mkldnn::impl::scales_t output_scales_;
     mkldnn::impl::post_ops_t post_ops_;
+    mkldnn::impl::zero_points_t zero_points_src_;
+    mkldnn::impl::zero_points_t zero_points_dst_;
     mkldnn::impl::rnn_data_qparams_t rnn_data_qparams_;
     mkldnn::impl::scales_t rnn_weights_qparams_;
 };
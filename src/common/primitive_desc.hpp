@@ -63,9 +63,25 @@ struct mkldnn_primitive_desc: public mkldnn::impl::c_compatible {
         using mkldnn::impl::types::is_zero_md;
         if (arg == MKLDNN_ARG_SCRATCHPAD && !is_zero_md(scratchpad_md()))
             return arg_usage_t::output;
+        if (arg == MKLDNN_ARG_ATTR_OUTPUT_SCALES
+                && !attr()->output_scales_.defined())
+            return arg_usage_t::input;
+        const int post_op_idx = arg - MKLDNN_ARG_ATTR_POST_OP_0;
+        if (0 <= post_op_idx && post_op_idx < attr()->post_ops_.len_
+                && !attr()->post_ops_.entry_[post_op_idx].defined())
+            return arg_usage_t::input;
         return arg_usage_t::unused;
     }
 
+    /** Returns true if the implementation can take the attribute parameters
+     * marked with MKLDNN_RUNTIME_F32_VAL at execution time */
+    virtual bool support_runtime_attr_params() const { return false; }
+
+    /** Returns true if the implementation writes zeros into the padded area
+     * of the destination (e.g. computes the whole blocks of channels with
+     * zero-padded weights), so that the output needs no extra zero padding */
+    virtual bool zero_pads_dst() const { return false; }
+
 #   define DECLARE_MD_STUB(stub) \
     virtual const mkldnn::impl::memory_desc_t *stub(int idx = 0) const \
     { return nullptr; }
@@ -123,6 +139,11 @@ struct mkldnn_primitive_desc: public mkldnn::impl::c_compatible {
             reinterpret_cast<const typename pd_t::hint_class *>(hint_fwd);
         auto _pd = new pd_t(engine, (const pd_op_desc_t *)adesc, attr, hint);
         if (_pd == nullptr) return out_of_memory;
+        if (_pd->attr()->has_runtime_params()
+                && !_pd->support_runtime_attr_params()) {
+            delete _pd;
+            return unimplemented;
+        }
         if (_pd->init() != success) { delete _pd; return unimplemented; }
         _pd->init_info();
         _pd->init_scratchpad_md();
@@ -21,6 +21,39 @@
 namespace mkldnn {
 namespace impl {
 
+namespace {
+bool is_runtime_attr_arg(primitive_arg_index_t arg) {
+    return arg == MKLDNN_ARG_ATTR_OUTPUT_SCALES
+        || (MKLDNN_ARG_ATTR_POST_OP_0 <= arg
+                && arg < MKLDNN_ARG_ATTR_POST_OP_0 + post_ops_t::capacity);
+}
+
+/* Checks that the memory passing the runtime attribute parameters @p arg is a
+ * dense f32 buffer with enough elements */
+bool runtime_attr_arg_ok(const primitive_desc_t *pd,
+        primitive_arg_index_t arg, const memory_t *mem) {
+    if (mem == nullptr) return false;
+
+    const memory_desc_wrapper mdw(mem->md());
+    if (mdw.is_zero() || mdw.data_type() != data_type::f32 || !mdw.is_dense())
+        return false;
+
+    if (arg == MKLDNN_ARG_ATTR_OUTPUT_SCALES) {
+        const int mask = pd->attr()->output_scales_.mask_;
+        const memory_desc_t *dst_md = pd->dst_md();
+        if (dst_md == nullptr) return mdw.nelems() >= 1;
+
+        dim_t count = 1;
+        for (int d = 0; d < dst_md->ndims; ++d)
+            if (mask & (1 << d)) count *= dst_md->dims[d];
+        return mdw.nelems() >= count;
+    }
+
+    /* eltwise post-op: alpha and beta */
+    return mdw.nelems() >= 2;
+}
+}
+
 status_t cvt_primtive_args(const primitive_desc_t *pd, int nargs,
         const mkldnn_exec_arg_t *c_args, exec_args_t &args) {
     using namespace status;
@@ -37,6 +70,9 @@ status_t cvt_primtive_args(const primitive_desc_t *pd, int nargs,
         switch (pd->arg_usage(arg)) {
         case primitive_desc_t::arg_usage_t::input:
             if (args.count(arg) != 0) return invalid_arguments;
+            if (is_runtime_attr_arg(arg)
+                    && !runtime_attr_arg_ok(pd, arg, mem))
+                return invalid_arguments;
             args[arg] = {mem, true};
             n_inputs++;
             break;
@@ -52,7 +88,8 @@ status_t cvt_primtive_args(const primitive_desc_t *pd, int nargs,
 
     bool scratchpad_required = !types::is_zero_md(pd->scratchpad_md());
 
-    if (n_inputs != pd->n_inputs()) return invalid_arguments;
+    if (n_inputs != pd->n_inputs() + pd->attr()->n_runtime_params())
+        return invalid_arguments;
     if (n_outputs != pd->n_outputs() + (scratchpad_required ? 1 : 0))
         return invalid_arguments;
 
@@ -53,6 +53,8 @@ status_t mkldnn_reorder_primitive_desc_create(
     const primitive_attr_t dummy_attr;
     if (attr == NULL)
         attr = &dummy_attr;
+    if (attr->has_runtime_params())
+        return unimplemented;
 
     for (auto r = e->get_reorder_implementation_list(); *r; ++r) {
         if ((*r)(r_pd, e, attr, src_engine, src_md, dst_engine, dst_md)
@@ -19,7 +19,6 @@
 #include "c_types_map.hpp"
 #include "type_helpers.hpp"
 #include "utils.hpp"
-#include "cpu/gemm/os_blas.hpp"
 
 using namespace mkldnn::impl;
 using namespace mkldnn::impl::status;
@@ -47,6 +46,10 @@ rnn_desc_t zero_rnn_desc() {
     rd.diff_bias_desc = zero_md();
     rd.diff_dst_layer_desc = zero_md();
     rd.diff_dst_iter_desc = zero_md();
+    rd.weights_peephole_desc = zero_md();
+    rd.weights_projection_desc = zero_md();
+    rd.diff_weights_peephole_desc = zero_md();
+    rd.diff_weights_projection_desc = zero_md();
     return rd;
 }
 }
@@ -105,8 +108,10 @@ status_t check_data_type_consistency_fwd(const rnn_cell_desc_t *rnn_cell_desc,
         prop_kind_t prop_kind, const memory_desc_t *src_layer_desc,
         const memory_desc_t *src_iter_desc,
         const memory_desc_t *weights_layer_desc,
-        const memory_desc_t *weights_iter_desc, const memory_desc_t *bias_desc,
-        const memory_desc_t *dst_layer_desc,
+        const memory_desc_t *weights_iter_desc,
+        const memory_desc_t *weights_peephole_desc,
+        const memory_desc_t *weights_projection_desc,
+        const memory_desc_t *bias_desc, const memory_desc_t *dst_layer_desc,
         const memory_desc_t *dst_iter_desc) {
     using namespace data_type;
     data_type_t src_layer_dt = src_layer_desc->data_type;
@@ -122,7 +127,6 @@ status_t check_data_type_consistency_fwd(const rnn_cell_desc_t *rnn_cell_desc,
                           dst_iter_desc->data_type == f32)
             && IMPLICATION(!is_zero_md(bias_desc), bias_desc->data_type == f32);
 
-#if USE_MKL_PACKED_GEMM
     bool is_u8u8u8 = src_layer_dt == u8
             && IMPLICATION(!is_zero_md(src_iter_desc),
                              src_iter_desc->data_type == u8)
@@ -144,12 +148,17 @@ status_t check_data_type_consistency_fwd(const rnn_cell_desc_t *rnn_cell_desc,
     bool is_inference = prop_kind == prop_kind::forward_inference;
     bool is_lstm = rnn_cell_desc->cell_kind == mkldnn_vanilla_lstm;
 
+    // peephole and projection weights stay in f32 for all configurations
+    bool extra_weights_ok = true
+            && IMPLICATION(!is_zero_md(weights_peephole_desc),
+                    weights_peephole_desc->data_type == f32)
+            && IMPLICATION(!is_zero_md(weights_projection_desc),
+                    weights_projection_desc->data_type == f32);
+    if (!extra_weights_ok) return unimplemented;
+
     return (is_f32 || ((is_u8u8u8 || is_f32u8f32) && is_lstm && is_inference))
             ? success
             : unimplemented;
-#else
-    return is_f32 ? success : unimplemented;
-#endif
 }
 
 status_t check_dim_consistency(const rnn_cell_desc_t *rnn_cell_desc,
@@ -157,11 +166,38 @@ status_t check_dim_consistency(const rnn_cell_desc_t *rnn_cell_desc,
         int SLC, int SIC, int DLC, int DIC, const memory_desc_t *src_layer_desc,
         const memory_desc_t *src_iter_desc,
         const memory_desc_t *weights_layer_desc,
-        const memory_desc_t *weights_iter_desc, const memory_desc_t *bias_desc,
-        const memory_desc_t *dst_layer_desc,
+        const memory_desc_t *weights_iter_desc,
+        const memory_desc_t *weights_peephole_desc,
+        const memory_desc_t *weights_projection_desc,
+        const memory_desc_t *bias_desc, const memory_desc_t *dst_layer_desc,
         const memory_desc_t *dst_iter_desc) {
     bool args_ok;
 
+    const bool with_peephole = !is_zero_md(weights_peephole_desc);
+    const bool with_projection = !is_zero_md(weights_projection_desc);
+    // with projection the hidden state has DHC channels while the cell
+    // state keeps DIC, both live in the DIC channels of the state tensors
+    const int DHC = with_projection ? weights_projection_desc->dims[3] : DIC;
+    const int SIC_states = with_projection ? DIC : SIC;
+
+    // * peephole and projection
+    args_ok = true
+        && IMPLICATION(with_peephole || with_projection,
+                rnn_cell_desc->cell_kind == alg_kind::vanilla_lstm)
+        && IMPLICATION(with_peephole, true
+                && weights_peephole_desc->ndims == 4
+                && L == weights_peephole_desc->dims[0]
+                && D == weights_peephole_desc->dims[1]
+                && 3 == weights_peephole_desc->dims[2]
+                && DIC == weights_peephole_desc->dims[3])
+        && IMPLICATION(with_projection, true
+                && weights_projection_desc->ndims == 4
+                && L == weights_projection_desc->dims[0]
+                && D == weights_projection_desc->dims[1]
+                && DIC == weights_projection_desc->dims[2]
+                && DHC <= DIC);
+    if (!args_ok) return invalid_arguments;
+
     // * algorithm specific
     args_ok = true
         && IMPLICATION(rnn_cell_desc->cell_kind == alg_kind::vanilla_gru,
@@ -227,14 +263,15 @@ status_t check_dim_consistency(const rnn_cell_desc_t *rnn_cell_desc,
     // * on sic
     args_ok = true
         && SIC == weights_iter_desc->dims[2]
+        && IMPLICATION(with_projection, SIC == DHC)
         && IMPLICATION(!is_zero_md(src_iter_desc),
-                SIC == src_iter_desc->dims[4]);
+                SIC_states == src_iter_desc->dims[4]);
     if (!args_ok) return invalid_arguments;
 
     // * on dlc
     int dlc_multiplier = (direction == mkldnn_bidirectional_concat) ? 2 : 1;
     args_ok = true
-        && DLC == dlc_multiplier * DIC
+        && DLC == dlc_multiplier * DHC
         && DLC == dst_layer_desc->dims[2];
     if (!args_ok) return invalid_arguments;
 
@@ -250,19 +287,22 @@ status_t check_dim_consistency(const rnn_cell_desc_t *rnn_cell_desc,
     // * unrolling/fusion conditions
     args_ok = true
         && IMPLICATION(L > 1, (dlc_multiplier * SLC) == DLC)
-        && IMPLICATION(T > 1, SIC == DIC);
+        && IMPLICATION(T > 1, SIC == DHC);
     if (!args_ok) return invalid_arguments;
 
     return success;
 }
 
-status_t MKLDNN_API mkldnn_rnn_forward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
+namespace {
+status_t rnn_common_fwd_desc_init(mkldnn_rnn_desc_t *rnn_desc,
         prop_kind_t prop_kind, const rnn_cell_desc_t *rnn_cell_desc,
         const rnn_direction_t direction, const memory_desc_t *src_layer_desc,
         const memory_desc_t *src_iter_desc,
         const memory_desc_t *weights_layer_desc,
-        const memory_desc_t *weights_iter_desc, const memory_desc_t *bias_desc,
-        const memory_desc_t *dst_layer_desc,
+        const memory_desc_t *weights_iter_desc,
+        const memory_desc_t *weights_peephole_desc,
+        const memory_desc_t *weights_projection_desc,
+        const memory_desc_t *bias_desc, const memory_desc_t *dst_layer_desc,
         const memory_desc_t *dst_iter_desc) {
     bool args_ok = true && rnn_cell_desc != nullptr
             && !any_null(src_layer_desc, weights_layer_desc, weights_iter_desc,
@@ -286,12 +326,14 @@ status_t MKLDNN_API mkldnn_rnn_forward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
 
     CHECK(check_dim_consistency(rnn_cell_desc, direction, L, D, T, N, S,
             G, SLC, SIC, DLC, DIC, src_layer_desc, src_iter_desc,
-            weights_layer_desc, weights_iter_desc, bias_desc, dst_layer_desc,
+            weights_layer_desc, weights_iter_desc, weights_peephole_desc,
+            weights_projection_desc, bias_desc, dst_layer_desc,
             dst_iter_desc));
 
     CHECK(check_data_type_consistency_fwd(rnn_cell_desc, prop_kind,
             src_layer_desc, src_iter_desc, weights_layer_desc,
-            weights_iter_desc, bias_desc, dst_layer_desc, dst_iter_desc));
+            weights_iter_desc, weights_peephole_desc, weights_projection_desc,
+            bias_desc, dst_layer_desc, dst_iter_desc));
 
     // Create the descriptor
     mkldnn_rnn_desc_t rd = zero_rnn_desc();
@@ -307,23 +349,30 @@ status_t MKLDNN_API mkldnn_rnn_forward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
     rd.bias_desc = copy_maybe_null(bias_desc);
     rd.dst_layer_desc = copy_maybe_null(dst_layer_desc);
     rd.dst_iter_desc = copy_maybe_null(dst_iter_desc);
+    rd.weights_peephole_desc = copy_maybe_null(weights_peephole_desc);
+    rd.weights_projection_desc = copy_maybe_null(weights_projection_desc);
 
     *rnn_desc = rd;
 
     return success;
 }
 
-status_t MKLDNN_API mkldnn_rnn_backward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
+status_t rnn_common_bwd_desc_init(mkldnn_rnn_desc_t *rnn_desc,
         prop_kind_t prop_kind, const rnn_cell_desc_t *rnn_cell_desc,
         const rnn_direction_t direction, const memory_desc_t *src_layer_desc,
         const memory_desc_t *src_iter_desc,
         const memory_desc_t *weights_layer_desc,
-        const memory_desc_t *weights_iter_desc, const memory_desc_t *bias_desc,
+        const memory_desc_t *weights_iter_desc,
+        const memory_desc_t *weights_peephole_desc,
+        const memory_desc_t *weights_projection_desc,
+        const memory_desc_t *bias_desc,
         const memory_desc_t *dst_layer_desc, const memory_desc_t *dst_iter_desc,
         const memory_desc_t *diff_src_layer_desc,
         const memory_desc_t *diff_src_iter_desc,
         const memory_desc_t *diff_weights_layer_desc,
         const memory_desc_t *diff_weights_iter_desc,
+        const memory_desc_t *diff_weights_peephole_desc,
+        const memory_desc_t *diff_weights_projection_desc,
         const memory_desc_t *diff_bias_desc,
         const memory_desc_t *diff_dst_layer_desc,
         const memory_desc_t *diff_dst_iter_desc) {
@@ -341,7 +390,9 @@ status_t MKLDNN_API mkldnn_rnn_backward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
 
     args_ok = args_ok && xnor_md(bias_desc, diff_bias_desc)
             && xnor_md(dst_iter_desc, diff_dst_iter_desc)
-            && xnor_md(src_iter_desc, diff_src_iter_desc);
+            && xnor_md(src_iter_desc, diff_src_iter_desc)
+            && xnor_md(weights_peephole_desc, diff_weights_peephole_desc)
+            && xnor_md(weights_projection_desc, diff_weights_projection_desc);
     if (!args_ok)
         return invalid_arguments;
 
@@ -362,14 +413,16 @@ status_t MKLDNN_API mkldnn_rnn_backward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
 
     status_t st = check_dim_consistency(rnn_cell_desc, direction, L, D, T, N, S,
             G, SLC, SIC, DLC, DIC, src_layer_desc, src_iter_desc,
-            weights_layer_desc, weights_iter_desc, bias_desc, dst_layer_desc,
+            weights_layer_desc, weights_iter_desc, weights_peephole_desc,
+            weights_projection_desc, bias_desc, dst_layer_desc,
             dst_iter_desc);
     if (st != success) return st;
 
     st = check_dim_consistency(rnn_cell_desc, direction, L, D, T, N, S,
             G, SLC, SIC, DLC, DIC, diff_src_layer_desc, diff_src_iter_desc,
-            diff_weights_layer_desc, diff_weights_iter_desc, diff_bias_desc,
-            diff_dst_layer_desc, diff_dst_iter_desc);
+            diff_weights_layer_desc, diff_weights_iter_desc,
+            diff_weights_peephole_desc, diff_weights_projection_desc,
+            diff_bias_desc, diff_dst_layer_desc, diff_dst_iter_desc);
     if (st != success) return st;
 
     mkldnn_rnn_desc_t rd = zero_rnn_desc();
@@ -393,8 +446,100 @@ status_t MKLDNN_API mkldnn_rnn_backward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
     rd.diff_bias_desc = copy_maybe_null(diff_bias_desc);
     rd.diff_dst_layer_desc = copy_maybe_null(diff_dst_layer_desc);
     rd.diff_dst_iter_desc = copy_maybe_null(diff_dst_iter_desc);
+    rd.weights_peephole_desc = copy_maybe_null(weights_peephole_desc);
+    rd.weights_projection_desc = copy_maybe_null(weights_projection_desc);
+    rd.diff_weights_peephole_desc = copy_maybe_null(diff_weights_peephole_desc);
+    rd.diff_weights_projection_desc
+            = copy_maybe_null(diff_weights_projection_desc);
 
     *rnn_desc = rd;
 
     return success;
 }
+}
+
+status_t MKLDNN_API mkldnn_rnn_forward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
+        prop_kind_t prop_kind, const rnn_cell_desc_t *rnn_cell_desc,
+        const rnn_direction_t direction, const memory_desc_t *src_layer_desc,
+        const memory_desc_t *src_iter_desc,
+        const memory_desc_t *weights_layer_desc,
+        const memory_desc_t *weights_iter_desc, const memory_desc_t *bias_desc,
+        const memory_desc_t *dst_layer_desc,
+        const memory_desc_t *dst_iter_desc) {
+    return rnn_common_fwd_desc_init(rnn_desc, prop_kind, rnn_cell_desc,
+            direction, src_layer_desc, src_iter_desc, weights_layer_desc,
+            weights_iter_desc, nullptr, nullptr, bias_desc, dst_layer_desc,
+            dst_iter_desc);
+}
+
+status_t MKLDNN_API mkldnn_lstm_forward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
+        prop_kind_t prop_kind, const rnn_cell_desc_t *rnn_cell_desc,
+        const rnn_direction_t direction, const memory_desc_t *src_layer_desc,
+        const memory_desc_t *src_iter_desc,
+        const memory_desc_t *weights_layer_desc,
+        const memory_desc_t *weights_iter_desc,
+        const memory_desc_t *weights_peephole_desc,
+        const memory_desc_t *weights_projection_desc,
+        const memory_desc_t *bias_desc, const memory_desc_t *dst_layer_desc,
+        const memory_desc_t *dst_iter_desc) {
+    if (rnn_cell_desc == nullptr
+            || rnn_cell_desc->cell_kind != alg_kind::vanilla_lstm)
+        return invalid_arguments;
+    return rnn_common_fwd_desc_init(rnn_desc, prop_kind, rnn_cell_desc,
+            direction, src_layer_desc, src_iter_desc, weights_layer_desc,
+            weights_iter_desc, weights_peephole_desc, weights_projection_desc,
+            bias_desc, dst_layer_desc, dst_iter_desc);
+}
+
+status_t MKLDNN_API mkldnn_rnn_backward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
+        prop_kind_t prop_kind, const rnn_cell_desc_t *rnn_cell_desc,
+        const rnn_direction_t direction, const memory_desc_t *src_layer_desc,
+        const memory_desc_t *src_iter_desc,
+        const memory_desc_t *weights_layer_desc,
+        const memory_desc_t *weights_iter_desc, const memory_desc_t *bias_desc,
+        const memory_desc_t *dst_layer_desc, const memory_desc_t *dst_iter_desc,
+        const memory_desc_t *diff_src_layer_desc,
+        const memory_desc_t *diff_src_iter_desc,
+        const memory_desc_t *diff_weights_layer_desc,
+        const memory_desc_t *diff_weights_iter_desc,
+        const memory_desc_t *diff_bias_desc,
+        const memory_desc_t *diff_dst_layer_desc,
+        const memory_desc_t *diff_dst_iter_desc) {
+    return rnn_common_bwd_desc_init(rnn_desc, prop_kind, rnn_cell_desc,
+            direction, src_layer_desc, src_iter_desc, weights_layer_desc,
+            weights_iter_desc, nullptr, nullptr, bias_desc, dst_layer_desc,
+            dst_iter_desc, diff_src_layer_desc, diff_src_iter_desc,
+            diff_weights_layer_desc, diff_weights_iter_desc, nullptr, nullptr,
+            diff_bias_desc, diff_dst_layer_desc, diff_dst_iter_desc);
+}
+
+status_t MKLDNN_API mkldnn_lstm_backward_desc_init(mkldnn_rnn_desc_t *rnn_desc,
+        prop_kind_t prop_kind, const rnn_cell_desc_t *rnn_cell_desc,
+        const rnn_direction_t direction, const memory_desc_t *src_layer_desc,
+        const memory_desc_t *src_iter_desc,
+        const memory_desc_t *weights_layer_desc,
+        const memory_desc_t *weights_iter_desc,
+        const memory_desc_t *weights_peephole_desc,
+        const memory_desc_t *weights_projection_desc,
+        const memory_desc_t *bias_desc,
+        const memory_desc_t *dst_layer_desc, const memory_desc_t *dst_iter_desc,
+        const memory_desc_t *diff_src_layer_desc,
+        const memory_desc_t *diff_src_iter_desc,
+        const memory_desc_t *diff_weights_layer_desc,
+        const memory_desc_t *diff_weights_iter_desc,
+        const memory_desc_t *diff_weights_peephole_desc,
+        const memory_desc_t *diff_weights_projection_desc,
+        const memory_desc_t *diff_bias_desc,
+        const memory_desc_t *diff_dst_layer_desc,
+        const memory_desc_t *diff_dst_iter_desc) {
+    if (rnn_cell_desc == nullptr
+            || rnn_cell_desc->cell_kind != alg_kind::vanilla_lstm)
+        return invalid_arguments;
+    return rnn_common_bwd_desc_init(rnn_desc, prop_kind, rnn_cell_desc,
+            direction, src_layer_desc, src_iter_desc, weights_layer_desc,
+            weights_iter_desc, weights_peephole_desc, weights_projection_desc,
+            bias_desc, dst_layer_desc, dst_iter_desc, diff_src_layer_desc,
+            diff_src_iter_desc, diff_weights_layer_desc, diff_weights_iter_desc,
+            diff_weights_peephole_desc, diff_weights_projection_desc,
+            diff_bias_desc, diff_dst_layer_desc, diff_dst_iter_desc);
+}
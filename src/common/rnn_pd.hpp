@@ -43,6 +43,8 @@ struct rnn_pd_t : public primitive_desc_t {
         , weights_layer_md_(desc_.weights_layer_desc)
         , weights_iter_md_(desc_.weights_iter_desc)
         , bias_md_(desc_.bias_desc)
+        , weights_peephole_md_(desc_.weights_peephole_desc)
+        , weights_projection_md_(desc_.weights_projection_desc)
         , dst_layer_md_(desc_.dst_layer_desc)
         , dst_iter_md_(desc_.dst_iter_desc)
         , ws_md_()
@@ -70,6 +72,8 @@ struct rnn_pd_t : public primitive_desc_t {
         if (index == 0) return &weights_layer_md_;
         if (index == 1) return &weights_iter_md_;
         if (index == 2 && with_bias()) return &bias_md_;
+        if (index == 3 && with_peephole()) return &weights_peephole_md_;
+        if (index == 4 && with_projection()) return &weights_projection_md_;
         return nullptr;
     }
     virtual const memory_desc_t *dst_md(int index = 0) const override {
@@ -105,6 +109,12 @@ struct rnn_pd_t : public primitive_desc_t {
     dim_t DIC() const { return desc_.weights_layer_desc.dims[4]; }
 
     dim_t DLC() const { return desc_.dst_layer_desc.dims[2]; }
+    /* channels of the hidden state passed on to the next layer and
+     * iteration, DIC unless the LSTM projects it */
+    dim_t DHC() const {
+        return with_projection() ? desc_.weights_projection_desc.dims[3]
+                                 : DIC();
+    }
 
     bool with_bias() const
     { return !memory_desc_wrapper(desc_.bias_desc).is_zero(); }
@@ -115,6 +125,12 @@ struct rnn_pd_t : public primitive_desc_t {
     bool with_dst_iter() const
     { return !memory_desc_wrapper(desc_.dst_iter_desc).is_zero(); }
 
+    bool with_peephole() const
+    { return !memory_desc_wrapper(desc_.weights_peephole_desc).is_zero(); }
+
+    bool with_projection() const
+    { return !memory_desc_wrapper(desc_.weights_projection_desc).is_zero(); }
+
     mkldnn::impl::alg_kind_t cell_kind() const
     { return desc_.cell_desc.cell_kind; }
     mkldnn::impl::alg_kind_t activation_kind() const
@@ -134,6 +150,8 @@ protected:
     memory_desc_t weights_layer_md_;
     memory_desc_t weights_iter_md_;
     memory_desc_t bias_md_;
+    memory_desc_t weights_peephole_md_;
+    memory_desc_t weights_projection_md_;
     memory_desc_t dst_layer_md_;
     memory_desc_t dst_iter_md_;
 
@@ -165,6 +183,12 @@ struct rnn_fwd_pd_t: public rnn_pd_t {
         if (arg == MKLDNN_ARG_BIAS && with_bias())
             return arg_usage_t::input;
 
+        if (arg == MKLDNN_ARG_WEIGHTS_PEEPHOLE && with_peephole())
+            return arg_usage_t::input;
+
+        if (arg == MKLDNN_ARG_WEIGHTS_PROJECTION && with_projection())
+            return arg_usage_t::input;
+
         if (arg == MKLDNN_ARG_DST_LAYER)
             return arg_usage_t::output;
 
@@ -177,8 +201,10 @@ struct rnn_fwd_pd_t: public rnn_pd_t {
         return primitive_desc_t::arg_usage(arg);
     }
 
-    virtual int n_inputs() const override
-    { return 3 + with_bias() + with_src_iter(); }
+    virtual int n_inputs() const override {
+        return 3 + with_bias() + with_src_iter() + with_peephole()
+            + with_projection();
+    }
     virtual int n_outputs() const override
     { return 1 + with_dst_iter() + is_training(); }
 };
@@ -197,6 +223,8 @@ struct rnn_bwd_pd_t : public rnn_pd_t {
         , diff_weights_layer_md_(desc_.diff_weights_layer_desc)
         , diff_weights_iter_md_(desc_.diff_weights_iter_desc)
         , diff_bias_md_(desc_.diff_bias_desc)
+        , diff_weights_peephole_md_(desc_.diff_weights_peephole_desc)
+        , diff_weights_projection_md_(desc_.diff_weights_projection_desc)
         , diff_dst_layer_md_(desc_.diff_dst_layer_desc)
         , diff_dst_iter_md_(desc_.diff_dst_iter_desc)
     {}
@@ -226,6 +254,22 @@ struct rnn_bwd_pd_t : public rnn_pd_t {
                 return arg_usage_t::output;
         }
 
+        if (with_peephole()) {
+            if (arg == MKLDNN_ARG_WEIGHTS_PEEPHOLE)
+                return arg_usage_t::input;
+
+            if (arg == MKLDNN_ARG_DIFF_WEIGHTS_PEEPHOLE)
+                return arg_usage_t::output;
+        }
+
+        if (with_projection()) {
+            if (arg == MKLDNN_ARG_WEIGHTS_PROJECTION)
+                return arg_usage_t::input;
+
+            if (arg == MKLDNN_ARG_DIFF_WEIGHTS_PROJECTION)
+                return arg_usage_t::output;
+        }
+
         if (utils::one_of(arg, MKLDNN_ARG_DST_ITER, MKLDNN_ARG_DIFF_DST_ITER)
                 && with_dst_iter())
             return arg_usage_t::input;
@@ -251,6 +295,9 @@ struct rnn_bwd_pd_t : public rnn_pd_t {
         if (index == 0) return &diff_weights_layer_md_;
         if (index == 1) return &diff_weights_iter_md_;
         if (index == 2 && with_bias()) return &diff_bias_md_;
+        if (index == 3 && with_peephole()) return &diff_weights_peephole_md_;
+        if (index == 4 && with_projection())
+            return &diff_weights_projection_md_;
         return nullptr;
     }
     virtual const memory_desc_t *diff_dst_md(int index = 0) const override {
@@ -259,10 +306,14 @@ struct rnn_bwd_pd_t : public rnn_pd_t {
         return nullptr;
     }
 
-    virtual int n_inputs() const override
-    { return 6 + with_src_iter() + with_bias() + 2 * with_dst_iter(); }
-    virtual int n_outputs() const override
-    { return 3 + with_src_iter() + with_bias(); }
+    virtual int n_inputs() const override {
+        return 6 + with_src_iter() + with_bias() + 2 * with_dst_iter()
+            + with_peephole() + with_projection();
+    }
+    virtual int n_outputs() const override {
+        return 3 + with_src_iter() + with_bias() + with_peephole()
+            + with_projection();
+    }
 
 protected:
     memory_desc_t diff_src_layer_md_;
@@ -270,6 +321,8 @@ protected:
     memory_desc_t diff_weights_layer_md_;
     memory_desc_t diff_weights_iter_md_;
     memory_desc_t diff_bias_md_;
+    memory_desc_t diff_weights_peephole_md_;
+    memory_desc_t diff_weights_projection_md_;
     memory_desc_t diff_dst_layer_md_;
     memory_desc_t diff_dst_iter_md_;
 };
@@ -104,7 +104,10 @@ protected:
         if (src_mds_[0].format_kind != format_kind::blocked)
             return status::unimplemented;
 
+        /* keep the requested data type, only the layout is taken */
+        const auto dst_dt = dst_md_.data_type;
         dst_md_ = src_mds_[0];
+        dst_md_.data_type = dst_dt;
 
         return status::success;
     }
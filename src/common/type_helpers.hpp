@@ -90,7 +90,10 @@ inline bool memory_extra_desc_is_equal(const memory_extra_desc_t &lhs,
         && IMPLICATION(lhs.flags & memory_extra_flags::compensation_conv_s8s8,
                 lhs.compensation_mask == rhs.compensation_mask)
         && IMPLICATION(lhs.flags & memory_extra_flags::scale_adjust,
-                lhs.scale_adjust == rhs.scale_adjust);
+                lhs.scale_adjust == rhs.scale_adjust)
+        && IMPLICATION(lhs.flags
+                & memory_extra_flags::compensation_conv_asymmetric_src,
+                lhs.asymm_compensation_mask == rhs.asymm_compensation_mask);
 }
 
 inline bool blocking_desc_is_equal(const blocking_desc_t &lhs,
@@ -42,6 +42,7 @@
 #include "cpu/jit_avx512_core_x8s8s32x_1x1_deconvolution.hpp"
 #include "cpu/ref_deconvolution.hpp"
 #include "cpu/ref_shuffle.hpp"
+#include "cpu/jit_uni_shuffle.hpp"
 #include "cpu/jit_uni_eltwise.hpp"
 #include "cpu/ref_eltwise.hpp"
 #include "cpu/ref_softmax.hpp"
@@ -50,6 +51,7 @@
 #include "cpu/ref_pooling.hpp"
 #include "cpu/nchw_pooling.hpp"
 #include "cpu/nhwc_pooling.hpp"
+#include "cpu/jit_uni_nspc_pooling.hpp"
 #include "cpu/jit_avx512_common_lrn.hpp"
 #include "cpu/jit_uni_lrn.hpp"
 #include "cpu/ref_lrn.hpp"
@@ -57,10 +59,12 @@
 #include "cpu/ref_batch_normalization.hpp"
 #include "cpu/ncsp_batch_normalization.hpp"
 #include "cpu/nspc_batch_normalization.hpp"
+#include "cpu/jit_uni_nspc_batch_normalization.hpp"
 #include "cpu/ref_inner_product.hpp"
 #include "cpu/gemm_inner_product.hpp"
 #include "cpu/gemm_x8s8s32x_inner_product.hpp"
 #include "cpu/jit_uni_dw_convolution.hpp"
+#include "cpu/jit_uni_nspc_convolution.hpp"
 #include "cpu/jit_avx512_core_u8s8s32x_wino_convolution.hpp"
 #include "cpu/jit_avx512_core_fp32_wino_conv_2x3.hpp"
 #include "cpu/jit_uni_batch_normalization_s8.hpp"
@@ -123,6 +127,12 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(jit_avx2_convolution_bwd_data_t),
     INSTANCE(jit_avx2_convolution_bwd_weights_t),
     INSTANCE(jit_sse42_convolution_fwd_t),
+    INSTANCE(jit_uni_nspc_convolution_fwd_t<avx512_common>),
+    INSTANCE(jit_uni_nspc_convolution_bwd_data_t<avx512_common>),
+    INSTANCE(jit_uni_nspc_convolution_bwd_weights_t<avx512_common>),
+    INSTANCE(jit_uni_nspc_convolution_fwd_t<avx2>),
+    INSTANCE(jit_uni_nspc_convolution_bwd_data_t<avx2>),
+    INSTANCE(jit_uni_nspc_convolution_bwd_weights_t<avx2>),
     INSTANCE(gemm_convolution_fwd_t),
     INSTANCE(gemm_convolution_bwd_data_t),
     INSTANCE(gemm_convolution_bwd_weights_t),
@@ -191,6 +201,8 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(ref_deconvolution_bwd_data_t),
     INSTANCE(ref_deconvolution_fwd_t),
     /* shuffle */
+    INSTANCE(jit_uni_shuffle_t<avx512_common>),
+    INSTANCE(jit_uni_shuffle_t<avx2>),
     INSTANCE(ref_shuffle_t<4>), /* f32 or s32 */
     INSTANCE(ref_shuffle_t<1>), /* s8 or u8 */
     /* eltwise */
@@ -219,6 +231,10 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(jit_uni_pooling_bwd_t<sse42>),
     INSTANCE(nchw_pooling_fwd_t<f32>),
     INSTANCE(nchw_pooling_bwd_t<f32>),
+    INSTANCE(jit_uni_nspc_pooling_fwd_t<avx512_common>),
+    INSTANCE(jit_uni_nspc_pooling_bwd_t<avx512_common>),
+    INSTANCE(jit_uni_nspc_pooling_fwd_t<avx2>),
+    INSTANCE(jit_uni_nspc_pooling_bwd_t<avx2>),
     INSTANCE(nhwc_pooling_fwd_t<f32>),
     INSTANCE(nhwc_pooling_bwd_t<f32>),
     INSTANCE(ref_pooling_fwd_t<f32>),
@@ -247,6 +263,10 @@ static const pd_create_f cpu_impl_list[] = {
     INSTANCE(jit_uni_batch_normalization_bwd_t<sse42>),
     INSTANCE(ncsp_batch_normalization_fwd_t),
     INSTANCE(ncsp_batch_normalization_bwd_t),
+    INSTANCE(jit_uni_nspc_batch_normalization_fwd_t<avx512_common>),
+    INSTANCE(jit_uni_nspc_batch_normalization_bwd_t<avx512_common>),
+    INSTANCE(jit_uni_nspc_batch_normalization_fwd_t<avx2>),
+    INSTANCE(jit_uni_nspc_batch_normalization_bwd_t<avx2>),
     INSTANCE(nspc_batch_normalization_fwd_t),
     INSTANCE(nspc_batch_normalization_bwd_t),
     INSTANCE(ref_batch_normalization_fwd_t<f32>),
@@ -79,6 +79,30 @@ protected:
         return pd()->scratchpad_registry().grantor(ptr);
     }
 
+    /** Returns the output scales: the ones passed at execution time for the
+     * runtime scales or the ones from the attributes otherwise */
+    const float *output_scales(const exec_ctx_t &ctx) const {
+        const auto &os = pd()->attr()->output_scales_;
+        if (os.defined()) return os.scales_;
+        return CTX_IN_MEM(const float *, MKLDNN_ARG_ATTR_OUTPUT_SCALES);
+    }
+
+    /** Returns the parameters of the eltwise post-op @p idx with the runtime
+     * alpha and beta replaced by the ones passed at execution time */
+    post_ops_t::entry_t::eltwise_t post_op_eltwise(const exec_ctx_t &ctx,
+            int idx) const {
+        const auto &e = pd()->attr()->post_ops_.entry_[idx];
+        assert(e.kind == primitive_kind::eltwise);
+        auto eltwise = e.eltwise;
+        if (!e.defined()) {
+            auto params = CTX_IN_MEM(const float *,
+                    MKLDNN_ARG_ATTR_POST_OP_0 + idx);
+            if (is_runtime_value(eltwise.alpha)) eltwise.alpha = params[0];
+            if (is_runtime_value(eltwise.beta)) eltwise.beta = params[1];
+        }
+        return eltwise;
+    }
+
 private:
     void *scratchpad_buffer_;
     scratchpad_t *global_scratchpad_;
@@ -0,0 +1,97 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_ZERO_POINTS_UTILS_HPP
+#define CPU_ZERO_POINTS_UTILS_HPP
+
+#include "c_types_map.hpp"
+#include "memory_desc_wrapper.hpp"
+#include "mkldnn_thread.hpp"
+#include "primitive_attr.hpp"
+#include "utils.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace zero_points_utils {
+
+/* Asymmetric quantization:
+ *      dst = zp_dst + post_ops(scale * (sum{w * (src - zp_src)} + bias))
+ *
+ * The source zero point is folded into the weights compensation:
+ *      sum{w * (src - zp_src)} = sum{w * src} + zp_src * (-sum{w}),
+ * where -sum{w} is precomputed by the weights reorder (the buffer is marked
+ * with memory_extra_flags::compensation_conv_asymmetric_src). This requires
+ * the padded area of the source to be filled with zp_src, so that it is
+ * zero in the dequantized domain. */
+
+/* Returns true if the zero points can be used with the source of the given
+ * data type and with @p oc output channels in total */
+inline bool zero_points_valid(const primitive_attr_t *attr,
+        data_type_t src_dt, dim_t oc) {
+    const auto &src_zp = attr->zero_points_src_;
+    const auto &dst_zp = attr->zero_points_dst_;
+
+    const int32_t zp = src_zp.zero_points_[0];
+    const bool src_ok = src_dt == data_type::u8
+        ? (0 <= zp && zp <= 255)
+        : (-128 <= zp && zp <= 127);
+    const bool dst_ok = IMPLICATION(dst_zp.mask_ != 0, dst_zp.count_ == oc);
+
+    return src_ok && dst_ok;
+}
+
+/* Marks the weights memory descriptor to carry the asymmetric compensation
+ * if the source zero point is non-zero */
+inline void init_asymmetric_compensation(memory_desc_t &wei_md,
+        const primitive_attr_t *attr, int compensation_mask) {
+    if (attr->zero_points_src_.has_default_values()) return;
+    wei_md.extra.flags |= memory_extra_flags::compensation_conv_asymmetric_src;
+    wei_md.extra.asymm_compensation_mask = compensation_mask;
+}
+
+/* Returns the pointer to the asymmetric compensation buffer (if any) */
+inline const int32_t *asymmetric_compensation(
+        const memory_desc_wrapper &wei_d, const void *wei) {
+    using namespace memory_extra_flags;
+    if (!(wei_d.extra().flags & compensation_conv_asymmetric_src))
+        return nullptr;
+    const size_t offset = wei_d.size()
+        - wei_d.additional_buffer_size(compensation_conv_asymmetric_src);
+    return reinterpret_cast<const int32_t *>(
+            reinterpret_cast<const char *>(wei) + offset);
+}
+
+/* Computes the compensation applied to the accumulator:
+ *      comp[i] = s8s8_comp[i] + zp_src * asymm_comp[i],
+ * where s8s8_comp is optional (nullptr for the unsigned source) */
+inline void compute_compensation(int32_t *comp, const int32_t *s8s8_comp,
+        const int32_t *asymm_comp, int32_t zp_src, dim_t len) {
+    parallel_nd(len, [&](dim_t i) {
+        comp[i] = (s8s8_comp ? s8s8_comp[i] : 0) + zp_src * asymm_comp[i];
+    });
+}
+
+}
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,280 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstdint>
+
+#include "mkldnn_thread.hpp"
+
+#include "jit_generator.hpp"
+#include "jit_uni_eltwise.hpp"
+#include "ref_eltwise.hpp"
+
+#include "gemm_epilogue_f32.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace Xbyak;
+
+namespace {
+
+/* Walks the columns of the block and finishes them in place, unrolled by up
+ * to 4 vectors along the rows; the row tail is handled with a mask. */
+template <cpu_isa_t isa>
+struct jit_uni_gemm_epilogue_kernel_f32: public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_gemm_epilogue_kernel_f32)
+
+    typedef gemm_epilogue_f32_t::call_s call_s;
+
+    jit_uni_gemm_epilogue_kernel_f32(bool with_bias, bool bias_per_row,
+            const post_ops_t::entry_t::eltwise_t *eltwise)
+        : with_bias_(with_bias), bias_per_row_(bias_per_row)
+        , eltwise_injector_(nullptr)
+    {
+        if (eltwise)
+            eltwise_injector_ = new jit_uni_eltwise_injector_f32<isa>(this,
+                    *eltwise, false, reg_table, Opmask(1));
+        generate();
+        jit_ker = (void (*)(const call_s *))getCode();
+    }
+
+    ~jit_uni_gemm_epilogue_kernel_f32() { delete eltwise_injector_; }
+
+    void (*jit_ker)(const call_s *);
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    using reg64_t = const Xbyak::Reg64;
+
+    enum { unroll = 4, vmm_dst_idx = 8 };
+    const int vlen = cpu_isa_traits<isa>::vlen;
+    const int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+
+    const bool with_bias_, bias_per_row_;
+    jit_uni_eltwise_injector_f32<isa> *eltwise_injector_;
+
+    reg64_t reg_param = abi_param1;
+    reg64_t reg_c = r8;
+    reg64_t reg_bias = r9;
+    reg64_t reg_ldc = r10;
+    reg64_t reg_m = r11;
+    reg64_t reg_n = r12;
+    reg64_t reg_ptr_c = r13;
+    reg64_t reg_ptr_bias = r14;
+    reg64_t reg_i = r15;
+    reg64_t reg_tmp = rdx;
+    reg64_t reg_table = rax;
+
+    Opmask k_tail = Opmask(2);
+
+    /* the injector takes its auxiliary vectors from the lowest indices */
+    Vmm vmm_dst(int u) { return Vmm(vmm_dst_idx + u); }
+    Vmm vmm_bias(int u) { return Vmm(vmm_dst_idx + unroll + u); }
+    Vmm vmm_col_bias() { return Vmm(vmm_dst_idx - 2); }
+    Vmm vmm_mask() { return Vmm(vmm_dst_idx - 1); }
+
+    void load(const Vmm &vmm, const Address &addr, bool tail) {
+        if (!tail)
+            uni_vmovups(vmm, addr);
+        else if (isa == avx512_common)
+            vmovups(vmm | k_tail | T_z, addr);
+        else
+            vmaskmovps(vmm, vmm_mask(), addr);
+    }
+
+    void store(const Address &addr, const Vmm &vmm, bool tail) {
+        if (!tail)
+            uni_vmovups(addr, vmm);
+        else if (isa == avx512_common)
+            vmovups(addr | k_tail, vmm);
+        else
+            vmaskmovps(addr, vmm_mask(), vmm);
+    }
+
+    void compute(int nv, bool tail) {
+        for (int u = 0; u < nv; ++u) {
+            load(vmm_dst(u), ptr[reg_ptr_c + u * vlen], tail);
+            if (!with_bias_) continue;
+            if (bias_per_row_) {
+                load(vmm_bias(u), ptr[reg_ptr_bias + u * vlen], tail);
+                uni_vaddps(vmm_dst(u), vmm_dst(u), vmm_bias(u));
+            } else {
+                uni_vaddps(vmm_dst(u), vmm_dst(u), vmm_col_bias());
+            }
+        }
+        if (eltwise_injector_)
+            eltwise_injector_->compute_vector_range(vmm_dst_idx,
+                    vmm_dst_idx + nv);
+        for (int u = 0; u < nv; ++u)
+            store(ptr[reg_ptr_c + u * vlen], vmm_dst(u), tail);
+    }
+
+    void step(int nv) {
+        add(reg_ptr_c, nv * vlen);
+        if (with_bias_ && bias_per_row_)
+            add(reg_ptr_bias, nv * vlen);
+        sub(reg_i, nv * simd_w);
+    }
+
+    void generate() {
+        preamble();
+
+#define PARAM_OFF(x) offsetof(call_s, x)
+        mov(reg_c, ptr[reg_param + PARAM_OFF(c)]);
+        mov(reg_bias, ptr[reg_param + PARAM_OFF(bias)]);
+        mov(reg_ldc, ptr[reg_param + PARAM_OFF(ldc)]);
+        mov(reg_m, ptr[reg_param + PARAM_OFF(m)]);
+        mov(reg_n, ptr[reg_param + PARAM_OFF(n)]);
+        if (isa == avx512_common) {
+            mov(reg_tmp, ptr[reg_param + PARAM_OFF(tail_kmask)]);
+            kmovw(k_tail, reg_tmp.cvt32());
+        } else {
+            mov(reg_tmp, ptr[reg_param + PARAM_OFF(tail_vmask)]);
+            vmovups(vmm_mask(), ptr[reg_tmp]);
+        }
+#undef PARAM_OFF
+        shl(reg_ldc, 2);
+
+        if (eltwise_injector_)
+            eltwise_injector_->load_table_addr();
+
+        Label l_n, l_m_unroll, l_m_single, l_m_tail, l_m_end;
+
+        L(l_n);
+        {
+            mov(reg_ptr_c, reg_c);
+            mov(reg_ptr_bias, reg_bias);
+            mov(reg_i, reg_m);
+            if (with_bias_ && !bias_per_row_)
+                uni_vbroadcastss(vmm_col_bias(), ptr[reg_bias]);
+
+            L(l_m_unroll);
+            cmp(reg_i, unroll * simd_w);
+            jl(l_m_single, T_NEAR);
+            compute(unroll, false);
+            step(unroll);
+            jmp(l_m_unroll, T_NEAR);
+
+            L(l_m_single);
+            cmp(reg_i, simd_w);
+            jl(l_m_tail, T_NEAR);
+            compute(1, false);
+            step(1);
+            jmp(l_m_single, T_NEAR);
+
+            L(l_m_tail);
+            cmp(reg_i, 0);
+            jle(l_m_end, T_NEAR);
+            compute(1, true);
+
+            L(l_m_end);
+            add(reg_c, reg_ldc);
+            if (with_bias_ && !bias_per_row_)
+                add(reg_bias, sizeof(float));
+            dec(reg_n);
+            jnz(l_n, T_NEAR);
+        }
+
+        postamble();
+
+        if (eltwise_injector_)
+            eltwise_injector_->prepare_table();
+    }
+};
+
+}
+
+gemm_epilogue_f32_t::gemm_epilogue_f32_t(bool with_bias, char bias_kind,
+        const post_ops_t::entry_t::eltwise_t *eltwise)
+    : with_bias_(with_bias), bias_kind_(bias_kind), simd_w_(1)
+    , kernel_(nullptr), ker_(nullptr), ref_eltwise_(nullptr)
+{
+    assert(utils::one_of(bias_kind, 'C', 'R'));
+    const bool bias_per_row = bias_kind == 'C';
+
+    if (mayiuse(avx512_common)) {
+        auto k = new jit_uni_gemm_epilogue_kernel_f32<avx512_common>(
+                with_bias, bias_per_row, eltwise);
+        kernel_ = k;
+        ker_ = k->jit_ker;
+        simd_w_ = cpu_isa_traits<avx512_common>::vlen / sizeof(float);
+    } else if (mayiuse(avx2)) {
+        auto k = new jit_uni_gemm_epilogue_kernel_f32<avx2>(
+                with_bias, bias_per_row, eltwise);
+        kernel_ = k;
+        ker_ = k->jit_ker;
+        simd_w_ = cpu_isa_traits<avx2>::vlen / sizeof(float);
+    } else if (eltwise) {
+        ref_eltwise_ = new ref_eltwise_scalar_fwd_t(*eltwise);
+    }
+}
+
+gemm_epilogue_f32_t::~gemm_epilogue_f32_t() {
+    delete kernel_;
+    delete ref_eltwise_;
+}
+
+void gemm_epilogue_f32_t::operator()(float *c, ptrdiff_t ldc, ptrdiff_t m,
+        ptrdiff_t n, const float *bias) const {
+    if (m <= 0 || n <= 0) return;
+
+    if (ker_) {
+        static const uint32_t vmask_table[16] = {
+            ~0u, ~0u, ~0u, ~0u, ~0u, ~0u, ~0u, ~0u, 0, 0, 0, 0, 0, 0, 0, 0 };
+        const int tail = m % simd_w_;
+
+        call_s p;
+        p.c = c;
+        p.bias = bias;
+        p.ldc = ldc;
+        p.m = m;
+        p.n = n;
+        p.tail_kmask = (1 << tail) - 1;
+        p.tail_vmask = simd_w_ == 8
+            ? (const float *)(vmask_table + 8 - tail) : nullptr;
+        ker_(&p);
+        return;
+    }
+
+    const bool bias_per_row = bias_kind_ == 'C';
+    for (ptrdiff_t j = 0; j < n; ++j) {
+        float *c_j = c + j * ldc;
+        for (ptrdiff_t i = 0; i < m; ++i) {
+            float d = c_j[i];
+            if (with_bias_) d += bias_per_row ? bias[i] : bias[j];
+            if (ref_eltwise_) d = ref_eltwise_->compute_scalar(d);
+            c_j[i] = d;
+        }
+    }
+}
+
+void gemm_epilogue_f32_t::parallel_apply(float *c, ptrdiff_t ldc,
+        ptrdiff_t m, ptrdiff_t n, const float *bias) const {
+    const int nthr = mkldnn_in_parallel() ? 1 : mkldnn_get_max_threads();
+    parallel(nthr, [&](const int ithr, const int nthr) {
+        ptrdiff_t start{0}, end{0};
+        balance211(n, nthr, ithr, start, end);
+        const float *b = with_bias_ && bias_kind_ == 'R' ? bias + start : bias;
+        (*this)(c + start * ldc, ldc, m, end - start, b);
+    });
+}
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,82 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef GEMM_EPILOGUE_F32_HPP
+#define GEMM_EPILOGUE_F32_HPP
+
+#include <cstddef>
+
+#include "c_types_map.hpp"
+#include "primitive_attr.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+class jit_generator;
+struct ref_eltwise_scalar_fwd_t;
+
+/* Post-processing fused into sgemm: C = eltwise(C + bias), applied to each
+ * block of the column-major C right after its final write-back, while the
+ * block is still in cache. The bias has one value per row of C (bias_kind
+ * 'C', as a column offset of the integer gemm) or one per column ('R').
+ *
+ * Primitives create the epilogue once and pass it together with the bias
+ * pointer of the call to extended_sgemm(). */
+struct gemm_epilogue_f32_t {
+    gemm_epilogue_f32_t(bool with_bias, char bias_kind,
+            const post_ops_t::entry_t::eltwise_t *eltwise);
+    ~gemm_epilogue_f32_t();
+
+    bool with_bias() const { return with_bias_; }
+    char bias_kind() const { return bias_kind_; }
+
+    /* bias points to the value of the first row ('C') or the first column
+     * ('R') of the block c */
+    void operator()(float *c, ptrdiff_t ldc, ptrdiff_t m, ptrdiff_t n,
+            const float *bias) const;
+
+    /* the same for a whole matrix, with the columns split between threads */
+    void parallel_apply(float *c, ptrdiff_t ldc, ptrdiff_t m, ptrdiff_t n,
+            const float *bias) const;
+
+    struct call_s {
+        float *c;
+        const float *bias;
+        size_t ldc;
+        size_t m;
+        size_t n;
+        size_t tail_kmask;
+        const float *tail_vmask;
+    };
+
+private:
+    const bool with_bias_;
+    const char bias_kind_;
+    int simd_w_;
+
+    jit_generator *kernel_;
+    void (*ker_)(const call_s *);
+    ref_eltwise_scalar_fwd_t *ref_eltwise_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
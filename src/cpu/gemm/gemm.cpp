@@ -17,17 +17,20 @@
 #include "mkldnn.h"
 
 #include "mkldnn_traits.hpp"
+#include "mkldnn_thread.hpp"
 #include "nstl.hpp"
 
 #include "jit_generator.hpp"
 
 #include "gemm.hpp"
 
+#include "f32/gemm_epilogue_f32.hpp"
 #include "f32/jit_avx512_common_gemm_f32.hpp"
 #include "f32/jit_avx_gemm_f32.hpp"
 #include "f32/ref_gemm_f32.hpp"
 
 #include "gemm_driver.hpp"
+#include "jit_uni_small_gemm.hpp"
 #include "s8x8s32/ref_gemm_s8x8s32.hpp"
 #include "s8x8s32/simple_gemm_s8s8s32.hpp"
 
@@ -120,6 +123,10 @@ mkldnn_status_t extended_sgemm(const char *transa, const char *transb,
     }
 #endif
 
+    if (small_sgemm(transa, transb, M, N, K, alpha, A, lda, B, ldb, beta, C,
+                ldc, bias) == mkldnn_success)
+        return mkldnn_success;
+
     if (mayiuse(avx512_mic)) {
         return jit_avx512_common_gemm_f32(transa, transb,
                 M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, bias);
@@ -136,6 +143,108 @@ mkldnn_status_t extended_sgemm(const char *transa, const char *transb,
     }
 }
 
+mkldnn_status_t extended_sgemm(const char *transa, const char *transb,
+        const int *M, const int *N, const int *K, const float *alpha,
+        const float *A, const int *lda, const float *B, const int *ldb,
+        const float *beta, float *C, const int *ldc, const float *bias,
+        const gemm_epilogue_f32_t &epilogue,
+        const bool force_jit_nocopy_gemm) {
+    mkldnn_status_t status = check_gemm_input(transa, transb, M, N, K,
+            lda, ldb, ldc, alpha, beta, false);
+    if (status != mkldnn_success)
+        return status;
+    if (epilogue.with_bias() && bias == nullptr)
+        return mkldnn_invalid_arguments;
+
+#ifdef USE_CBLAS
+    if (!force_jit_nocopy_gemm) {
+        status = extended_sgemm(transa, transb, M, N, K, alpha, A, lda, B,
+                ldb, beta, C, ldc, nullptr, false);
+        if (status == mkldnn_success)
+            epilogue.parallel_apply(C, *ldc, *M, *N, bias);
+        return status;
+    }
+#endif
+
+    if (small_sgemm(transa, transb, M, N, K, alpha, A, lda, B, ldb, beta, C,
+                ldc, nullptr) == mkldnn_success) {
+        epilogue(C, *ldc, *M, *N, bias);
+        return mkldnn_success;
+    }
+
+    // gemm_driver finishes each block of C right after its last update.
+    if (!mayiuse(avx512_mic) && mayiuse(avx)) {
+        const char bias_kind = epilogue.bias_kind();
+        float *dummy_ao = NULL;
+        float *dummy_bo = NULL;
+
+        return gemm_driver(transa, transb,
+                epilogue.with_bias() ? &bias_kind : NULL, M, N, K, alpha,
+                A, lda, dummy_ao, B, ldb, dummy_bo, beta, C, ldc, bias,
+                force_jit_nocopy_gemm, &epilogue);
+    }
+
+    status = extended_sgemm(transa, transb, M, N, K, alpha, A, lda, B, ldb,
+            beta, C, ldc, nullptr, force_jit_nocopy_gemm);
+    if (status == mkldnn_success)
+        epilogue.parallel_apply(C, *ldc, *M, *N, bias);
+
+    return status;
+}
+
+/* Without the jit copy kernels the packed A is just op(A) scaled by alpha
+ * and stored as a dense column-major M x K matrix. */
+size_t packed_sgemm_get_size(const int *M, const int *K) {
+    const size_t nelems = sgemm_pack_a_supported()
+        ? sgemm_pack_a_size(M, K) : (size_t) *M * *K;
+    return utils::rnd_up(nelems * sizeof(float), 64);
+}
+
+mkldnn_status_t packed_sgemm_pack(const char *transa, const int *M,
+        const int *K, const float *alpha, const float *A, const int *lda,
+        float *packed_A) {
+    if (utils::any_null(transa, M, K, alpha, A, lda, packed_A))
+        return mkldnn_invalid_arguments;
+    bool isTransA = utils::one_of(*transa, 'T', 't');
+    bool consistency = true
+        && utils::one_of(*transa, 'T', 't', 'N', 'n')
+        && *M >= 0
+        && *K >= 0
+        && *lda >= nstl::max(1, isTransA ? *K : *M);
+    if (!consistency)
+        return mkldnn_invalid_arguments;
+
+    if (sgemm_pack_a_supported()) {
+        sgemm_pack_a(transa, M, K, alpha, A, lda, packed_A);
+        return mkldnn_success;
+    }
+
+    const int m = *M, ld = *lda;
+    parallel_nd(*K, m, [&](int k, int i) {
+        packed_A[i + (size_t) k * m] = *alpha
+            * A[isTransA ? k + (size_t) i * ld : i + (size_t) k * ld];
+    });
+    return mkldnn_success;
+}
+
+mkldnn_status_t packed_sgemm_compute(const char *transb, const int *M,
+        const int *N, const int *K, const float *packed_A, const float *B,
+        const int *ldb, const float *beta, float *C, const int *ldc) {
+    const int lda = nstl::max(1, *M);
+    const float one = 1.0f;
+    mkldnn_status_t status = check_gemm_input("N", transb, M, N, K, &lda,
+            ldb, ldc, &one, beta, false);
+    if (status != mkldnn_success)
+        return status;
+
+    if (sgemm_pack_a_supported())
+        return sgemm_packed_a_driver(transb, M, N, K, packed_A, B, ldb, beta,
+                C, ldc);
+
+    return extended_sgemm("N", transb, M, N, K, &one, packed_A, &lda, B, ldb,
+            beta, C, ldc);
+}
+
 template <typename b_dt>
 mkldnn_status_t gemm_s8x8s32(const char *transa, const char *transb,
         const char *offsetc, const int *M, const int *N, const int *K,
@@ -172,8 +281,15 @@ mkldnn_status_t gemm_s8x8s32(const char *transa, const char *transb,
     } else {
         assert(data_traits<b_dt>::data_type == data_type::s8);
         // TODO CBLAS implementation of gemm_s8s8s32 goes here.
-        // mkldnn_gemm_s8s8s32 doesn't support non-zero ao and bo
-        if (utils::everyone_is(0, *ao, *bo)) {
+        if (small_gemm_s8x8s32(transa, transb, offsetc, M, N, K, alpha, A,
+                    LDA, ao, B, LDB, bo, beta, C, LDC, co) == mkldnn_success)
+            return mkldnn_success;
+
+        if (mayiuse(avx512_core)) {
+            return gemm_driver(transa, transb, offsetc, M,
+                    N, K, alpha, A, LDA, ao, (int8_t *)B, LDB, bo, beta,
+                    C, LDC, co, false);
+        } else if (utils::everyone_is(0, *ao, *bo)) {
             return simple_gemm_s8s8s32(transa, transb, offsetc, M,
                     N, K, alpha, A, LDA, ao, (int8_t *)B, LDB, bo, beta,
                     C, LDC, co);
@@ -183,6 +299,10 @@ mkldnn_status_t gemm_s8x8s32(const char *transa, const char *transb,
         }
     }
 #else
+    if (small_gemm_s8x8s32(transa, transb, offsetc, M, N, K, alpha, A, LDA,
+                ao, B, LDB, bo, beta, C, LDC, co) == mkldnn_success)
+        return mkldnn_success;
+
     cpu_isa_t isa = isa_any;
     if (mayiuse(avx512_core_vnni)) {
         isa = avx512_core_vnni;
@@ -203,13 +323,13 @@ mkldnn_status_t gemm_s8x8s32(const char *transa, const char *transb,
         }
     } else {
         assert(data_traits<b_dt>::data_type == data_type::s8);
-        // mkldnn_gemm_s8s8s32 doesn't support non-zero ao and bo
-        if ((mayiuse(avx512_core) || mayiuse(avx512_core_vnni))
-                && *ao == 0 && *bo == 0) {
-            return simple_gemm_s8s8s32(transa, transb, offsetc, M,
+        switch (isa) {
+        case avx512_core:
+        case avx512_core_vnni:
+            return gemm_driver(transa, transb, offsetc, M,
                     N, K, alpha, A, LDA, ao, (int8_t *)B, LDB, bo, beta,
-                    C, LDC, co);
-        } else {
+                    C, LDC, co, false);
+        default:
             return ref_gemm_s8x8s32(transa, transb, offsetc, M, N, K,
                     alpha, A, LDA, ao, B, LDB, bo, beta, C, LDC, co);
         }
@@ -30,6 +30,30 @@ mkldnn_status_t extended_sgemm(const char *transa, const char *transb,
         const float *beta, float *C, const int *ldc,
         const float *bias = nullptr, bool force_jit_gemm = false);
 
+struct gemm_epilogue_f32_t;
+
+/* The same with the bias and eltwise of the epilogue applied to the blocks of
+ * C as they are finished; bias may be nullptr if the epilogue has none. */
+mkldnn_status_t extended_sgemm(const char *transa, const char *transb,
+        const int *M, const int *N, const int *K, const float *alpha,
+        const float *A, const int *lda, const float *B, const int *ldb,
+        const float *beta, float *C, const int *ldc, const float *bias,
+        const gemm_epilogue_f32_t &epilogue, bool force_jit_gemm = false);
+
+/* sgemm for many products with the same A, like MKL's sgemm_pack and
+ * sgemm_compute: A is packed once (alpha applied) into a buffer of
+ * packed_sgemm_get_size() bytes, then packed_sgemm_compute() computes
+ * C = packed_A * op(B) + beta * C without copying A again. */
+size_t packed_sgemm_get_size(const int *M, const int *K);
+
+mkldnn_status_t packed_sgemm_pack(const char *transa, const int *M,
+        const int *K, const float *alpha, const float *A, const int *lda,
+        float *packed_A);
+
+mkldnn_status_t packed_sgemm_compute(const char *transb, const int *M,
+        const int *N, const int *K, const float *packed_A, const float *B,
+        const int *ldb, const float *beta, float *C, const int *ldc);
+
 template <typename b_dt>
 mkldnn_status_t gemm_s8x8s32(const char *transa, const char *transb,
         const char *offsetc, const int *M, const int *N, const int *K,
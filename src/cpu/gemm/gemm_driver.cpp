@@ -21,6 +21,7 @@
 
 #include "gemm_driver.hpp"
 
+#include "f32/gemm_epilogue_f32.hpp"
 #include "f32/gemm_utils_f32.hpp"
 #include "f32/jit_avx512_common_gemm_f32.hpp"
 #include "f32/jit_avx_gemm_f32.hpp"
@@ -140,7 +141,12 @@ void gemm_kernel(const dim_t m, const dim_t n, const dim_t k,
         a_type bo = arg->bo;
         c_type co_0 = offsetc == NO_OFFSET ? 0 : co[0];
 
-        if (bo != 0 || offsetc == COL_OFFSET)
+        // s8 B is copied shifted by 128, which is compensated together with
+        // bo through the row sums of A.
+        c_type b_comp = (c_type) bo
+            - (data_traits<b_type>::data_type == data_type::s8 ? 128 : 0);
+
+        if (b_comp != 0 || offsetc == COL_OFFSET)
             col_req = 1;
         if (ao != 0 || offsetc == ROW_OFFSET)
             row_req = 1;
@@ -165,9 +171,9 @@ void gemm_kernel(const dim_t m, const dim_t n, const dim_t k,
                     col_offset[i] += co[i];
             }
 
-            if (bo != 0) {
+            if (b_comp != 0) {
                 for (dim_t i = 0; i < m; i++)
-                    col_offset[i] += bo * a_row_sum[i];
+                    col_offset[i] += b_comp * a_row_sum[i];
             }
         }
 
@@ -236,6 +242,26 @@ void scale_matrix(dim_t m, dim_t n, scale_t alpha, mat_t * __restrict p_mat,
     }
 }
 
+// Finishes a block of C with the sgemm epilogue, co being the bias of the block.
+template <typename c_type>
+static inline void apply_epilogue(const gemm_epilogue_f32_t *epilogue,
+        const dim_t m, const dim_t n, c_type *c, const dim_t ldc,
+        const c_type *co) {
+    (*epilogue)((float *) c, ldc, m, n, (const float *) co);
+}
+
+// Size of the k-blocks of the copied A and B panels.
+template <typename a_type, typename b_type, typename c_type>
+static inline dim_t get_k_padd(const dim_t k,
+        const gemm_info_t<a_type, b_type, c_type> *arg) {
+    if (k <= arg->bk_traditional)
+        return nstl::max(128LL, utils::rnd_up(k, arg->uk));
+    else if (k < 2 * arg->bk)
+        return utils::rnd_up((k + 1) / 2, arg->uk);
+    else
+        return arg->bk;
+}
+
 template <typename a_type, typename b_type, typename c_type>
 static mkldnn_status_t gemm_kernel_driver(const dim_t m, const dim_t n,
         const dim_t k, const a_type *a, const b_type *b, c_type *c,
@@ -252,6 +278,7 @@ static mkldnn_status_t gemm_kernel_driver(const dim_t m, const dim_t n,
     }
 
     bool isInteger = (data_traits<a_type>::data_type == data_type::s8);
+    bool withEpilogue = arg->epilogue != NULL;
 
     // Scaling C matrix.
     if (!isInteger && beta != 1.0f && beta != 0.0f) {
@@ -264,19 +291,14 @@ static mkldnn_status_t gemm_kernel_driver(const dim_t m, const dim_t n,
         if (beta == 0.0f)
             scale_matrix(m, n, beta, c, ldc);
 
+        if (withEpilogue)
+            apply_epilogue(arg->epilogue, m, n, c, ldc, co);
+
         return mkldnn_success;
     }
 
     // Padding along K dimension.
-    dim_t k_padd = 0;
-    if (k <= arg->bk_traditional) {
-        k_padd = utils::rnd_up(k, arg->uk);
-        k_padd = nstl::max(128LL, k_padd);
-    } else if (k < 2 * arg->bk) {
-        k_padd = utils::rnd_up((k + 1) / 2, arg->uk);
-    } else {
-        k_padd = arg->bk;
-    }
+    dim_t k_padd = get_k_padd(k, arg);
 
     // Padding along M dimension.
     dim_t m_padd = utils::rnd_up(nstl::min(nstl::max(m, arg->um), arg->bm),
@@ -363,9 +385,11 @@ static mkldnn_status_t gemm_kernel_driver(const dim_t m, const dim_t n,
             else
                 beta = 1.0f;
 
-            // Apply C offset when to the last k-block of the partial sum.
+            // Apply C offset (or the epilogue) to the last k-block of the
+            // partial sum.
+            bool isLastK = Bk + sizeK == k;
             int offsetc = NO_OFFSET;
-            if (Bk + sizeK == k && isInteger)
+            if (isLastK && (isInteger || withEpilogue))
                 offsetc = arg->offsetc;
 
             dim_t sizeN = 0;
@@ -411,7 +435,7 @@ static mkldnn_status_t gemm_kernel_driver(const dim_t m, const dim_t n,
 
                     c_type *c_block = c + (Bm + Um) + Bn * ldc;
                     dim_t co_stride = 0;
-                    if (isInteger) {
+                    if (isInteger || withEpilogue) {
                         if (offsetc == FIX_OFFSET) {
                             co_stride = 0;
                         } else if (offsetc == ROW_OFFSET) {
@@ -437,6 +461,11 @@ static mkldnn_status_t gemm_kernel_driver(const dim_t m, const dim_t n,
                                 bufferA + Um_forA * sizeK, bufferB, beta,
                                 c_block, ldc, a_row_sum + Um_forA, b_col_sum,
                                 co + co_stride, offsetc, arg);
+
+                        // The block is still in cache: finish it.
+                        if (withEpilogue && isLastK)
+                            apply_epilogue(arg->epilogue, sizeUM, sizeN,
+                                    c_block, ldc, co + co_stride);
                     }
                 }
                 a_block_copied = 1;
@@ -454,7 +483,7 @@ template <typename a_type, typename b_type, typename c_type>
 static mkldnn_status_t kernel_driver_parallel_acopiedbcopy(const dim_t m,
         const dim_t n, const dim_t k, const a_type *bufferA, const b_type *b,
         const float beta, c_type *c, const int offsetc, const c_type *co,
-        const c_type *a_row_sum,
+        const c_type *a_row_sum, const bool isLastK,
         const gemm_info_t<a_type, b_type, c_type> *arg) {
 
     dim_t ldb = arg->ldb;
@@ -487,6 +516,7 @@ static mkldnn_status_t kernel_driver_parallel_acopiedbcopy(const dim_t m,
     size_t mem_size = b_buf_nelems * sizeof(*b) + PAGE_4K;
 
     bool isInteger = data_traits<a_type>::data_type == data_type::s8;
+    bool withEpilogue = arg->epilogue != NULL;
 
     if (isInteger) {
         mem_size += b_col_sum_nelems * sizeof(*c) + PAGE_4K;
@@ -534,7 +564,7 @@ static mkldnn_status_t kernel_driver_parallel_acopiedbcopy(const dim_t m,
                 b_col_sum);
 
         dim_t co_stride = 0;
-        if (isInteger) {
+        if (isInteger || withEpilogue) {
             if (offsetc == FIX_OFFSET) {
                 co_stride = 0;
             } else if (offsetc == ROW_OFFSET) {
@@ -556,6 +586,11 @@ static mkldnn_status_t kernel_driver_parallel_acopiedbcopy(const dim_t m,
         } else {
             gemm_kernel(m, sizeN, k, alpha, bufferA, bufferB, beta, c_block,
                     ldc, a_row_sum, b_col_sum, co + co_stride, offsetc, arg);
+
+            // The block is still in cache: finish it.
+            if (withEpilogue && isLastK)
+                apply_epilogue(arg->epilogue, m, sizeN, c_block, ldc,
+                        co + co_stride);
         }
     }
 
@@ -939,7 +974,7 @@ static inline void decompose_matrices(const int ithr, int *nthrs, dim_t *m,
             *c = arg->c + offset;
 
             // Set offset vector for C matrix.
-            if (isInteger) {
+            if (isInteger || arg->epilogue) {
                 dim_t co_stride = 0;
                 if (offsetc == FIX_OFFSET) {
                     co_stride = 0;
@@ -973,7 +1008,7 @@ static inline void decompose_matrices(const int ithr, int *nthrs, dim_t *m,
             *c = arg->c + offset * arg->ldc;
 
             // Set offset vector for C matrix
-            if (isInteger) {
+            if (isInteger || arg->epilogue) {
                 dim_t co_stride = 0;
                 if (offsetc == FIX_OFFSET) {
                     co_stride = 0;
@@ -1016,7 +1051,7 @@ static inline void decompose_matrices(const int ithr, int *nthrs, dim_t *m,
             *c = arg->c + m_disp + n_disp * arg->ldc;
 
             // Set offset vector for C matrix
-            if (isInteger) {
+            if (isInteger || arg->epilogue) {
                 dim_t co_stride = 0;
                 if (offsetc == FIX_OFFSET) {
                     co_stride = 0;
@@ -1121,9 +1156,11 @@ static mkldnn_status_t parallel_a_copy(const int ithr, const int nthrs,
         else
             beta = 1.0f;
 
-        // Apply C offset for the last k-block of the partial sum.
+        // Apply C offset (or the epilogue) for the last k-block of the
+        // partial sum.
+        bool isLastK = Bk + sizeK == k;
         int offsetc = NO_OFFSET;
-        if (Bk + sizeK == k && isInteger)
+        if (isLastK && (isInteger || arg->epilogue))
             offsetc = arg->offsetc;
 
         dim_t sizeM = 0;
@@ -1168,7 +1205,7 @@ static mkldnn_status_t parallel_a_copy(const int ithr, const int nthrs,
             c_type *c_block = c + Bm;
 
             dim_t co_stride = 0;
-            if (isInteger) {
+            if (isInteger || arg->epilogue) {
                 if (offsetc == FIX_OFFSET) {
                     co_stride = 0;
                 } else if (offsetc == ROW_OFFSET) {
@@ -1180,7 +1217,7 @@ static mkldnn_status_t parallel_a_copy(const int ithr, const int nthrs,
 
             result = kernel_driver_parallel_acopiedbcopy(sizeM, n, sizeK,
                     bufferA, b_block, beta, c_block, offsetc, co + co_stride,
-                    a_row_sum, arg);
+                    a_row_sum, isLastK, arg);
 
             mkldnn_thr_barrier(); // Wait for kernel computations to finish.
         }
@@ -1296,12 +1333,16 @@ static mkldnn_status_t gemm_threading_driver(
         return mkldnn_success;
 
     if (arg->force_nocopy) {
-        return call_no_copy_sgemm(arg->transa, arg->transb,
+        mkldnn_status_t status = call_no_copy_sgemm(arg->transa, arg->transb,
                 arg->m, arg->n, arg->k, arg->alpha,
                 (float *) arg->a, arg->lda,
                 (float *) arg->b, arg->ldb,
                 arg->beta, (float *) arg->c, arg->ldc,
-                (float *) arg->co);
+                arg->epilogue ? NULL : (float *) arg->co);
+        if (status == mkldnn_success && arg->epilogue)
+            arg->epilogue->parallel_apply((float *) arg->c, arg->ldc,
+                    arg->m, arg->n, (const float *) arg->co);
+        return status;
     }
 
     if (data_traits<a_type>::data_type == data_type::s8) {
@@ -1330,12 +1371,17 @@ static mkldnn_status_t gemm_threading_driver(
 
     if ((data_traits<a_type>::data_type == data_type::f32) &&
             nocopy_checker(nthr, arg->transa, arg->transb, arg->m, arg->n,
-                arg->k, arg->lda, arg->ldb, arg->ldc))
-        return call_no_copy_sgemm(arg->transa, arg->transb,
-                arg->m, arg->n, arg->k, arg->alpha,
+                arg->k, arg->lda, arg->ldb, arg->ldc)) {
+        mkldnn_status_t status = call_no_copy_sgemm(arg->transa,
+                arg->transb, arg->m, arg->n, arg->k, arg->alpha,
                 (float *) arg->a, arg->lda,
                 (float *) arg->b, arg->ldb,
                 arg->beta, (float *) arg->c, arg->ldc, NULL);
+        if (status == mkldnn_success && arg->epilogue)
+            arg->epilogue->parallel_apply((float *) arg->c, arg->ldc,
+                    arg->m, arg->n, (const float *) arg->co);
+        return status;
+    }
 
     mkldnn_status_t *results = (mkldnn_status_t *) malloc(
             sizeof(*results) * nthr * CACHE_LINE_SIZE, PAGE_4K);
@@ -1404,6 +1450,9 @@ static mkldnn_status_t gemm_threading_driver(
                                     arg->beta, (float *)c, arg->ldc,
                                     NULL, NULL);
                         }
+                        if (arg->epilogue)
+                            apply_epilogue(arg->epilogue, m, n, c, arg->ldc,
+                                    co);
                         results[ithr * CACHE_LINE_SIZE] = mkldnn_success;
                     }
                     break;
@@ -1434,7 +1483,7 @@ mkldnn_status_t gemm_driver(
         const float *alpha, const a_type *a, const int *lda, const a_type *oa,
         const b_type *b, const int *ldb, const a_type *ob,
         const float *beta, c_type *c, const int *ldc, const c_type *oc,
-        const bool force_nocopy) {
+        const bool force_nocopy, const gemm_epilogue_f32_t *epilogue) {
 
     // gemm_driver supports 8-bit integer and for avx512_vnni and avx512_core.
     assert(IMPLICATION(data_traits<a_type>::data_type == data_type::s8,
@@ -1445,7 +1494,8 @@ mkldnn_status_t gemm_driver(
             mayiuse(avx)));
 
     gemm_info_t<a_type, b_type, c_type> args(transA, transB, offsetC, m, n, k,
-            alpha, a, lda, oa, b, ldb, ob, beta, c, ldc, oc, force_nocopy);
+            alpha, a, lda, oa, b, ldb, ob, beta, c, ldc, oc, force_nocopy,
+            epilogue);
 
     // Check if copy algorithm kernels were generated on supported ISAs.
     assert(args.hasKernels());
@@ -1453,6 +1503,170 @@ mkldnn_status_t gemm_driver(
     return gemm_threading_driver(&args);
 }
 
+/* sgemm with a prepacked A: for each k-block of get_k_padd() the panels of um
+ * rows are stored one after the other as copyA leaves them in
+ * gemm_kernel_driver, with alpha applied. The k-block Bk starts at
+ * Bk * rnd_up(m, um) and its panel Um at Um * sizeK, so that the kernels can
+ * run on any um-aligned range of rows without copying A again. */
+static gemm_info_t<float, float, float> sgemm_packed_a_info(
+        const char *transA, const char *transB) {
+    const int dummy_dim = 1;
+    const float dummy_scale = 1.0f;
+
+    return gemm_info_t<float, float, float>(transA, transB, NULL,
+            &dummy_dim, &dummy_dim, &dummy_dim, &dummy_scale, NULL,
+            &dummy_dim, NULL, NULL, &dummy_dim, NULL, &dummy_scale, NULL,
+            &dummy_dim, NULL, false);
+}
+
+bool sgemm_pack_a_supported() {
+    static const bool supported = [] {
+        if (!mayiuse(avx2) || mayiuse(avx512_mic))
+            return false;
+
+        auto info = sgemm_packed_a_info("N", "N");
+        return !info.force_nocopy && info.hasKernels();
+    }();
+    return supported;
+}
+
+size_t sgemm_pack_a_size(const int *m, const int *k) {
+    auto info = sgemm_packed_a_info("N", "N");
+    return (size_t) utils::rnd_up((dim_t) *m, info.um) * *k;
+}
+
+void sgemm_pack_a(const char *transA, const int *m, const int *k,
+        const float *alpha, const float *a, const int *lda, float *packed_a) {
+    auto info = sgemm_packed_a_info(transA, "N");
+
+    const dim_t M = *m;
+    const dim_t K = *k;
+    const dim_t LDA = *lda;
+    const dim_t m_padd = utils::rnd_up(M, info.um);
+    const dim_t k_padd = get_k_padd(K, &info);
+
+    const dim_t strideAm = (info.transa == no_trans) ? 1 : LDA;
+    const dim_t strideAk = (info.transa != no_trans) ? 1 : LDA;
+
+    const dim_t nblk_m = utils::div_up(M, info.um);
+    const dim_t nblk_k = utils::div_up(K, k_padd);
+
+    // Only the last panel of a k-block is partial, so the panels of a block
+    // never overlap and can be copied in any order.
+    parallel_nd(nblk_k, nblk_m, [&](dim_t kb, dim_t mb) {
+        const dim_t Bk = kb * k_padd;
+        const dim_t Um = mb * info.um;
+        const dim_t sizeK = nstl::min(k_padd, K - Bk);
+        const dim_t sizeUM = nstl::min(info.um, M - Um);
+
+        info.copyA(&sizeK, &sizeUM, a + Um * strideAm + Bk * strideAk, &LDA,
+                alpha, packed_a + Bk * m_padd + Um * sizeK, NULL, NULL, NULL);
+    });
+}
+
+mkldnn_status_t sgemm_packed_a_driver(const char *transB,
+        const int *m, const int *n, const int *k, const float *packed_a,
+        const float *b, const int *ldb, const float *beta, float *c,
+        const int *ldc) {
+    const dim_t M = *m;
+    const dim_t N = *n;
+    const dim_t K = *k;
+    const dim_t LDB = *ldb;
+    const dim_t LDC = *ldc;
+
+    if (M <= 0 || N <= 0)
+        return mkldnn_success;
+
+    if (K <= 0) {
+        parallel_nd(N, [&](dim_t j) {
+            for (dim_t i = 0; i < M; i++)
+                c[i + j * LDC] = *beta == 0.0f ? 0.0f : *beta * c[i + j * LDC];
+        });
+        return mkldnn_success;
+    }
+
+    auto info = sgemm_packed_a_info("N", transB);
+    assert(info.hasKernels());
+
+    const dim_t um = info.um;
+    const dim_t un = info.un;
+    const dim_t m_padd = utils::rnd_up(M, um);
+    const dim_t k_padd = get_k_padd(K, &info);
+    const dim_t n_padd = utils::rnd_up(nstl::min(nstl::max(N, un),
+                K < info.blocking_small_k ? info.bn_small_k : info.bn), un);
+
+    const dim_t strideBk = (info.transb == no_trans) ? 1 : LDB;
+    const dim_t strideBn = (info.transb != no_trans) ? 1 : LDB;
+
+    // Threads split C by whole panels of A and groups of un columns.
+    const dim_t nblk_m = utils::div_up(M, um);
+    const dim_t nblk_n = utils::div_up(N, un);
+    int nthr = (mkldnn_in_parallel()) ? 1 : mkldnn_get_max_threads();
+    const int nthr_m = (int) nstl::min((dim_t) nthr, nblk_m);
+    const int nthr_n = (int) nstl::min((dim_t) (nthr / nthr_m), nblk_n);
+    nthr = nthr_m * nthr_n;
+
+    const size_t b_buf_stride = utils::rnd_up(k_padd * n_padd * sizeof(float),
+            PAGE_4K);
+    char *mem = (char *) malloc(b_buf_stride * nthr, PAGE_4K);
+    if (!mem)
+        return mkldnn_out_of_memory;
+
+    parallel(nthr, [&](const int ithr, const int) {
+        const int ithr_m = ithr % nthr_m;
+        const int ithr_n = ithr / nthr_m;
+
+        dim_t mb_s = 0, mb_e = 0, nb_s = 0, nb_e = 0;
+        balance211(nblk_m, nthr_m, ithr_m, mb_s, mb_e);
+        balance211(nblk_n, nthr_n, ithr_n, nb_s, nb_e);
+
+        const dim_t m_s = mb_s * um;
+        const dim_t m_e = nstl::min(mb_e * um, M);
+        const dim_t n_s = nb_s * un;
+        const dim_t n_e = nstl::min(nb_e * un, N);
+        if (m_s >= m_e || n_s >= n_e)
+            return;
+
+        float *bufferB = (float *) (mem + ithr * b_buf_stride);
+        const float one = 1.0f;
+
+        float beta_first = *beta;
+        if (beta_first != 1.0f && beta_first != 0.0f) {
+            scale_matrix(m_e - m_s, n_e - n_s, beta_first,
+                    c + m_s + n_s * LDC, LDC);
+            beta_first = 1.0f;
+        }
+
+        dim_t sizeK = 0;
+        for (dim_t Bk = 0; Bk < K; Bk += sizeK) {
+            sizeK = nstl::min(k_padd, K - Bk);
+            const float beta_k = Bk == 0 ? beta_first : 1.0f;
+
+            dim_t sizeN = 0;
+            for (dim_t Bn = n_s; Bn < n_e; Bn += sizeN) {
+                sizeN = nstl::min(n_padd, n_e - Bn);
+
+                info.copyB(&sizeK, &sizeN, b + Bk * strideBk + Bn * strideBn,
+                        &LDB, &one, bufferB, NULL, NULL, NULL);
+
+                dim_t sizeUM = 0;
+                for (dim_t Um = m_s; Um < m_e; Um += sizeUM) {
+                    sizeUM = nstl::min(um, m_e - Um);
+
+                    gemm_kernel(sizeUM, sizeN, sizeK, 1.0f,
+                            packed_a + Bk * m_padd + Um * sizeK, bufferB,
+                            beta_k, c + Um + Bn * LDC, LDC, (float *) NULL,
+                            (float *) NULL, (float *) NULL, NO_OFFSET, &info);
+                }
+            }
+        }
+    });
+
+    free(mem);
+
+    return mkldnn_success;
+}
+
 template // Instantiate gemm_s8u8s32
 mkldnn_status_t gemm_driver<int8_t, uint8_t, int32_t>(
         const char *transA, const char *transB, const char *offsetC,
@@ -1460,7 +1674,16 @@ mkldnn_status_t gemm_driver<int8_t, uint8_t, int32_t>(
         const float *alpha, const int8_t *a, const int *lda, const int8_t *oa,
         const uint8_t *b, const int *ldb, const int8_t *ob,
         const float *beta, int32_t *c, const int *ldc, const int32_t *oc,
-        const bool force_nocopy);
+        const bool force_nocopy, const gemm_epilogue_f32_t *epilogue);
+
+template // Instantiate gemm_s8s8s32
+mkldnn_status_t gemm_driver<int8_t, int8_t, int32_t>(
+        const char *transA, const char *transB, const char *offsetC,
+        const int *m, const int *n, const int *k,
+        const float *alpha, const int8_t *a, const int *lda, const int8_t *oa,
+        const int8_t *b, const int *ldb, const int8_t *ob,
+        const float *beta, int32_t *c, const int *ldc, const int32_t *oc,
+        const bool force_nocopy, const gemm_epilogue_f32_t *epilogue);
 
 template // Instantiate sgemm
 mkldnn_status_t gemm_driver<float, float, float>(
@@ -1469,7 +1692,7 @@ mkldnn_status_t gemm_driver<float, float, float>(
         const float *alpha, const float *a, const int *lda, const float *oa,
         const float *b, const int *ldb, const float *ob,
         const float *beta, float *c, const int *ldc, const float *oc,
-        const bool force_nocopy);
+        const bool force_nocopy, const gemm_epilogue_f32_t *epilogue);
 
 }
 }
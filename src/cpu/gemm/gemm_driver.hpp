@@ -17,12 +17,18 @@
 #ifndef GEMM_DRIVER_HPP
 #define GEMM_DRIVER_HPP
 
+#include <cstddef>
+
 #include "mkldnn_types.h"
 
 namespace mkldnn {
 namespace impl {
 namespace cpu {
 
+struct gemm_epilogue_f32_t;
+
+/* epilogue is sgemm only: it is applied to each block of C on its final
+ * write-back, with the bias passed as the C offset of kind 'C' or 'R'. */
 template <typename a_type, typename b_type, typename c_type>
 mkldnn_status_t gemm_driver(
         const char *transA, const char *transB, const char *offsetC,
@@ -30,7 +36,20 @@ mkldnn_status_t gemm_driver(
         const float *alpha, const a_type *a, const int *lda, const a_type *oa,
         const b_type *b, const int *ldb, const a_type *ob,
         const float *beta, c_type *c, const int *ldc, const c_type *oc,
-        const bool force_jit_nocopy_gemm);
+        const bool force_jit_nocopy_gemm,
+        const gemm_epilogue_f32_t *epilogue = nullptr);
+
+/* sgemm with A packed ahead of time into the panels of the copy-based jit
+ * kernels, alpha applied while packing; sizes are in floats. Only available
+ * when sgemm_pack_a_supported(), see packed_sgemm_*() for the public entry. */
+bool sgemm_pack_a_supported();
+size_t sgemm_pack_a_size(const int *m, const int *k);
+void sgemm_pack_a(const char *transA, const int *m, const int *k,
+        const float *alpha, const float *a, const int *lda, float *packed_a);
+mkldnn_status_t sgemm_packed_a_driver(const char *transB,
+        const int *m, const int *n, const int *k, const float *packed_a,
+        const float *b, const int *ldb, const float *beta, float *c,
+        const int *ldc);
 
 }
 }
@@ -39,7 +39,7 @@ gemm_info_t<a_type, b_type, c_type>::gemm_info_t(const char *transA,
         const int *k, const float *alpha, const a_type *a, const int *lda,
         const a_type *oa, const b_type *b, const int *ldb, const a_type *ob,
         const float *beta, c_type *c, const int *ldc, const c_type *oc,
-        const bool force_nocopy) {
+        const bool force_nocopy, const gemm_epilogue_f32_t *epilogue) {
 
     char transa = *transA;
     char transb = *transB;
@@ -68,6 +68,8 @@ gemm_info_t<a_type, b_type, c_type>::gemm_info_t(const char *transA,
 
     this->offsetc = NO_OFFSET;
 
+    this->epilogue = epilogue;
+
     if (data_traits<a_type>::data_type == data_type::s8) {
         this->ao = *oa;
         this->bo = *ob;
@@ -87,9 +89,11 @@ gemm_info_t<a_type, b_type, c_type>::gemm_info_t(const char *transA,
     }
 
     bool is_sgemm = data_traits<a_type>::data_type == data_type::f32;
-    bool has_bias = (is_sgemm && this->co && this->offsetc == COL_OFFSET);
+    bool has_bias = (is_sgemm && this->co && this->offsetc == COL_OFFSET
+            && !epilogue);
 
-    // Use nocopy for sgemm if requested, if there is bias or if under avx ISA.
+    // Use nocopy for sgemm if requested, if there is bias (unless it is part
+    // of the epilogue) or if under avx ISA.
     this->force_nocopy = is_sgemm &&
         (force_nocopy || has_bias || (mayiuse(avx) && !mayiuse(avx2)));
 
@@ -174,6 +178,9 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
         static jit_generator *copy_a[2][2] = {{NULL}};
         static jit_generator *copy_b[2][2] = {{NULL}};
 
+        // s8 B is shifted to u8 by its copy kernels.
+        const bool s8b = data_traits<b_type>::data_type == data_type::s8;
+
         switch (data_traits<a_type>::data_type) {
         case data_type::s8:
             if (mayiuse(avx512_core)) {
@@ -183,9 +190,9 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
                     new jit_avx512_core_u8_copy_at_kern();
 
                 copy_b[no_trans][no_sum] =
-                    new jit_avx512_core_u8_copy_bn_kern();
+                    new jit_avx512_core_u8_copy_bn_kern(s8b);
                 copy_b[do_trans][no_sum] =
-                    new jit_avx512_core_u8_copy_bt_kern();
+                    new jit_avx512_core_u8_copy_bt_kern(s8b);
 
                 copy_a[no_trans][do_sum] =
                     new jit_avx512_core_u8_copy_sum_an_kern();
@@ -193,9 +200,9 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
                     new jit_avx512_core_u8_copy_sum_at_kern();
 
                 copy_b[no_trans][do_sum] =
-                    new jit_avx512_core_u8_copy_sum_bn_kern();
+                    new jit_avx512_core_u8_copy_sum_bn_kern(s8b);
                 copy_b[do_trans][do_sum] =
-                    new jit_avx512_core_u8_copy_sum_bt_kern();
+                    new jit_avx512_core_u8_copy_sum_bt_kern(s8b);
             }
             break;
 
@@ -295,7 +302,9 @@ void gemm_info_t<a_type, b_type, c_type>::jit_init(void) {
         }
     });
 
-    int doSumA = this->bo != 0 ? do_sum : no_sum;
+    // Row sums of A also compensate the shift of s8 B.
+    bool b_is_s8 = data_traits<b_type>::data_type == data_type::s8;
+    int doSumA = (this->bo != 0 || b_is_s8) ? do_sum : no_sum;
     int doSumB = this->ao != 0 ? do_sum : no_sum;
 
     this->copyA = copyA[this->transa][doSumA];
@@ -361,6 +370,9 @@ bool gemm_info_t<a_type, b_type, c_type>::hasKernels(void) {
 template // For gemm_s8u8s32
 struct gemm_info_t<int8_t, uint8_t, int32_t>;
 
+template // For gemm_s8s8s32
+struct gemm_info_t<int8_t, int8_t, int32_t>;
+
 template // For sgemm.
 struct gemm_info_t<float, float, float>;
 
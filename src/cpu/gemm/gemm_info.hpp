@@ -23,6 +23,8 @@ namespace mkldnn {
 namespace impl {
 namespace cpu {
 
+struct gemm_epilogue_f32_t;
+
 enum {
     PARTITION_1D_ROW,
     PARTITION_1D_COL,
@@ -97,11 +99,15 @@ struct gemm_info_t {
 
     bool force_nocopy;
 
+    // Applied to the final blocks of C (sgemm only), the bias being co.
+    const gemm_epilogue_f32_t *epilogue;
+
     gemm_info_t(const char *transA, const char *transB, const char *offsetC,
             const int *m, const int *n, const int *k, const float *alpha,
             const a_type *a, const int *lda, const a_type *oa, const b_type *b,
             const int *ldb, const a_type *ob, const float *beta, c_type *c,
-            const int *ldc, const c_type *oc, const bool force_nocopy);
+            const int *ldc, const c_type *oc, const bool force_nocopy,
+            const gemm_epilogue_f32_t *epilogue = nullptr);
 
     bool hasKernels(void);
 
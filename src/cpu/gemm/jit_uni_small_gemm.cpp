@@ -0,0 +1,461 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <cstring>
+#include <map>
+#include <mutex>
+
+#include "c_types_map.hpp"
+#include "mkldnn_traits.hpp"
+#include "nstl.hpp"
+#include "utils.hpp"
+
+#include "cpu_isa_traits.hpp"
+#include "jit_generator.hpp"
+
+#include "gemm_info.hpp"
+#include "jit_uni_small_gemm.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace Xbyak;
+
+namespace {
+
+/* Limits of the small path: every dimension and the number of vector
+ * multiply-adds of the fully unrolled kernel */
+enum {
+    max_small_dim = 64,
+    max_small_madds = 4096,
+    max_cached_kernels = 1024,
+};
+
+/* The exact shape a kernel is generated for. All the fields are ints, so
+ * the ordering for the cache is a plain memcmp */
+struct small_gemm_conf_t {
+    int is_int8;
+    int b_is_s8;
+    int transb;
+    int m, n, k;
+    int lda, ldb, ldc;
+    int beta_zero;
+    int with_bias; // f32 only
+    int offsetc; // int8 only, as in gemm_info.hpp
+    int with_ao, with_bo; // int8 only
+
+    bool operator<(const small_gemm_conf_t &rhs) const
+    { return std::memcmp(this, &rhs, sizeof(*this)) < 0; }
+};
+
+struct small_gemm_call_s {
+    const void *a, *b;
+    void *c;
+    const void *bias; // bias for f32, offsets of C for int8
+    const float *alpha, *beta; // f32 only
+    int32_t ao, bo; // int8 only
+};
+
+#define GET_OFF(field) offsetof(small_gemm_call_s, field)
+
+template <cpu_isa_t isa>
+struct jit_uni_small_gemm_kern: public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_small_gemm_kern)
+
+    jit_uni_small_gemm_kern(const small_gemm_conf_t &ajsc): jsc(ajsc) {
+        generate();
+        jit_ker = (decltype(jit_ker))getCode();
+    }
+
+    void operator()(const small_gemm_call_s *p) const { jit_ker(p); }
+
+    static const int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    using reg64_t = const Reg64;
+
+    enum { n_vregs = isa == avx512_common ? 32 : 16 };
+
+    small_gemm_conf_t jsc;
+    void (*jit_ker)(const small_gemm_call_s *);
+
+    /* M is processed by blocks of mbv_ vectors and N by blocks of nb_
+     * columns, the accumulators of a block stay in registers for all K */
+    int nv_, mbv_, nb_, tail_;
+
+    reg64_t reg_param = abi_param1;
+    reg64_t reg_a = r8;
+    reg64_t reg_b = r9;
+    reg64_t reg_c = r10;
+    reg64_t reg_bias = r11;
+    reg64_t reg_bo = rdx;
+    reg64_t reg_tmp = rax;
+
+    Opmask k_tail = Opmask(1);
+
+    Vmm vmm_acc(int v, int j) { return Vmm(v * nb_ + j); }
+    Vmm vmm_a(int v) { return Vmm(mbv_ * nb_ + v); }
+    Vmm vmm_tmp() { return Vmm(n_vregs - 1); }
+    Vmm vmm_b() { return Vmm(n_vregs - 2); }
+    /* alpha for f32, ao for int8 */
+    Vmm vmm_alpha() { return Vmm(n_vregs - 3); }
+    /* beta for f32, the fixed offset of C for int8 */
+    Vmm vmm_beta() { return Vmm(n_vregs - 4); }
+    Vmm vmm_mask() { return Vmm(n_vregs - 5); }
+    enum { n_reserved = 5 };
+
+    Label l_tail_mask;
+
+    bool is_tail(int v) const { return tail_ && v == nv_ - 1; }
+    int a_sz() const { return jsc.is_int8 ? 1 : 4; }
+
+    Address a_addr(int v, int p) {
+        return ptr[reg_a + (v * simd_w + (size_t)p * jsc.lda) * a_sz()];
+    }
+    size_t b_off(int p, int j) {
+        return (jsc.transb ? j + (size_t)p * jsc.ldb : p + (size_t)j * jsc.ldb)
+            * a_sz();
+    }
+    Address c_addr(int v, int j) {
+        return ptr[reg_c + (v * simd_w + (size_t)j * jsc.ldc) * 4];
+    }
+
+    void load(const Vmm &vmm, const Address &addr, bool tail) {
+        if (!tail)
+            uni_vmovups(vmm, addr);
+        else if (isa == avx512_common)
+            vmovups(vmm | k_tail | T_z, addr);
+        else
+            vmaskmovps(vmm, vmm_mask(), addr);
+    }
+
+    void store(const Address &addr, const Vmm &vmm, bool tail) {
+        if (!tail)
+            uni_vmovups(addr, vmm);
+        else if (isa == avx512_common)
+            vmovups(addr | k_tail, vmm);
+        else
+            vmaskmovps(addr, vmm_mask(), vmm);
+    }
+
+    void load_a(int v, int p, bool tail) {
+        const Vmm va = vmm_a(v % mbv_);
+        if (!jsc.is_int8) {
+            load(va, a_addr(v, p), tail);
+            return;
+        }
+        if (tail)
+            vpmovsxbd(va | k_tail | T_z, a_addr(v, p));
+        else
+            vpmovsxbd(va, a_addr(v, p));
+        if (jsc.with_ao) vpaddd(va, va, vmm_alpha());
+    }
+
+    void compute_block(int v0, int nbv, int j0, int nbj);
+    void store_block(int v0, int nbv, int j0, int nbj);
+    void generate();
+};
+
+template <cpu_isa_t isa>
+void jit_uni_small_gemm_kern<isa>::compute_block(int v0, int nbv, int j0,
+        int nbj) {
+    for (int v = 0; v < nbv; ++v)
+    for (int j = 0; j < nbj; ++j)
+        uni_vpxor(vmm_acc(v, j), vmm_acc(v, j), vmm_acc(v, j));
+
+    for (int p = 0; p < jsc.k; ++p) {
+        for (int v = 0; v < nbv; ++v)
+            load_a(v0 + v, p, is_tail(v0 + v));
+
+        for (int j = 0; j < nbj; ++j) {
+            const size_t off = b_off(p, j0 + j);
+            if (jsc.is_int8) {
+                if (jsc.b_is_s8)
+                    movsx(reg_tmp.cvt32(), byte[reg_b + off]);
+                else
+                    movzx(reg_tmp.cvt32(), byte[reg_b + off]);
+                if (jsc.with_bo) add(reg_tmp.cvt32(), reg_bo.cvt32());
+                vpbroadcastd(vmm_b(), reg_tmp.cvt32());
+                for (int v = 0; v < nbv; ++v) {
+                    vpmulld(vmm_tmp(), vmm_a(v), vmm_b());
+                    vpaddd(vmm_acc(v, j), vmm_acc(v, j), vmm_tmp());
+                }
+            } else if (isa == avx512_common) {
+                for (int v = 0; v < nbv; ++v)
+                    vfmadd231ps(vmm_acc(v, j), vmm_a(v), ptr_b[reg_b + off]);
+            } else {
+                vbroadcastss(vmm_b(), ptr[reg_b + off]);
+                for (int v = 0; v < nbv; ++v)
+                    vfmadd231ps(vmm_acc(v, j), vmm_a(v), vmm_b());
+            }
+        }
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_small_gemm_kern<isa>::store_block(int v0, int nbv, int j0,
+        int nbj) {
+    for (int v = 0; v < nbv; ++v)
+    for (int j = 0; j < nbj; ++j) {
+        const bool tail = is_tail(v0 + v);
+        const Vmm acc = vmm_acc(v, j);
+        const Address c = c_addr(v0 + v, j0 + j);
+
+        if (jsc.is_int8) {
+            if (!jsc.beta_zero) {
+                load(vmm_tmp(), c, tail);
+                vpaddd(acc, acc, vmm_tmp());
+            }
+            switch (jsc.offsetc) {
+            case FIX_OFFSET: vpaddd(acc, acc, vmm_beta()); break;
+            case COL_OFFSET:
+                load(vmm_tmp(), ptr[reg_bias + (v0 + v) * simd_w * 4], tail);
+                vpaddd(acc, acc, vmm_tmp());
+                break;
+            case ROW_OFFSET:
+                vpaddd(acc, acc, ptr_b[reg_bias + (j0 + j) * 4]);
+                break;
+            default: break;
+            }
+        } else {
+            vmulps(acc, acc, vmm_alpha());
+            if (!jsc.beta_zero) {
+                load(vmm_tmp(), c, tail);
+                vfmadd231ps(acc, vmm_tmp(), vmm_beta());
+            }
+            if (jsc.with_bias) {
+                load(vmm_tmp(), ptr[reg_bias + (v0 + v) * simd_w * 4], tail);
+                vaddps(acc, acc, vmm_tmp());
+            }
+        }
+        store(c, acc, tail);
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_small_gemm_kern<isa>::generate() {
+    nv_ = utils::div_up(jsc.m, simd_w);
+    tail_ = jsc.m % simd_w;
+    mbv_ = nstl::min(nv_, isa == avx512_common ? 4 : 2);
+    nb_ = nstl::min(jsc.n, (n_vregs - n_reserved - mbv_) / mbv_);
+
+    preamble();
+
+    mov(reg_a, ptr[reg_param + GET_OFF(a)]);
+    mov(reg_b, ptr[reg_param + GET_OFF(b)]);
+    mov(reg_c, ptr[reg_param + GET_OFF(c)]);
+    mov(reg_bias, ptr[reg_param + GET_OFF(bias)]);
+
+    if (jsc.is_int8) {
+        if (jsc.with_ao)
+            vpbroadcastd(vmm_alpha(), ptr[reg_param + GET_OFF(ao)]);
+        if (jsc.with_bo)
+            mov(reg_bo.cvt32(), dword[reg_param + GET_OFF(bo)]);
+        if (jsc.offsetc == FIX_OFFSET)
+            vpbroadcastd(vmm_beta(), ptr[reg_bias]);
+    } else {
+        mov(reg_tmp, ptr[reg_param + GET_OFF(alpha)]);
+        uni_vbroadcastss(vmm_alpha(), ptr[reg_tmp]);
+        if (!jsc.beta_zero) {
+            mov(reg_tmp, ptr[reg_param + GET_OFF(beta)]);
+            uni_vbroadcastss(vmm_beta(), ptr[reg_tmp]);
+        }
+    }
+
+    if (tail_) {
+        if (isa == avx512_common) {
+            mov(reg_tmp.cvt32(), (1 << tail_) - 1);
+            kmovw(k_tail, reg_tmp.cvt32());
+        } else {
+            mov(reg_tmp, l_tail_mask);
+            vmovups(vmm_mask(), ptr[reg_tmp]);
+        }
+    }
+
+    for (int v0 = 0; v0 < nv_; v0 += mbv_) {
+        const int nbv = nstl::min(mbv_, nv_ - v0);
+        for (int j0 = 0; j0 < jsc.n; j0 += nb_) {
+            const int nbj = nstl::min(nb_, jsc.n - j0);
+            compute_block(v0, nbv, j0, nbj);
+            store_block(v0, nbv, j0, nbj);
+        }
+    }
+
+    postamble();
+
+    if (tail_ && isa != avx512_common) {
+        align(64);
+        L(l_tail_mask);
+        for (int i = 0; i < simd_w; ++i)
+            dd(i < tail_ ? 0xffffffff : 0);
+    }
+}
+
+template struct jit_uni_small_gemm_kern<avx2>;
+template struct jit_uni_small_gemm_kern<avx512_common>;
+
+/* Kernels are shared by all the threads and never freed, like the kernels
+ * of gemm_driver. Each thread keeps its own index of them, so the lock is
+ * only taken the first time a thread meets a shape */
+template <cpu_isa_t isa>
+const jit_uni_small_gemm_kern<isa> *get_kernel(const small_gemm_conf_t &jsc) {
+    using kernel_t = jit_uni_small_gemm_kern<isa>;
+    typedef std::map<small_gemm_conf_t, const kernel_t *> cache_t;
+
+    thread_local static cache_t local_cache;
+    auto it = local_cache.find(jsc);
+    if (it != local_cache.end()) return it->second;
+
+    static std::mutex mutex;
+    static cache_t cache;
+
+    const kernel_t *kernel = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        auto git = cache.find(jsc);
+        if (git != cache.end()) {
+            kernel = git->second;
+        } else {
+            if (cache.size() >= max_cached_kernels) return nullptr;
+            kernel = new kernel_t(jsc);
+            cache[jsc] = kernel;
+        }
+    }
+
+    local_cache[jsc] = kernel;
+    return kernel;
+}
+
+bool is_small(bool transa, bool transb, int m, int n, int k, int lda,
+        int ldb, int ldc, int simd_w, int dt_size) {
+    if (transa) return false;
+    if (m <= 0 || n <= 0 || k <= 0) return false;
+    if (nstl::max(m, nstl::max(n, k)) > max_small_dim) return false;
+    if ((size_t)utils::div_up(m, simd_w) * n * k > max_small_madds)
+        return false;
+
+    /* displacements are encoded in the instructions */
+    const size_t max_disp = INT32_MAX;
+    const size_t a_off = (m + (size_t)(k - 1) * lda) * dt_size;
+    const size_t b_off = (transb ? n + (size_t)(k - 1) * ldb
+            : k + (size_t)(n - 1) * ldb) * dt_size;
+    const size_t c_off = (m + (size_t)(n - 1) * ldc) * sizeof(float);
+    return nstl::max(a_off, nstl::max(b_off, c_off)) < max_disp;
+}
+
+template <cpu_isa_t isa>
+mkldnn_status_t execute(const small_gemm_conf_t &jsc,
+        const small_gemm_call_s &p) {
+    auto kernel = get_kernel<isa>(jsc);
+    if (kernel == nullptr) return mkldnn_unimplemented;
+    (*kernel)(&p);
+    return mkldnn_success;
+}
+
+}
+
+mkldnn_status_t small_sgemm(const char *transa, const char *transb,
+        const int *M, const int *N, const int *K, const float *alpha,
+        const float *A, const int *lda, const float *B, const int *ldb,
+        const float *beta, float *C, const int *ldc, const float *bias) {
+    const cpu_isa_t isa = mayiuse(avx512_common) ? avx512_common
+        : mayiuse(avx2) ? avx2 : isa_any;
+    if (isa == isa_any) return mkldnn_unimplemented;
+
+    const int simd_w = isa == avx512_common
+        ? jit_uni_small_gemm_kern<avx512_common>::simd_w
+        : jit_uni_small_gemm_kern<avx2>::simd_w;
+    const bool trA = utils::one_of(*transa, 'T', 't');
+    const bool trB = utils::one_of(*transb, 'T', 't');
+    if (!is_small(trA, trB, *M, *N, *K, *lda, *ldb, *ldc, simd_w,
+                sizeof(float)))
+        return mkldnn_unimplemented;
+
+    small_gemm_conf_t jsc;
+    std::memset(&jsc, 0, sizeof(jsc));
+    jsc.transb = trB;
+    jsc.m = *M; jsc.n = *N; jsc.k = *K;
+    jsc.lda = *lda; jsc.ldb = *ldb; jsc.ldc = *ldc;
+    jsc.beta_zero = *beta == 0.f;
+    jsc.with_bias = bias != nullptr;
+
+    small_gemm_call_s p;
+    p.a = A; p.b = B; p.c = C;
+    p.bias = bias;
+    p.alpha = alpha; p.beta = beta;
+    p.ao = p.bo = 0;
+
+    return isa == avx512_common
+        ? execute<avx512_common>(jsc, p) : execute<avx2>(jsc, p);
+}
+
+template <typename b_dt>
+mkldnn_status_t small_gemm_s8x8s32(const char *transa, const char *transb,
+        const char *offsetc, const int *M, const int *N, const int *K,
+        const float *alpha, const int8_t *A, const int *lda, const int8_t *ao,
+        const b_dt *B, const int *ldb, const int8_t *bo, const float *beta,
+        int32_t *C, const int *ldc, const int32_t *co) {
+    /* the integer kernels accumulate exactly, without scaling */
+    if (!mayiuse(avx512_common)) return mkldnn_unimplemented;
+    if (*alpha != 1.f || !utils::one_of(*beta, 0.f, 1.f))
+        return mkldnn_unimplemented;
+
+    const bool trA = utils::one_of(*transa, 'T', 't');
+    const bool trB = utils::one_of(*transb, 'T', 't');
+    if (!is_small(trA, trB, *M, *N, *K, *lda, *ldb, *ldc,
+                jit_uni_small_gemm_kern<avx512_common>::simd_w,
+                sizeof(int8_t)))
+        return mkldnn_unimplemented;
+
+    small_gemm_conf_t jsc;
+    std::memset(&jsc, 0, sizeof(jsc));
+    jsc.is_int8 = true;
+    jsc.b_is_s8 = data_traits<b_dt>::data_type == data_type::s8;
+    jsc.transb = trB;
+    jsc.m = *M; jsc.n = *N; jsc.k = *K;
+    jsc.lda = *lda; jsc.ldb = *ldb; jsc.ldc = *ldc;
+    jsc.beta_zero = *beta == 0.f;
+    jsc.offsetc = utils::one_of(*offsetc, 'F', 'f') ? FIX_OFFSET
+        : utils::one_of(*offsetc, 'C', 'c') ? COL_OFFSET : ROW_OFFSET;
+    jsc.with_ao = *ao != 0;
+    jsc.with_bo = *bo != 0;
+
+    small_gemm_call_s p;
+    p.a = A; p.b = B; p.c = C;
+    p.bias = co;
+    p.alpha = alpha; p.beta = beta;
+    p.ao = *ao; p.bo = *bo;
+
+    return execute<avx512_common>(jsc, p);
+}
+
+template mkldnn_status_t small_gemm_s8x8s32<int8_t>(const char *transa,
+        const char *transb, const char *offsetc, const int *M, const int *N,
+        const int *K, const float *alpha, const int8_t *A, const int *lda,
+        const int8_t *ao, const int8_t *B, const int *ldb, const int8_t *bo,
+        const float *beta, int32_t *C, const int *ldc, const int32_t *co);
+
+template mkldnn_status_t small_gemm_s8x8s32<uint8_t>(const char *transa,
+        const char *transb, const char *offsetc, const int *M, const int *N,
+        const int *K, const float *alpha, const int8_t *A, const int *lda,
+        const int8_t *ao, const uint8_t *B, const int *ldb, const int8_t *bo,
+        const float *beta, int32_t *C, const int *ldc, const int32_t *co);
+
+}
+}
+}
@@ -0,0 +1,48 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_UNI_SMALL_GEMM_HPP
+#define JIT_UNI_SMALL_GEMM_HPP
+
+#include <cstdint>
+
+#include "mkldnn_types.h"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Small gemm problems skip the blocking, the copies and the threading of
+ * gemm_driver: a fully unrolled kernel is generated for the exact shape and
+ * cached by it. These return mkldnn_unimplemented if the problem is not small
+ * enough (or not supported), so the caller falls back to the regular path. */
+mkldnn_status_t small_sgemm(const char *transa, const char *transb,
+        const int *M, const int *N, const int *K, const float *alpha,
+        const float *A, const int *lda, const float *B, const int *ldb,
+        const float *beta, float *C, const int *ldc, const float *bias);
+
+template <typename b_dt>
+mkldnn_status_t small_gemm_s8x8s32(const char *transa, const char *transb,
+        const char *offsetc, const int *M, const int *N, const int *K,
+        const float *alpha, const int8_t *A, const int *lda, const int8_t *ao,
+        const b_dt *B, const int *ldb, const int8_t *bo, const float *beta,
+        int32_t *C, const int *ldc, const int32_t *co);
+
+}
+}
+}
+
+#endif // JIT_UNI_SMALL_GEMM_HPP
@@ -48,14 +48,14 @@ class jit_avx512_core_u8_copy_bn_kern : public jit_generator {
     DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_avx512_core_u8_copy_bn_kern);
 
     public:
-        jit_avx512_core_u8_copy_bn_kern();
+        jit_avx512_core_u8_copy_bn_kern(bool s8_case = false);
 };
 
 class jit_avx512_core_u8_copy_bt_kern : public jit_generator {
     DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_avx512_core_u8_copy_bt_kern);
 
     public:
-        jit_avx512_core_u8_copy_bt_kern();
+        jit_avx512_core_u8_copy_bt_kern(bool s8_case = false);
 };
 
 class jit_avx512_core_u8_copy_sum_an_kern : public jit_generator {
@@ -76,14 +76,14 @@ class jit_avx512_core_u8_copy_sum_bn_kern : public jit_generator {
     DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_avx512_core_u8_copy_sum_bn_kern);
 
     public:
-        jit_avx512_core_u8_copy_sum_bn_kern();
+        jit_avx512_core_u8_copy_sum_bn_kern(bool s8_case = false);
 };
 
 class jit_avx512_core_u8_copy_sum_bt_kern : public jit_generator {
     DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_avx512_core_u8_copy_sum_bt_kern);
 
     public:
-        jit_avx512_core_u8_copy_sum_bt_kern();
+        jit_avx512_core_u8_copy_sum_bt_kern(bool s8_case = false);
 };
 
 }
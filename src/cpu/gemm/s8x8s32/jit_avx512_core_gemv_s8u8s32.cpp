@@ -82,6 +82,12 @@ int gemm_s8u8s32_jump_to_gemv_s8u8s32(
     return 0;
 }
 
+// There are no s8s8s32 gemv kernels, the copy based driver handles it.
+template <>
+int gemm_s8u8s32_jump_to_gemv_s8u8s32(
+        gemm_info_t<int8_t, int8_t, int32_t> *arg) {
+    return 0;
+}
 
 int gemv_kernel_driver(gemm_info_t<int8_t, uint8_t, int32_t> *arg) {
 
@@ -21,7 +21,8 @@ namespace mkldnn {
 namespace impl {
 namespace cpu {
 
-jit_avx512_core_u8_copy_bn_kern::jit_avx512_core_u8_copy_bn_kern() :
+jit_avx512_core_u8_copy_bn_kern::jit_avx512_core_u8_copy_bn_kern(
+        bool s8_case) :
     jit_generator(nullptr, U8_COPY_KERNEL_CODE_SIZE) {
 
 #ifndef _WIN32
@@ -93,6 +94,13 @@ Xbyak::Label l688;
 Xbyak::Label l698;
 
 	preamble();
+	if (s8_case) {
+		// s8 B is stored shifted by 128 to feed the u8 compute kernel;
+		// column sums are taken on the unshifted data.
+		mov(eax, 0x80808080);
+		movd(xmm15, eax);
+		pshufd(xmm15, xmm15, 0x0);
+	}
 #ifdef _WIN32
 	auto stacksize = get_size_of_abi_save_regs();
 	mov(ALPHA, ptr[ARG_ALPHA]);
@@ -137,9 +145,13 @@ L(l3c);
 	movdqa(xmm3, xmm4);
 	punpcklqdq(xmm4, xmm5);
 	punpckhqdq(xmm3, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x60], xmm1);
+	if (s8_case) pxor(xmm4, xmm15);
 	movdqu(xword[B-0x40], xmm4);
+	if (s8_case) pxor(xmm3, xmm15);
 	movdqu(xword[B-0x20], xmm3);
 	movdqu(xmm0, xword[A2-0x80]);
 	movdqu(xmm1, xword[A2+LDA*1-0x80]);
@@ -158,9 +170,13 @@ L(l3c);
 	movdqa(xmm3, xmm4);
 	punpcklqdq(xmm4, xmm5);
 	punpckhqdq(xmm3, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x70], xmm0);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x50], xmm1);
+	if (s8_case) pxor(xmm4, xmm15);
 	movdqu(xword[B-0x30], xmm4);
+	if (s8_case) pxor(xmm3, xmm15);
 	movdqu(xword[B-0x10], xmm3);
 	sub(B, -128);
 	dec(I);
@@ -180,7 +196,9 @@ L(l118);
 	movdqa(xmm1, xmm0);
 	punpcklqdq(xmm0, xmm2);
 	punpckhqdq(xmm1, xmm2);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x60], xmm1);
 	movq(xmm0, qword[A2-0x80]);
 	movq(xmm1, qword[A2+LDA*1-0x80]);
@@ -192,7 +210,9 @@ L(l118);
 	movdqa(xmm1, xmm0);
 	punpcklqdq(xmm0, xmm2);
 	punpckhqdq(xmm1, xmm2);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x70], xmm0);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x50], xmm1);
 	sub(B, -64);
 	align(4);
@@ -208,6 +228,7 @@ L(l1a8);
 	punpckldq(xmm0, xmm1);
 	punpckldq(xmm2, xmm3);
 	punpcklqdq(xmm0, xmm2);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	movd(xmm0, dword[A2-0x80]);
 	movd(xmm1, dword[A2+LDA*1-0x80]);
@@ -217,6 +238,7 @@ L(l1a8);
 	punpckldq(xmm0, xmm1);
 	punpckldq(xmm2, xmm3);
 	punpcklqdq(xmm0, xmm2);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x70], xmm0);
 	sub(B, -32);
 	align(4);
@@ -242,6 +264,7 @@ L(l218);
 	mov(ax, word[A2+LDA3*1-0x80]);
 	sub(A2, -2);
 	pinsrw(xmm0, eax, 0x7);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	align(4);
@@ -265,6 +288,7 @@ L(l28c);
 	pinsrb(xmm0, eax, 0x6);
 	mov(al, byte[A2+LDA3*1-0x80]);
 	pinsrb(xmm0, eax, 0x7);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -309,9 +333,13 @@ L(l32c);
 	movdqa(xmm3, xmm4);
 	punpcklqdq(xmm4, xmm5);
 	punpckhqdq(xmm3, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x70], xmm1);
+	if (s8_case) pxor(xmm4, xmm15);
 	movdqu(xword[B-0x60], xmm4);
+	if (s8_case) pxor(xmm3, xmm15);
 	movdqu(xword[B-0x50], xmm3);
 	sub(B, -64);
 	dec(I);
@@ -332,7 +360,9 @@ L(l3a0);
 	movdqa(xmm1, xmm0);
 	punpcklqdq(xmm0, xmm2);
 	punpckhqdq(xmm1, xmm2);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x70], xmm1);
 	sub(B, -32);
 	align(4);
@@ -349,6 +379,7 @@ L(l3f0);
 	punpckldq(xmm0, xmm1);
 	punpckldq(xmm2, xmm3);
 	punpcklqdq(xmm0, xmm2);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	align(4);
@@ -366,6 +397,7 @@ L(l434);
 	mov(ax, word[A2+LDA*1-0x80]);
 	sub(A2, -2);
 	pinsrw(xmm0, eax, 0x3);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -381,6 +413,7 @@ L(l47c);
 	pinsrb(xmm0, eax, 0x2);
 	mov(al, byte[A2+LDA*1-0x80]);
 	pinsrb(xmm0, eax, 0x3);
+	if (s8_case) pxor(xmm0, xmm15);
 	movd(dword[B-0x80], xmm0);
 	sub(B, -4);
 	align(4);
@@ -414,7 +447,9 @@ L(l4f0);
 	movdqa(xmm2, xmm0);
 	punpckldq(xmm0, xmm1);
 	punpckhdq(xmm2, xmm1);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
+	if (s8_case) pxor(xmm2, xmm15);
 	movdqu(xword[B-0x70], xmm2);
 	sub(B, -32);
 	dec(I);
@@ -429,6 +464,7 @@ L(l528);
 	movq(xmm1, qword[A2-0x80]);
 	sub(A2, -8);
 	punpckldq(xmm0, xmm1);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	align(4);
@@ -441,6 +477,7 @@ L(l554);
 	movd(xmm1, dword[A2-0x80]);
 	sub(A2, -4);
 	punpckldq(xmm0, xmm1);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -454,6 +491,7 @@ L(l580);
 	mov(ax, word[A2-0x80]);
 	sub(A2, -2);
 	pinsrw(xmm0, eax, 0x1);
+	if (s8_case) pxor(xmm0, xmm15);
 	movd(dword[B-0x80], xmm0);
 	sub(B, -4);
 	align(4);
@@ -462,8 +500,10 @@ L(l5b0);
 	test(M, 0x1);
 	jle(l5d0, T_NEAR);
 	mov(al, byte[A1-0x80]);
+	if (s8_case) xor_(al, 0x80);
 	mov(byte[B-0x80], al);
 	mov(al, byte[A2-0x80]);
+	if (s8_case) xor_(al, 0x80);
 	mov(byte[B-0x7f], al);
 	sub(B, -2);
 	align(4);
@@ -490,6 +530,7 @@ L(l5e8);
 L(l5f8);
 	movdqu(xmm0, xword[A1-0x80]);
 	sub(A1, -16);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	dec(I);
@@ -501,6 +542,7 @@ L(l614);
 	jle(l634, T_NEAR);
 	movq(xmm0, qword[A1-0x80]);
 	sub(A1, -8);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -510,6 +552,7 @@ L(l634);
 	jle(l654, T_NEAR);
 	movd(xmm0, dword[A1-0x80]);
 	sub(A1, -4);
+	if (s8_case) pxor(xmm0, xmm15);
 	movd(dword[B-0x80], xmm0);
 	sub(B, -4);
 	align(4);
@@ -518,6 +561,7 @@ L(l654);
 	test(M, 0x2);
 	jle(l670, T_NEAR);
 	mov(ax, word[A1-0x80]);
+	if (s8_case) xor_(ax, static_cast<int16_t>(0x8080));
 	mov(word[B-0x80], ax);
 	sub(A1, -2);
 	sub(B, -2);
@@ -527,6 +571,7 @@ L(l670);
 	test(M, 0x1);
 	jle(l688, T_NEAR);
 	mov(al, byte[A1-0x80]);
+	if (s8_case) xor_(al, 0x80);
 	mov(byte[B-0x80], al);
 	sub(B, -1);
 	align(4);
@@ -21,7 +21,8 @@ namespace mkldnn {
 namespace impl {
 namespace cpu {
 
-jit_avx512_core_u8_copy_bt_kern::jit_avx512_core_u8_copy_bt_kern() :
+jit_avx512_core_u8_copy_bt_kern::jit_avx512_core_u8_copy_bt_kern(
+        bool s8_case) :
     jit_generator(nullptr, U8_COPY_KERNEL_CODE_SIZE) {
 
 #ifndef _WIN32
@@ -89,6 +90,13 @@ Xbyak::Label l534;
 Xbyak::Label lcc;
 
 	preamble();
+	if (s8_case) {
+		// s8 B is stored shifted by 128 to feed the u8 compute kernel;
+		// column sums are taken on the unshifted data.
+		mov(eax, 0x80808080);
+		movd(xmm15, eax);
+		pshufd(xmm15, xmm15, 0x0);
+	}
 #ifdef _WIN32
 	auto stacksize = get_size_of_abi_save_regs();
 	mov(ALPHA, ptr[ARG_ALPHA]);
@@ -127,7 +135,9 @@ L(l34);
 	movdqa(xmm1, xmm0);
 	punpcklwd(xmm0, xmm2);
 	punpckhwd(xmm1, xmm2);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x70], xmm1);
 	movq(xmm0, qword[A1-0x80]);
 	add(A1, LDA);
@@ -142,7 +152,9 @@ L(l34);
 	movdqa(xmm1, xmm0);
 	punpcklwd(xmm0, xmm2);
 	punpckhwd(xmm1, xmm2);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x60], xmm0);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x50], xmm1);
 	sub(B, -64);
 	dec(I);
@@ -165,7 +177,9 @@ L(lcc);
 	movdqa(xmm1, xmm0);
 	punpcklwd(xmm0, xmm2);
 	punpckhwd(xmm1, xmm2);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x70], xmm1);
 	sub(B, -32);
 	align(4);
@@ -178,6 +192,7 @@ L(l120);
 	movq(xmm1, qword[A1-0x80]);
 	add(A1, LDA);
 	punpcklbw(xmm0, xmm1);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	align(4);
@@ -187,6 +202,7 @@ L(l14c);
 	jle(l168, T_NEAR);
 	movq(xmm0, qword[A1-0x80]);
 	add(A1, LDA);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -222,6 +238,7 @@ L(l194);
 	punpcklbw(xmm0, xmm1);
 	punpcklbw(xmm2, xmm3);
 	punpcklwd(xmm0, xmm2);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	movd(xmm0, dword[A1-0x80]);
 	add(A1, LDA);
@@ -234,6 +251,7 @@ L(l194);
 	punpcklbw(xmm0, xmm1);
 	punpcklbw(xmm2, xmm3);
 	punpcklwd(xmm0, xmm2);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x70], xmm0);
 	sub(B, -32);
 	dec(I);
@@ -254,6 +272,7 @@ L(l20c);
 	punpcklbw(xmm0, xmm1);
 	punpcklbw(xmm2, xmm3);
 	punpcklwd(xmm0, xmm2);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	align(4);
@@ -266,6 +285,7 @@ L(l250);
 	movd(xmm1, dword[A1-0x80]);
 	add(A1, LDA);
 	punpcklbw(xmm0, xmm1);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -274,6 +294,7 @@ L(l27c);
 	test(M, 0x1);
 	jle(l298, T_NEAR);
 	movd(xmm0, dword[A1-0x80]);
+	if (s8_case) pxor(xmm0, xmm15);
 	movd(dword[B-0x80], xmm0);
 	sub(B, -4);
 	align(4);
@@ -329,6 +350,7 @@ L(l2c8);
 	punpcklbw(xmm3, xmm4);
 	punpcklwd(xmm1, xmm3);
 	punpcklqdq(xmm0, xmm1);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	dec(LDA3);
@@ -353,6 +375,7 @@ L(l360);
 	punpcklbw(xmm0, xmm1);
 	punpcklbw(xmm2, xmm3);
 	punpcklwd(xmm0, xmm2);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -367,6 +390,7 @@ L(l3b4);
 	add(A1, LDA);
 	pinsrw(xmm1, eax, 0x0);
 	punpcklbw(xmm0, xmm1);
+	if (s8_case) pxor(xmm0, xmm15);
 	movd(dword[B-0x80], xmm0);
 	sub(B, -4);
 	align(4);
@@ -375,6 +399,7 @@ L(l3e8);
 	test(M, 0x1);
 	jle(l400, T_NEAR);
 	mov(ax, word[A1-0x80]);
+	if (s8_case) xor_(ax, static_cast<int16_t>(0x8080));
 	mov(word[B-0x80], ax);
 	sub(B, -2);
 	align(4);
@@ -423,6 +448,7 @@ L(l428);
 	mov(al, byte[A1-0x80]);
 	add(A1, LDA);
 	pinsrb(xmm0, eax, 0x7);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	dec(LDA3);
@@ -444,6 +470,7 @@ L(l4a0);
 	mov(al, byte[A1-0x80]);
 	add(A1, LDA);
 	pinsrb(xmm0, eax, 0x3);
+	if (s8_case) pxor(xmm0, xmm15);
 	movd(dword[B-0x80], xmm0);
 	sub(B, -4);
 	align(4);
@@ -453,9 +480,11 @@ L(l4e8);
 	jle(l50c, T_NEAR);
 	mov(al, byte[A1-0x80]);
 	add(A1, LDA);
+	if (s8_case) xor_(al, 0x80);
 	mov(byte[B-0x80], al);
 	mov(al, byte[A1-0x80]);
 	add(A1, LDA);
+	if (s8_case) xor_(al, 0x80);
 	mov(byte[B-0x7f], al);
 	sub(B, -2);
 	align(4);
@@ -464,6 +493,7 @@ L(l50c);
 	test(M, 0x1);
 	jle(l524, T_NEAR);
 	mov(al, byte[A1-0x80]);
+	if (s8_case) xor_(al, 0x80);
 	mov(byte[B-0x80], al);
 	sub(B, -1);
 	align(4);
@@ -21,7 +21,8 @@ namespace mkldnn {
 namespace impl {
 namespace cpu {
 
-jit_avx512_core_u8_copy_sum_bn_kern::jit_avx512_core_u8_copy_sum_bn_kern() :
+jit_avx512_core_u8_copy_sum_bn_kern::jit_avx512_core_u8_copy_sum_bn_kern(
+        bool s8_case) :
     jit_generator(nullptr, U8_COPY_KERNEL_CODE_SIZE) {
 
 #ifndef _WIN32
@@ -96,6 +97,13 @@ Xbyak::Label lb38;
 Xbyak::Label lb58;
 
 	preamble();
+	if (s8_case) {
+		// s8 B is stored shifted by 128 to feed the u8 compute kernel;
+		// column sums are taken on the unshifted data.
+		mov(eax, 0x80808080);
+		movd(xmm15, eax);
+		pshufd(xmm15, xmm15, 0x0);
+	}
 	auto stacksize = get_size_of_abi_save_regs();
 #ifdef _WIN32
 	mov(ALPHA, ptr[ARG_ALPHA]);
@@ -149,6 +157,7 @@ L(l48);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm8, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	pmovsxbw(xmm5, xmm1);
 	movhlps(xmm6, xmm1);
@@ -157,6 +166,7 @@ L(l48);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm8, xmm5);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x60], xmm1);
 	pmovsxbw(xmm5, xmm4);
 	movhlps(xmm6, xmm4);
@@ -165,6 +175,7 @@ L(l48);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm8, xmm5);
+	if (s8_case) pxor(xmm4, xmm15);
 	movdqu(xword[B-0x40], xmm4);
 	pmovsxbw(xmm5, xmm3);
 	movhlps(xmm6, xmm3);
@@ -173,6 +184,7 @@ L(l48);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm8, xmm5);
+	if (s8_case) pxor(xmm3, xmm15);
 	movdqu(xword[B-0x20], xmm3);
 	movdqu(xmm0, xword[A2-0x80]);
 	movdqu(xmm1, xword[A2+LDA*1-0x80]);
@@ -198,6 +210,7 @@ L(l48);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm9, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x70], xmm0);
 	pmovsxbw(xmm5, xmm1);
 	movhlps(xmm6, xmm1);
@@ -206,6 +219,7 @@ L(l48);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm9, xmm5);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x50], xmm1);
 	pmovsxbw(xmm5, xmm4);
 	movhlps(xmm6, xmm4);
@@ -214,6 +228,7 @@ L(l48);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm9, xmm5);
+	if (s8_case) pxor(xmm4, xmm15);
 	movdqu(xword[B-0x30], xmm4);
 	pmovsxbw(xmm5, xmm3);
 	movhlps(xmm6, xmm3);
@@ -222,6 +237,7 @@ L(l48);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm9, xmm5);
+	if (s8_case) pxor(xmm3, xmm15);
 	movdqu(xword[B-0x10], xmm3);
 	sub(B, -128);
 	dec(I);
@@ -248,6 +264,7 @@ L(l22c);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm8, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	pmovsxbw(xmm5, xmm1);
 	movhlps(xmm6, xmm1);
@@ -256,6 +273,7 @@ L(l22c);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm8, xmm5);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x60], xmm1);
 	movq(xmm0, qword[A2-0x80]);
 	movq(xmm1, qword[A2+LDA*1-0x80]);
@@ -274,6 +292,7 @@ L(l22c);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm9, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x70], xmm0);
 	pmovsxbw(xmm5, xmm1);
 	movhlps(xmm6, xmm1);
@@ -282,6 +301,7 @@ L(l22c);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm9, xmm5);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x50], xmm1);
 	sub(B, -64);
 	align(4);
@@ -304,6 +324,7 @@ L(l340);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm8, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	movd(xmm0, dword[A2-0x80]);
 	movd(xmm1, dword[A2+LDA*1-0x80]);
@@ -320,6 +341,7 @@ L(l340);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm9, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x70], xmm0);
 	sub(B, -32);
 	align(4);
@@ -354,6 +376,7 @@ L(l3f8);
 	phaddw(xmm6, xmm6);
 	pmovsxwd(xmm6, xmm6);
 	paddd(xmm9, xmm6);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	align(4);
@@ -382,6 +405,7 @@ L(l498);
 	pmovsxbd(xmm6, xmm6);
 	paddd(xmm8, xmm5);
 	paddd(xmm9, xmm6);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -438,6 +462,7 @@ L(l56c);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	pmovsxbw(xmm5, xmm1);
 	movhlps(xmm6, xmm1);
@@ -446,6 +471,7 @@ L(l56c);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x70], xmm1);
 	pmovsxbw(xmm5, xmm4);
 	movhlps(xmm6, xmm4);
@@ -454,6 +480,7 @@ L(l56c);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm4, xmm15);
 	movdqu(xword[B-0x60], xmm4);
 	pmovsxbw(xmm5, xmm3);
 	movhlps(xmm6, xmm3);
@@ -462,6 +489,7 @@ L(l56c);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm3, xmm15);
 	movdqu(xword[B-0x50], xmm3);
 	sub(B, -64);
 	dec(I);
@@ -489,6 +517,7 @@ L(l664);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	pmovsxbw(xmm5, xmm1);
 	movhlps(xmm6, xmm1);
@@ -497,6 +526,7 @@ L(l664);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x70], xmm1);
 	sub(B, -32);
 	align(4);
@@ -520,6 +550,7 @@ L(l6f8);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	align(4);
@@ -541,6 +572,7 @@ L(l75c);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -558,6 +590,7 @@ L(l7b4);
 	pinsrb(xmm0, eax, 0x3);
 	pmovsxbd(xmm5, xmm0);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movd(dword[B-0x80], xmm0);
 	sub(B, -4);
 	align(4);
@@ -604,6 +637,7 @@ L(l848);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	pshufd(xmm6, xmm2, 0xd8);
 	pmovsxbw(xmm5, xmm6);
@@ -614,6 +648,7 @@ L(l848);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm2, xmm15);
 	movdqu(xword[B-0x70], xmm2);
 	sub(B, -32);
 	dec(I);
@@ -637,6 +672,7 @@ L(l8d8);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	align(4);
@@ -654,6 +690,7 @@ L(l930);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -671,6 +708,7 @@ L(l974);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movd(dword[B-0x80], xmm0);
 	sub(B, -4);
 	align(4);
@@ -680,9 +718,11 @@ L(l9b8);
 	jle(l9ec, T_NEAR);
 	mov(al, byte[A1-0x80]);
 	pinsrb(xmm0, eax, 0x0);
+	if (s8_case) xor_(al, 0x80);
 	mov(byte[B-0x80], al);
 	mov(al, byte[A2-0x80]);
 	pinsrb(xmm0, eax, 0x1);
+	if (s8_case) xor_(al, 0x80);
 	mov(byte[B-0x7f], al);
 	sub(B, -2);
 	pmovsxbd(xmm5, xmm0);
@@ -724,6 +764,7 @@ L(la28);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	dec(I);
@@ -741,6 +782,7 @@ L(la6c);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -755,6 +797,7 @@ L(laa8);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movd(dword[B-0x80], xmm0);
 	sub(B, -4);
 	align(4);
@@ -768,6 +811,7 @@ L(lae0);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) xor_(ax, static_cast<int16_t>(0x8080));
 	mov(word[B-0x80], ax);
 	sub(A1, -2);
 	sub(B, -2);
@@ -780,6 +824,7 @@ L(lb14);
 	pinsrb(xmm0, eax, 0x0);
 	pmovsxbd(xmm5, xmm0);
 	paddd(xmm7, xmm5);
+	if (s8_case) xor_(al, 0x80);
 	mov(byte[B-0x80], al);
 	sub(B, -1);
 	align(4);
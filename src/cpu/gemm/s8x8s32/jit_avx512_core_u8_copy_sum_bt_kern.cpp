@@ -21,7 +21,8 @@ namespace mkldnn {
 namespace impl {
 namespace cpu {
 
-jit_avx512_core_u8_copy_sum_bt_kern::jit_avx512_core_u8_copy_sum_bt_kern() :
+jit_avx512_core_u8_copy_sum_bt_kern::jit_avx512_core_u8_copy_sum_bt_kern(
+        bool s8_case) :
     jit_generator(nullptr, U8_COPY_KERNEL_CODE_SIZE) {
 
 #ifndef _WIN32
@@ -92,6 +93,13 @@ Xbyak::Label l7c8;
 Xbyak::Label l7e8;
 
 	preamble();
+	if (s8_case) {
+		// s8 B is stored shifted by 128 to feed the u8 compute kernel;
+		// column sums are taken on the unshifted data.
+		mov(eax, 0x80808080);
+		movd(xmm15, eax);
+		pshufd(xmm15, xmm15, 0x0);
+	}
 	auto stacksize = get_size_of_abi_save_regs();
 #ifdef _WIN32
 	mov(ALPHA, ptr[ARG_ALPHA]);
@@ -146,7 +154,9 @@ L(l40);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm9, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x70], xmm1);
 	movq(xmm0, qword[A1-0x80]);
 	add(A1, LDA);
@@ -175,7 +185,9 @@ L(l40);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm9, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x60], xmm0);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x50], xmm1);
 	sub(B, -64);
 	dec(I);
@@ -212,7 +224,9 @@ L(l15c);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm9, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
+	if (s8_case) pxor(xmm1, xmm15);
 	movdqu(xword[B-0x70], xmm1);
 	sub(B, -32);
 	align(4);
@@ -234,6 +248,7 @@ L(l1f4);
 	phaddw(xmm6, xmm6);
 	pmovsxwd(xmm6, xmm6);
 	paddd(xmm9, xmm6);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	align(4);
@@ -248,6 +263,7 @@ L(l248);
 	pmovsxbd(xmm6, xmm6);
 	paddd(xmm8, xmm5);
 	paddd(xmm9, xmm6);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -295,6 +311,7 @@ L(l2c8);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	movd(xmm0, dword[A1-0x80]);
 	add(A1, LDA);
@@ -314,6 +331,7 @@ L(l2c8);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x70], xmm0);
 	sub(B, -32);
 	dec(I);
@@ -341,6 +359,7 @@ L(l384);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	align(4);
@@ -357,6 +376,7 @@ L(l3e8);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -367,6 +387,7 @@ L(l424);
 	movd(xmm0, dword[A1-0x80]);
 	pmovsxbd(xmm5, xmm0);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movd(dword[B-0x80], xmm0);
 	sub(B, -4);
 	align(4);
@@ -435,6 +456,7 @@ L(l48c);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movdqu(xword[B-0x80], xmm0);
 	sub(B, -16);
 	dec(LDA3);
@@ -464,6 +486,7 @@ L(l550);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	align(4);
@@ -482,6 +505,7 @@ L(l5bc);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movd(dword[B-0x80], xmm0);
 	sub(B, -4);
 	align(4);
@@ -493,6 +517,7 @@ L(l600);
 	pinsrw(xmm0, eax, 0x0);
 	pmovsxbd(xmm5, xmm0);
 	paddd(xmm7, xmm5);
+	if (s8_case) xor_(ax, static_cast<int16_t>(0x8080));
 	mov(word[B-0x80], ax);
 	sub(B, -2);
 	align(4);
@@ -551,6 +576,7 @@ L(l668);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movq(qword[B-0x80], xmm0);
 	sub(B, -8);
 	dec(LDA3);
@@ -577,6 +603,7 @@ L(l700);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) pxor(xmm0, xmm15);
 	movd(dword[B-0x80], xmm0);
 	sub(B, -4);
 	align(4);
@@ -587,6 +614,7 @@ L(l760);
 	mov(al, byte[A1-0x80]);
 	add(A1, LDA);
 	pinsrb(xmm0, eax, 0x0);
+	if (s8_case) xor_(al, 0x80);
 	mov(byte[B-0x80], al);
 	mov(al, byte[A1-0x80]);
 	add(A1, LDA);
@@ -595,6 +623,7 @@ L(l760);
 	phaddw(xmm5, xmm5);
 	pmovsxwd(xmm5, xmm5);
 	paddd(xmm7, xmm5);
+	if (s8_case) xor_(al, 0x80);
 	mov(byte[B-0x7f], al);
 	sub(B, -2);
 	align(4);
@@ -606,6 +635,7 @@ L(l7a4);
 	pinsrw(xmm0, eax, 0x0);
 	pmovsxbd(xmm5, xmm0);
 	paddd(xmm7, xmm5);
+	if (s8_case) xor_(al, 0x80);
 	mov(byte[B-0x80], al);
 	sub(B, -1);
 	align(4);
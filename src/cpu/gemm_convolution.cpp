@@ -21,7 +21,6 @@
 #include "utils.hpp"
 #include "type_helpers.hpp"
 #include "mkldnn_thread.hpp"
-#include "ref_eltwise.hpp"
 
 namespace mkldnn {
 namespace impl {
@@ -91,44 +90,17 @@ void gemm_convolution_fwd_t::execute_forward(const exec_ctx_t &ctx) const {
             const int LDA = jcp.im2col_sz ? m : M;
             data_t *_dst = _dst_im + od * jcp.os + oh * jcp.ow + ow;
 
-            extended_sgemm("N", "N", &m, &N, &K, &one,
-                    jcp.im2col_sz ? _col : _src + od * m, &LDA, _weights, &K,
-                    &this->beta_, _dst, &M);
-
-            data_t *d = _dst;
-            if (eltwise_) {
-                // fast branch for ReLU case
-                if (eltwise_->alg_ == alg_kind::eltwise_relu) {
-                    parallel_nd(jcp.oc, [&](const int oc) {
-                        data_t b = jcp.with_bias ? bias[g * jcp.oc + oc] : 0;
-                        data_t *d_ = d + oc * M;
-                        PRAGMA_OMP_SIMD()
-                        for (int oS = 0; oS < m; ++oS) {
-                            d_[oS] += b;
-                            if (d_[oS] < 0) d_[oS] *= eltwise_->alpha_;
-                        }
-                    });
-                } else {
-                    parallel_nd(jcp.oc, [&](const int oc) {
-                        data_t b = jcp.with_bias ? bias[g * jcp.oc + oc] : 0;
-                        data_t *d_ = d + oc * M;
-                        PRAGMA_OMP_SIMD()
-                        for (int oS = 0; oS < m; ++oS) {
-                            d_[oS] += b;
-                            d_[oS] = eltwise_->compute_scalar(d_[oS]);
-                        }
-                    });
-                }
-            } else if (jcp.with_bias) {
-                parallel_nd(jcp.oc, [&](const int oc) {
-                    data_t b = bias[g * jcp.oc + oc];
-                    data_t *d_ = d + oc * M;
-                    PRAGMA_OMP_SIMD()
-                    for (int oS = 0; oS < m; ++oS) {
-                        d_[oS] += b;
-                    }
-                });
-            }
+            if (epilogue_)
+                extended_sgemm("N", "N", &m, &N, &K, &one,
+                        jcp.im2col_sz ? _col : _src + od * m, &LDA, _weights,
+                        &K, &this->beta_, _dst, &M,
+                        jcp.with_bias ? bias + g * jcp.oc : nullptr,
+                        *epilogue_);
+            else
+                extended_sgemm("N", "N", &m, &N, &K, &one,
+                        jcp.im2col_sz ? _col : _src + od * m, &LDA, _weights,
+                        &K, &this->beta_, _dst, &M);
+
             nd_iterator_step(g, jcp.ngroups, n, jcp.mb, od, jcp.od, ohb, nb_oh,
                     owb, nb_ow);
         }
@@ -159,7 +131,8 @@ void gemm_convolution_bwd_data_t::execute_backward_data(
 
     if (jcp.id > 1) {
         const ptrdiff_t diff_src_sz = (ptrdiff_t)(work_amount * src_step);
-        parallel_nd(diff_src_sz, [&](ptrdiff_t i) { diff_src[i] = (data_t)0; });
+        parallel_nd_cost(1, diff_src_sz,
+                [&](ptrdiff_t i) { diff_src[i] = (data_t)0; });
     }
 
     parallel(jcp.nthr, [&](const int ithr, const int nthr) {
@@ -283,7 +256,8 @@ void gemm_convolution_bwd_weights_t::execute_backward_weights(
     });
 
     if (jcp.with_bias) {
-        parallel_nd(jcp.ngroups, jcp.oc, [&](int g, int oc) {
+        const size_t oc_cost = (size_t)jcp.mb * jcp.od * jcp.oh * jcp.ow;
+        parallel_nd_cost(oc_cost, jcp.ngroups, jcp.oc, [&](int g, int oc) {
             data_t db = 0;
             size_t offset_ = (size_t)g * dst_step + (size_t)oc * K;
             for (int mb = 0; mb < jcp.mb; ++mb)
@@ -22,9 +22,10 @@
 
 #include "gemm_convolution_utils.hpp"
 #include "gemm/gemm.hpp"
-#include "ref_eltwise.hpp"
+#include "gemm/f32/gemm_epilogue_f32.hpp"
 
 #include "cpu_convolution_pd.hpp"
+#include "cpu_primitive.hpp"
 
 namespace mkldnn {
 namespace impl {
@@ -79,7 +80,8 @@ struct gemm_convolution_fwd_t: public cpu_primitive_t {
             auto const &po = attr()->post_ops_;
             auto is_eltwise = [&](int idx)
             { return po.entry_[idx].is_eltwise(); };
-            auto is_sum = [&](int idx) { return po.entry_[idx].is_sum(); };
+            auto is_sum = [&](int idx)
+            { return po.entry_[idx].is_sum(false); };
 
             switch (po.len_) {
             case 0: return true; // no post_ops
@@ -93,18 +95,22 @@ struct gemm_convolution_fwd_t: public cpu_primitive_t {
 
     gemm_convolution_fwd_t(const pd_t *apd)
         : cpu_primitive_t(apd, true)
-        , eltwise_(nullptr)
+        , epilogue_(nullptr)
     {
         const auto &post_ops = pd()->attr()->post_ops_;
-        const data_t one = 1.0, zero = 0.0;
-        beta_ = post_ops.find(primitive_kind::sum) >= 0 ? one : zero;
-
-        const int entry_idx = post_ops.find(primitive_kind::eltwise);
-        if (entry_idx != -1) eltwise_ = new ref_eltwise_scalar_fwd_t(
-                post_ops.entry_[entry_idx].eltwise);
+        const int sum_idx = post_ops.find(primitive_kind::sum);
+        beta_ = sum_idx >= 0 ? post_ops.entry_[sum_idx].sum.scale : 0.f;
+
+        /* bias and eltwise are applied by gemm to the blocks of dst it
+         * computes, the bias being per column (output channel) */
+        const int eltwise_idx = post_ops.find(primitive_kind::eltwise);
+        if (pd()->with_bias() || eltwise_idx >= 0)
+            epilogue_ = new gemm_epilogue_f32_t(pd()->with_bias(), 'R',
+                    eltwise_idx >= 0
+                    ? &post_ops.entry_[eltwise_idx].eltwise : nullptr);
     }
 
-    ~gemm_convolution_fwd_t() { delete eltwise_; }
+    ~gemm_convolution_fwd_t() { delete epilogue_; }
 
     typedef typename prec_traits<data_type::f32>::type data_t;
 
@@ -119,7 +125,7 @@ private:
 
     data_t beta_;
 
-    ref_eltwise_scalar_fwd_t* eltwise_;
+    gemm_epilogue_f32_t *epilogue_;
 };
 
 struct gemm_convolution_bwd_data_t: public cpu_primitive_t {
@@ -225,6 +225,8 @@ void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
         T *__restrict imtr, uint8_t *__restrict col, int hs, int hb, int ws,
         int wb) {
     uint8_t shift = jcp.signed_input ? 128 : 0;
+    // padded area corresponds to the source zero point
+    uint8_t pad = (uint8_t)(shift + jcp.src_zero_point);
     const int dh = 1 + jcp.dilate_h;
     const int dw = 1 + jcp.dilate_w;
     const int sh = jcp.stride_h;
@@ -282,23 +284,23 @@ void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
                     for (int oh = 0; oh < oh_start; oh++) {
                         const ptrdiff_t col_idx_oh = col_idx_ic + oh * wb;
                         for (int ow = 0; ow < wb; ++ow)
-                            col[col_idx_oh + ow] = shift;
+                            col[col_idx_oh + ow] = pad;
                     }
                     for (int oh = oh_start; oh < oh_end; oh++) {
                         const ptrdiff_t col_idx_oh = col_idx_ic + oh * wb;
                         const ptrdiff_t imtr_idx_oh = imtr_idx_ic + oh * iwb;
                         for (int ow = 0; ow < ow_start; ++ow)
-                            col[col_idx_oh + ow] = shift;
+                            col[col_idx_oh + ow] = pad;
                         for (int ow = ow_start; ow < ow_end; ++ow)
                             col[col_idx_oh + ow]
                                     = imtr[imtr_idx_oh + ow] + shift;
                         for (int ow = ow_end; ow < wb; ++ow)
-                            col[col_idx_oh + ow] = shift;
+                            col[col_idx_oh + ow] = pad;
                     }
                     for (int oh = oh_end; oh < hb; oh++) {
                         const ptrdiff_t col_idx_oh = col_idx_ic + oh * wb;
                         for (int ow = 0; ow < wb; ++ow)
-                            col[col_idx_oh + ow] = shift;
+                            col[col_idx_oh + ow] = pad;
                     }
                 }
             }
@@ -312,14 +314,14 @@ void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
                         = (((kh * jcp.kw + kw) * jcp.ic + ic) * hb + oh) * wb;
                 if (ih < 0 || ih >= jcp.ih)
                     for (int ow = 0; ow < wb; ow++)
-                        col[col_idx_base + ow] = shift;
+                        col[col_idx_base + ow] = pad;
                 else {
                     const int wp = lp - kw * dw;
                     const int ow_start = limit(0, wb, div_up(wp, sw) - ws);
                     const int ow_end
                             = limit(0, wb, div_up(jcp.iw + wp, sw) - ws);
                     for (int ow = 0; ow < ow_start; ow++)
-                        col[col_idx_base + ow] = shift;
+                        col[col_idx_base + ow] = pad;
                     const int iw_base = ws * sw - wp;
                     const ptrdiff_t im_idx_base = ih * im_ih_stride + ic;
                     for (int ow = ow_start; ow < ow_end; ow++) {
@@ -329,7 +331,7 @@ void im2col_u8(const jit_gemm_conv_conf_t &jcp, const T *__restrict im,
                         col[col_idx_base + ow] = im[im_idx] + shift;
                     }
                     for (int ow = ow_end; ow < wb; ow++)
-                        col[col_idx_base + ow] = shift;
+                        col[col_idx_base + ow] = pad;
                 }
             });
     }
@@ -518,6 +520,7 @@ status_t init_conf(jit_gemm_conv_conf_t &jcp,
     jcp.ks = jcp.kh * jcp.kw * jcp.kd;
 
     jcp.signed_input = src_d.data_type() == data_type::s8;
+    jcp.src_zero_point = 0;
 
     jcp.im2col_sz = !everyone_is(true,
             jcp.ow == jcp.iw, jcp.oh == jcp.ih, jcp.od == jcp.id,
@@ -45,21 +45,14 @@ void gemm_inner_product_fwd_t<data_type>::execute_forward(
     bool wei_tr = !memory_desc_matches_one_of_tag(
             *pd()->weights_md(), hwio, dhwio, io);
 
-    const auto &post_ops = pd()->attr()->post_ops_;
-    const bool do_relu = post_ops.len_ == 1;
-
-    float alpha = 1.0, beta = 0.0;
-    extended_sgemm(wei_tr ? "T" : "N", "N", &OC, &MB, &IC, &alpha, weights,
-            wei_tr ? &IC : &OC, src, &IC, &beta, dst, &OC, bias);
-
-    if (do_relu) {
-        float nslope = post_ops.entry_[0].eltwise.alpha;
-        parallel_nd(MB, OC, [&](int mb, int oc) {
-            size_t dst_off = mb * OC + oc;
-            if (dst[dst_off] < 0)
-                dst[dst_off] *= nslope;
-        });
-    }
+    float alpha = 1.0;
+    if (epilogue_)
+        extended_sgemm(wei_tr ? "T" : "N", "N", &OC, &MB, &IC, &alpha,
+                weights, wei_tr ? &IC : &OC, src, &IC, &beta_, dst, &OC,
+                bias, *epilogue_);
+    else
+        extended_sgemm(wei_tr ? "T" : "N", "N", &OC, &MB, &IC, &alpha,
+                weights, wei_tr ? &IC : &OC, src, &IC, &beta_, dst, &OC);
 }
 
 template <impl::data_type_t data_type>
@@ -114,7 +107,8 @@ void gemm_inner_product_bwd_weights_t<data_type>::execute_backward_weights(
         constexpr int blksize = 8;
         const int OC_blocks = OC / blksize;
         const int rem_OC = OC % blksize;
-        parallel(0, [&](const int ithr, const int nthr) {
+        const int nthr = nthr_for_work(OC_blocks, (size_t)MB * blksize);
+        parallel(nthr, [&](const int ithr, const int nthr) {
             int oc_st{0}, oc_e{0};
             balance211(OC_blocks, nthr, ithr, oc_st, oc_e);
             oc_st = oc_st * blksize;
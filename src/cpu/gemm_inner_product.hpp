@@ -24,6 +24,7 @@
 #include "utils.hpp"
 
 #include "gemm/gemm.hpp"
+#include "gemm/f32/gemm_epilogue_f32.hpp"
 
 #include "cpu_inner_product_pd.hpp"
 #include "cpu_primitive.hpp"
@@ -52,16 +53,49 @@ struct gemm_inner_product_fwd_t: public cpu_primitive_t {
                         dst_md()->data_type,
                         with_bias() ? weights_md(1)->data_type : data_type)
                 && attr()->output_scales_.has_default_values()
-                && attr()->post_ops_.len_ <= 1
-                && IMPLICATION(attr()->post_ops_.len_ == 1,
-                        attr()->post_ops_.entry_[0].is_relu(true, false))
+                && attr()->zero_points_default()
+                && post_ops_ok()
                 && dense_gemm_consitency_check(src_md(), weights_md(),
                         dst_md());
             return ok ? status::success : status::unimplemented;
         }
+
+    protected:
+        bool post_ops_ok() const {
+            auto const &po = attr()->post_ops_;
+            auto is_eltwise = [&](int idx)
+            { return po.entry_[idx].is_eltwise(); };
+            auto is_sum = [&](int idx)
+            { return po.entry_[idx].is_sum(false); };
+
+            switch (po.len_) {
+            case 0: return true; // no post_ops
+            case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
+            case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
+            default: return false;
+            }
+            return false;
+        }
     };
 
-    gemm_inner_product_fwd_t(const pd_t *apd): cpu_primitive_t(apd) {}
+    gemm_inner_product_fwd_t(const pd_t *apd)
+        : cpu_primitive_t(apd), epilogue_(nullptr)
+    {
+        const auto &post_ops = pd()->attr()->post_ops_;
+        const int sum_idx = post_ops.find(primitive_kind::sum);
+        beta_ = sum_idx >= 0 ? post_ops.entry_[sum_idx].sum.scale : 0.f;
+
+        /* bias and eltwise are applied by gemm to the blocks of dst it
+         * computes, the bias being per row (output channel) */
+        const int eltwise_idx = post_ops.find(primitive_kind::eltwise);
+        if (pd()->with_bias() || eltwise_idx >= 0)
+            epilogue_ = new gemm_epilogue_f32_t(pd()->with_bias(), 'C',
+                    eltwise_idx >= 0
+                    ? &post_ops.entry_[eltwise_idx].eltwise : nullptr);
+    }
+
+    ~gemm_inner_product_fwd_t() { delete epilogue_; }
+
     typedef typename prec_traits<data_type>::type data_t;
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
@@ -72,6 +106,10 @@ struct gemm_inner_product_fwd_t: public cpu_primitive_t {
 private:
     void execute_forward(const exec_ctx_t &ctx) const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    float beta_;
+
+    gemm_epilogue_f32_t *epilogue_;
 };
 
 template <impl::data_type_t data_type>
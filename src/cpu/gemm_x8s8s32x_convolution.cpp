@@ -22,6 +22,7 @@
 
 #include "simple_q10n.hpp"
 
+#include "cpu_zero_points_utils.hpp"
 #include "gemm/gemm.hpp"
 #include "gemm_x8s8s32x_convolution.hpp"
 
@@ -49,9 +50,32 @@ execute_forward(const exec_ctx_t &ctx) const {
             jcp.id != 1, jcp.oh_block == jcp.oh && jcp.ow_block == jcp.ow));
     assert(IMPLICATION(jcp.ow_block != jcp.ow, jcp.oh_block == 1));
 
+    if (jcp.src_zero_point) {
+        const auto wei_md = memory_desc_wrapper(pd()->weights_md(0));
+        const ptrdiff_t offset
+            = (ptrdiff_t)jcp.ngroups * jcp.ks * jcp.ic * jcp.oc;
+        const int32_t *s8s8_comp = jcp.signed_input
+            ? (const int32_t *)(wei_base + offset) : nullptr;
+        zero_points_utils::compute_compensation(
+                scratchpad.get<int32_t>(key_conv_zp_compensation), s8s8_comp,
+                zero_points_utils::asymmetric_compensation(wei_md, wei_base),
+                jcp.src_zero_point, jcp.ngroups * jcp.oc);
+    }
+
+    const float *scales = output_scales(ctx);
+
+    const auto &post_ops = pd()->attr()->post_ops_;
+    float nslope = 0;
+    for (int idx = 0; idx < post_ops.len_; ++idx) {
+        if (post_ops.entry_[idx].is_relu(true, false)) {
+            nslope = post_op_eltwise(ctx, idx).alpha;
+            break;
+        }
+    }
+
     parallel(jcp.nthr, [&](const int ithr, const int nthr) {
         execute_forward_thr(ithr, nthr, src_base, wei_base, bia_base, dst_base,
-                scratchpad);
+                scales, nslope, scratchpad);
     });
 }
 
@@ -68,6 +92,8 @@ _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::pp_ker_t(
     , do_bias_(false)
     , do_relu_(false)
     , do_sum_(false)
+    , dst_zp_idx_mult_(0)
+    , do_dst_zero_point_(false)
 {
     using namespace types;
 
@@ -92,6 +118,11 @@ _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::pp_ker_t(
 
     do_sum_ = post_ops.contain(primitive_kind::sum, 0);
     do_bias_ = pd->with_bias();
+
+    const auto &dst_zp = pd->attr()->zero_points_dst_;
+    do_dst_zero_point_ = !dst_zp.has_default_values();
+    dst_zp_idx_mult_ = (dst_zp.mask_ == (1 << 1));
+
     bias_data_type_ = pd->desc()->bias_desc.data_type;
     if (do_bias_) {
         assert(bias_data_type_ != data_type::undef);
@@ -126,6 +157,7 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::generate()
     Reg64 reg_acc = rax;
     Reg64 reg_bias = rbx;
     Reg64 reg_scales = rsi;
+    Reg64 reg_dst_zp = r12;
 
     Reg64 reg_len = r8;
     Reg64 reg_tmp = rcx; // intentional for shifting purposes
@@ -143,6 +175,7 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::generate()
     Zmm vreg_nslope = Zmm(2);
     Zmm vreg_sum_scale = Zmm(3);
     Zmm vreg_signed_scale = Zmm(4);
+    Zmm vreg_dst_zp = Zmm(29);
 
     size_t def_unroll = 4;
     size_t max_unroll = 12;
@@ -171,6 +204,13 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::generate()
     mov(reg_scales, ptr[reg_param + PARAM_OFF(scales)]);
     mov(reg_len, ptr[reg_param + PARAM_OFF(len)]);
     mov(reg_oc_offset, ptr[reg_param + PARAM_OFF(oc_offset)]);
+    if (do_dst_zero_point_) {
+        mov(reg_dst_zp, ptr[reg_param + PARAM_OFF(dst_zero_points)]);
+        if (dst_zp_idx_mult_ == 0) {
+            vpbroadcastd(vreg_dst_zp, dword[reg_dst_zp]);
+            vcvtdq2ps(vreg_dst_zp, vreg_dst_zp);
+        }
+    }
     vbroadcastss(vreg_nslope, ptr[reg_param + PARAM_OFF(nslope)]);
     vbroadcastss(vreg_sum_scale, ptr[reg_param + PARAM_OFF(sum_scale)]);
     vbroadcastss(vreg_signed_scale, ptr[reg_param + PARAM_OFF(signed_scale)]);
@@ -204,6 +244,17 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::generate()
             vmovups(vreg_scale_, scale_addr);
         }
 
+        if (do_dst_zero_point_ && dst_zp_idx_mult_ > 0) {
+            assert(dst_zp_idx_mult_ == 1);
+            auto dst_zp_addr = ptr[reg_dst_zp + offset * sizeof(int32_t)];
+            auto vreg_dst_zp_ = vreg_dst_zp;
+            if (apply_mask)
+                vreg_dst_zp_ = vreg_dst_zp_ | kreg_rem_mask_short;
+            else
+                vreg_dst_zp_ = vreg_dst_zp_ | kreg_rem_mask_vlen;
+            vcvtdq2ps(vreg_dst_zp_, dst_zp_addr);
+        }
+
         auto vreg_dst_ = vreg_dst(idx);
         if (apply_mask)
             vreg_dst_ = vreg_dst_ | kreg_rem_mask_short;
@@ -261,6 +312,8 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::generate()
             }
             if (dst_type != data_type::f32)
                 vcvtdq2ps(vreg_prev_dst(idx), vreg_prev_dst(idx));
+            if (do_dst_zero_point_)
+                vsubps(vreg_prev_dst(idx), vreg_prev_dst(idx), vreg_dst_zp);
 
             vfmadd231ps(vreg_dst(idx), vreg_prev_dst(idx), vreg_sum_scale);
         }
@@ -270,6 +323,9 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::generate()
             vmulps(vreg_dst(idx) | kreg_relu_cmp, vreg_dst(idx), vreg_nslope);
         }
 
+        if (do_dst_zero_point_)
+            vaddps(vreg_dst(idx), vreg_dst(idx), vreg_dst_zp);
+
         if (dst_type != data_type::f32) {
             vcvtps2dq(vreg_dst(idx), vreg_dst(idx));
         }
@@ -300,6 +356,8 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::generate()
             assert(scale_idx_mult_ == 1);
             add(reg_scales, offset * sizeof(float));
         }
+        if (do_dst_zero_point_ && dst_zp_idx_mult_)
+            add(reg_dst_zp, offset * sizeof(int32_t));
         if (do_bias_)
             add(reg_bias, offset * bias_data_type_size_);
     };
@@ -312,6 +370,8 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::generate()
             assert(scale_idx_mult_ == 1);
             lea(reg_scales, ptr[reg_scales + offset * sizeof(float)]);
         }
+        if (do_dst_zero_point_ && dst_zp_idx_mult_)
+            lea(reg_dst_zp, ptr[reg_dst_zp + offset * sizeof(int32_t)]);
         if (do_bias_)
             lea(reg_bias, ptr[reg_bias + offset * bias_data_type_size_]);
     };
@@ -325,6 +385,8 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::generate()
             assert(scale_idx_mult_ == 1);
             sub(reg_scales, OC_ * sizeof(float));
         }
+        if (do_dst_zero_point_ && dst_zp_idx_mult_)
+            sub(reg_dst_zp, OC_ * sizeof(int32_t));
         add(reg_dst, (dst_os_stride_ - OC_) * sizeof(dst_data_t));
     };
 
@@ -472,8 +534,8 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::generate()
 template <data_type_t src_type, data_type_t dst_type>
 void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::operator ()
     (dst_data_t *dst, const acc_data_t *acc, const char *bias,
-        const float *scales, float nslope, float sum_scale, float signed_scale,
-        int g, size_t start, size_t end)
+        const float *scales, const int32_t *dst_zero_points, float nslope,
+        float sum_scale, float signed_scale, int g, size_t start, size_t end)
 {
     using math::get_bias;
 
@@ -489,6 +551,8 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::operator ()
         args.dst = dst + os_offset * dst_os_stride_ + oc_offset;
         args.bias = bias + (g * jcp_.oc + oc_offset) * bias_data_type_size_;
         args.scales = scales + scale_idx_mult_ * (g * jcp_.oc + oc_offset);
+        args.dst_zero_points = dst_zero_points
+            + dst_zp_idx_mult_ * (g * jcp_.oc + oc_offset);
         args.nslope = nslope;
         args.sum_scale = sum_scale;
         args.signed_scale = signed_scale;
@@ -518,10 +582,15 @@ void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::pp_ker_t::operator ()
                         bias_data_type_);
 
                 d *= scales[(g * jcp_.oc + oc) * scale_idx_mult_];
+                const float dst_zp = do_dst_zero_point_
+                    ? (float)dst_zero_points[
+                            (g * jcp_.oc + oc) * dst_zp_idx_mult_]
+                    : 0.f;
                 if (do_sum_)
-                    d += sum_scale * dst[dst_off];
+                    d += sum_scale * (dst[dst_off] - dst_zp);
                 if (do_relu_ && d < 0)
                     d *= nslope;
+                d += dst_zp;
                 dst[dst_off] = qz_a1b0<float, dst_data_t>()(d);
             }
         }
@@ -532,6 +601,7 @@ template <data_type_t src_type, data_type_t dst_type>
 void _gemm_x8s8s32x_convolution_fwd_t<src_type, dst_type>::
 execute_forward_thr(const int ithr, const int nthr, const src_data_t *src_base,
         const wei_data_t *wei_base, const char *bia_base, dst_data_t *dst_base,
+        const float *scales, float nslope,
         const memory_tracking::grantor_t &scratchpad) const {
     const jit_gemm_conv_conf_t &jcp = this->pd()->jcp_;
 
@@ -546,21 +616,13 @@ execute_forward_thr(const int ithr, const int nthr, const src_data_t *src_base,
     const size_t dst_mb_stride = dst_md.blk_off(1);
     const size_t dst_g_stride = dst_md.blk_off(0, 1) * jcp.oc;
 
-    const float *scales = pd()->attr()->output_scales_.scales_;
+    const int32_t *dst_zero_points
+        = pd()->attr()->zero_points_dst_.zero_points_;
 
     const auto &post_ops = pd()->attr()->post_ops_;
     const bool do_sum = post_ops.contain(primitive_kind::sum, 0);
     const float sum_scale = do_sum ? post_ops.entry_[0].sum.scale : 0;
 
-    float nslope = 0;
-    for (int idx = 0; idx < post_ops.len_; ++idx) {
-        const auto &e = post_ops.entry_[idx];
-        if (e.is_relu(true, false)) {
-            nslope = e.eltwise.alpha;
-            break;
-        }
-    }
-
     auto col = scratchpad.get<uint8_t>(key_conv_gemm_col)
         + (ptrdiff_t)ithr * jcp.im2col_sz;
     src_data_t *__restrict imtr = scratchpad.get<src_data_t>(key_conv_gemm_imtr)
@@ -569,7 +631,10 @@ execute_forward_thr(const int ithr, const int nthr, const src_data_t *src_base,
         + (ptrdiff_t)ithr * jcp.oh_block * jcp.ow_block * jcp.oc;
 
     const ptrdiff_t offset = (ptrdiff_t)jcp.ngroups * jcp.ks * jcp.ic * jcp.oc;
-    const int32_t *_wei_comp = (const int32_t *)(wei_base + offset);
+    const int32_t *_wei_comp = jcp.src_zero_point
+        ? scratchpad.get<int32_t>(key_conv_zp_compensation)
+        : (const int32_t *)(wei_base + offset);
+    const bool with_comp = jcp.signed_input || jcp.src_zero_point;
 
     int g{ 0 }, n{ 0 }, ohb{ 0 }, owb{ 0 };
     size_t start = 0, end = 0;
@@ -606,10 +671,10 @@ execute_forward_thr(const int ithr, const int nthr, const src_data_t *src_base,
         const int8_t off_a = 0, off_b = 0;
         const int32_t off_c = 0;
         const float onef = 1.0, zerof = 0.0;
-        gemm_s8x8s32("N", BT, jcp.signed_input ? "C" : "F",
+        gemm_s8x8s32("N", BT, with_comp ? "C" : "F",
             &M, &N, &K, &onef, wei, &LDA, &off_a,
             jcp.im2col_sz ? col : (uint8_t *)src, &LDB, &off_b,
-            &zerof, acc, &M, jcp.signed_input ? wei_comp : &off_c);
+            &zerof, acc, &M, with_comp ? wei_comp : &off_c);
 
         auto wei_adj_scale =
             (wei_md.extra().flags | memory_extra_flags::scale_adjust)
@@ -619,7 +684,7 @@ execute_forward_thr(const int ithr, const int nthr, const src_data_t *src_base,
             size_t start, end;
             balance211((size_t)N * jcp.oc, nthr, ithr, start, end);
             (*pp_ker_)(dst + (oh * jcp.ow + ow) * pp_ker_->dst_os_stride_,
-                    acc, bia_base, scales, nslope, sum_scale,
+                    acc, bia_base, scales, dst_zero_points, nslope, sum_scale,
                     1.f / wei_adj_scale, g, start, end);
         });
 
@@ -705,7 +770,7 @@ execute_backward_data_thr(const int ithr, const int nthr,
         if (jcp.im2col_sz)
             jit_gemm_convolution_utils::col2im_s32(jcp, col, acc);
 
-        parallel_nd(jcp.is, jcp.ic, [&](int is, int ic) {
+        parallel_nd_cost(4, jcp.is, jcp.ic, [&](int is, int ic) {
             float d = (float)acc[is * jcp.ic + ic];
             if (jcp.with_bias)
                 d += get_bias(bia_base, g * jcp.ic + ic,
@@ -26,6 +26,7 @@
 #include "jit_primitive_conf.hpp"
 #include "jit_generator.hpp"
 #include "gemm_convolution_utils.hpp"
+#include "cpu_zero_points_utils.hpp"
 
 #include "gemm/gemm.hpp"
 
@@ -59,17 +60,30 @@ struct _gemm_x8s8s32x_convolution_fwd_t: public cpu_primitive_t {
                 && set_default_formats_common(
                         dat_tag(), format_tag::any, dat_tag())
                 && post_ops_ok()
+                && zero_points_utils::zero_points_valid(attr(), src_type, OC())
                 && memory_desc_matches_tag(*src_md(), dat_tag())
                 && memory_desc_matches_tag(*dst_md(), dat_tag())
                 && set_or_check_wei_format();
             if (!ok) return status::unimplemented;
 
             auto scratchpad = scratchpad_registry().registrar();
-            return jit_gemm_convolution_utils::init_conf(jcp_, scratchpad,
-                    *desc(), src_md(), weights_md(0), dst_md(),
+            status_t status = jit_gemm_convolution_utils::init_conf(jcp_,
+                    scratchpad, *desc(), src_md(), weights_md(0), dst_md(),
                     mkldnn_get_max_threads());
+            if (status != status::success) return status;
+
+            jcp_.src_zero_point = attr()->zero_points_src_.zero_points_[0];
+            if (jcp_.src_zero_point)
+                scratchpad.book(memory_tracking::names::
+                        key_conv_zp_compensation,
+                        sizeof(int32_t) * jcp_.ngroups * jcp_.oc);
+
+            return status::success;
         }
 
+        virtual bool support_runtime_attr_params() const override
+        { return true; }
+
         jit_gemm_conv_conf_t jcp_;
 
     protected:
@@ -92,6 +106,8 @@ struct _gemm_x8s8s32x_convolution_fwd_t: public cpu_primitive_t {
                 want_wei_md.extra.scale_adjust =
                     mayiuse(avx512_core_vnni) ? 1.f : 0.5f;
             }
+            zero_points_utils::init_asymmetric_compensation(want_wei_md,
+                    attr(), (1 << 0) + (with_groups() ? (1 << 1) : 0));
 
             if (weights_md_.format_kind == format_kind::any) {
                 weights_md_ = want_wei_md;
@@ -144,6 +160,7 @@ private:
 
         void operator()(dst_data_t *dst, const acc_data_t *acc,
             const char *bias, const float *scales,
+            const int32_t *dst_zero_points,
             float nslope, float sum_scale, float signed_scale,
             int g, size_t start, size_t end);
 
@@ -157,6 +174,7 @@ private:
             const acc_data_t *acc;
             const char *bias;
             const float *scales;
+            const int32_t *dst_zero_points;
             float nslope;
             float sum_scale;
             float signed_scale;
@@ -175,6 +193,8 @@ private:
         bool do_relu_;
         bool do_sum_;
         bool do_signed_scaling_;
+        size_t dst_zp_idx_mult_;
+        bool do_dst_zero_point_;
         size_t vlen_;
     };
 
@@ -182,8 +202,8 @@ private:
     void execute_forward(const exec_ctx_t &ctx) const;
     void execute_forward_thr(const int ithr, const int nthr,
             const src_data_t *src_base, const wei_data_t *wei_base,
-            const char *bia_base, dst_data_t *dst_base,
-            const memory_tracking::grantor_t &scratchpad) const;
+            const char *bia_base, dst_data_t *dst_base, const float *scales,
+            float nslope, const memory_tracking::grantor_t &scratchpad) const;
 
     int nthr_;
     pp_ker_t *pp_ker_;
@@ -214,6 +234,7 @@ struct _gemm_u8s8s32x_convolution_bwd_data_t: public cpu_primitive_t {
                 && !has_zero_dim_memory()
                 && set_default_formats_common(dat_tag(), wei_tag(), dat_tag())
                 && attr()->post_ops_.has_default_values()
+                && attr()->zero_points_default()
                 && memory_desc_matches_tag(*diff_src_md(), dat_tag())
                 && memory_desc_matches_tag(*diff_dst_md(), dat_tag())
                 && memory_desc_matches_tag(*weights_md(), wei_tag());
@@ -35,6 +35,7 @@ gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::pp_kernel_t(
     : ker_(nullptr), OC_(pd->OC())
     , bias_data_type_(data_type::undef), bias_data_type_size_(0)
     , scale_idx_mult_(0), do_bias_(false), do_relu_(false)
+    , dst_zp_idx_mult_(0), do_dst_zero_point_(false)
 {
     using namespace types;
 
@@ -43,6 +44,11 @@ gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::pp_kernel_t(
     auto &post_ops = pd->attr()->post_ops_;
     do_relu_ = post_ops.len_ == 1;
     do_bias_ = pd->with_bias();
+
+    const auto &dst_zp = pd->attr()->zero_points_dst_;
+    do_dst_zero_point_ = !dst_zp.has_default_values();
+    dst_zp_idx_mult_ = (dst_zp.mask_ == (1 << 1));
+
     bias_data_type_ = pd->desc()->bias_desc.data_type;
     if (do_bias_) {
         assert(bias_data_type_ != data_type::undef);
@@ -70,6 +76,7 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::generat
     Reg64 reg_acc = rax;
     Reg64 reg_bias = rbx;
     Reg64 reg_scales = rsi;
+    Reg64 reg_dst_zp = r12;
 
     Reg64 reg_len = r8;
     Reg64 reg_tmp = rcx; // intentional for shifting purposes
@@ -83,6 +90,7 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::generat
     Zmm vreg_zero = Zmm(0);
     Zmm vreg_scale = Zmm(1);
     Zmm vreg_nslope = Zmm(2);
+    Zmm vreg_dst_zp = Zmm(29);
 
     auto vreg_dst = [&](int idx) { return Zmm(3 + idx * 2 + 0); };
     auto vreg_bias = [&](int idx) { return Zmm(3 + idx * 2 + 1); };
@@ -99,6 +107,13 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::generat
     vbroadcastss(vreg_nslope, ptr[reg_param + PARAM_OFF(nslope)]);
     if (scale_idx_mult_ == 0)
         vbroadcastss(vreg_scale, dword[reg_scales]);
+    if (do_dst_zero_point_) {
+        mov(reg_dst_zp, ptr[reg_param + PARAM_OFF(dst_zero_points)]);
+        if (dst_zp_idx_mult_ == 0) {
+            vpbroadcastd(vreg_dst_zp, dword[reg_dst_zp]);
+            vcvtdq2ps(vreg_dst_zp, vreg_dst_zp);
+        }
+    }
 #undef PARAM_OFF
 
     if (do_relu_ || dst_type == data_type::u8)
@@ -118,6 +133,15 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::generat
             vmovups(vreg_scale, scale_addr);
         }
 
+        if (do_dst_zero_point_ && dst_zp_idx_mult_ > 0) {
+            assert(dst_zp_idx_mult_ == 1);
+            auto dst_zp_addr = ptr[reg_dst_zp + offset * sizeof(int32_t)];
+            auto vreg_dst_zp_ = vreg_dst_zp;
+            if (apply_mask)
+                vreg_dst_zp_ = vreg_dst_zp_ | kreg_rem_mask;
+            vcvtdq2ps(vreg_dst_zp_, dst_zp_addr);
+        }
+
         auto vreg_dst_ = vreg_dst(idx);
         if (apply_mask)
             vreg_dst_ = vreg_dst_ | kreg_rem_mask;
@@ -153,6 +177,9 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::generat
             vmulps(vreg_dst(idx) | kreg_relu_cmp, vreg_dst(idx), vreg_nslope);
         }
 
+        if (do_dst_zero_point_)
+            vaddps(vreg_dst(idx), vreg_dst(idx), vreg_dst_zp);
+
         if (dst_type == data_type::u8)
             vmaxps(vreg_dst(idx), vreg_dst(idx), vreg_zero);
 
@@ -184,6 +211,8 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::generat
             assert(scale_idx_mult_ == 1);
             add(reg_scales, offset * sizeof(float));
         }
+        if (do_dst_zero_point_ && dst_zp_idx_mult_)
+            add(reg_dst_zp, offset * sizeof(int32_t));
         if (do_bias_)
             add(reg_bias, offset * bias_data_type_size_);
     };
@@ -196,6 +225,8 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::generat
             assert(scale_idx_mult_ == 1);
             lea(reg_scales, ptr[reg_scales + offset * sizeof(float)]);
         }
+        if (do_dst_zero_point_ && dst_zp_idx_mult_)
+            lea(reg_dst_zp, ptr[reg_dst_zp + offset * sizeof(int32_t)]);
         if (do_bias_)
             lea(reg_bias, ptr[reg_bias + offset * bias_data_type_size_]);
     };
@@ -209,6 +240,8 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::generat
             assert(scale_idx_mult_ == 1);
             sub(reg_scales, OC_ * sizeof(float));
         }
+        if (do_dst_zero_point_ && dst_zp_idx_mult_)
+            sub(reg_dst_zp, OC_ * sizeof(int32_t));
     };
 
     //      <-------------------- OC ------------------------------->
@@ -356,8 +389,8 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::generat
 template<data_type_t src_type, data_type_t dst_type>
 void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::operator ()(
         dst_data_t *dst, const acc_data_t *acc,
-        const char *bias, const float *scales, float nslope,
-        size_t start, size_t end)
+        const char *bias, const float *scales, const int32_t *dst_zero_points,
+        float nslope, size_t start, size_t end)
 {
     using math::get_bias;
 
@@ -372,6 +405,7 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::operato
         args.acc = acc + start;
         args.bias = bias + oc_offset * bias_data_type_size_;
         args.scales = scales + scale_idx_mult_ * oc_offset;
+        args.dst_zero_points = dst_zero_points + dst_zp_idx_mult_ * oc_offset;
         args.nslope = nslope;
         args.len = end - start;
         args.oc_offset = oc_offset;
@@ -386,6 +420,8 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::pp_kernel_t::operato
             d *= scales[oc * scale_idx_mult_];
             if (do_relu_ && d < 0)
                 d *= nslope;
+            if (do_dst_zero_point_)
+                d += (float)dst_zero_points[oc * dst_zp_idx_mult_];
             dst[i] = qz_a1b0<float, dst_data_t>()(d);
             oc = (oc == OC_ - 1) ? 0 : oc + 1;
         }
@@ -412,19 +448,39 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::execute_forward(
     const int8_t off_a = 0, off_b = 0;
     const int32_t off_c = 0;
 
-    const float *scales = pd()->attr()->output_scales_.scales_;
+    const float *scales = output_scales(ctx);
+    const int32_t *dst_zero_points
+        = pd()->attr()->zero_points_dst_.zero_points_;
+
+    /* The source zero point is applied through the gemm row offsets:
+     * comp[oc] = -zp_src * sum_{ic} w[oc][ic] */
+    const int32_t src_zero_point
+        = pd()->attr()->zero_points_src_.zero_points_[0];
+    int32_t *comp = nullptr;
+    if (src_zero_point) {
+        comp = scratchpad(ctx).template get<int32_t>(
+                key_iprod_zp_compensation);
+        parallel_nd_cost(K, OC, [&](int oc) {
+            int32_t sum = 0;
+            for (int ic = 0; ic < K; ++ic)
+                sum += wei_tr ? weights[(size_t)oc * K + ic]
+                    : weights[(size_t)ic * OC + oc];
+            comp[oc] = -src_zero_point * sum;
+        });
+    }
 
     const auto &post_ops = pd()->attr()->post_ops_;
     const bool do_relu = post_ops.len_ == 1;
-    const float nslope = do_relu ? post_ops.entry_[0].eltwise.alpha : 0.f;
+    const float nslope = do_relu ? post_op_eltwise(ctx, 0).alpha : 0.f;
 
     acc_data_t *acc = pd()->dst_is_acc_
         ? (acc_data_t *)dst
         : scratchpad(ctx).template get<acc_data_t>(key_iprod_int_dat_in_acc_dt);
 
     const float onef = 1.0, zerof = 0.0;
-    gemm_s8x8s32(wei_tr ? "T" : "N", "N", "F", &M, &N, &K, &onef, weights,
-            wei_tr ? &K : &M, &off_a, src, &K, &off_b, &zerof, acc, &M, &off_c);
+    gemm_s8x8s32(wei_tr ? "T" : "N", "N", comp ? "C" : "F", &M, &N, &K, &onef,
+            weights, wei_tr ? &K : &M, &off_a, src, &K, &off_b, &zerof, acc, &M,
+            comp ? comp : &off_c);
 
     if (!pd()->attr()->has_default_values() || !pd()->dst_is_acc_
             || pd()->with_bias()) {
@@ -432,7 +488,8 @@ void gemm_x8s8s32x_inner_product_fwd_t<src_type, dst_type>::execute_forward(
         parallel(force_sequential ? 1 : 0, [&](int ithr, int nthr) {
             size_t start, end;
             balance211((size_t)OC * MB, nthr, ithr, start, end);
-            (*pp_kernel_)(dst, acc, bias, scales, nslope, start, end);
+            (*pp_kernel_)(dst, acc, bias, scales, dst_zero_points, nslope,
+                    start, end);
         });
     }
 }
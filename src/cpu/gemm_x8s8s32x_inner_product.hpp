@@ -29,6 +29,7 @@
 
 #include "cpu_inner_product_pd.hpp"
 #include "cpu_primitive.hpp"
+#include "cpu_zero_points_utils.hpp"
 
 namespace mkldnn {
 namespace impl {
@@ -59,6 +60,7 @@ struct gemm_x8s8s32x_inner_product_fwd_t: public cpu_primitive_t {
                 && attr()->post_ops_.len_ <= 1
                 && IMPLICATION(attr()->post_ops_.len_,
                         attr()->post_ops_.entry_[0].is_relu(true, false))
+                && zero_points_utils::zero_points_valid(attr(), src_type, OC())
                 && dense_gemm_consitency_check(src_md(), weights_md(),
                         dst_md());
             if (!ok) return status::unimplemented;
@@ -70,6 +72,9 @@ struct gemm_x8s8s32x_inner_product_fwd_t: public cpu_primitive_t {
             return status::success;
         }
 
+        virtual bool support_runtime_attr_params() const override
+        { return true; }
+
         bool dst_is_acc_;
 
     protected:
@@ -96,6 +101,12 @@ struct gemm_x8s8s32x_inner_product_fwd_t: public cpu_primitive_t {
                         memory_tracking::names::key_iprod_int_dat_in_acc_dt,
                         sizeof(acc_data_t) * MB() * OC());
             }
+            if (!attr()->zero_points_src_.has_default_values()) {
+                auto scratchpad = scratchpad_registry().registrar();
+                scratchpad.book(
+                        memory_tracking::names::key_iprod_zp_compensation,
+                        sizeof(int32_t) * OC());
+            }
         }
     };
 
@@ -127,7 +138,8 @@ private:
         pp_kernel_t(const pd_t *pd, bool dst_is_acc);
 
         void operator()(dst_data_t *dst, const acc_data_t *acc,
-                const char *bias, const float *scales, float nslope,
+                const char *bias, const float *scales,
+                const int32_t *dst_zero_points, float nslope,
                 size_t start, size_t end);
     private:
         void generate();
@@ -137,6 +149,7 @@ private:
             const acc_data_t *acc;
             const char *bias;
             const float *scales;
+            const int32_t *dst_zero_points;
             float nslope;
             size_t len;
             size_t oc_offset;
@@ -149,6 +162,8 @@ private:
         size_t scale_idx_mult_;
         bool do_bias_;
         bool do_relu_;
+        size_t dst_zp_idx_mult_;
+        bool do_dst_zero_point_;
     };
 
     void execute_forward(const exec_ctx_t &ctx) const;
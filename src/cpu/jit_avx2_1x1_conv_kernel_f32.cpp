@@ -490,7 +490,11 @@ status_t jit_avx2_1x1_conv_kernel_f32::init_conf(jit_1x1_conv_conf_t &jcp,
             OIhw8o8i);
 
     jcp.src_tag = src_d.matches_one_of_tag(dat_tag);
-    jcp.dst_tag = dst_d.matches_one_of_tag(dat_tag);
+    if (one_of(jcp.prop_kind, forward_training, forward_inference))
+        jcp.dst_tag = dst_d.matches_tag_any_mb_stride(dat_tag)
+            ? dat_tag : format_tag::undef;
+    else
+        jcp.dst_tag = dst_d.matches_one_of_tag(dat_tag);
     jcp.wei_tag = weights_d.matches_one_of_tag(wei_tag);
 
     const int simd_w = 8;
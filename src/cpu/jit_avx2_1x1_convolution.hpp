@@ -73,6 +73,8 @@ struct jit_avx2_1x1_convolution_fwd_t: public cpu_primitive_t {
             return status::success;
         }
 
+        virtual bool zero_pads_dst() const override { return true; }
+
         jit_1x1_conv_conf_t jcp_;
         reduce_to_unit_stride_t rtus_;
 
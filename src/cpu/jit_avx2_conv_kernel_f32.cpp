@@ -466,17 +466,20 @@ status_t jit_avx2_conv_fwd_kernel_f32::init_conf(jit_conv_conf_t &jcp,
         jcp.src_tag = src_d.matches_one_of_tag(ncw, nwc, nCw8c);
         jcp.wei_tag = weights_d.matches_one_of_tag(
                 Owi8o, gOwi8o, OIw8i8o, gOIw8i8o);
-        jcp.dst_tag = dst_d.matches_one_of_tag(nCw8c);
+        jcp.dst_tag = dst_d.matches_tag_any_mb_stride(nCw8c)
+            ? nCw8c : format_tag::undef;
     } else if (ndims == 4) {
         jcp.src_tag = src_d.matches_one_of_tag(nchw, nhwc, nChw8c);
         jcp.wei_tag = weights_d.matches_one_of_tag(
                 Ohwi8o, gOhwi8o, OIhw8i8o, gOIhw8i8o);
-        jcp.dst_tag = dst_d.matches_one_of_tag(nChw8c);
+        jcp.dst_tag = dst_d.matches_tag_any_mb_stride(nChw8c)
+            ? nChw8c : format_tag::undef;
     } else if (ndims == 5) {
         jcp.src_tag = src_d.matches_one_of_tag(ncdhw, ndhwc, nCdhw8c);
         jcp.wei_tag = weights_d.matches_one_of_tag(
                 Odhwi8o, gOdhwi8o, OIdhw8i8o, gOIdhw8i8o);
-        jcp.dst_tag = dst_d.matches_one_of_tag(nCdhw8c);
+        jcp.dst_tag = dst_d.matches_tag_any_mb_stride(nCdhw8c)
+            ? nCdhw8c : format_tag::undef;
     }
     jcp.with_bias = cd.bias_desc.format_kind != format_kind::undef;
 
@@ -64,6 +64,8 @@ struct jit_avx2_convolution_fwd_t: public cpu_primitive_t {
             return status::success;
         }
 
+        virtual bool zero_pads_dst() const override { return true; }
+
         jit_conv_conf_t jcp_;
 
     protected:
@@ -646,7 +646,11 @@ status_t jit_avx512_common_1x1_conv_kernel::init_conf(jit_1x1_conv_conf_t &jcp,
 
     auto dat_tag = pick(ndims - 3, nCw16c, nChw16c);
     jcp.src_tag = src_d.matches_one_of_tag(dat_tag);
-    jcp.dst_tag = dst_d.matches_one_of_tag(dat_tag);
+    if (one_of(jcp.prop_kind, forward_training, forward_inference))
+        jcp.dst_tag = dst_d.matches_tag_any_mb_stride(dat_tag)
+            ? dat_tag : format_tag::undef;
+    else
+        jcp.dst_tag = dst_d.matches_one_of_tag(dat_tag);
 
     bool args_ok = true
         && jcp.ngroups == 1
@@ -1232,7 +1232,8 @@ status_t jit_avx512_common_conv_fwd_kernel::init_conf(
         CHECK(memory_desc_init_by_tag(dst_md, dst_tag));
         jcp.dst_tag = dst_tag;
     } else {
-        jcp.dst_tag = dst_d.matches_one_of_tag(dst_tag);
+        jcp.dst_tag = dst_d.matches_tag_any_mb_stride(dst_tag)
+            ? dst_tag : format_tag::undef;
     }
     if (jcp.dst_tag != dst_tag)
         return status::unimplemented;
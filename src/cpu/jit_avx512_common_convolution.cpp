@@ -236,19 +236,11 @@ template <data_type_t src_type, data_type_t wei_type,
           data_type_t dst_type>
 void jit_avx512_common_convolution_fwd_t<src_type, wei_type, dst_type>::
 execute_forward_2d(const exec_ctx_t &ctx) const {
-    auto src = CTX_IN_MEM(const src_data_t *, MKLDNN_ARG_SRC);
-    auto weights = CTX_IN_MEM(const wei_data_t *, MKLDNN_ARG_WEIGHTS);
     auto bias = CTX_IN_MEM(const dst_data_t *, MKLDNN_ARG_BIAS);
-    auto dst = CTX_OUT_MEM(dst_data_t *, MKLDNN_ARG_DST);
 
     prepare_padded_bias(bias, this->scratchpad(ctx));
 
-    const memory_desc_wrapper src_d(pd()->src_md());
-    const memory_desc_wrapper dst_d(pd()->dst_md());
-    const memory_desc_wrapper weights_d(pd()->weights_md(0));
-
     const auto &jcp = pd()->jcp_;
-    assert(jcp.nb_oc % jcp.nb_oc_blocking == 0);
 
     int oc_chunks = jcp.nb_oc / jcp.nb_oc_blocking;
     int work_amount = jcp.mb * jcp.ngroups * oc_chunks * jcp.oh * jcp.nb_ow;
@@ -259,18 +251,46 @@ execute_forward_2d(const exec_ctx_t &ctx) const {
     else
         nthr = mkldnn_get_max_threads();
 
+    /* the rows next to the top and the bottom padding skip a part of the
+     * filter, so let the threads that got them take more rows */
+    work_scheduler_t sched(work_amount, nthr, jcp.t_pad > 0 || jcp.b_pad > 0);
+
     parallel(nthr, [&](const int ithr, const int nthr) {
-        int start{0}, end{0}, start_copy;
-        balance211(work_amount, nthr, ithr, start, end);
-        start_copy = start;
+        execute_forward_2d_thr(ctx, bias, &sched, ithr, nthr);
+    });
+}
 
-        auto par_conv = jit_conv_call_s();
-        size_t src_h_stride = src_d.blk_off(0, 0, 1);
-        size_t src_c_stride = src_d.blk_off(0, 1);
-        size_t dst_h_stride = dst_d.blk_off(0, 0, 1);
-        size_t wht_h_stride = wht_blk_off(weights_d, 0, 0, 0, 1);
-        size_t wht_ic_stride = wht_blk_off(weights_d, 0, 0, 1);
+template <data_type_t src_type, data_type_t wei_type,
+          data_type_t dst_type>
+void jit_avx512_common_convolution_fwd_t<src_type, wei_type, dst_type>::
+execute_forward_2d_thr(const exec_ctx_t &ctx, const dst_data_t *bias,
+        work_scheduler_t *sched, int ithr, int nthr) const {
+    auto src = CTX_IN_MEM(const src_data_t *, MKLDNN_ARG_SRC);
+    auto weights = CTX_IN_MEM(const wei_data_t *, MKLDNN_ARG_WEIGHTS);
+    auto dst = CTX_OUT_MEM(dst_data_t *, MKLDNN_ARG_DST);
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const memory_desc_wrapper weights_d(pd()->weights_md(0));
 
+    const auto &jcp = pd()->jcp_;
+    assert(jcp.nb_oc % jcp.nb_oc_blocking == 0);
+
+    int oc_chunks = jcp.nb_oc / jcp.nb_oc_blocking;
+    int work_amount = jcp.mb * jcp.ngroups * oc_chunks * jcp.oh * jcp.nb_ow;
+
+    work_scheduler_t static_sched(work_amount, nthr, false);
+    auto thr_sched = (sched ? *sched : static_sched).thread(ithr, nthr);
+    int start{0}, end{0}, start_copy{0};
+
+    auto par_conv = jit_conv_call_s();
+    size_t src_h_stride = src_d.blk_off(0, 0, 1);
+    size_t src_c_stride = src_d.blk_off(0, 1);
+    size_t dst_h_stride = dst_d.blocking_desc().strides[2];
+    size_t wht_h_stride = wht_blk_off(weights_d, 0, 0, 0, 1);
+    size_t wht_ic_stride = wht_blk_off(weights_d, 0, 0, 1);
+
+    while (thr_sched.next(start_copy, end)) {
         for (int icb_l2 = 0 ; icb_l2 < jcp.nb_ic; icb_l2 += jcp.nb_ic_L2) {
             start = start_copy;
             int n{0}, g{0}, occ{0}, oh_s{0}, owb{0};
@@ -294,17 +314,18 @@ execute_forward_2d(const exec_ctx_t &ctx) const {
 
                 int ow_s =  owb * jcp.ow_block;
                 int iw_s =  ow_s * jcp.stride_w;
-                int oh_e = oh_s + work_rem > jcp.oh ? jcp.oh : oh_s + work_rem;
+                int oh_e = oh_s + work_rem > jcp.oh
+                    ? jcp.oh : oh_s + work_rem;
                 auto bias_w = bias ? bias + g_oc : nullptr;
 
                 for (int oh_b = oh_s; oh_b < oh_e; oh_b += jcp.h_blocking) {
                     int ih_b = -jcp.t_pad + oh_b * jcp.stride_h;
 
                     auto dst_w = dst + dst_d.blk_off(n, g_ocb, oh_b, ow_s);
-                    auto src_w
-                        = src + src_d.blk_off(n, g_icb + icb_l2, ih_b, iw_s);
-                    auto wht_w
-                            = weights + wht_blk_off(weights_d, g, ocb, icb_l2);
+                    auto src_w = src
+                        + src_d.blk_off(n, g_icb + icb_l2, ih_b, iw_s);
+                    auto wht_w = weights
+                        + wht_blk_off(weights_d, g, ocb, icb_l2);
 
                     for (int icb = icb_l2;
                             icb < min(jcp.nb_ic, icb_l2 + jcp.nb_ic_L2);
@@ -315,19 +336,21 @@ execute_forward_2d(const exec_ctx_t &ctx) const {
                                 oj < min(oh_e, oh_b + jcp.h_blocking);
                                 ++oj, ij += jcp.stride_h) {
                             int dilate_h = jcp.dilate_h + 1;
-                            int i_t_overflow = div_up(max(0, -ij), dilate_h);
+                            int i_t_overflow
+                                = div_up(max(0, -ij), dilate_h);
                             int i_b_overflow = div_up(max(0, ij - jcp.ih
                                 + (jcp.kh - 1) * dilate_h + 1), dilate_h);
-                            int kh_padding = nstl::max(
-                                    0, jcp.kh - i_t_overflow - i_b_overflow);
+                            int kh_padding = nstl::max(0,
+                                    jcp.kh - i_t_overflow - i_b_overflow);
 
-                            auto aux_src = src_c
-                                    + i_t_overflow * dilate_h * src_h_stride;
-                            auto aux_wht = wht_w + i_t_overflow * wht_h_stride;
+                            auto aux_src = src_c + i_t_overflow * dilate_h
+                                * src_h_stride;
+                            auto aux_wht = wht_w
+                                + i_t_overflow * wht_h_stride;
 
                             jit_conv_ker_pipeline_ow_thr(kernel_->jit_ker,
-                                par_conv, aux_src, dst_c, aux_wht, bias_w, icb,
-                                kh_padding, owb);
+                                par_conv, aux_src, dst_c, aux_wht, bias_w,
+                                icb, kh_padding, owb);
 
                             src_c += src_h_stride * jcp.stride_h;
                             dst_c += dst_h_stride;
@@ -338,19 +361,28 @@ execute_forward_2d(const exec_ctx_t &ctx) const {
                 }
 
                 if (jcp.loop_order == loop_cwgn)
-                    nd_iterator_jump(start, end, occ, oc_chunks, owb, jcp.nb_ow,
-                        g, jcp.ngroups, n, jcp.mb, oh_s, jcp.oh);
+                    nd_iterator_jump(start, end, occ, oc_chunks, owb,
+                        jcp.nb_ow, g, jcp.ngroups, n, jcp.mb, oh_s, jcp.oh);
                 else if (jcp.loop_order == loop_gncw)
-                    nd_iterator_jump(start, end, g, jcp.ngroups, n, jcp.mb, occ,
-                        oc_chunks, owb, jcp.nb_ow, oh_s, jcp.oh);
+                    nd_iterator_jump(start, end, g, jcp.ngroups, n, jcp.mb,
+                        occ, oc_chunks, owb, jcp.nb_ow, oh_s, jcp.oh);
                 else
                     assert(!"unsupported loop order");
             }
         }
+    }
 
-        jit_conv_ker_pipeline_ow_thr(kernel_->jit_ker, par_conv,
-                src, dst, weights, bias, 0, 0, 0);
-    });
+    jit_conv_ker_pipeline_ow_thr(kernel_->jit_ker, par_conv,
+            src, dst, weights, bias, 0, 0, 0);
+}
+
+template <data_type_t src_type, data_type_t wei_type,
+          data_type_t dst_type>
+void jit_avx512_common_convolution_fwd_t<src_type, wei_type, dst_type>::
+execute_thr(const exec_ctx_t &ctx, int ithr, int nthr) const {
+    assert(has_execute_thr());
+    auto bias = CTX_IN_MEM(const dst_data_t *, MKLDNN_ARG_BIAS);
+    execute_forward_2d_thr(ctx, bias, nullptr, ithr, nthr);
 }
 
 template <data_type_t src_type, data_type_t wei_type,
@@ -372,105 +404,117 @@ execute_forward_3d(const exec_ctx_t &ctx) const {
     const auto &jcp = pd()->jcp_;
     assert(jcp.nb_oc % jcp.nb_oc_blocking == 0);
 
+    int oc_chunks = jcp.nb_oc / jcp.nb_oc_blocking;
+    int work_amount = jcp.mb * jcp.ngroups * oc_chunks * jcp.od * jcp.oh
+        * jcp.nb_ow;
+
+    /* the rows and the planes next to the padding skip a part of the filter,
+     * so let the threads that got them take more of them */
+    const bool dynamic = jcp.t_pad > 0 || jcp.b_pad > 0 || jcp.f_pad > 0
+        || jcp.back_pad > 0;
+    work_scheduler_t sched(work_amount, mkldnn_get_max_threads(), dynamic);
+
     parallel(0, [&](const int ithr, const int nthr) {
-        int oc_chunks = jcp.nb_oc / jcp.nb_oc_blocking;
-        int start{0}, end{0}, start_copy;
-        int work_amount = jcp.mb * jcp.ngroups * oc_chunks * jcp.od * jcp.oh
-            * jcp.nb_ow;
-        balance211(work_amount, nthr, ithr, start, end);
-        start_copy = start;
+        auto thr_sched = sched.thread(ithr, nthr);
+        int start{0}, end{0}, start_copy{0};
 
         auto par_conv = jit_conv_call_s();
         size_t src_d_stride = src_d.blk_off(0, 0, 1);
         size_t src_h_stride = src_d.blk_off(0, 0, 0, 1);
         size_t src_c_stride = src_d.blk_off(0, 1);
-        size_t dst_h_stride = dst_d.blk_off(0, 0, 0, 1);
+        size_t dst_h_stride = dst_d.blocking_desc().strides[3];
         size_t wht_d_stride = wht_blk_off(weights_d, 0, 0, 0, 1);
         size_t wht_h_stride = wht_blk_off(weights_d, 0, 0, 0, 0, 1);
         size_t wht_ic_stride = wht_blk_off(weights_d, 0, 0, 1);
 
-        for (int icb_l2 = 0 ; icb_l2 < jcp.nb_ic; icb_l2 += jcp.nb_ic_L2) {
-            start = start_copy;
-            int n{0}, g{0}, occ{0}, oh_s{0}, od_s{0}, owb{0};
+        while (thr_sched.next(start_copy, end)) {
+            for (int icb_l2 = 0 ; icb_l2 < jcp.nb_ic; icb_l2 += jcp.nb_ic_L2) {
+                start = start_copy;
+                int n{0}, g{0}, occ{0}, oh_s{0}, od_s{0}, owb{0};
 
-            if (jcp.loop_order == loop_cwgn)
-                nd_iterator_init(start,
-                    occ, oc_chunks, owb, jcp.nb_ow, g, jcp.ngroups, n, jcp.mb,
-                    od_s, jcp.od, oh_s, jcp.oh);
-            else if (jcp.loop_order == loop_gncw)
-                nd_iterator_init(start,
-                    g, jcp.ngroups, n, jcp.mb, occ, oc_chunks, owb, jcp.nb_ow,
-                    od_s, jcp.od, oh_s, jcp.oh);
-            else
-                assert(!"unsupported loop order");
+                if (jcp.loop_order == loop_cwgn)
+                    nd_iterator_init(start,
+                        occ, oc_chunks, owb, jcp.nb_ow, g, jcp.ngroups,
+                        n, jcp.mb, od_s, jcp.od, oh_s, jcp.oh);
+                else if (jcp.loop_order == loop_gncw)
+                    nd_iterator_init(start,
+                        g, jcp.ngroups, n, jcp.mb, occ, oc_chunks,
+                        owb, jcp.nb_ow, od_s, jcp.od, oh_s, jcp.oh);
+                else
+                    assert(!"unsupported loop order");
 
-            while (start < end) {
-                int ocb = occ * jcp.nb_oc_blocking;
-                int g_ocb = g * jcp.nb_oc + ocb;
-                int g_oc = g_ocb * jcp.oc_block;
-                int g_icb = g * jcp.nb_ic * jcp.nonblk_group_off;
+                while (start < end) {
+                    int ocb = occ * jcp.nb_oc_blocking;
+                    int g_ocb = g * jcp.nb_oc + ocb;
+                    int g_oc = g_ocb * jcp.oc_block;
+                    int g_icb = g * jcp.nb_ic * jcp.nonblk_group_off;
 
-                int work_rem = end - start;
-                int ih_s = -jcp.t_pad + oh_s * jcp.stride_h;
-                int ow_s =  owb * jcp.ow_block;
-                int iw_s =  ow_s * jcp.stride_w;
-                int oh_e = oh_s + work_rem > jcp.oh ? jcp.oh : oh_s + work_rem;
+                    int work_rem = end - start;
+                    int ih_s = -jcp.t_pad + oh_s * jcp.stride_h;
+                    int ow_s =  owb * jcp.ow_block;
+                    int iw_s =  ow_s * jcp.stride_w;
+                    int oh_e = oh_s + work_rem > jcp.oh
+                        ? jcp.oh : oh_s + work_rem;
 
-                int id_s = -jcp.f_pad + od_s * jcp.stride_d;
+                    int id_s = -jcp.f_pad + od_s * jcp.stride_d;
 
-                int dilate_d = jcp.dilate_d + 1;
-                int d_t_overflow = div_up(max(0, -id_s), dilate_d);
-                int d_b_overflow = div_up(
-                        max(0, id_s - jcp.id + (jcp.kd - 1) * dilate_d + 1),
-                        dilate_d);
-                int kd_padding = nstl::max(0,
-                    jcp.kd - d_t_overflow - d_b_overflow);
+                    int dilate_d = jcp.dilate_d + 1;
+                    int d_t_overflow = div_up(max(0, -id_s), dilate_d);
+                    int d_b_overflow = div_up(
+                            max(0, id_s - jcp.id + (jcp.kd - 1) * dilate_d + 1),
+                            dilate_d);
+                    int kd_padding = nstl::max(0,
+                        jcp.kd - d_t_overflow - d_b_overflow);
+
+                    auto bias_w = bias ? bias + bias_d.blk_off(g_oc) : 0;
+                    auto dst_w = dst
+                        + dst_d.blk_off(n, g_ocb, od_s, oh_s, ow_s);
+                    auto src_w = src
+                        + src_d.blk_off(n, g_icb + icb_l2, id_s, ih_s, iw_s)
+                        + d_t_overflow * dilate_d * src_d_stride;
+                    auto wht_w = weights
+                        + wht_blk_off(weights_d, g, ocb, icb_l2)
+                        + d_t_overflow * wht_d_stride;
 
-                auto bias_w = bias ? bias + bias_d.blk_off(g_oc) : 0;
-                auto dst_w = dst + dst_d.blk_off(n, g_ocb, od_s, oh_s, ow_s);
-                auto src_w = src + src_d.blk_off(n, g_icb + icb_l2, id_s, ih_s,
-                    iw_s) + d_t_overflow * dilate_d * src_d_stride;
-                auto wht_w = weights + wht_blk_off(weights_d, g, ocb, icb_l2)
-                    + d_t_overflow * wht_d_stride;
+                    for (int icb = icb_l2;
+                         icb < min(jcp.nb_ic, icb_l2 + jcp.nb_ic_L2); ++icb) {
+                        auto src_c = src_w;
+                        auto dst_c = dst_w;
+                        for (int oj = oh_s, ij = ih_s;
+                                oj < oh_e; ++oj, ij += jcp.stride_h)
+                        {
+                            int dilate_h = jcp.dilate_h + 1;
+                            int i_t_overflow = div_up(max(0, -ij), dilate_h);
+                            int i_b_overflow = div_up(
+                                    max(0, ij - jcp.ih + (jcp.kh - 1) * dilate_h
+                                                    + 1),
+                                    dilate_h);
+                            int kh_padding = nstl::max(0,
+                                jcp.kh - i_t_overflow - i_b_overflow);
+                            jit_conv_3d_ker_pipeline_ow_thr(kernel_->jit_ker,
+                                par_conv,
+                                src_c + i_t_overflow * dilate_h * src_h_stride,
+                                dst_c, wht_w + i_t_overflow * wht_h_stride,
+                                bias_w, icb, kh_padding, kd_padding, owb);
 
-                for (int icb = icb_l2;
-                     icb < min(jcp.nb_ic, icb_l2 + jcp.nb_ic_L2); ++icb) {
-                    auto src_c = src_w;
-                    auto dst_c = dst_w;
-                    for (int oj = oh_s, ij = ih_s;
-                            oj < oh_e; ++oj, ij += jcp.stride_h)
-                    {
-                        int dilate_h = jcp.dilate_h + 1;
-                        int i_t_overflow = div_up(max(0, -ij), dilate_h);
-                        int i_b_overflow = div_up(
-                                max(0, ij - jcp.ih + (jcp.kh - 1) * dilate_h
-                                                + 1),
-                                dilate_h);
-                        int kh_padding = nstl::max(0,
-                            jcp.kh - i_t_overflow - i_b_overflow);
-                        jit_conv_3d_ker_pipeline_ow_thr(kernel_->jit_ker,
-                            par_conv,
-                            src_c + i_t_overflow * dilate_h * src_h_stride,
-                            dst_c, wht_w + i_t_overflow * wht_h_stride,
-                            bias_w, icb, kh_padding, kd_padding, owb);
-
-                        src_c += src_h_stride * jcp.stride_h;
-                        dst_c += dst_h_stride;
+                            src_c += src_h_stride * jcp.stride_h;
+                            dst_c += dst_h_stride;
+                        }
+                        src_w += src_c_stride;
+                        wht_w += wht_ic_stride;
                     }
-                    src_w += src_c_stride;
-                    wht_w += wht_ic_stride;
-                }
 
-                if (jcp.loop_order == loop_cwgn)
-                    nd_iterator_jump(start, end,
-                      occ, oc_chunks, owb, jcp.nb_ow, g, jcp.ngroups, n, jcp.mb,
-                      od_s, jcp.od, oh_s, jcp.oh);
-                else if (jcp.loop_order == loop_gncw)
-                    nd_iterator_jump(start, end,
-                      g, jcp.ngroups, n, jcp.mb, occ, oc_chunks, owb, jcp.nb_ow,
-                      od_s, jcp.od, oh_s, jcp.oh);
-                else
-                    assert(!"unsupported loop order");
+                    if (jcp.loop_order == loop_cwgn)
+                        nd_iterator_jump(start, end,
+                          occ, oc_chunks, owb, jcp.nb_ow, g, jcp.ngroups,
+                          n, jcp.mb, od_s, jcp.od, oh_s, jcp.oh);
+                    else if (jcp.loop_order == loop_gncw)
+                        nd_iterator_jump(start, end,
+                          g, jcp.ngroups, n, jcp.mb, occ, oc_chunks,
+                          owb, jcp.nb_ow, od_s, jcp.od, oh_s, jcp.oh);
+                    else
+                        assert(!"unsupported loop order");
+                }
             }
         }
         jit_conv_3d_ker_pipeline(kernel_->jit_ker, par_conv,
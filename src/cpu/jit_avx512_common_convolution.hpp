@@ -71,6 +71,8 @@ struct jit_avx512_common_convolution_fwd_t : public cpu_primitive_t {
             return status;
         }
 
+        virtual bool zero_pads_dst() const override { return true; }
+
         jit_conv_conf_t jcp_;
     };
 
@@ -102,11 +104,22 @@ struct jit_avx512_common_convolution_fwd_t : public cpu_primitive_t {
         return status::success;
     }
 
+    /* the padded bias and the zero padding of dst are serial parts */
+    virtual bool has_execute_thr() const override {
+        return pd()->ndims() == 4 && !pd()->wants_padded_bias()
+            && !pd()->wants_zero_pad_dst();
+    }
+    virtual void execute_thr(const exec_ctx_t &ctx, int ithr, int nthr)
+        const override;
+
 private:
     void prepare_padded_bias(const dst_data_t *&bias,
             const memory_tracking::grantor_t &scratchpad) const;
     void execute_forward_1d(const exec_ctx_t &ctx) const;
     void execute_forward_2d(const exec_ctx_t &ctx) const;
+    /* sched == nullptr means the static schedule */
+    void execute_forward_2d_thr(const exec_ctx_t &ctx, const dst_data_t *bias,
+            work_scheduler_t *sched, int ithr, int nthr) const;
     void execute_forward_3d(const exec_ctx_t &ctx) const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
 
@@ -64,6 +64,7 @@ struct jit_avx512_core_u8s8s32x_wino_convolution_fwd_t : public cpu_primitive_t
                             desc()->bias_desc.data_type, data_type::f32,
                             data_type::s32, data_type::s8, data_type::u8))
                 && !has_zero_dim_memory()
+                && attr()->zero_points_default()
                 && set_default_formats();
 
             if (!ok) return status::unimplemented;
@@ -56,6 +56,7 @@ struct jit_avx512_core_x8s8s32x_1x1_convolution_fwd_t : public cpu_primitive_t {
                             desc()->bias_desc.data_type, data_type::f32,
                             data_type::s32, data_type::s8, data_type::u8))
                 && !has_zero_dim_memory()
+                && attr()->zero_points_default()
                 && set_default_formats_common(dat_tag(), format_tag::any,
                         dat_tag())
                 && set_or_check_wei_format();
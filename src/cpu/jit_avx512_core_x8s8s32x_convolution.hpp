@@ -54,7 +54,8 @@ struct jit_avx512_core_x8s8s32x_convolution_fwd_t : public cpu_primitive_t {
                 && IMPLICATION(with_bias(), utils::one_of(bias_md_.data_type,
                             data_type::f32, data_type::s32, data_type::s8,
                             data_type::u8))
-                && !has_zero_dim_memory();
+                && !has_zero_dim_memory()
+                && attr()->zero_points_default();
             if (!ok) return status::unimplemented;
 
             status_t status = jit_avx512_core_x8s8s32x_fwd_kernel::init_conf(
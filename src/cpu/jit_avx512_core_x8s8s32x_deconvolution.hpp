@@ -181,7 +181,8 @@ struct _jit_avx512_core_x8s8s32x_deconvolution_fwd_t : public cpu_primitive_t {
                 && IMPLICATION(with_bias(), utils::one_of(
                             desc()->bias_desc.data_type, data_type::f32,
                             data_type::s32, data_type::s8, data_type::u8))
-                && desc()->accum_data_type == data_type::s32;
+                && desc()->accum_data_type == data_type::s32
+                && attr()->zero_points_default();
             if (!ok) return status::unimplemented;
 
             status_t status = jit_avx512_core_x8s8s32x_deconv_fwd_kernel::
@@ -409,6 +409,7 @@ struct jit_gemm_conv_conf_t {
     ptrdiff_t im2col_sz;
     bool need_wei_reduction;
     bool signed_input;
+    int32_t src_zero_point;
     int oh_block;
     int ow_block;
     bool outer_threading;
@@ -473,6 +474,39 @@ struct jit_pool_call_s {
     float ker_area_h;
 };
 
+/* Pooling on channels-last data: a kernel call handles one output point
+ * and one chunk of channels, the window is described by the number of
+ * taps that fall into the source in each dimension */
+struct jit_nspc_pool_conf_t {
+    int ndims;
+    int mb, c;
+    int id, ih, iw, od, oh, ow;
+    int stride_d, stride_h, stride_w;
+    int kd, kh, kw;
+    int f_pad, t_pad, l_pad;
+    alg_kind_t alg;
+    bool is_backward;
+    data_type_t ind_dt; // undef if no workspace is read or written
+
+    int simd_w;
+    int nv; // vectors in a full chunk
+    int nb_chunks;
+    int last_nv; // vectors in the last chunk
+    int tail; // valid lanes in the last vector of the last chunk, 0 if full
+};
+
+struct jit_nspc_pool_call_s {
+    /* forward: the first valid tap of the source window and the
+     * destination point; backward: the first valid tap of the diff_src
+     * window and the diff_dst point */
+    float *win;
+    float *pt;
+    void *indices;
+    size_t kd_cnt, kh_cnt, kw_cnt;
+    size_t idx_base; // the window index of the first valid tap
+    float divisor;
+};
+
 
 }
 }
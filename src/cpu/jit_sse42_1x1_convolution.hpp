@@ -56,6 +56,8 @@ struct jit_sse42_1x1_convolution_fwd_t: public cpu_primitive_t {
                     *src_md(), *weights_md(), *dst_md(), *attr());
         }
 
+        virtual bool zero_pads_dst() const override { return true; }
+
         jit_1x1_conv_conf_t jcp_;
 
     protected:
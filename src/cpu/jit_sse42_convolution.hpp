@@ -57,6 +57,8 @@ struct jit_sse42_convolution_fwd_t: public cpu_primitive_t {
                     *src_md(), *weights_md(), *dst_md(), *attr());
         }
 
+        virtual bool zero_pads_dst() const override { return true; }
+
         jit_conv_conf_t jcp_;
 
     protected:
@@ -89,8 +89,7 @@ void _jit_uni_dw_convolution_fwd_t<isa>::execute_forward(
     };
 
     const int chb_work = utils::div_up(jcp.nb_ch, jcp.nb_ch_blocking);
-    parallel_nd(jcp.mb, chb_work, jcp.oh,
-            [&](int n, int chb, int oh) {
+    auto ker = [&](int n, int chb, int oh) {
         int ch = chb * jcp.nb_ch_blocking;
         int ch_num = jcp.nb_ch_blocking;
 
@@ -135,7 +134,14 @@ void _jit_uni_dw_convolution_fwd_t<isa>::execute_forward(
 
             kernel_->jit_ker(&par_conv);
         }
-    });
+    };
+
+    /* the rows next to the top and the bottom padding skip a part of the
+     * filter, so let the threads that got them take more rows */
+    if (jcp.t_pad > 0 || jcp.b_pad > 0)
+        parallel_nd_dynamic(jcp.mb, chb_work, jcp.oh, ker);
+    else
+        parallel_nd(jcp.mb, chb_work, jcp.oh, ker);
 
     if (pd()->wants_zero_pad_dst())
         ctx.memory(MKLDNN_ARG_DST)->zero_pad();
@@ -189,8 +195,7 @@ void _jit_uni_dw_convolution_bwd_data_t<isa>::execute_backward_data(
     };
 
     const int chb_work = utils::div_up(jcp.nb_ch, jcp.nb_ch_blocking);
-    parallel_nd(jcp.mb, chb_work, jcp.ih,
-        [&](int n, int chb, int ih) {
+    auto ker = [&](int n, int chb, int ih) {
         int ch = chb * jcp.nb_ch_blocking;
         int ch_num = jcp.nb_ch_blocking;
 
@@ -239,7 +244,15 @@ void _jit_uni_dw_convolution_bwd_data_t<isa>::execute_backward_data(
                 kernel_->jit_ker(&par_conv);
             }
         }
-    });
+    };
+
+    /* unless the padding matches the filter size the border rows of diff_src
+     * get fewer filter taps than the inner ones */
+    if (jcp.t_pad != jcp.kh - 1 || jcp.b_pad != jcp.kh - 1
+            || jcp.stride_h > 1)
+        parallel_nd_dynamic(jcp.mb, chb_work, jcp.ih, ker);
+    else
+        parallel_nd(jcp.mb, chb_work, jcp.ih, ker);
 }
 
 template struct _jit_uni_dw_convolution_bwd_data_t<avx512_common>;
@@ -65,6 +65,8 @@ struct _jit_uni_dw_convolution_fwd_t: public cpu_primitive_t {
             return status::success;
         }
 
+        virtual bool zero_pads_dst() const override { return true; }
+
         jit_conv_conf_t jcp_;
 
     protected:
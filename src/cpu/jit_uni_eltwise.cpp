@@ -1037,6 +1037,14 @@ jit_uni_eltwise_fwd_t<isa>::~jit_uni_eltwise_fwd_t()
 
 template <cpu_isa_t isa>
 void jit_uni_eltwise_fwd_t<isa>::execute_forward(const exec_ctx_t &ctx) const {
+    parallel(0, [&](const int ithr, const int nthr) {
+        execute_forward_thr(ctx, ithr, nthr);
+    });
+}
+
+template <cpu_isa_t isa>
+void jit_uni_eltwise_fwd_t<isa>::execute_forward_thr(const exec_ctx_t &ctx,
+        int ithr, int nthr) const {
     auto src = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SRC);
     auto dst = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DST);
 
@@ -1047,23 +1055,21 @@ void jit_uni_eltwise_fwd_t<isa>::execute_forward(const exec_ctx_t &ctx) const {
     src += data_d.offset0();
     dst += data_d.offset0();
 
-    parallel(0, [&](const int ithr, const int nthr) {
-        size_t start{0}, end{0};
+    size_t start{0}, end{0};
 
-        const int cache_line = 16;
+    const int cache_line = 16;
 
-        balance211(utils::div_up(nelems, cache_line), nthr, ithr, start, end);
-        start = nstl::min(nelems, start * cache_line);
-        end = nstl::min(nelems, end * cache_line);
+    balance211(utils::div_up(nelems, cache_line), nthr, ithr, start, end);
+    start = nstl::min(nelems, start * cache_line);
+    end = nstl::min(nelems, end * cache_line);
 
-        auto arg = jit_args();
-        arg.from = &src[start];
-        arg.for_comparison = &src[start];
-        arg.to = &dst[start];
-        arg.work_amount = end - start;
-        if (arg.work_amount)
-            (*kernel_)(&arg);
-    });
+    auto arg = jit_args();
+    arg.from = &src[start];
+    arg.for_comparison = &src[start];
+    arg.to = &dst[start];
+    arg.work_amount = end - start;
+    if (arg.work_amount)
+        (*kernel_)(&arg);
 }
 
 template <cpu_isa_t isa>
@@ -1098,6 +1104,14 @@ jit_uni_eltwise_bwd_t<isa>::~jit_uni_eltwise_bwd_t()
 
 template <cpu_isa_t isa>
 void jit_uni_eltwise_bwd_t<isa>::execute_backward(const exec_ctx_t &ctx) const {
+    parallel(0, [&](const int ithr, const int nthr) {
+        execute_backward_thr(ctx, ithr, nthr);
+    });
+}
+
+template <cpu_isa_t isa>
+void jit_uni_eltwise_bwd_t<isa>::execute_backward_thr(const exec_ctx_t &ctx,
+        int ithr, int nthr) const {
     auto src = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SRC);
     auto diff_dst = CTX_IN_MEM(const data_t *, MKLDNN_ARG_DIFF_DST);
     auto diff_src = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DIFF_SRC);
@@ -1111,23 +1125,21 @@ void jit_uni_eltwise_bwd_t<isa>::execute_backward(const exec_ctx_t &ctx) const {
     diff_dst += diff_data_d.offset0();
     diff_src += diff_data_d.offset0();
 
-    parallel(0, [&](const int ithr, const int nthr) {
-        size_t start{0}, end{0};
+    size_t start{0}, end{0};
 
-        const int cache_line = 16;
+    const int cache_line = 16;
 
-        balance211(utils::div_up(nelems, cache_line), nthr, ithr, start, end);
-        start = nstl::min(nelems, start * cache_line);
-        end = nstl::min(nelems, end * cache_line);
+    balance211(utils::div_up(nelems, cache_line), nthr, ithr, start, end);
+    start = nstl::min(nelems, start * cache_line);
+    end = nstl::min(nelems, end * cache_line);
 
-        auto arg = jit_args();
-        arg.from = &diff_dst[start];
-        arg.to = &diff_src[start];
-        arg.for_comparison = &src[start];
-        arg.work_amount = end - start;
-        if (arg.work_amount)
-            (*kernel_)(&arg);
-    });
+    auto arg = jit_args();
+    arg.from = &diff_dst[start];
+    arg.to = &diff_src[start];
+    arg.for_comparison = &src[start];
+    arg.work_amount = end - start;
+    if (arg.work_amount)
+        (*kernel_)(&arg);
 }
 
 template struct jit_uni_eltwise_fwd_t<sse42>;
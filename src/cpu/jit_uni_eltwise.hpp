@@ -152,8 +152,13 @@ struct jit_uni_eltwise_fwd_t : public cpu_primitive_t {
         return status::success;
     }
 
+    virtual bool has_execute_thr() const override { return true; }
+    virtual void execute_thr(const exec_ctx_t &ctx, int ithr, int nthr)
+        const override { execute_forward_thr(ctx, ithr, nthr); }
+
 private:
     void execute_forward(const exec_ctx_t &ctx) const;
+    void execute_forward_thr(const exec_ctx_t &ctx, int ithr, int nthr) const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
     jit_uni_eltwise_kernel_f32 *kernel_;
 };
@@ -180,8 +185,13 @@ struct jit_uni_eltwise_bwd_t : public cpu_primitive_t {
         return status::success;
     }
 
+    virtual bool has_execute_thr() const override { return true; }
+    virtual void execute_thr(const exec_ctx_t &ctx, int ithr, int nthr)
+        const override { execute_backward_thr(ctx, ithr, nthr); }
+
 private:
     void execute_backward(const exec_ctx_t &ctx) const;
+    void execute_backward_thr(const exec_ctx_t &ctx, int ithr, int nthr) const;
     const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
     jit_uni_eltwise_kernel_f32 *kernel_;
 };
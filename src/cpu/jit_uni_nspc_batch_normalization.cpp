@@ -0,0 +1,735 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include <math.h>
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_generator.hpp"
+
+#include "jit_uni_nspc_batch_normalization.hpp"
+
+#define GET_OFF(field) offsetof(call_params_t, field)
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+
+using namespace memory_tracking::names;
+
+using namespace Xbyak;
+
+typedef float data_t;
+
+struct call_params_t {
+    const data_t *src;
+    const data_t *diff_dst;
+    data_t *dst; // diff_src for the backward kernel
+    uint8_t *ws;
+    const data_t *coef;
+    data_t *rbuf;
+    size_t rows;
+};
+
+/* Every kernel walks `rows` rows of one chunk of channels:
+ *   mean:      rbuf[0] += src
+ *   var:       rbuf[0] += (src - coef[0])^2
+ *   fwd:       dst = (src - coef[2]) * coef[0] + coef[1] (relu, workspace)
+ *   bwd_stats: rbuf[0] += (src - coef[0]) * diff_dst, rbuf[1] += diff_dst
+ *   bwd:       diff_src = (diff_dst + (src - coef[3]) * coef[1] + coef[2])
+ *                      * coef[0]
+ * where the per-channel arrays coef[k] and rbuf[k] are C_pad apart; the
+ * mean is subtracted explicitly not to lose precision on large means */
+enum kernel_kind_t { k_mean, k_var, k_fwd, k_bwd_stats, k_bwd, k_nkinds };
+
+struct bnorm_nspc_conf_t {
+    dim_t C, C_pad;
+    int simd_w;
+    int nv; // vectors in a full chunk
+    int nb_chunks;
+    int last_nv; // vectors in the last chunk
+    int tail; // valid lanes in the last vector of the last chunk, 0 if full
+    bool with_relu, with_ws;
+};
+
+template <cpu_isa_t isa>
+struct jit_bnorm_nspc_t: public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_bnorm_nspc_t)
+
+    enum { nv_max = 4 };
+
+    jit_bnorm_nspc_t(const bnorm_nspc_conf_t &conf, kernel_kind_t kind,
+            bool last)
+        : conf_(conf), kind_(kind)
+        , nv_(last ? conf.last_nv : conf.nv)
+        , tail_(last ? conf.tail : 0)
+    {
+        generate();
+        ker = (void (*)(const call_params_t *))getCode();
+    }
+
+    void operator()(const call_params_t *p) const { (*ker)(p); }
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    using reg64_t = const Reg64;
+    const int vlen = cpu_isa_traits<isa>::vlen;
+
+    const bnorm_nspc_conf_t conf_;
+    const kernel_kind_t kind_;
+    const int nv_, tail_;
+
+    void (*ker)(const call_params_t *);
+
+    reg64_t reg_param = abi_param1;
+    reg64_t reg_src = r8;
+    reg64_t reg_diff_dst = r9;
+    reg64_t reg_dst = r10;
+    reg64_t reg_ws = r11;
+    reg64_t reg_coef = r12;
+    reg64_t reg_rbuf = r13;
+    reg64_t reg_rows = r14;
+    reg64_t reg_tmp = rax;
+
+    Opmask k_tail = Opmask(2);
+    Opmask k_cmp = Opmask(3);
+
+    /* constants or accumulators: k-th per-channel array, v-th vector */
+    Vmm vmm_c(int k, int v) { return Vmm(k * nv_max + v); }
+    Vmm vmm_mask() { return Vmm(3 * nv_max); }
+    Vmm vmm_zero() { return Vmm(3 * nv_max + 1); }
+    Vmm vmm_t0() { return Vmm(3 * nv_max + 2); }
+    Vmm vmm_t1() { return Vmm(3 * nv_max + 3); }
+    /* the forward kernel keeps two arrays only, so the third is free */
+    Vmm vmm_t2() { return vmm_c(2, 0); }
+    Vmm vmm_one() { return Vmm(3 * nv_max + 4); } // avx512 only
+
+    Label l_tail_mask;
+
+    bool is_tail(int v) const { return tail_ && v == nv_ - 1; }
+    int n_arrays() const {
+        return utils::one_of(kind_, k_bwd_stats, k_bwd) ? 3 : 2;
+    }
+
+    Address coef_addr(int k, int v)
+    { return ptr[reg_coef + (k * conf_.C_pad * sizeof(data_t) + v * vlen)]; }
+    Address rbuf_addr(int k, int v)
+    { return ptr[reg_rbuf + (k * conf_.C_pad * sizeof(data_t) + v * vlen)]; }
+
+    void load(const Vmm &vmm, const Address &addr, bool tail) {
+        if (!tail)
+            uni_vmovups(vmm, addr);
+        else if (isa == avx512_common)
+            vmovups(vmm | k_tail | T_z, addr);
+        else
+            vmaskmovps(vmm, vmm_mask(), addr);
+    }
+
+    void store(const Address &addr, const Vmm &vmm, bool tail) {
+        if (!tail)
+            uni_vmovups(addr, vmm);
+        else if (isa == avx512_common)
+            vmovups(addr | k_tail, vmm);
+        else
+            vmaskmovps(addr, vmm_mask(), vmm);
+    }
+
+    void prepare_tail_mask() {
+        if (isa == avx512_common) {
+            mov(reg_tmp.cvt32(), (1 << tail_) - 1);
+            kmovw(k_tail, reg_tmp.cvt32());
+        } else {
+            mov(reg_tmp, l_tail_mask);
+            vmovups(vmm_mask(), ptr[reg_tmp]);
+        }
+    }
+
+    /* stores the n lowest bytes of xmm to base + off, byte by byte past the
+     * qwords: masked byte stores need avx512bw */
+    void store_bytes(const Reg64 &base, int off, const Xmm &xmm, int n) {
+        if (n >= 8) {
+            vmovq(ptr[base + off], xmm);
+            vpextrq(reg_tmp, xmm, 1);
+            off += 8;
+            n -= 8;
+        } else {
+            vmovq(reg_tmp, xmm);
+        }
+        for (int i = 0; i < n; ++i) {
+            mov(ptr[base + off + i], reg_tmp.cvt8());
+            shr(reg_tmp, 8);
+        }
+    }
+
+    /* stores 1 to the workspace for positive vmm lanes and 0 otherwise */
+    void store_ws(int v, const Vmm &vmm) {
+        const int off = v * conf_.simd_w;
+        const int n = is_tail(v) ? tail_ : conf_.simd_w;
+        Xmm xmm_t1(vmm_t1().getIdx());
+        if (isa == avx512_common) {
+            vcmpps(k_cmp, vmm, vmm_zero(), _cmp_nle_us);
+            vpblendmd(vmm_t1() | k_cmp, vmm_zero(), vmm_one());
+            vpmovdb(xmm_t1, vmm_t1());
+        } else {
+            Xmm xmm_t2(vmm_t2().getIdx());
+            vcmpps(vmm_t1(), vmm, vmm_zero(), _cmp_nle_us);
+            vpsrld(vmm_t1(), vmm_t1(), 31);
+            vextractf128(xmm_t2, vmm_t1(), 1);
+            vpackssdw(xmm_t1, xmm_t1, xmm_t2);
+            vpacksswb(xmm_t1, xmm_t1, xmm_t1);
+        }
+        if (n == 16)
+            vmovups(ptr[reg_ws + off], xmm_t1);
+        else if (n == 8)
+            vmovq(ptr[reg_ws + off], xmm_t1);
+        else
+            store_bytes(reg_ws, off, xmm_t1, n);
+    }
+
+    /* loads diff_dst into t0 zeroing the lanes the forward relu cut off;
+     * clobbers t1 */
+    void load_diff_dst(int v) {
+        const bool tail = is_tail(v);
+        const Address dd_addr = ptr[reg_diff_dst + v * vlen];
+        if (!conf_.with_ws) {
+            load(vmm_t0(), dd_addr, tail);
+            return;
+        }
+
+        const int off = v * conf_.simd_w;
+        if (isa == avx512_common) {
+            if (tail)
+                vpmovzxbd(vmm_t1() | k_tail | T_z, ptr[reg_ws + off]);
+            else
+                vpmovzxbd(vmm_t1(), ptr[reg_ws + off]);
+            vptestmd(k_cmp, vmm_t1(), vmm_t1());
+            if (tail) kandw(k_cmp, k_cmp, k_tail);
+            vmovups(vmm_t0() | k_cmp | T_z, dd_addr);
+        } else {
+            Xmm xmm_t1(vmm_t1().getIdx());
+            if (tail) {
+                /* gather the bytes one by one not to read past the row */
+                xor_(reg_tmp, reg_tmp);
+                for (int i = tail_ - 1; i >= 0; --i) {
+                    shl(reg_tmp, 8);
+                    mov(reg_tmp.cvt8(), ptr[reg_ws + off + i]);
+                }
+                vmovq(xmm_t1, reg_tmp);
+                vpmovzxbd(vmm_t1(), xmm_t1);
+            } else {
+                vpmovzxbd(vmm_t1(), ptr[reg_ws + off]);
+            }
+            vpcmpeqd(vmm_t1(), vmm_t1(), vmm_zero());
+            load(vmm_t0(), dd_addr, tail);
+            vandnps(vmm_t0(), vmm_t1(), vmm_t0());
+        }
+    }
+
+    void compute_row() {
+        for (int v = 0; v < nv_; ++v) {
+            const bool tail = is_tail(v);
+            const Address src_addr = ptr[reg_src + v * vlen];
+            switch (kind_) {
+            case k_mean:
+                load(vmm_t0(), src_addr, tail);
+                uni_vaddps(vmm_c(0, v), vmm_c(0, v), vmm_t0());
+                break;
+            case k_var:
+                load(vmm_t0(), src_addr, tail);
+                uni_vsubps(vmm_t0(), vmm_t0(), vmm_c(1, v));
+                uni_vfmadd231ps(vmm_c(0, v), vmm_t0(), vmm_t0());
+                break;
+            case k_fwd:
+                load(vmm_t0(), src_addr, tail);
+                uni_vsubps(vmm_t0(), vmm_t0(), coef_addr(2, v));
+                uni_vfmadd213ps(vmm_t0(), vmm_c(0, v), vmm_c(1, v));
+                if (conf_.with_ws) store_ws(v, vmm_t0());
+                if (conf_.with_relu)
+                    uni_vmaxps(vmm_t0(), vmm_t0(), vmm_zero());
+                store(ptr[reg_dst + v * vlen], vmm_t0(), tail);
+                break;
+            case k_bwd_stats:
+                load_diff_dst(v);
+                load(vmm_t1(), src_addr, tail);
+                uni_vsubps(vmm_t1(), vmm_t1(), vmm_c(2, v));
+                uni_vfmadd231ps(vmm_c(0, v), vmm_t1(), vmm_t0());
+                uni_vaddps(vmm_c(1, v), vmm_c(1, v), vmm_t0());
+                break;
+            case k_bwd:
+                load_diff_dst(v);
+                load(vmm_t1(), src_addr, tail);
+                uni_vsubps(vmm_t1(), vmm_t1(), coef_addr(3, v));
+                uni_vfmadd231ps(vmm_t0(), vmm_t1(), vmm_c(1, v));
+                uni_vaddps(vmm_t0(), vmm_t0(), vmm_c(2, v));
+                uni_vmulps(vmm_t0(), vmm_t0(), vmm_c(0, v));
+                store(ptr[reg_dst + v * vlen], vmm_t0(), tail);
+                break;
+            default: assert(!"unknown kernel kind");
+            }
+        }
+    }
+
+    void generate() {
+        const bool is_reduction = utils::one_of(kind_, k_mean, k_var,
+                k_bwd_stats);
+        const int n_acc = kind_ == k_bwd_stats ? 2 : 1;
+        const size_t row_stride = conf_.C * sizeof(data_t);
+
+        preamble();
+
+        mov(reg_src, ptr[reg_param + GET_OFF(src)]);
+        mov(reg_diff_dst, ptr[reg_param + GET_OFF(diff_dst)]);
+        mov(reg_dst, ptr[reg_param + GET_OFF(dst)]);
+        mov(reg_ws, ptr[reg_param + GET_OFF(ws)]);
+        mov(reg_coef, ptr[reg_param + GET_OFF(coef)]);
+        mov(reg_rbuf, ptr[reg_param + GET_OFF(rbuf)]);
+        mov(reg_rows, ptr[reg_param + GET_OFF(rows)]);
+
+        if (tail_) prepare_tail_mask();
+        uni_vpxor(vmm_zero(), vmm_zero(), vmm_zero());
+        if (isa == avx512_common && kind_ == k_fwd && conf_.with_ws) {
+            mov(reg_tmp.cvt32(), 1);
+            vpbroadcastd(vmm_one(), reg_tmp.cvt32());
+        }
+
+        /* the partial sums are accumulated over the calls; the constants
+         * follow the accumulators in the same numbering */
+        for (int v = 0; v < nv_; ++v) {
+            if (is_reduction) {
+                for (int k = 0; k < n_acc; ++k)
+                    uni_vmovups(vmm_c(k, v), rbuf_addr(k, v));
+                if (kind_ != k_mean)
+                    uni_vmovups(vmm_c(n_acc, v), coef_addr(0, v));
+            } else {
+                for (int k = 0; k < n_arrays(); ++k)
+                    uni_vmovups(vmm_c(k, v), coef_addr(k, v));
+            }
+        }
+
+        Label row_loop, row_end;
+        test(reg_rows, reg_rows);
+        jz(row_end, T_NEAR);
+        L(row_loop); {
+            compute_row();
+            add(reg_src, row_stride);
+            add(reg_diff_dst, row_stride);
+            add(reg_dst, row_stride);
+            add(reg_ws, conf_.C);
+            dec(reg_rows);
+            jnz(row_loop, T_NEAR);
+        }
+        L(row_end);
+
+        if (is_reduction)
+            for (int k = 0; k < n_acc; ++k)
+            for (int v = 0; v < nv_; ++v)
+                uni_vmovups(rbuf_addr(k, v), vmm_c(k, v));
+
+        postamble();
+
+        if (isa != avx512_common && tail_) {
+            align(64);
+            L(l_tail_mask);
+            for (int i = 0; i < conf_.simd_w; ++i)
+                dd(i < tail_ ? 0xffffffff : 0);
+        }
+    }
+};
+
+}
+
+namespace bnorm_nspc_impl {
+
+template <cpu_isa_t isa>
+struct driver_t: public c_compatible {
+    typedef jit_bnorm_nspc_t<isa> kernel_t;
+
+    driver_t(const batch_normalization_pd_t *bdesc): bdesc_(bdesc) {
+        init_conf(conf_, bdesc_);
+        utils::array_set(kernels_[0], nullptr, k_nkinds);
+        utils::array_set(kernels_[1], nullptr, k_nkinds);
+
+        const bool need_last = conf_.tail != 0 || conf_.last_nv != conf_.nv;
+        auto create = [&](kernel_kind_t kind) {
+            kernels_[0][kind] = new kernel_t(conf_, kind, false);
+            kernels_[1][kind] = need_last
+                ? new kernel_t(conf_, kind, true) : kernels_[0][kind];
+        };
+
+        if (bdesc_->is_fwd()) {
+            if (!bdesc_->stats_is_src()) {
+                create(k_mean);
+                create(k_var);
+            }
+            create(k_fwd);
+        } else {
+            create(k_bwd_stats);
+            create(k_bwd);
+        }
+    }
+
+    ~driver_t() {
+        for (int kind = 0; kind < k_nkinds; ++kind) {
+            if (kernels_[1][kind] != kernels_[0][kind])
+                delete kernels_[1][kind];
+            delete kernels_[0][kind];
+        }
+    }
+
+    static void init_conf(bnorm_nspc_conf_t &conf,
+            const batch_normalization_pd_t *bdesc) {
+        conf.simd_w = cpu_isa_traits<isa>::vlen / sizeof(data_t);
+        conf.nv = kernel_t::nv_max;
+        conf.C = bdesc->C();
+        conf.C_pad = utils::rnd_up(conf.C, (dim_t)conf.simd_w);
+
+        const dim_t chunk = conf.nv * conf.simd_w;
+        conf.nb_chunks = (int)utils::div_up(conf.C, chunk);
+        const dim_t last_c = conf.C - (conf.nb_chunks - 1) * chunk;
+        conf.last_nv = (int)utils::div_up(last_c, (dim_t)conf.simd_w);
+        conf.tail = (int)(conf.C % conf.simd_w);
+
+        conf.with_relu = bdesc->is_fwd()
+            ? bdesc->with_relu_post_op() || bdesc->fuse_bn_relu()
+            : bdesc->fuse_bn_relu();
+        conf.with_ws = bdesc->fuse_bn_relu()
+            && IMPLICATION(bdesc->is_fwd(), bdesc->is_training());
+    }
+
+    static void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+            const batch_normalization_pd_t *bdesc) {
+        bnorm_nspc_conf_t conf;
+        init_conf(conf, bdesc);
+
+        const int nthr = mkldnn_get_max_threads();
+        scratchpad.book(key_bnorm_reduction,
+                sizeof(data_t) * 2 * conf.C_pad * nthr);
+        scratchpad.book(key_bnorm_tmp_stats,
+                sizeof(data_t) * 4 * conf.C_pad);
+        if (bdesc->is_fwd() && !bdesc->stats_is_src()
+                && !bdesc->is_training())
+            scratchpad.book(key_bnorm_tmp_mean, sizeof(data_t) * 2 * conf.C);
+        if (bdesc->is_bwd())
+            scratchpad.book(key_bnorm_tmp_diff_ss,
+                    sizeof(data_t) * 2 * conf.C);
+    }
+
+    void exec_fwd(const data_t *src, data_t *dst, const data_t *scale_shift,
+            data_t *mean, data_t *var, uint8_t *ws,
+            const memory_tracking::grantor_t &scratchpad) const {
+        auto rbuf = scratchpad.get<data_t>(key_bnorm_reduction);
+        auto coef = scratchpad.get<data_t>(key_bnorm_tmp_stats);
+        if (mean == nullptr) {
+            mean = scratchpad.get<data_t>(key_bnorm_tmp_mean);
+            var = mean + conf_.C;
+        }
+
+        const dim_t C = conf_.C, C_pad = conf_.C_pad;
+        const dim_t rows = bdesc_->MB() * bdesc_->D() * bdesc_->H()
+            * bdesc_->W();
+
+        if (!bdesc_->stats_is_src()) {
+            reduce(k_mean, src, nullptr, nullptr, coef, rbuf, rows,
+                    [&](dim_t c, data_t s, data_t) {
+                mean[c] = s / rows;
+                coef[c] = mean[c];
+            });
+            reduce(k_var, src, nullptr, nullptr, coef, rbuf, rows,
+                    [&](dim_t c, data_t s, data_t) { var[c] = s / rows; });
+        }
+
+        const float eps = bdesc_->desc()->batch_norm_epsilon;
+        const bool use_scaleshift = bdesc_->use_scaleshift();
+        parallel_nd(C, [&](dim_t c) {
+            const data_t sm = (use_scaleshift ? scale_shift[c] : 1.f)
+                / sqrtf(var[c] + eps);
+            const data_t sv = use_scaleshift ? scale_shift[C + c] : 0.f;
+            coef[c] = sm;
+            coef[C_pad + c] = sv;
+            coef[2 * C_pad + c] = mean[c];
+        });
+
+        apply(k_fwd, src, nullptr, dst, ws, coef, rows);
+    }
+
+    void exec_bwd(const data_t *src, const data_t *diff_dst,
+            data_t *diff_src, const data_t *scale_shift,
+            data_t *diff_scale_shift, const data_t *mean, const data_t *var,
+            const uint8_t *ws,
+            const memory_tracking::grantor_t &scratchpad) const {
+        auto rbuf = scratchpad.get<data_t>(key_bnorm_reduction);
+        auto coef = scratchpad.get<data_t>(key_bnorm_tmp_stats);
+        if (diff_scale_shift == nullptr)
+            diff_scale_shift = scratchpad.get<data_t>(key_bnorm_tmp_diff_ss);
+
+        const dim_t C = conf_.C, C_pad = conf_.C_pad;
+        const dim_t rows = bdesc_->MB() * bdesc_->D() * bdesc_->H()
+            * bdesc_->W();
+        const float eps = bdesc_->desc()->batch_norm_epsilon;
+        data_t *diff_gamma = diff_scale_shift, *diff_beta = diff_scale_shift + C;
+        uint8_t *ws_ = const_cast<uint8_t *>(ws);
+
+        parallel_nd(C, [&](dim_t c) { coef[c] = mean[c]; });
+        reduce(k_bwd_stats, src, diff_dst, ws_, coef, rbuf, rows,
+                [&](dim_t c, data_t s0, data_t s1) {
+            diff_gamma[c] = s0 / sqrtf(var[c] + eps);
+            diff_beta[c] = s1;
+        });
+
+        const bool use_scaleshift = bdesc_->use_scaleshift();
+        const bool calculate_diff_stats = !bdesc_->use_global_stats();
+        parallel_nd(C, [&](dim_t c) {
+            const data_t rs = 1.f / sqrtf(var[c] + eps);
+            const data_t k = (use_scaleshift ? scale_shift[c] : 1.f) * rs;
+            data_t b = 0.f, d = 0.f;
+            if (calculate_diff_stats) {
+                b = -diff_gamma[c] * rs / rows;
+                d = -diff_beta[c] / rows;
+            }
+            coef[c] = k;
+            coef[C_pad + c] = b;
+            coef[2 * C_pad + c] = d;
+            coef[3 * C_pad + c] = mean[c];
+        });
+
+        apply(k_bwd, src, diff_dst, diff_src, ws_, coef, rows);
+    }
+
+private:
+    /* rows per call: the data of a block of rows over all the chunks
+     * stays in L1 */
+    dim_t row_block() const
+    { return nstl::max<dim_t>(1, 4096 / conf_.C); }
+
+    void call(kernel_kind_t kind, int chunk, dim_t row, dim_t nrows,
+            const data_t *src, const data_t *diff_dst, data_t *dst,
+            uint8_t *ws, const data_t *coef, data_t *rbuf) const {
+        const dim_t c0 = (dim_t)chunk * conf_.nv * conf_.simd_w;
+        const size_t off = (size_t)row * conf_.C + c0;
+        call_params_t p;
+        p.src = src + off;
+        p.diff_dst = diff_dst ? diff_dst + off : nullptr;
+        p.dst = dst ? dst + off : nullptr;
+        p.ws = ws ? ws + off : nullptr;
+        p.coef = coef + c0;
+        p.rbuf = rbuf ? rbuf + c0 : nullptr;
+        p.rows = nrows;
+        (*kernels_[chunk == conf_.nb_chunks - 1][kind])(&p);
+    }
+
+    /* computes the per-thread partial sums and finalizes them with
+     * f(c, sum0, sum1) */
+    template <typename F>
+    void reduce(kernel_kind_t kind, const data_t *src,
+            const data_t *diff_dst, uint8_t *ws, const data_t *coef,
+            data_t *rbuf, dim_t rows, F f) const {
+        const dim_t C_pad = conf_.C_pad;
+        const dim_t blk = row_block();
+        int nthr_used = 1;
+
+        parallel(0, [&](const int ithr, const int nthr) {
+            if (ithr == 0) nthr_used = nthr;
+            dim_t r_s = 0, r_e = 0;
+            balance211(rows, nthr, ithr, r_s, r_e);
+
+            data_t *rbuf_loc = rbuf + 2 * C_pad * ithr;
+            utils::array_set(rbuf_loc, 0, 2 * C_pad);
+            for (dim_t r = r_s; r < r_e; r += blk) {
+                const dim_t nrows = nstl::min(blk, r_e - r);
+                for (int ch = 0; ch < conf_.nb_chunks; ++ch)
+                    call(kind, ch, r, nrows, src, diff_dst, nullptr, ws,
+                            coef, rbuf_loc);
+            }
+        });
+
+        parallel_nd(conf_.C, [&](dim_t c) {
+            data_t s0 = 0.f, s1 = 0.f;
+            for (int t = 0; t < nthr_used; ++t) {
+                s0 += rbuf[2 * C_pad * t + c];
+                s1 += rbuf[2 * C_pad * t + C_pad + c];
+            }
+            f(c, s0, s1);
+        });
+    }
+
+    void apply(kernel_kind_t kind, const data_t *src, const data_t *diff_dst,
+            data_t *dst, uint8_t *ws, const data_t *coef, dim_t rows) const {
+        const dim_t blk = row_block();
+        parallel(0, [&](const int ithr, const int nthr) {
+            dim_t r_s = 0, r_e = 0;
+            balance211(rows, nthr, ithr, r_s, r_e);
+            for (dim_t r = r_s; r < r_e; r += blk) {
+                const dim_t nrows = nstl::min(blk, r_e - r);
+                for (int ch = 0; ch < conf_.nb_chunks; ++ch)
+                    call(kind, ch, r, nrows, src, diff_dst, dst, ws, coef,
+                            nullptr);
+            }
+        });
+    }
+
+    const batch_normalization_pd_t *bdesc_;
+    bnorm_nspc_conf_t conf_;
+    kernel_t *kernels_[2][k_nkinds];
+};
+
+}
+
+using namespace data_type;
+using namespace utils;
+
+/* fwd */
+
+template <cpu_isa_t isa>
+status_t jit_uni_nspc_batch_normalization_fwd_t<isa>::pd_t::init() {
+    auto desired_fmt_tag = ndims() == 4 ? format_tag::nhwc : format_tag::ndhwc;
+
+    bool ok = true
+        && mayiuse(isa)
+        && is_fwd()
+        && !has_zero_dim_memory()
+        && one_of(ndims(), 4, 5)
+        && src_md()->data_type == f32
+        && IMPLICATION(use_scaleshift(), weights_md()->data_type == f32)
+        && memory_desc_matches_tag(*src_md(), desired_fmt_tag)
+        && (attr()->has_default_values() || this->with_relu_post_op());
+    if (!ok) return status::unimplemented;
+
+    if (is_training() && fuse_bn_relu()) init_default_ws(8);
+
+    auto scratchpad = scratchpad_registry().registrar();
+    bnorm_nspc_impl::driver_t<isa>::init_scratchpad(scratchpad, this);
+
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+jit_uni_nspc_batch_normalization_fwd_t<isa>::
+jit_uni_nspc_batch_normalization_fwd_t(const pd_t *apd): cpu_primitive_t(apd)
+{ bnorm_driver_ = new bnorm_nspc_impl::driver_t<isa>(pd()); }
+
+template <cpu_isa_t isa>
+status_t jit_uni_nspc_batch_normalization_fwd_t<isa>::execute(
+        const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SRC);
+    auto scale_shift = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SCALE_SHIFT);
+
+    data_t *mean = nullptr, *var = nullptr;
+    if (pd()->stats_is_src()) {
+        mean = const_cast<data_t *>(
+                CTX_IN_MEM(const data_t *, MKLDNN_ARG_MEAN));
+        var = const_cast<data_t *>(
+                CTX_IN_MEM(const data_t *, MKLDNN_ARG_VARIANCE));
+    } else if (pd()->is_training()) {
+        mean = CTX_OUT_MEM(data_t *, MKLDNN_ARG_MEAN);
+        var = CTX_OUT_MEM(data_t *, MKLDNN_ARG_VARIANCE);
+    }
+
+    auto dst = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DST);
+    auto ws = CTX_OUT_MEM(uint8_t *, MKLDNN_ARG_WORKSPACE);
+
+    bnorm_driver_->exec_fwd(src, dst, scale_shift, mean, var, ws,
+            this->scratchpad(ctx));
+
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+jit_uni_nspc_batch_normalization_fwd_t<isa>::
+~jit_uni_nspc_batch_normalization_fwd_t()
+{ delete bnorm_driver_; }
+
+/* bwd */
+
+template <cpu_isa_t isa>
+status_t jit_uni_nspc_batch_normalization_bwd_t<isa>::pd_t::init() {
+    auto desired_fmt_tag = ndims() == 4 ? format_tag::nhwc : format_tag::ndhwc;
+
+    bool ok = true
+        && mayiuse(isa)
+        && is_bwd()
+        && !has_zero_dim_memory()
+        && one_of(ndims(), 4, 5)
+        && everyone_is(f32, src_md()->data_type, diff_src_md()->data_type)
+        && IMPLICATION(use_scaleshift(),
+                utils::everyone_is(f32,
+                    weights_md()->data_type,
+                    diff_weights_md()->data_type))
+        && memory_desc_matches_tag(*src_md(), desired_fmt_tag)
+        && memory_desc_matches_tag(*diff_src_md(), desired_fmt_tag)
+        && memory_desc_matches_tag(*diff_dst_md(), desired_fmt_tag)
+        && attr()->has_default_values();
+    if (!ok) return status::unimplemented;
+
+    if (fuse_bn_relu()) {
+        init_default_ws(8);
+        if (!compare_ws(hint_fwd_pd_))
+            return status::unimplemented;
+    }
+
+    auto scratchpad = scratchpad_registry().registrar();
+    bnorm_nspc_impl::driver_t<isa>::init_scratchpad(scratchpad, this);
+
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+jit_uni_nspc_batch_normalization_bwd_t<isa>::
+jit_uni_nspc_batch_normalization_bwd_t(const pd_t *apd): cpu_primitive_t(apd)
+{ bnorm_driver_ = new bnorm_nspc_impl::driver_t<isa>(pd()); }
+
+template <cpu_isa_t isa>
+status_t jit_uni_nspc_batch_normalization_bwd_t<isa>::execute(
+        const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SRC);
+    auto mean = CTX_IN_MEM(const data_t *, MKLDNN_ARG_MEAN);
+    auto var = CTX_IN_MEM(const data_t *, MKLDNN_ARG_VARIANCE);
+    auto diff_dst = CTX_IN_MEM(const data_t *, MKLDNN_ARG_DIFF_DST);
+    auto scale_shift = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SCALE_SHIFT);
+    auto ws = CTX_IN_MEM(const uint8_t *, MKLDNN_ARG_WORKSPACE);
+
+    auto diff_src = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DIFF_SRC);
+    auto diff_scale_shift = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DIFF_SCALE_SHIFT);
+
+    bnorm_driver_->exec_bwd(src, diff_dst, diff_src, scale_shift,
+            diff_scale_shift, mean, var, ws, this->scratchpad(ctx));
+
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+jit_uni_nspc_batch_normalization_bwd_t<isa>::
+~jit_uni_nspc_batch_normalization_bwd_t()
+{ delete bnorm_driver_; }
+
+/* struct instantiation */
+template struct jit_uni_nspc_batch_normalization_fwd_t<avx2>;
+template struct jit_uni_nspc_batch_normalization_bwd_t<avx2>;
+template struct jit_uni_nspc_batch_normalization_fwd_t<avx512_common>;
+template struct jit_uni_nspc_batch_normalization_bwd_t<avx512_common>;
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,350 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <limits.h>
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_uni_nspc_conv_kernel_f32.hpp"
+
+#define GET_OFF(field) offsetof(jit_nspc_conv_call_s, field)
+#define GET_BATCH_OFF(field) offsetof(jit_nspc_conv_batch_t, field)
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::format_tag;
+using namespace mkldnn::impl::prop_kind;
+using namespace mkldnn::impl::memory_tracking::names;
+using namespace mkldnn::impl::utils;
+
+using namespace Xbyak;
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_conv_kernel_f32<isa>::load(const Vmm &vmm,
+        const Address &addr, bool tail) {
+    if (!tail)
+        uni_vmovups(vmm, addr);
+    else if (isa == avx512_common)
+        vmovups(vmm | k_tail | T_z, addr);
+    else
+        vmaskmovps(vmm, vmm_mask(), addr);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_conv_kernel_f32<isa>::store(const Address &addr,
+        const Vmm &vmm, bool tail) {
+    if (!tail)
+        uni_vmovups(addr, vmm);
+    else if (isa == avx512_common)
+        vmovups(addr | k_tail, vmm);
+    else
+        vmaskmovps(addr, vmm_mask(), vmm);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_conv_kernel_f32<isa>::prepare_tail_mask() {
+    if (isa == avx512_common) {
+        mov(reg_tmp.cvt32(), (1 << tail_) - 1);
+        kmovw(k_tail, reg_tmp.cvt32());
+    } else {
+        mov(reg_tmp, l_tail_mask);
+        vmovups(vmm_mask(), ptr[reg_tmp]);
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_conv_kernel_f32<isa>::compute_k_step() {
+    for (int v = 0; v < nv_; ++v)
+        load(vmm_b(v), ptr[reg_b + v * vlen], is_tail(v));
+
+    for (int m = 0; m < m_; ++m) {
+        uni_vbroadcastss(vmm_bcast(),
+                ptr[reg_a + m * jcp.a_stride_m * sizeof(float)]);
+        for (int v = 0; v < nv_; ++v)
+            uni_vfmadd231ps(vmm_acc(m, v), vmm_bcast(), vmm_b(v));
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_conv_kernel_f32<isa>::store_output() {
+    Label skip_accumulation;
+    mov(reg_tmp, ptr[reg_param + GET_OFF(accumulate)]);
+    test(reg_tmp, reg_tmp);
+    jz(skip_accumulation, T_NEAR);
+    for (int m = 0; m < m_; ++m)
+    for (int v = 0; v < nv_; ++v) {
+        load(vmm_tmp(), c_addr(m, v), is_tail(v));
+        uni_vaddps(vmm_acc(m, v), vmm_acc(m, v), vmm_tmp());
+    }
+    L(skip_accumulation);
+
+    if (jcp.with_bias) {
+        mov(reg_tmp, ptr[reg_param + GET_OFF(bias)]);
+        for (int v = 0; v < nv_; ++v) {
+            load(vmm_tmp(), ptr[reg_tmp + v * vlen], is_tail(v));
+            for (int m = 0; m < m_; ++m)
+                uni_vaddps(vmm_acc(m, v), vmm_acc(m, v), vmm_tmp());
+        }
+    }
+
+    if (jcp.with_sum) {
+        const bool scaled = jcp.sum_scale != 1.f;
+        if (scaled) {
+            mov(reg_tmp.cvt32(), float2int(jcp.sum_scale));
+            if (isa == avx512_common) {
+                vpbroadcastd(vmm_scale(), reg_tmp.cvt32());
+            } else {
+                movq(Xmm(vmm_scale().getIdx()), reg_tmp);
+                uni_vbroadcastss(vmm_scale(), Xmm(vmm_scale().getIdx()));
+            }
+        }
+        for (int m = 0; m < m_; ++m)
+        for (int v = 0; v < nv_; ++v) {
+            load(vmm_tmp(), c_addr(m, v), is_tail(v));
+            if (scaled)
+                uni_vfmadd231ps(vmm_acc(m, v), vmm_tmp(), vmm_scale());
+            else
+                uni_vaddps(vmm_acc(m, v), vmm_acc(m, v), vmm_tmp());
+        }
+    }
+
+    if (jcp.with_eltwise)
+        eltwise_injector_->compute_vector_range(0, m_ * nv_);
+
+    for (int m = 0; m < m_; ++m)
+    for (int v = 0; v < nv_; ++v)
+        store(c_addr(m, v), vmm_acc(m, v), is_tail(v));
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_conv_kernel_f32<isa>::generate() {
+    preamble();
+
+    mov(reg_batch, ptr[reg_param + GET_OFF(batch)]);
+    mov(reg_bs, ptr[reg_param + GET_OFF(batch_size)]);
+    mov(reg_c, ptr[reg_param + GET_OFF(c)]);
+
+    if (tail_) prepare_tail_mask();
+
+    for (int m = 0; m < m_; ++m)
+    for (int v = 0; v < nv_; ++v)
+        uni_vpxor(vmm_acc(m, v), vmm_acc(m, v), vmm_acc(m, v));
+
+    Label batch_loop, batch_end, k_loop, k_end;
+    test(reg_bs, reg_bs);
+    jz(batch_end, T_NEAR);
+    L(batch_loop); {
+        mov(reg_a, ptr[reg_batch + GET_BATCH_OFF(a)]);
+        mov(reg_b, ptr[reg_batch + GET_BATCH_OFF(b)]);
+        mov(reg_k, ptr[reg_batch + GET_BATCH_OFF(k)]);
+        test(reg_k, reg_k);
+        jz(k_end, T_NEAR);
+        L(k_loop); {
+            compute_k_step();
+            add(reg_a, jcp.a_stride_k * sizeof(float));
+            add(reg_b, jcp.b_stride_k * sizeof(float));
+            dec(reg_k);
+            jnz(k_loop, T_NEAR);
+        }
+        L(k_end);
+        add(reg_batch, sizeof(jit_nspc_conv_batch_t));
+        dec(reg_bs);
+        jnz(batch_loop, T_NEAR);
+    }
+    L(batch_end);
+
+    store_output();
+
+    postamble();
+
+    if (isa != avx512_common && tail_) {
+        align(64);
+        L(l_tail_mask);
+        for (int i = 0; i < jcp.simd_w; ++i)
+            dd(i < tail_ ? 0xffffffff : 0);
+    }
+
+    if (jcp.with_eltwise)
+        eltwise_injector_->prepare_table();
+}
+
+template <cpu_isa_t isa>
+bool jit_uni_nspc_conv_kernel_f32<isa>::post_ops_ok(
+        const primitive_attr_t &attr) {
+    const auto &p = attr.post_ops_;
+
+    auto is_eltwise = [&](int idx) { return p.entry_[idx].is_eltwise(); };
+    /* the sum scale is applied in the epilogue */
+    auto is_sum = [&](int idx) { return p.entry_[idx].is_sum(false); };
+
+    switch (p.len_) {
+    case 0: return true; // no post_ops
+    case 1: return is_eltwise(0) || is_sum(0); // sum OR eltwise
+    case 2: return is_sum(0) && is_eltwise(1); // sum -> eltwise
+    default: return false;
+    }
+
+    return false;
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_nspc_conv_kernel_f32<isa>::init_conf(
+        jit_nspc_conv_conf_t &jcp, const convolution_desc_t &cd,
+        const memory_desc_wrapper &src_d, const memory_desc_wrapper &weights_d,
+        const memory_desc_wrapper &dst_d, const primitive_attr_t &attr) {
+    if (!mayiuse(isa)) return status::unimplemented;
+
+    jcp = zero<decltype(jcp)>();
+    jcp.prop_kind = cd.prop_kind;
+
+    const bool with_groups = weights_d.ndims() == src_d.ndims() + 1;
+    const int ndims = src_d.ndims();
+    jcp.ndims = ndims;
+
+    jcp.ngroups = with_groups ? weights_d.dims()[0] : 1;
+    jcp.mb = src_d.dims()[0];
+    jcp.oc = dst_d.dims()[1] / jcp.ngroups;
+    jcp.ic = src_d.dims()[1] / jcp.ngroups;
+
+    jcp.id = (ndims == 5) ? src_d.dims()[2] : 1;
+    jcp.ih = (ndims == 3) ? 1 : src_d.dims()[ndims-2];
+    jcp.iw = src_d.dims()[ndims-1];
+    jcp.od = (ndims == 5) ? dst_d.dims()[2] : 1;
+    jcp.oh = (ndims == 3) ? 1 : dst_d.dims()[ndims-2];
+    jcp.ow = dst_d.dims()[ndims-1];
+    jcp.kd = (ndims == 5) ? weights_d.dims()[with_groups + 2] : 1;
+    jcp.kh = (ndims == 3) ? 1 : weights_d.dims()[with_groups + ndims-2];
+    jcp.kw = weights_d.dims()[with_groups + ndims-1];
+
+    jcp.f_pad = (ndims == 5) ? cd.padding[0][0] : 0;
+    jcp.t_pad = (ndims == 3) ? 0 : cd.padding[0][ndims-4];
+    jcp.l_pad = cd.padding[0][ndims-3];
+    jcp.stride_d = (ndims == 5) ? cd.strides[0] : 1;
+    jcp.stride_h = (ndims == 3) ? 1 : cd.strides[ndims-4];
+    jcp.stride_w = cd.strides[ndims-3];
+
+    jcp.dilate_d = (ndims == 5) ? cd.dilates[0] : 0;
+    jcp.dilate_h = (ndims == 3) ? 0 : cd.dilates[ndims-4];
+    jcp.dilate_w = cd.dilates[ndims-3];
+
+    auto dat_tag = pick(ndims - 3, nwc, nhwc, ndhwc);
+    if (!src_d.matches_tag(dat_tag) || !dst_d.matches_tag(dat_tag))
+        return status::unimplemented;
+
+    /* any plain weights will do as long as the dimension handled by vectors
+     * is dense; backward by data works on a transposed copy anyway */
+    const bool is_bwd_d = jcp.prop_kind == backward_data;
+    const auto &wei_strides = weights_d.blocking_desc().strides;
+    const dim_t wei_oc_stride = wei_strides[with_groups + 0];
+    const dim_t wei_ic_stride = wei_strides[with_groups + 1];
+    if (!weights_d.is_plain() || (!is_bwd_d && wei_oc_stride != 1))
+        return status::unimplemented;
+
+    /* backward by data takes bias and post-ops too: this is how the
+     * deconvolution forward is computed */
+    if (one_of(jcp.prop_kind, forward_training, forward_inference,
+                backward_data)) {
+        jcp.with_bias = cd.bias_desc.format_kind != format_kind::undef;
+
+        if (!attr.output_scales_.has_default_values()
+                || !attr.zero_points_default()
+                || !post_ops_ok(attr))
+            return status::unimplemented;
+
+        const auto &p = attr.post_ops_;
+        const int sum_ind = p.find(primitive_kind::sum);
+        jcp.with_sum = sum_ind != -1;
+        if (jcp.with_sum) jcp.sum_scale = p.entry_[sum_ind].sum.scale;
+        const int eltwise_ind = p.find(primitive_kind::eltwise);
+        jcp.with_eltwise = eltwise_ind != -1;
+        if (jcp.with_eltwise) jcp.eltwise = p.entry_[eltwise_ind].eltwise;
+    } else if (!attr.has_default_values()) {
+        return status::unimplemented;
+    }
+
+    jcp.simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+    jcp.n = is_bwd_d ? jcp.ic : jcp.oc;
+
+    const int n_vecs = div_up(jcp.n, jcp.simd_w);
+    jcp.n_block = nstl::min((int)n_block_max, n_vecs);
+    jcp.nb_n = div_up(n_vecs, jcp.n_block);
+    jcp.n_last_block = n_vecs - (jcp.nb_n - 1) * jcp.n_block;
+    jcp.n_tail = jcp.n % jcp.simd_w;
+    jcp.m_block = nstl::min(8, acc_max / jcp.n_block);
+
+    const dim_t src_pix = src_d.blocking_desc().strides[ndims - 1];
+    const dim_t dst_pix = dst_d.blocking_desc().strides[ndims - 1];
+    switch (jcp.prop_kind) {
+    case backward_data:
+        jcp.a_stride_m = dst_pix;
+        jcp.a_stride_k = 1;
+        jcp.b_stride_k = jcp.ic;
+        jcp.c_stride_m = jcp.stride_w * src_pix;
+        break;
+    case backward_weights:
+        jcp.a_stride_m = 1;
+        jcp.a_stride_k = jcp.stride_w * src_pix;
+        jcp.b_stride_k = dst_pix;
+        jcp.c_stride_m = wei_ic_stride;
+        break;
+    default:
+        jcp.a_stride_m = jcp.stride_w * src_pix;
+        jcp.a_stride_k = 1;
+        jcp.b_stride_k = wei_ic_stride;
+        jcp.c_stride_m = dst_pix;
+        break;
+    }
+
+    /* all the offsets are encoded as 32-bit displacements */
+    const dim_t max_disp = jcp.m_block * nstl::max(nstl::max(jcp.a_stride_m,
+            jcp.c_stride_m), nstl::max(jcp.a_stride_k, jcp.b_stride_k))
+        * sizeof(float);
+    if (max_disp >= INT_MAX) return status::unimplemented;
+
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_conv_kernel_f32<isa>::init_scratchpad(
+        memory_tracking::registrar_t &scratchpad,
+        const jit_nspc_conv_conf_t &jcp) {
+    const size_t nthr = mkldnn_get_max_threads();
+
+    size_t batch_size = (size_t)jcp.kd * jcp.kh * jcp.kw;
+    if (jcp.prop_kind == backward_weights)
+        batch_size = (size_t)jcp.od * jcp.oh;
+    scratchpad.book(key_conv_nspc_batch,
+            sizeof(jit_nspc_conv_batch_t) * batch_size * nthr);
+
+    if (jcp.prop_kind == backward_data)
+        scratchpad.book(key_conv_tr_wei, sizeof(float) * jcp.ngroups
+                * jcp.kd * jcp.kh * jcp.kw * jcp.oc * jcp.ic);
+}
+
+template struct jit_uni_nspc_conv_kernel_f32<avx512_common>;
+template struct jit_uni_nspc_conv_kernel_f32<avx2>;
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
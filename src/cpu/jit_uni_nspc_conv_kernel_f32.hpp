@@ -0,0 +1,168 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_UNI_NSPC_CONV_KERNEL_F32_HPP
+#define JIT_UNI_NSPC_CONV_KERNEL_F32_HPP
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+
+#include "jit_generator.hpp"
+#include "jit_uni_eltwise.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Convolution on channels-last data (n[d]hwc activations, [d]hw[i][g]o
+ * weights) is expressed as a sequence of small matrix multiplications:
+ *
+ *     C[m_block][n] (+)= sum over the batch of A_i[m_block][k_i] * B_i[k_i][n]
+ *
+ * where n is the dimension contiguous in memory (oc for forward and
+ * backward by weights, ic for backward by data) and is processed by vectors
+ * with the tail of the last vector masked, so channels need no padding.
+ * Each A row is broadcast element by element and every matrix is described
+ * by constant strides (in elements), the batch carries the base pointers. */
+struct jit_nspc_conv_conf_t {
+    prop_kind_t prop_kind;
+    int ndims;
+    int mb, ngroups, ic, oc; // ic and oc are per group
+    int id, ih, iw, od, oh, ow;
+    int kd, kh, kw;
+    int f_pad, t_pad, l_pad;
+    int stride_d, stride_h, stride_w;
+    int dilate_d, dilate_h, dilate_w;
+
+    bool with_bias, with_sum, with_eltwise;
+    float sum_scale;
+    post_ops_t::entry_t::eltwise_t eltwise;
+
+    int simd_w;
+    int n; // the dimension handled by vectors
+    int n_block; // vectors per kernel call
+    int nb_n; // number of n chunks of n_block vectors
+    int n_last_block; // vectors in the last chunk
+    int n_tail; // valid lanes in the last vector of the last chunk, 0 if full
+    int m_block; // max number of C rows per kernel call
+
+    dim_t a_stride_m, a_stride_k, b_stride_k, c_stride_m;
+};
+
+struct jit_nspc_conv_batch_t {
+    const float *a;
+    const float *b;
+    size_t k;
+};
+
+struct jit_nspc_conv_call_s {
+    const jit_nspc_conv_batch_t *batch;
+    size_t batch_size;
+    float *c;
+    const float *bias;
+    size_t accumulate; // add the result to C instead of overwriting it
+};
+
+template <cpu_isa_t isa>
+struct jit_uni_nspc_conv_kernel_f32: public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_nspc_conv_kernel_f32)
+
+    /* m is the number of C rows, last selects the last (masked) n chunk */
+    jit_uni_nspc_conv_kernel_f32(const jit_nspc_conv_conf_t &ajcp, int m,
+            bool last)
+        : jcp(ajcp), m_(m)
+        , nv_(last ? ajcp.n_last_block : ajcp.n_block)
+        , tail_(last ? ajcp.n_tail : 0)
+        , eltwise_injector_(nullptr)
+    {
+        if (jcp.with_eltwise)
+            eltwise_injector_ = new jit_uni_eltwise_injector_f32<isa>(this,
+                    jcp.eltwise, true, rax, Xbyak::Opmask(1));
+
+        this->generate();
+        jit_ker = (void (*)(jit_nspc_conv_call_s *))this->getCode();
+    }
+
+    ~jit_uni_nspc_conv_kernel_f32() { delete eltwise_injector_; }
+
+    static bool post_ops_ok(const primitive_attr_t &attr);
+    static status_t init_conf(jit_nspc_conv_conf_t &jcp,
+            const convolution_desc_t &cd, const memory_desc_wrapper &src_d,
+            const memory_desc_wrapper &weights_d,
+            const memory_desc_wrapper &dst_d, const primitive_attr_t &attr);
+    static void init_scratchpad(memory_tracking::registrar_t &scratchpad,
+            const jit_nspc_conv_conf_t &jcp);
+
+    /* the upper bound on accumulators and on vectors per row */
+    enum {
+        acc_max = isa == avx512_common ? 24 : 12,
+        n_block_max = isa == avx512_common ? 4 : 2,
+    };
+
+    jit_nspc_conv_conf_t jcp;
+    void (*jit_ker)(jit_nspc_conv_call_s *);
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    using reg64_t = const Xbyak::Reg64;
+    const int vlen = cpu_isa_traits<isa>::vlen;
+
+    const int m_, nv_, tail_;
+
+    reg64_t reg_param = abi_param1;
+    reg64_t reg_batch = r8;
+    reg64_t reg_bs = r9;
+    reg64_t reg_a = r10;
+    reg64_t reg_b = r11;
+    reg64_t reg_k = r12;
+    reg64_t reg_c = r13;
+    reg64_t reg_tmp = r14;
+
+    Xbyak::Opmask k_tail = Xbyak::Opmask(2);
+
+    Vmm vmm_acc(int m, int v) { return Vmm(m * nv_ + v); }
+    Vmm vmm_b(int v) { return Vmm(acc_max + v); }
+    Vmm vmm_bcast() { return Vmm(acc_max + n_block_max); }
+    Vmm vmm_mask() { return Vmm(acc_max + n_block_max + 1); }
+    /* the temporaries are used in the epilogue only */
+    Vmm vmm_tmp() { return vmm_b(0); }
+    Vmm vmm_scale() { return vmm_b(1); }
+
+    bool is_tail(int v) const { return tail_ && v == nv_ - 1; }
+    Xbyak::Address c_addr(int m, int v) {
+        return ptr[reg_c
+            + (m * jcp.c_stride_m + v * jcp.simd_w) * sizeof(float)];
+    }
+
+    void load(const Vmm &vmm, const Xbyak::Address &addr, bool tail);
+    void store(const Xbyak::Address &addr, const Vmm &vmm, bool tail);
+    void prepare_tail_mask();
+    void compute_k_step();
+    void store_output();
+
+    jit_uni_eltwise_injector_f32<isa> *eltwise_injector_;
+    Xbyak::Label l_tail_mask;
+
+    void generate();
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,402 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_uni_nspc_convolution.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace mkldnn::impl::memory_tracking::names;
+using namespace mkldnn::impl::utils;
+
+#define dat_blk_off(f, n, c, d, h, w) \
+    (pd()->ndims() == 3) \
+    ? (f).blk_off(n, c, w) \
+    : (pd()->ndims() == 4) \
+    ? (f).blk_off(n, c, h, w) \
+    : (f).blk_off(n, c, d, h, w)
+
+#define wht_blk_off_(f, g, ...) \
+    pd()->with_groups() ? (f).blk_off(g, __VA_ARGS__) : (f).blk_off(__VA_ARGS__)
+#define wht_blk_off(f, g, oc, ic, kd, kh, kw) \
+    (pd()->ndims() == 3) \
+    ? wht_blk_off_(f, g, oc, ic, kw) \
+    : (pd()->ndims() == 4) \
+    ? wht_blk_off_(f, g, oc, ic, kh, kw) \
+    : wht_blk_off_(f, g, oc, ic, kd, kh, kw)
+
+namespace {
+/* Classifies the taps of a block of m output points with the first input
+ * point i (the others follow with stride s) against the range [0, len):
+ * returns 1 if the whole block is inside, 0 if it is outside and -1 if the
+ * block crosses the border */
+inline int block_inside(int i, int m, int s, int len) {
+    const int i_last = i + (m - 1) * s;
+    if (i >= 0 && i_last < len) return 1;
+    if (i_last < 0 || i >= len) return 0;
+    return -1;
+}
+
+/* Returns the output point the input point i is computed from by the tap
+ * with offset t (i = o * s + t), or -1 if there is no such point */
+inline int src_to_dst(int i, int t, int s, int len) {
+    const int x = i - t;
+    if (x < 0 || x % s != 0 || x / s >= len) return -1;
+    return x / s;
+}
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_convolution_fwd_t<isa>::execute_forward(
+        const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SRC);
+    auto weights = CTX_IN_MEM(const data_t *, MKLDNN_ARG_WEIGHTS);
+    auto bias = CTX_IN_MEM(const data_t *, MKLDNN_ARG_BIAS);
+    auto dst = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DST);
+
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper dst_d(pd()->dst_md());
+    const memory_desc_wrapper weights_d(pd()->weights_md(0));
+    const memory_desc_wrapper bias_d(pd()->weights_md(1));
+
+    const auto &jcp = pd()->jcp_;
+    auto batch_base = scratchpad(ctx).template get<jit_nspc_conv_batch_t>(
+            key_conv_nspc_batch);
+
+    const int n_chunk = jcp.n_block * jcp.simd_w;
+    const int nb_ow = div_up(jcp.ow, jcp.m_block);
+    const size_t work_amount = (size_t)jcp.mb * jcp.ngroups * jcp.od * jcp.oh
+        * nb_ow * jcp.nb_n;
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        size_t start{0}, end{0};
+        balance211(work_amount, nthr, ithr, start, end);
+
+        auto batch = batch_base + (size_t)ithr * jcp.kd * jcp.kh * jcp.kw;
+
+        auto compute = [&](int n, int g, int od, int oh, int ow, int m,
+                int ocb) {
+            const int oc = ocb * n_chunk;
+            int bs = 0;
+            for (int kd = 0; kd < jcp.kd; ++kd) {
+                const int id = od * jcp.stride_d - jcp.f_pad
+                    + kd * (jcp.dilate_d + 1);
+                if (id < 0 || id >= jcp.id) continue;
+                for (int kh = 0; kh < jcp.kh; ++kh) {
+                    const int ih = oh * jcp.stride_h - jcp.t_pad
+                        + kh * (jcp.dilate_h + 1);
+                    if (ih < 0 || ih >= jcp.ih) continue;
+                    for (int kw = 0; kw < jcp.kw; ++kw) {
+                        const int iw = ow * jcp.stride_w - jcp.l_pad
+                            + kw * (jcp.dilate_w + 1);
+                        if (!block_inside(iw, m, jcp.stride_w, jcp.iw))
+                            continue;
+                        batch[bs].a = &src[dat_blk_off(src_d, n,
+                                g * jcp.ic, id, ih, iw)];
+                        batch[bs].b = &weights[wht_blk_off(weights_d, g,
+                                oc, 0, kd, kh, kw)];
+                        batch[bs].k = jcp.ic;
+                        ++bs;
+                    }
+                }
+            }
+
+            auto p = jit_nspc_conv_call_s();
+            p.batch = batch;
+            p.batch_size = bs;
+            p.c = &dst[dat_blk_off(dst_d, n, g * jcp.oc + oc, od, oh, ow)];
+            if (bias) p.bias = &bias[bias_d.blk_off(g * jcp.oc + oc)];
+            kernels_(m, ocb == jcp.nb_n - 1, &p);
+        };
+
+        int n{0}, g{0}, od{0}, oh{0}, owb{0}, ocb{0};
+        nd_iterator_init(start, n, jcp.mb, g, jcp.ngroups, od, jcp.od,
+                oh, jcp.oh, owb, nb_ow, ocb, jcp.nb_n);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            const int ow = owb * jcp.m_block;
+            const int m = nstl::min(jcp.m_block, jcp.ow - ow);
+
+            /* the blocks crossing the left or the right border are
+             * computed point by point */
+            bool crosses_border = false;
+            for (int kw = 0; kw < jcp.kw; ++kw) {
+                const int iw = ow * jcp.stride_w - jcp.l_pad
+                    + kw * (jcp.dilate_w + 1);
+                if (block_inside(iw, m, jcp.stride_w, jcp.iw) < 0)
+                    crosses_border = true;
+            }
+
+            if (crosses_border) {
+                for (int i = 0; i < m; ++i)
+                    compute(n, g, od, oh, ow + i, 1, ocb);
+            } else {
+                compute(n, g, od, oh, ow, m, ocb);
+            }
+
+            nd_iterator_step(n, jcp.mb, g, jcp.ngroups, od, jcp.od,
+                    oh, jcp.oh, owb, nb_ow, ocb, jcp.nb_n);
+        }
+    });
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_convolution_bwd_data_t<isa>::execute_backward_data(
+        const exec_ctx_t &ctx) const {
+    auto diff_dst = CTX_IN_MEM(const data_t *, MKLDNN_ARG_DIFF_DST);
+    auto weights = CTX_IN_MEM(const data_t *, MKLDNN_ARG_WEIGHTS);
+    auto bias = CTX_IN_MEM(const data_t *, MKLDNN_ARG_BIAS);
+    auto diff_src = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DIFF_SRC);
+
+    const memory_desc_wrapper diff_dst_d(pd()->diff_dst_md());
+    const memory_desc_wrapper diff_src_d(pd()->diff_src_md());
+    const memory_desc_wrapper weights_d(pd()->weights_md(0));
+    const memory_desc_wrapper bias_d(pd()->weights_md(1));
+
+    const auto &jcp = pd()->jcp_;
+    auto scratchpad = this->scratchpad(ctx);
+    auto batch_base = scratchpad.template get<jit_nspc_conv_batch_t>(
+            key_conv_nspc_batch);
+    auto tr_wei = scratchpad.template get<data_t>(key_conv_tr_wei);
+
+    /* ic is the dimension handled by vectors, so the weights are transposed
+     * to [g][kd][kh][kw][oc][ic] */
+    const size_t tr_wei_tap_size = (size_t)jcp.oc * jcp.ic;
+    parallel_nd(jcp.ngroups, jcp.kd, jcp.kh, jcp.kw, jcp.oc,
+            [&](int g, int kd, int kh, int kw, int oc) {
+        const size_t tap = ((size_t)(g * jcp.kd + kd) * jcp.kh + kh) * jcp.kw
+            + kw;
+        data_t *tr = &tr_wei[tap * tr_wei_tap_size + (size_t)oc * jcp.ic];
+        for (int ic = 0; ic < jcp.ic; ++ic)
+            tr[ic] = weights[wht_blk_off(weights_d, g, oc, ic, kd, kh, kw)];
+    });
+
+    /* diff_src points of the same residue modulo stride_w are computed by
+     * the same set of taps, so the rows of a block are taken from one
+     * residue class */
+    const int n_chunk = jcp.n_block * jcp.simd_w;
+    const int nb_iw = div_up(div_up(jcp.iw, jcp.stride_w), jcp.m_block);
+    const size_t work_amount = (size_t)jcp.mb * jcp.ngroups * jcp.id * jcp.ih
+        * jcp.stride_w * nb_iw * jcp.nb_n;
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        size_t start{0}, end{0};
+        balance211(work_amount, nthr, ithr, start, end);
+
+        auto batch = batch_base + (size_t)ithr * jcp.kd * jcp.kh * jcp.kw;
+
+        auto compute = [&](int n, int g, int id, int ih, int iw, int m,
+                int icb) {
+            const int ic = icb * n_chunk;
+            int bs = 0;
+            for (int kd = 0; kd < jcp.kd; ++kd) {
+                const int od = src_to_dst(id + jcp.f_pad,
+                        kd * (jcp.dilate_d + 1), jcp.stride_d, jcp.od);
+                if (od < 0) continue;
+                for (int kh = 0; kh < jcp.kh; ++kh) {
+                    const int oh = src_to_dst(ih + jcp.t_pad,
+                            kh * (jcp.dilate_h + 1), jcp.stride_h, jcp.oh);
+                    if (oh < 0) continue;
+                    for (int kw = 0; kw < jcp.kw; ++kw) {
+                        const int x = iw + jcp.l_pad - kw * (jcp.dilate_w + 1);
+                        if ((x % jcp.stride_w + jcp.stride_w) % jcp.stride_w)
+                            continue;
+                        const int ow = x / jcp.stride_w;
+                        if (!block_inside(ow, m, 1, jcp.ow)) continue;
+                        const size_t tap = ((size_t)(g * jcp.kd + kd) * jcp.kh
+                                + kh) * jcp.kw + kw;
+                        batch[bs].a = &diff_dst[dat_blk_off(diff_dst_d, n,
+                                g * jcp.oc, od, oh, ow)];
+                        batch[bs].b = &tr_wei[tap * tr_wei_tap_size + ic];
+                        batch[bs].k = jcp.oc;
+                        ++bs;
+                    }
+                }
+            }
+
+            auto p = jit_nspc_conv_call_s();
+            p.batch = batch;
+            p.batch_size = bs;
+            p.c = &diff_src[dat_blk_off(diff_src_d, n, g * jcp.ic + ic,
+                    id, ih, iw)];
+            if (bias) p.bias = &bias[bias_d.blk_off(g * jcp.ic + ic)];
+            kernels_(m, icb == jcp.nb_n - 1, &p);
+        };
+
+        int n{0}, g{0}, id{0}, ih{0}, r{0}, iwb{0}, icb{0};
+        nd_iterator_init(start, n, jcp.mb, g, jcp.ngroups, id, jcp.id,
+                ih, jcp.ih, r, jcp.stride_w, iwb, nb_iw, icb, jcp.nb_n);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            const int iw = r + iwb * jcp.m_block * jcp.stride_w;
+            const int m = iw < jcp.iw ? nstl::min(jcp.m_block,
+                    div_up(jcp.iw - iw, jcp.stride_w)) : 0;
+
+            bool crosses_border = false;
+            for (int kw = 0; kw < jcp.kw && m > 0; ++kw) {
+                const int x = iw + jcp.l_pad - kw * (jcp.dilate_w + 1);
+                if ((x % jcp.stride_w + jcp.stride_w) % jcp.stride_w)
+                    continue;
+                const int ow = x / jcp.stride_w;
+                if (block_inside(ow, m, 1, jcp.ow) < 0)
+                    crosses_border = true;
+            }
+
+            if (crosses_border) {
+                for (int i = 0; i < m; ++i)
+                    compute(n, g, id, ih, iw + i * jcp.stride_w, 1, icb);
+            } else if (m > 0) {
+                compute(n, g, id, ih, iw, m, icb);
+            }
+
+            nd_iterator_step(n, jcp.mb, g, jcp.ngroups, id, jcp.id,
+                    ih, jcp.ih, r, jcp.stride_w, iwb, nb_iw, icb, jcp.nb_n);
+        }
+    });
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_convolution_bwd_weights_t<isa>::execute_backward_weights(
+        const exec_ctx_t &ctx) const {
+    auto diff_dst = CTX_IN_MEM(const data_t *, MKLDNN_ARG_DIFF_DST);
+    auto src = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SRC);
+    auto diff_weights = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DIFF_WEIGHTS);
+
+    const memory_desc_wrapper diff_dst_d(pd()->diff_dst_md());
+    const memory_desc_wrapper src_d(pd()->src_md());
+    const memory_desc_wrapper diff_weights_d(pd()->diff_weights_md(0));
+
+    const auto &jcp = pd()->jcp_;
+    auto batch_base = scratchpad(ctx).template get<jit_nspc_conv_batch_t>(
+            key_conv_nspc_batch);
+
+    /* every thread owns a set of (tap, ic block, oc chunk) of the diff
+     * weights and reduces over the minibatch and the spatial dims, the rows
+     * of a block being input channels */
+    const int n_chunk = jcp.n_block * jcp.simd_w;
+    const int nb_ic = div_up(jcp.ic, jcp.m_block);
+    const size_t work_amount = (size_t)jcp.ngroups * jcp.kd * jcp.kh * jcp.kw
+        * nb_ic * jcp.nb_n;
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        size_t start{0}, end{0};
+        balance211(work_amount, nthr, ithr, start, end);
+
+        auto batch = batch_base + (size_t)ithr * jcp.od * jcp.oh;
+
+        int g{0}, kd{0}, kh{0}, kw{0}, icb{0}, ocb{0};
+        nd_iterator_init(start, g, jcp.ngroups, kd, jcp.kd, kh, jcp.kh,
+                kw, jcp.kw, icb, nb_ic, ocb, jcp.nb_n);
+        for (size_t iwork = start; iwork < end; ++iwork) {
+            const int ic = icb * jcp.m_block;
+            const int m = nstl::min(jcp.m_block, jcp.ic - ic);
+            const int oc = ocb * n_chunk;
+
+            /* the range of ow reading the valid input points */
+            const int w_off = jcp.l_pad - kw * (jcp.dilate_w + 1);
+            const int ow_s = w_off <= 0 ? 0 : div_up(w_off, jcp.stride_w);
+            const int ow_e = jcp.iw - 1 + w_off < 0 ? 0 : nstl::min(jcp.ow,
+                    (jcp.iw - 1 + w_off) / jcp.stride_w + 1);
+
+            auto p = jit_nspc_conv_call_s();
+            p.batch = batch;
+            p.c = &diff_weights[wht_blk_off(diff_weights_d, g, oc, ic,
+                    kd, kh, kw)];
+
+            for (int n = 0; n < jcp.mb; ++n) {
+                int bs = 0;
+                for (int od = 0; od < jcp.od && ow_s < ow_e; ++od) {
+                    const int id = od * jcp.stride_d - jcp.f_pad
+                        + kd * (jcp.dilate_d + 1);
+                    if (id < 0 || id >= jcp.id) continue;
+                    for (int oh = 0; oh < jcp.oh; ++oh) {
+                        const int ih = oh * jcp.stride_h - jcp.t_pad
+                            + kh * (jcp.dilate_h + 1);
+                        if (ih < 0 || ih >= jcp.ih) continue;
+                        batch[bs].a = &src[dat_blk_off(src_d, n,
+                                g * jcp.ic + ic, id, ih,
+                                ow_s * jcp.stride_w - w_off)];
+                        batch[bs].b = &diff_dst[dat_blk_off(diff_dst_d, n,
+                                g * jcp.oc + oc, od, oh, ow_s)];
+                        batch[bs].k = ow_e - ow_s;
+                        ++bs;
+                    }
+                }
+
+                p.batch_size = bs;
+                p.accumulate = n > 0;
+                kernels_(m, ocb == jcp.nb_n - 1, &p);
+            }
+
+            nd_iterator_step(g, jcp.ngroups, kd, jcp.kd, kh, jcp.kh,
+                    kw, jcp.kw, icb, nb_ic, ocb, jcp.nb_n);
+        }
+    });
+
+    if (pd()->with_bias()) compute_diff_bias(ctx);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_convolution_bwd_weights_t<isa>::compute_diff_bias(
+        const exec_ctx_t &ctx) const {
+    auto diff_dst = CTX_IN_MEM(const data_t *, MKLDNN_ARG_DIFF_DST);
+    auto diff_bias = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DIFF_BIAS);
+
+    const memory_desc_wrapper diff_dst_d(pd()->diff_dst_md());
+    const memory_desc_wrapper diff_bias_d(pd()->diff_weights_md(1));
+
+    const auto &jcp = pd()->jcp_;
+    const int oc_block = 16;
+    const int nb_oc = div_up(jcp.oc, oc_block);
+
+    parallel_nd(jcp.ngroups, nb_oc, [&](int g, int ocb) {
+        const int oc = g * jcp.oc + ocb * oc_block;
+        const int len = nstl::min(oc_block, jcp.oc - ocb * oc_block);
+
+        data_t db[oc_block] = {0};
+        for (int n = 0; n < jcp.mb; ++n)
+        for (int od = 0; od < jcp.od; ++od)
+        for (int oh = 0; oh < jcp.oh; ++oh)
+        for (int ow = 0; ow < jcp.ow; ++ow) {
+            const data_t *d = &diff_dst[dat_blk_off(diff_dst_d, n, oc,
+                    od, oh, ow)];
+            PRAGMA_OMP_SIMD()
+            for (int i = 0; i < len; ++i)
+                db[i] += d[i];
+        }
+
+        for (int i = 0; i < len; ++i)
+            diff_bias[diff_bias_d.off(oc + i)] = db[i];
+    });
+}
+
+template struct jit_uni_nspc_convolution_fwd_t<avx512_common>;
+template struct jit_uni_nspc_convolution_fwd_t<avx2>;
+template struct jit_uni_nspc_convolution_bwd_data_t<avx512_common>;
+template struct jit_uni_nspc_convolution_bwd_data_t<avx2>;
+template struct jit_uni_nspc_convolution_bwd_weights_t<avx512_common>;
+template struct jit_uni_nspc_convolution_bwd_weights_t<avx2>;
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
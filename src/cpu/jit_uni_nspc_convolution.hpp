@@ -0,0 +1,262 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_JIT_UNI_NSPC_CONVOLUTION_HPP
+#define CPU_JIT_UNI_NSPC_CONVOLUTION_HPP
+
+#include "c_types_map.hpp"
+#include "memory_tracking.hpp"
+#include "utils.hpp"
+
+#include "cpu_convolution_pd.hpp"
+#include "cpu_primitive.hpp"
+
+#include "jit_uni_nspc_conv_kernel_f32.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Kernels for every number of rows up to m_block, for the full n chunks and
+ * (if it differs) for the last one */
+template <cpu_isa_t isa>
+struct jit_uni_nspc_conv_kernels_t {
+    using kernel_t = jit_uni_nspc_conv_kernel_f32<isa>;
+
+    jit_uni_nspc_conv_kernels_t(const jit_nspc_conv_conf_t &jcp) {
+        const bool need_last = jcp.n_tail != 0
+            || jcp.n_last_block != jcp.n_block;
+        for (int m = 1; m <= jcp.m_block; ++m) {
+            kernels_[0][m - 1] = new kernel_t(jcp, m, false);
+            kernels_[1][m - 1] = need_last
+                ? new kernel_t(jcp, m, true) : kernels_[0][m - 1];
+        }
+    }
+
+    ~jit_uni_nspc_conv_kernels_t() {
+        const int m_block = kernels_[0][0]->jcp.m_block;
+        for (int m = 0; m < m_block; ++m) {
+            if (kernels_[1][m] != kernels_[0][m]) delete kernels_[1][m];
+            delete kernels_[0][m];
+        }
+    }
+
+    void operator()(int m, bool last, jit_nspc_conv_call_s *p) const
+    { kernels_[last][m - 1]->jit_ker(p); }
+
+private:
+    kernel_t *kernels_[2][8];
+};
+
+template <cpu_isa_t isa>
+struct jit_uni_nspc_convolution_fwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_convolution_fwd_pd_t {
+        pd_t(engine_t *engine, const convolution_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const typename pd_t::base_class *hint_fwd_pd)
+            : cpu_convolution_fwd_pd_t(engine, adesc, attr, hint_fwd_pd)
+            , jcp_() {}
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit_nspc:", isa, ""),
+                jit_uni_nspc_convolution_fwd_t<isa>);
+
+        status_t init() {
+            using namespace format_tag;
+
+            auto dat_tag = utils::pick(ndims() - 3, nwc, nhwc, ndhwc);
+            auto wei_tag = with_groups()
+                ? (ndims() == 4 ? hwigo : format_tag::undef)
+                : utils::pick(ndims() - 3, wio, hwio, dhwio);
+
+            bool ok = true
+                && is_fwd()
+                && set_default_alg_kind(alg_kind::convolution_direct)
+                && expect_data_types(data_type::f32, data_type::f32,
+                        data_type::f32, data_type::f32, data_type::f32)
+                && !has_zero_dim_memory()
+                && set_default_formats_common(dat_tag, wei_tag, dat_tag);
+            if (!ok) return status::unimplemented;
+
+            status_t status = jit_uni_nspc_conv_kernel_f32<isa>::init_conf(
+                    jcp_, *desc(), *src_md(), *weights_md(), *dst_md(),
+                    *attr());
+            if (status != status::success) return status;
+
+            auto scratchpad = scratchpad_registry().registrar();
+            jit_uni_nspc_conv_kernel_f32<isa>::init_scratchpad(scratchpad,
+                    jcp_);
+
+            return status::success;
+        }
+
+        jit_nspc_conv_conf_t jcp_;
+    };
+
+    jit_uni_nspc_convolution_fwd_t(const pd_t *apd)
+        : cpu_primitive_t(apd), kernels_(pd()->jcp_) {}
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual status_t execute(const exec_ctx_t &ctx) const override {
+        execute_forward(ctx);
+        return status::success;
+    }
+
+private:
+    void execute_forward(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    jit_uni_nspc_conv_kernels_t<isa> kernels_;
+};
+
+template <cpu_isa_t isa>
+struct jit_uni_nspc_convolution_bwd_data_t: public cpu_primitive_t {
+    struct pd_t: public cpu_convolution_bwd_data_pd_t {
+        pd_t(engine_t *engine, const convolution_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const convolution_fwd_pd_t *hint_fwd_pd)
+            : cpu_convolution_bwd_data_pd_t(engine, adesc, attr, hint_fwd_pd)
+            , jcp_() {}
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit_nspc:", isa, ""),
+                jit_uni_nspc_convolution_bwd_data_t<isa>);
+
+        status_t init() {
+            using namespace format_tag;
+
+            auto dat_tag = utils::pick(ndims() - 3, nwc, nhwc, ndhwc);
+            auto wei_tag = with_groups()
+                ? (ndims() == 4 ? hwigo : format_tag::undef)
+                : utils::pick(ndims() - 3, wio, hwio, dhwio);
+
+            bool ok = true
+                && desc()->prop_kind == prop_kind::backward_data
+                && set_default_alg_kind(alg_kind::convolution_direct)
+                && expect_data_types(data_type::f32, data_type::f32,
+                        data_type::f32, data_type::f32, data_type::f32)
+                && !has_zero_dim_memory()
+                && set_default_formats_common(dat_tag, wei_tag, dat_tag);
+            if (!ok) return status::unimplemented;
+
+            status_t status = jit_uni_nspc_conv_kernel_f32<isa>::init_conf(
+                    jcp_, *desc(), *diff_src_md(), *weights_md(),
+                    *diff_dst_md(), *attr());
+            if (status != status::success) return status;
+
+            auto scratchpad = scratchpad_registry().registrar();
+            jit_uni_nspc_conv_kernel_f32<isa>::init_scratchpad(scratchpad,
+                    jcp_);
+
+            return status::success;
+        }
+
+        /* bias and post-ops are applied in the store epilogue */
+        virtual bool support_bias() const override { return true; }
+        virtual bool support_post_ops() const override { return true; }
+
+        jit_nspc_conv_conf_t jcp_;
+    };
+
+    jit_uni_nspc_convolution_bwd_data_t(const pd_t *apd)
+        : cpu_primitive_t(apd), kernels_(pd()->jcp_) {}
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual status_t execute(const exec_ctx_t &ctx) const override {
+        execute_backward_data(ctx);
+        return status::success;
+    }
+
+private:
+    void execute_backward_data(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    jit_uni_nspc_conv_kernels_t<isa> kernels_;
+};
+
+template <cpu_isa_t isa>
+struct jit_uni_nspc_convolution_bwd_weights_t: public cpu_primitive_t {
+    struct pd_t: public cpu_convolution_bwd_weights_pd_t {
+        pd_t(engine_t *engine, const convolution_desc_t *adesc,
+                const primitive_attr_t *attr,
+                const convolution_fwd_pd_t *hint_fwd_pd)
+            : cpu_convolution_bwd_weights_pd_t(engine, adesc, attr,
+                    hint_fwd_pd)
+            , jcp_() {}
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit_nspc:", isa, ""),
+                jit_uni_nspc_convolution_bwd_weights_t<isa>);
+
+        status_t init() {
+            using namespace format_tag;
+
+            auto dat_tag = utils::pick(ndims() - 3, nwc, nhwc, ndhwc);
+            auto wei_tag = with_groups()
+                ? (ndims() == 4 ? hwigo : format_tag::undef)
+                : utils::pick(ndims() - 3, wio, hwio, dhwio);
+
+            bool ok = true
+                && desc()->prop_kind == prop_kind::backward_weights
+                && set_default_alg_kind(alg_kind::convolution_direct)
+                && expect_data_types(data_type::f32, data_type::f32,
+                        data_type::f32, data_type::f32, data_type::f32)
+                && !has_zero_dim_memory()
+                && set_default_formats_common(dat_tag, wei_tag, dat_tag);
+            if (!ok) return status::unimplemented;
+
+            status_t status = jit_uni_nspc_conv_kernel_f32<isa>::init_conf(
+                    jcp_, *desc(), *src_md(), *diff_weights_md(),
+                    *diff_dst_md(), *attr());
+            if (status != status::success) return status;
+
+            auto scratchpad = scratchpad_registry().registrar();
+            jit_uni_nspc_conv_kernel_f32<isa>::init_scratchpad(scratchpad,
+                    jcp_);
+
+            return status::success;
+        }
+
+        jit_nspc_conv_conf_t jcp_;
+    };
+
+    jit_uni_nspc_convolution_bwd_weights_t(const pd_t *apd)
+        : cpu_primitive_t(apd), kernels_(pd()->jcp_) {}
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual status_t execute(const exec_ctx_t &ctx) const override {
+        execute_backward_weights(ctx);
+        return status::success;
+    }
+
+private:
+    void execute_backward_weights(const exec_ctx_t &ctx) const;
+    void compute_diff_bias(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    jit_uni_nspc_conv_kernels_t<isa> kernels_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
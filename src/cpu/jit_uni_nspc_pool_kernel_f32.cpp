@@ -0,0 +1,363 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <limits.h>
+
+#include "c_types_map.hpp"
+#include "nstl.hpp"
+#include "utils.hpp"
+
+#include "jit_uni_nspc_pool_kernel_f32.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace Xbyak;
+using namespace alg_kind;
+
+#define GET_OFF(field) offsetof(jit_nspc_pool_call_s, field)
+
+template <cpu_isa_t isa>
+status_t jit_uni_nspc_pool_kernel_f32<isa>::init_conf(
+        jit_nspc_pool_conf_t &jpp, const pooling_pd_t *ppd) {
+    const auto &pd = *ppd->desc();
+    const memory_desc_wrapper src_d(
+            ppd->is_fwd() ? ppd->src_md() : ppd->diff_src_md());
+    const memory_desc_wrapper dst_d(
+            ppd->is_fwd() ? ppd->dst_md() : ppd->diff_dst_md());
+
+    bool args_ok = true
+        && mayiuse(isa)
+        && utils::one_of(pd.alg_kind, pooling_max,
+                pooling_avg_include_padding,
+                pooling_avg_exclude_padding);
+    if (!args_ok) return status::unimplemented;
+
+    const int ndims = src_d.ndims();
+
+    jpp.ndims = ndims;
+    jpp.mb = src_d.dims()[0];
+    jpp.c = src_d.dims()[1];
+
+    jpp.id = (ndims == 5) ? src_d.dims()[2] : 1;
+    jpp.ih = src_d.dims()[ndims-2];
+    jpp.iw = src_d.dims()[ndims-1];
+    jpp.od = (ndims == 5) ? dst_d.dims()[2] : 1;
+    jpp.oh = dst_d.dims()[ndims-2];
+    jpp.ow = dst_d.dims()[ndims-1];
+
+    jpp.stride_d = (ndims == 5 ) ? pd.strides[0] : 1;
+    jpp.stride_h = pd.strides[ndims-4];
+    jpp.stride_w = pd.strides[ndims-3];
+    jpp.kd = (ndims == 5) ? pd.kernel[0] : 1;
+    jpp.kh = pd.kernel[ndims-4];
+    jpp.kw = pd.kernel[ndims-3];
+
+    jpp.f_pad = (ndims == 5 ) ? pd.padding[0][0] : 0;
+    jpp.t_pad = pd.padding[0][ndims-4];
+    jpp.l_pad = pd.padding[0][ndims-3];
+
+    jpp.alg = pd.alg_kind;
+    jpp.is_backward = !ppd->is_fwd();
+    jpp.ind_dt = ppd->workspace_md()
+        ? ppd->workspace_md()->data_type : data_type::undef;
+
+    /* the window is walked with 32-bit displacements */
+    if ((size_t)jpp.ih * jpp.iw * jpp.c * sizeof(float) >= INT_MAX)
+        return status::unimplemented;
+
+    jpp.simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+    jpp.nv = nv_max;
+    const int chunk = jpp.nv * jpp.simd_w;
+    jpp.nb_chunks = utils::div_up(jpp.c, chunk);
+    jpp.last_nv = utils::div_up(jpp.c - (jpp.nb_chunks - 1) * chunk,
+            jpp.simd_w);
+    jpp.tail = jpp.c % jpp.simd_w;
+
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_pool_kernel_f32<isa>::load(const Vmm &vmm,
+        const Address &addr, bool tail) {
+    if (!tail)
+        uni_vmovups(vmm, addr);
+    else if (isa == avx512_common)
+        vmovups(vmm | k_tail | T_z, addr);
+    else
+        vmaskmovps(vmm, vmm_mask(), addr);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_pool_kernel_f32<isa>::store(const Address &addr,
+        const Vmm &vmm, bool tail) {
+    if (!tail)
+        uni_vmovups(addr, vmm);
+    else if (isa == avx512_common)
+        vmovups(addr | k_tail, vmm);
+    else
+        vmaskmovps(addr, vmm_mask(), vmm);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_pool_kernel_f32<isa>::load_indices(int v) {
+    const bool tail = is_tail(v);
+    const Vmm vmm = vmm_ind(v);
+    if (jpp.ind_dt == data_type::s32) {
+        load(vmm, ptr[reg_ind + v * vlen], tail);
+        return;
+    }
+
+    const int off = v * jpp.simd_w;
+    if (isa == avx512_common) {
+        if (tail)
+            vpmovzxbd(vmm | k_tail | T_z, ptr[reg_ind + off]);
+        else
+            vpmovzxbd(vmm, ptr[reg_ind + off]);
+    } else if (tail) {
+        /* gather the bytes one by one not to read past the row */
+        xor_(reg_tmp, reg_tmp);
+        for (int i = tail_ - 1; i >= 0; --i) {
+            shl(reg_tmp, 8);
+            mov(reg_tmp.cvt8(), ptr[reg_ind + off + i]);
+        }
+        vmovq(Xmm(vmm.getIdx()), reg_tmp);
+        vpmovzxbd(vmm, Xmm(vmm.getIdx()));
+    } else {
+        vpmovzxbd(vmm, ptr[reg_ind + off]);
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_pool_kernel_f32<isa>::store_indices(int v) {
+    const bool tail = is_tail(v);
+    const Vmm vmm = vmm_ind(v);
+    if (jpp.ind_dt == data_type::s32) {
+        store(ptr[reg_ind + v * vlen], vmm, tail);
+        return;
+    }
+
+    const int off = v * jpp.simd_w;
+    const int n = tail ? tail_ : jpp.simd_w;
+    Xmm xmm(vmm.getIdx()), xmm_tmp(vmm_tmp().getIdx());
+    if (isa == avx512_common) {
+        vpmovdb(xmm, vmm);
+    } else {
+        vextracti128(xmm_tmp, vmm, 1);
+        vpackssdw(xmm, xmm, xmm_tmp);
+        vpackuswb(xmm, xmm, xmm);
+    }
+    if (n == 16)
+        vmovups(ptr[reg_ind + off], xmm);
+    else if (n == 8)
+        vmovq(ptr[reg_ind + off], xmm);
+    else
+        store_bytes(reg_ind, off, xmm, n);
+}
+
+/* masked byte stores need avx512bw, so the bytes past the first qword are
+ * stored one by one */
+template <cpu_isa_t isa>
+void jit_uni_nspc_pool_kernel_f32<isa>::store_bytes(const Reg64 &base,
+        int off, const Xmm &xmm, int n) {
+    if (n >= 8) {
+        vmovq(ptr[base + off], xmm);
+        vpextrq(reg_tmp, xmm, 1);
+        off += 8;
+        n -= 8;
+    } else {
+        vmovq(reg_tmp, xmm);
+    }
+    for (int i = 0; i < n; ++i) {
+        mov(ptr[base + off + i], reg_tmp.cvt8());
+        shr(reg_tmp, 8);
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_pool_kernel_f32<isa>::prepare_tail_mask() {
+    if (isa == avx512_common) {
+        mov(reg_tmp.cvt32(), (1 << tail_) - 1);
+        kmovw(k_tail, reg_tmp.cvt32());
+    } else {
+        mov(reg_tmp, l_tail_mask);
+        vmovups(vmm_mask(), ptr[reg_tmp]);
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_pool_kernel_f32<isa>::compute_tap() {
+    const bool is_max = jpp.alg == pooling_max;
+
+    if (is_max && with_indices()) {
+        if (isa == avx512_common) {
+            vpbroadcastd(vmm_idx(), reg_idx.cvt32());
+        } else {
+            vmovq(Xmm(vmm_idx().getIdx()), reg_idx);
+            vpbroadcastd(vmm_idx(), Xmm(vmm_idx().getIdx()));
+        }
+    }
+
+    for (int v = 0; v < nv_; ++v) {
+        const bool tail = is_tail(v);
+        const Address win_addr = ptr[aux_reg_w + v * vlen];
+        load(vmm_tmp(), win_addr, tail);
+
+        if (!jpp.is_backward) {
+            if (!is_max) {
+                uni_vaddps(vmm_acc(v), vmm_acc(v), vmm_tmp());
+            } else if (!with_indices()) {
+                uni_vmaxps(vmm_acc(v), vmm_acc(v), vmm_tmp());
+            } else if (isa == avx512_common) {
+                vcmpps(k_cmp, vmm_acc(v), vmm_tmp(), _cmp_lt_os);
+                vblendmps(vmm_acc(v) | k_cmp, vmm_acc(v), vmm_tmp());
+                vpblendmd(vmm_ind(v) | k_cmp, vmm_ind(v), vmm_idx());
+            } else {
+                vcmpps(vmm_tmp2(), vmm_acc(v), vmm_tmp(), _cmp_lt_os);
+                vblendvps(vmm_acc(v), vmm_acc(v), vmm_tmp(), vmm_tmp2());
+                vblendvps(vmm_ind(v), vmm_ind(v), vmm_idx(), vmm_tmp2());
+            }
+        } else {
+            if (!is_max) {
+                uni_vaddps(vmm_tmp(), vmm_tmp(), vmm_acc(v));
+            } else if (isa == avx512_common) {
+                vpcmpeqd(k_cmp, vmm_ind(v), vmm_idx());
+                vaddps(vmm_tmp() | k_cmp, vmm_tmp(), vmm_acc(v));
+            } else {
+                vpcmpeqd(vmm_tmp2(), vmm_ind(v), vmm_idx());
+                vandps(vmm_tmp2(), vmm_tmp2(), vmm_acc(v));
+                vaddps(vmm_tmp(), vmm_tmp(), vmm_tmp2());
+            }
+            store(win_addr, vmm_tmp(), tail);
+        }
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_pool_kernel_f32<isa>::generate() {
+    const bool is_max = jpp.alg == pooling_max;
+    const bool track_idx = is_max && with_indices();
+    const size_t w_stride = jpp.c * sizeof(float);
+    const size_t h_stride = jpp.iw * w_stride;
+    const size_t d_stride = jpp.ih * h_stride;
+
+    preamble();
+
+    mov(reg_win, ptr[reg_param + GET_OFF(win)]);
+    mov(reg_pt, ptr[reg_param + GET_OFF(pt)]);
+    mov(reg_ind, ptr[reg_param + GET_OFF(indices)]);
+
+    if (tail_) prepare_tail_mask();
+
+    if (!jpp.is_backward) {
+        if (is_max) {
+            mov(reg_tmp.cvt32(),
+                    float2int(nstl::numeric_limits<float>::lowest()));
+            movq(Xmm(vmm_tmp().getIdx()), reg_tmp);
+            uni_vbroadcastss(vmm_tmp(), Xmm(vmm_tmp().getIdx()));
+        }
+        for (int v = 0; v < nv_; ++v) {
+            if (is_max)
+                uni_vmovups(vmm_acc(v), vmm_tmp());
+            else
+                uni_vpxor(vmm_acc(v), vmm_acc(v), vmm_acc(v));
+            if (track_idx)
+                uni_vpxor(vmm_ind(v), vmm_ind(v), vmm_ind(v));
+        }
+    } else {
+        if (!is_max)
+            uni_vbroadcastss(vmm_tmp2(), ptr[reg_param + GET_OFF(divisor)]);
+        for (int v = 0; v < nv_; ++v) {
+            load(vmm_acc(v), ptr[reg_pt + v * vlen], is_tail(v));
+            if (is_max)
+                load_indices(v);
+            else
+                uni_vdivps(vmm_acc(v), vmm_acc(v), vmm_tmp2());
+        }
+    }
+
+    if (track_idx)
+        mov(reg_idx, ptr[reg_param + GET_OFF(idx_base)]);
+
+    Label kd_loop, kh_loop, kw_loop, window_end;
+    mov(aux_reg_d, reg_win);
+    mov(reg_kd, ptr[reg_param + GET_OFF(kd_cnt)]);
+    test(reg_kd, reg_kd);
+    jz(window_end, T_NEAR);
+    L(kd_loop); {
+        mov(aux_reg_h, aux_reg_d);
+        mov(reg_kh, ptr[reg_param + GET_OFF(kh_cnt)]);
+        L(kh_loop); {
+            mov(aux_reg_w, aux_reg_h);
+            mov(reg_kw, ptr[reg_param + GET_OFF(kw_cnt)]);
+            L(kw_loop); {
+                compute_tap();
+                if (track_idx) inc(reg_idx);
+                add(aux_reg_w, w_stride);
+                dec(reg_kw);
+                jnz(kw_loop, T_NEAR);
+            }
+            if (track_idx) {
+                add(reg_idx, jpp.kw);
+                sub(reg_idx, ptr[reg_param + GET_OFF(kw_cnt)]);
+            }
+            add(aux_reg_h, h_stride);
+            dec(reg_kh);
+            jnz(kh_loop, T_NEAR);
+        }
+        if (track_idx) {
+            mov(reg_tmp, ptr[reg_param + GET_OFF(kh_cnt)]);
+            imul(reg_tmp, reg_tmp, jpp.kw);
+            add(reg_idx, jpp.kh * jpp.kw);
+            sub(reg_idx, reg_tmp);
+        }
+        add(aux_reg_d, d_stride);
+        dec(reg_kd);
+        jnz(kd_loop, T_NEAR);
+    }
+    L(window_end);
+
+    if (!jpp.is_backward) {
+        if (!is_max)
+            uni_vbroadcastss(vmm_tmp2(), ptr[reg_param + GET_OFF(divisor)]);
+        for (int v = 0; v < nv_; ++v) {
+            if (!is_max)
+                uni_vdivps(vmm_acc(v), vmm_acc(v), vmm_tmp2());
+            store(ptr[reg_pt + v * vlen], vmm_acc(v), is_tail(v));
+            if (track_idx)
+                store_indices(v);
+        }
+    }
+
+    postamble();
+
+    if (isa != avx512_common && tail_) {
+        align(64);
+        L(l_tail_mask);
+        for (int i = 0; i < jpp.simd_w; ++i)
+            dd(i < tail_ ? 0xffffffff : 0);
+    }
+}
+
+template struct jit_uni_nspc_pool_kernel_f32<avx2>;
+template struct jit_uni_nspc_pool_kernel_f32<avx512_common>;
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,110 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef JIT_UNI_NSPC_POOL_KERNEL_F32_HPP
+#define JIT_UNI_NSPC_POOL_KERNEL_F32_HPP
+
+#include "c_types_map.hpp"
+#include "pooling_pd.hpp"
+#include "type_helpers.hpp"
+
+#include "jit_generator.hpp"
+#include "jit_primitive_conf.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+template <cpu_isa_t isa>
+struct jit_uni_nspc_pool_kernel_f32: public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_nspc_pool_kernel_f32)
+
+    enum { nv_max = 4 };
+
+    /* last selects the last (possibly masked) chunk of channels */
+    jit_uni_nspc_pool_kernel_f32(const jit_nspc_pool_conf_t &ajpp, bool last)
+        : jpp(ajpp)
+        , nv_(last ? ajpp.last_nv : ajpp.nv)
+        , tail_(last ? ajpp.tail : 0)
+    {
+        this->generate();
+        jit_ker = (decltype(jit_ker))this->getCode();
+    }
+
+    static status_t init_conf(jit_nspc_pool_conf_t &jpp,
+            const pooling_pd_t *ppd);
+
+    void operator()(jit_nspc_pool_call_s *arg) const { jit_ker(arg); }
+
+    jit_nspc_pool_conf_t jpp;
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    using reg64_t = const Xbyak::Reg64;
+    const int vlen = cpu_isa_traits<isa>::vlen;
+
+    const int nv_, tail_;
+
+    void (*jit_ker)(jit_nspc_pool_call_s *);
+
+    reg64_t reg_param = abi_param1;
+    reg64_t reg_win = r8;
+    reg64_t reg_pt = r9;
+    reg64_t reg_ind = r10;
+    reg64_t aux_reg_d = r11;
+    reg64_t aux_reg_h = r12;
+    reg64_t aux_reg_w = r13;
+    reg64_t reg_kd = r14;
+    reg64_t reg_kh = r15;
+    reg64_t reg_kw = rbx;
+    reg64_t reg_idx = rdx;
+    reg64_t reg_tmp = rax;
+
+    Xbyak::Opmask k_tail = Xbyak::Opmask(2);
+    Xbyak::Opmask k_cmp = Xbyak::Opmask(3);
+
+    /* the result (forward) or the diff_dst (backward) of the point */
+    Vmm vmm_acc(int v) { return Vmm(v); }
+    /* the window indices of the maximums */
+    Vmm vmm_ind(int v) { return Vmm(nv_max + v); }
+    Vmm vmm_tmp() { return Vmm(2 * nv_max); }
+    Vmm vmm_tmp2() { return Vmm(2 * nv_max + 1); }
+    Vmm vmm_idx() { return Vmm(2 * nv_max + 2); }
+    Vmm vmm_mask() { return Vmm(2 * nv_max + 3); }
+
+    Xbyak::Label l_tail_mask;
+
+    bool is_tail(int v) const { return tail_ && v == nv_ - 1; }
+    bool with_indices() const { return jpp.ind_dt != data_type::undef; }
+
+    void load(const Vmm &vmm, const Xbyak::Address &addr, bool tail);
+    void store(const Xbyak::Address &addr, const Vmm &vmm, bool tail);
+    void load_indices(int v);
+    void store_indices(int v);
+    void store_bytes(const Xbyak::Reg64 &base, int off, const Xbyak::Xmm &xmm,
+            int n);
+    void prepare_tail_mask();
+    void compute_tap();
+    void generate();
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,158 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_uni_nspc_pooling.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+namespace {
+
+/* Fills in the window of the output point (od, oh, ow) and returns the
+ * spatial offset of its first valid source tap */
+size_t init_window(const jit_nspc_pool_conf_t &jpp, jit_nspc_pool_call_s &p,
+        int n, int od, int oh, int ow) {
+    const int id0 = od * jpp.stride_d - jpp.f_pad;
+    const int ih0 = oh * jpp.stride_h - jpp.t_pad;
+    const int iw0 = ow * jpp.stride_w - jpp.l_pad;
+    const int id_s = nstl::max(id0, 0), id_e = nstl::min(id0 + jpp.kd, jpp.id);
+    const int ih_s = nstl::max(ih0, 0), ih_e = nstl::min(ih0 + jpp.kh, jpp.ih);
+    const int iw_s = nstl::max(iw0, 0), iw_e = nstl::min(iw0 + jpp.kw, jpp.iw);
+
+    const int kd_cnt = nstl::max(id_e - id_s, 0);
+    const int kh_cnt = nstl::max(ih_e - ih_s, 0);
+    const int kw_cnt = nstl::max(iw_e - iw_s, 0);
+    const int taps = kd_cnt * kh_cnt * kw_cnt;
+
+    /* the kernel skips the window if the first count is 0 */
+    p.kd_cnt = taps ? kd_cnt : 0;
+    p.kh_cnt = kh_cnt;
+    p.kw_cnt = kw_cnt;
+    p.idx_base = (id_s - id0) * jpp.kh * jpp.kw + (ih_s - ih0) * jpp.kw
+        + (iw_s - iw0);
+    p.divisor = jpp.alg == alg_kind::pooling_avg_include_padding
+        ? (float)(jpp.kd * jpp.kh * jpp.kw) : (float)nstl::max(taps, 1);
+
+    return (((size_t)n * jpp.id + id_s) * jpp.ih + ih_s) * jpp.iw + iw_s;
+}
+
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_pooling_fwd_t<isa>::execute_forward(
+        const exec_ctx_t &ctx) const {
+    auto src = CTX_IN_MEM(const data_t *, MKLDNN_ARG_SRC);
+    auto dst = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DST);
+    auto ws = CTX_OUT_MEM(char *, MKLDNN_ARG_WORKSPACE);
+
+    const auto &jpp = pd()->jpp_;
+    const size_t ind_dt_size = ws ? types::data_type_size(jpp.ind_dt) : 0;
+    const int chunk = jpp.nv * jpp.simd_w;
+
+    parallel_nd(jpp.mb, jpp.od, jpp.oh, jpp.ow,
+            [&](int n, int od, int oh, int ow) {
+        jit_nspc_pool_call_s p;
+        const size_t src_sp = init_window(jpp, p, n, od, oh, ow);
+        const size_t dst_sp
+            = (((size_t)n * jpp.od + od) * jpp.oh + oh) * jpp.ow + ow;
+
+        for (int ch = 0; ch < jpp.nb_chunks; ++ch) {
+            const size_t c0 = (size_t)ch * chunk;
+            p.win = const_cast<data_t *>(src) + src_sp * jpp.c + c0;
+            p.pt = dst + dst_sp * jpp.c + c0;
+            p.indices = ws ? ws + (dst_sp * jpp.c + c0) * ind_dt_size
+                : nullptr;
+            kernels_(ch == jpp.nb_chunks - 1, &p);
+        }
+    });
+}
+
+template <cpu_isa_t isa>
+void jit_uni_nspc_pooling_bwd_t<isa>::execute_backward(
+        const exec_ctx_t &ctx) const {
+    auto diff_dst = CTX_IN_MEM(const data_t *, MKLDNN_ARG_DIFF_DST);
+    auto ws = CTX_IN_MEM(const char *, MKLDNN_ARG_WORKSPACE);
+    auto diff_src = CTX_OUT_MEM(data_t *, MKLDNN_ARG_DIFF_SRC);
+
+    const auto &jpp = pd()->jpp_;
+    const size_t ind_dt_size = ws ? types::data_type_size(jpp.ind_dt) : 0;
+    const int chunk = jpp.nv * jpp.simd_w;
+    const size_t isp = (size_t)jpp.id * jpp.ih * jpp.iw;
+
+    auto ker = [&](int n, int od, int oh, int ow, int ch) {
+        jit_nspc_pool_call_s p;
+        const size_t src_sp = init_window(jpp, p, n, od, oh, ow);
+        const size_t dst_sp
+            = (((size_t)n * jpp.od + od) * jpp.oh + oh) * jpp.ow + ow;
+        const size_t c0 = (size_t)ch * chunk;
+        p.win = diff_src + src_sp * jpp.c + c0;
+        p.pt = const_cast<data_t *>(diff_dst) + dst_sp * jpp.c + c0;
+        p.indices = ws
+            ? const_cast<char *>(ws) + (dst_sp * jpp.c + c0) * ind_dt_size
+            : nullptr;
+        kernels_(ch == jpp.nb_chunks - 1, &p);
+    };
+
+    const bool disjoint_windows = true
+        && jpp.kd <= jpp.stride_d
+        && jpp.kh <= jpp.stride_h
+        && jpp.kw <= jpp.stride_w;
+
+    if (disjoint_windows) {
+        /* every diff_src point is updated by one window at most */
+        parallel_nd(jpp.mb * isp, [&](size_t sp) {
+            utils::array_set(diff_src + sp * jpp.c, 0, jpp.c);
+        });
+        parallel_nd(jpp.mb, jpp.od, jpp.oh, jpp.ow,
+                [&](int n, int od, int oh, int ow) {
+            for (int ch = 0; ch < jpp.nb_chunks; ++ch)
+                ker(n, od, oh, ow, ch);
+        });
+        return;
+    }
+
+    /* the windows overlap, so a thread owns a chunk of channels of an image
+     * and accumulates all of its windows */
+    parallel_nd(jpp.mb, jpp.nb_chunks, [&](int n, int ch) {
+        const size_t c0 = (size_t)ch * chunk;
+        const size_t clen = nstl::min((size_t)chunk, jpp.c - c0);
+        for (size_t sp = 0; sp < isp; ++sp)
+            utils::array_set(diff_src + (n * isp + sp) * jpp.c + c0, 0, clen);
+
+        for (int od = 0; od < jpp.od; ++od)
+        for (int oh = 0; oh < jpp.oh; ++oh)
+        for (int ow = 0; ow < jpp.ow; ++ow)
+            ker(n, od, oh, ow, ch);
+    });
+}
+
+template struct jit_uni_nspc_pooling_fwd_t<avx2>;
+template struct jit_uni_nspc_pooling_bwd_t<avx2>;
+template struct jit_uni_nspc_pooling_fwd_t<avx512_common>;
+template struct jit_uni_nspc_pooling_bwd_t<avx512_common>;
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
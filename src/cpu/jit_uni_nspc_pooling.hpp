@@ -0,0 +1,179 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_JIT_UNI_NSPC_POOLING_HPP
+#define CPU_JIT_UNI_NSPC_POOLING_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "cpu_pooling_pd.hpp"
+#include "cpu_primitive.hpp"
+
+#include "jit_uni_nspc_pool_kernel_f32.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+/* Kernels for the full chunks of channels and (if it differs) for the last
+ * one */
+template <cpu_isa_t isa>
+struct jit_uni_nspc_pool_kernels_t {
+    using kernel_t = jit_uni_nspc_pool_kernel_f32<isa>;
+
+    jit_uni_nspc_pool_kernels_t(const jit_nspc_pool_conf_t &jpp) {
+        kernels_[0] = new kernel_t(jpp, false);
+        kernels_[1] = jpp.tail != 0 || jpp.last_nv != jpp.nv
+            ? new kernel_t(jpp, true) : kernels_[0];
+    }
+
+    ~jit_uni_nspc_pool_kernels_t() {
+        if (kernels_[1] != kernels_[0]) delete kernels_[1];
+        delete kernels_[0];
+    }
+
+    void operator()(bool last, jit_nspc_pool_call_s *p) const
+    { (*kernels_[last])(p); }
+
+private:
+    kernel_t *kernels_[2];
+};
+
+template <cpu_isa_t isa>
+struct jit_uni_nspc_pooling_fwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_pooling_fwd_pd_t {
+        using cpu_pooling_fwd_pd_t::cpu_pooling_fwd_pd_t;
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit_nspc:", isa, ""),
+                jit_uni_nspc_pooling_fwd_t<isa>);
+
+        status_t init() {
+            using namespace utils;
+
+            bool ok = true
+                && set_default_params() == status::success
+                && is_fwd()
+                && !has_zero_dim_memory()
+                && one_of(ndims(), 4, 5)
+                && everyone_is(data_type::f32,
+                        src_md()->data_type,
+                        dst_md()->data_type)
+                && attr()->has_default_values()
+                && memory_desc_matches_tag(*src_md(), desired_fmt_tag())
+                && memory_desc_matches_tag(*dst_md(), desired_fmt_tag());
+            if (!ok) return status::unimplemented;
+
+            bool is_training = desc_.prop_kind == prop_kind::forward_training;
+            if (desc()->alg_kind == alg_kind::pooling_max && is_training)
+                init_default_ws();
+
+            return jit_uni_nspc_pool_kernel_f32<isa>::init_conf(jpp_, this);
+        }
+
+        format_tag_t desired_fmt_tag() {
+            return ndims() == 4 ? format_tag::nhwc : format_tag::ndhwc;
+        }
+
+        jit_nspc_pool_conf_t jpp_;
+    };
+
+    jit_uni_nspc_pooling_fwd_t(const pd_t *apd)
+        : cpu_primitive_t(apd), kernels_(pd()->jpp_) {}
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual status_t execute(const exec_ctx_t &ctx) const override {
+        execute_forward(ctx);
+        return status::success;
+    }
+
+private:
+    void execute_forward(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    jit_uni_nspc_pool_kernels_t<isa> kernels_;
+};
+
+template <cpu_isa_t isa>
+struct jit_uni_nspc_pooling_bwd_t: public cpu_primitive_t {
+    struct pd_t: public cpu_pooling_bwd_pd_t {
+        using cpu_pooling_bwd_pd_t::cpu_pooling_bwd_pd_t;
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit_nspc:", isa, ""),
+                jit_uni_nspc_pooling_bwd_t<isa>);
+
+        status_t init() {
+            using namespace utils;
+
+            bool ok = true
+                && set_default_params() == status::success
+                && !is_fwd()
+                && !has_zero_dim_memory()
+                && one_of(ndims(), 4, 5)
+                && everyone_is(data_type::f32,
+                        diff_src_md()->data_type,
+                        diff_dst_md()->data_type)
+                && attr()->has_default_values()
+                && memory_desc_matches_tag(*diff_dst_md(), desired_fmt_tag())
+                && memory_desc_matches_tag(*diff_src_md(), desired_fmt_tag());
+            if (!ok) return status::unimplemented;
+
+            if (desc()->alg_kind == alg_kind::pooling_max) {
+                init_default_ws();
+                if (!compare_ws(hint_fwd_pd_))
+                    return status::unimplemented;
+            }
+
+            return jit_uni_nspc_pool_kernel_f32<isa>::init_conf(jpp_, this);
+        }
+
+        format_tag_t desired_fmt_tag() {
+            return ndims() == 4 ? format_tag::nhwc : format_tag::ndhwc;
+        }
+
+        jit_nspc_pool_conf_t jpp_;
+    };
+
+    jit_uni_nspc_pooling_bwd_t(const pd_t *apd)
+        : cpu_primitive_t(apd), kernels_(pd()->jpp_) {}
+
+    typedef typename prec_traits<data_type::f32>::type data_t;
+
+    virtual status_t execute(const exec_ctx_t &ctx) const override {
+        execute_backward(ctx);
+        return status::success;
+    }
+
+private:
+    void execute_backward(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    jit_uni_nspc_pool_kernels_t<isa> kernels_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
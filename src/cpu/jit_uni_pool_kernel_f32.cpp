@@ -164,7 +164,7 @@ inline void jit_uni_pool_kernel_f32<isa>::avg_step(int ur_w, int pad_l,
     L(kh_label);
     {
         for (int ki = 0; ki < kw; ki++) {
-            int jj_start = nstl::max(0, pad_l - ki);
+            int jj_start = nstl::max(0, utils::div_up(pad_l - ki, stride_w));
             int jj_end = ur_w
                 - utils::div_up(nstl::max(0, ki + pad_r - (kw-1)), stride_w);
             for (int jj = jj_start; jj  < jj_end; jj++) {
@@ -248,7 +248,7 @@ inline void jit_uni_pool_kernel_f32<isa>::max_step_fwd(int ur_w, int pad_l,
     L(kh_label);
     {
         for (int ki = 0; ki < kw; ki++) {
-            int jj_start = nstl::max(0, pad_l - ki);
+            int jj_start = nstl::max(0, utils::div_up(pad_l - ki, stride_w));
             int jj_end = ur_w
                 - utils::div_up(nstl::max(0, ki + pad_r - (kw-1)), stride_w);
             for (int jj = jj_start; jj  < jj_end; jj++) {
@@ -417,7 +417,7 @@ inline void jit_uni_pool_kernel_f32<isa>::max_step_bwd(int ur_w, int pad_l,
     L(kh_label);
     {
         for (int ki = 0; ki < kw; ki++) {
-            int jj_start = nstl::max(0, pad_l - ki);
+            int jj_start = nstl::max(0, utils::div_up(pad_l - ki, stride_w));
             int jj_end = ur_w
                 - utils::div_up(nstl::max(0, ki + pad_r - (kw-1)), stride_w);
             for (int jj = jj_start; jj  < jj_end; jj++) {
@@ -53,12 +53,17 @@ struct jit_uni_pooling_fwd_t: public cpu_primitive_t {
                         dst_md()->data_type)
                 && attr()->has_default_values()
                 && memory_desc_matches_tag(*src_md(), desired_fmt_tag())
-                && memory_desc_matches_tag(*dst_md(), desired_fmt_tag());
+                && memory_desc_wrapper(dst_md()).matches_tag_any_mb_stride(
+                        desired_fmt_tag());
             if (!ok) return status::unimplemented;
 
             bool is_training = desc_.prop_kind == prop_kind::forward_training;
-            if (desc()->alg_kind == alg_kind::pooling_max && is_training)
+            if (desc()->alg_kind == alg_kind::pooling_max && is_training) {
                 init_default_ws();
+                /* the workspace is dense even if the destination is a
+                 * sub-memory of a bigger tensor */
+                CHECK(memory_desc_init_by_tag(ws_md_, desired_fmt_tag()));
+            }
 
             return jit_uni_pool_kernel_f32<isa>::init_conf(jpp_, this);
         }
@@ -0,0 +1,365 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <assert.h>
+#include <limits.h>
+
+#include "c_types_map.hpp"
+#include "mkldnn_thread.hpp"
+#include "nstl.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "jit_generator.hpp"
+
+#include "jit_uni_shuffle.hpp"
+
+#define GET_OFF(field) offsetof(call_params_t, field)
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+using namespace Xbyak;
+using namespace mkldnn::impl::format_tag;
+using namespace mkldnn::impl::utils;
+
+template <cpu_isa_t isa>
+struct jit_uni_shuffle_kernel_t: public jit_generator {
+    DECLARE_CPU_JIT_AUX_FUNCTIONS(jit_uni_shuffle_kernel_t)
+
+    struct call_params_t {
+        const void *src;
+        void *dst;
+        const int *offsets;
+        const int *shifts;
+        const int *mask;
+        size_t work;
+    };
+
+    void (*ker_)(const call_params_t *);
+    void operator()(const call_params_t *p) { assert(ker_); ker_(p); }
+
+    jit_uni_shuffle_kernel_t(const jit_shuffle_conf_t &jsp, bool use_nt)
+        : ker_(nullptr), jsp_(jsp), use_nt_(use_nt) {
+        generate();
+        ker_ = reinterpret_cast<decltype(ker_)>(const_cast<uint8_t*>(
+                    getCode()));
+    }
+
+private:
+    using Vmm = typename cpu_isa_traits<isa>::Vmm;
+    const int vlen = cpu_isa_traits<isa>::vlen;
+
+    const jit_shuffle_conf_t &jsp_;
+    const bool use_nt_;
+
+    Reg64 reg_param = abi_param1;
+    Reg64 reg_src = r8;
+    Reg64 reg_dst = r9;
+    Reg64 reg_off = r10;
+    Reg64 reg_shift = r11;
+    Reg64 reg_mask = r12;
+    Reg64 reg_work = r13;
+
+    Vmm vmm_dst = Vmm(0);
+    Vmm vmm_off = Vmm(1);
+    Vmm vmm_shift = Vmm(2);
+    Vmm vmm_mask = Vmm(3);
+    Vmm vmm_gather_mask = Vmm(4);
+
+    Opmask k_mask = Opmask(1);
+    Opmask k_gather_mask = Opmask(2);
+
+    void prepare_mask(bool masked);
+    void gather(int b);
+    void store(int b, bool masked);
+    void generate();
+};
+
+template <cpu_isa_t isa>
+void jit_uni_shuffle_kernel_t<isa>::prepare_mask(bool masked) {
+    /* gather instructions clear the mask, so keep a copy for the store */
+    if (isa == avx512_common) {
+        if (masked) {
+            vmovups(vmm_mask, ptr[reg_mask]);
+            vptestmd(k_mask, vmm_mask, vmm_mask);
+        } else {
+            kxnorw(k_mask, k_mask, k_mask);
+        }
+        kmovw(k_gather_mask, k_mask);
+    } else {
+        if (masked)
+            vmovups(vmm_mask, ptr[reg_mask]);
+        else
+            vpcmpeqd(vmm_mask, vmm_mask, vmm_mask);
+        vmovups(vmm_gather_mask, vmm_mask);
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_shuffle_kernel_t<isa>::gather(int b) {
+    vmovups(vmm_off, ptr[reg_off + b * vlen]);
+    if (jsp_.dt_size == 4) {
+        if (isa == avx512_common)
+            vgatherdps(vmm_dst | k_gather_mask, ptr[reg_src + vmm_off]);
+        else
+            vgatherdps(vmm_dst, ptr[reg_src + vmm_off], vmm_gather_mask);
+    } else {
+        /* 1-byte data types: each lane loads a dword that ends at (or
+         * contains) the required byte, which is then moved to the lowest
+         * byte of the lane. This never touches memory outside of the
+         * source tensor. */
+        assert(isa == avx512_common);
+        vpgatherdd(vmm_dst | k_gather_mask, ptr[reg_src + vmm_off]);
+        vmovups(vmm_shift, ptr[reg_shift + b * vlen]);
+        vpsrlvd(vmm_dst, vmm_dst, vmm_shift);
+    }
+}
+
+template <cpu_isa_t isa>
+void jit_uni_shuffle_kernel_t<isa>::store(int b, bool masked) {
+    const int simd_w = jsp_.simd_w;
+    if (jsp_.dt_size == 1) {
+        vpmovdb(ptr[reg_dst + b * simd_w], vmm_dst | k_mask);
+        return;
+    }
+
+    auto addr = ptr[reg_dst + b * vlen];
+    if (use_nt_)
+        vmovntps(addr, vmm_dst);
+    else if (!masked)
+        vmovups(addr, vmm_dst);
+    else if (isa == avx512_common)
+        vmovups(addr | k_mask, vmm_dst);
+    else
+        vmaskmovps(addr, vmm_mask, vmm_dst);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_shuffle_kernel_t<isa>::generate() {
+    preamble();
+
+    mov(reg_src, ptr[reg_param + GET_OFF(src)]);
+    mov(reg_dst, ptr[reg_param + GET_OFF(dst)]);
+    mov(reg_off, ptr[reg_param + GET_OFF(offsets)]);
+    if (jsp_.dt_size == 1)
+        mov(reg_shift, ptr[reg_param + GET_OFF(shifts)]);
+    mov(reg_mask, ptr[reg_param + GET_OFF(mask)]);
+    mov(reg_work, ptr[reg_param + GET_OFF(work)]);
+
+    Label sp_loop;
+    L(sp_loop); {
+        for (int b = 0; b < jsp_.nb; ++b) {
+            /* the last vector takes the mask from the caller, since in the
+             * blocked layout only the last channel block has a tail;
+             * non-temporal stores are only used if there is no tail */
+            const bool masked = b == jsp_.nb - 1 && !use_nt_;
+            prepare_mask(masked);
+            gather(b);
+            store(b, masked);
+        }
+
+        add(reg_src, jsp_.sp_stride);
+        add(reg_dst, jsp_.sp_stride);
+        dec(reg_work);
+        jnz(sp_loop, T_NEAR);
+    }
+
+    if (use_nt_)
+        sfence();
+
+    postamble();
+}
+
+template <cpu_isa_t isa>
+status_t jit_uni_shuffle_t<isa>::pd_t::init() {
+    const data_type_t dt = data_md()->data_type;
+    const int dt_size = types::data_type_size(dt);
+
+    bool ok = true
+        && mayiuse(isa)
+        && axis() == 1
+        && utils::one_of(ndims(), 4, 5)
+        && IMPLICATION(dt_size == 1, isa == avx512_common)
+        && utils::one_of(dt_size, 1, 4)
+        && attr()->has_default_values();
+    if (!ok) return status::unimplemented;
+
+    const int simd_w = cpu_isa_traits<isa>::vlen / sizeof(float);
+    const format_tag_t blk_tag = isa == avx512_common
+        ? utils::pick(ndims() - 4, nChw16c, nCdhw16c)
+        : utils::pick(ndims() - 4, nChw8c, nCdhw8c);
+    const format_tag_t plain_tag = utils::pick(ndims() - 4, nhwc, ndhwc);
+
+    const format_tag_t dat_tag = memory_desc_matches_one_of_tag(
+            *data_md(), blk_tag, plain_tag);
+    if (dat_tag == format_tag::undef) return status::unimplemented;
+
+    const memory_desc_wrapper data_d(data_md());
+
+    jsp_.mb = MB();
+    jsp_.c = C();
+    jsp_.sp = D() * H() * W();
+    jsp_.simd_w = simd_w;
+    jsp_.dt_size = dt_size;
+    jsp_.blocked = dat_tag == blk_tag;
+    jsp_.stride_mb = data_d.blocking_desc().strides[0];
+
+    if (jsp_.blocked) {
+        jsp_.nb = 1;
+        jsp_.sp_stride = (size_t)simd_w * dt_size;
+        jsp_.c_tail = jsp_.c % simd_w;
+    } else {
+        /* 1-byte gathers read 4 bytes at once, so there should be at least 4
+         * of them in each spatial point */
+        if (dt_size == 1 && jsp_.c < 4) return status::unimplemented;
+        jsp_.nb = utils::div_up(jsp_.c, simd_w);
+        jsp_.sp_stride = (size_t)jsp_.c * dt_size;
+        jsp_.c_tail = jsp_.c % simd_w;
+    }
+
+    /* gather offsets are 32-bit signed integers */
+    if (jsp_.stride_mb * dt_size > INT_MAX) return status::unimplemented;
+
+    const size_t data_size = data_d.size();
+    const size_t llc_size = get_cache_size(3, false);
+    jsp_.use_nt = true
+        && dt_size == 4
+        && jsp_.c_tail == 0
+        && jsp_.sp_stride % cpu_isa_traits<isa>::vlen == 0
+        && data_size > llc_size;
+
+    return status::success;
+}
+
+template <cpu_isa_t isa>
+jit_uni_shuffle_t<isa>::jit_uni_shuffle_t(const pd_t *apd)
+    : cpu_primitive_t(apd), ker_(nullptr), ker_nt_(nullptr)
+    , offsets_(nullptr), shifts_(nullptr)
+    , mask_full_(nullptr), mask_tail_(nullptr)
+{
+    const auto &jsp = pd()->jsp_;
+
+    const int C = jsp.c;
+    const int simd_w = jsp.simd_w;
+    const int C_padded = utils::rnd_up(C, simd_w);
+    const int axis_size = pd()->axis_size();
+    const int group_size = pd()->group_size();
+    const int transpose_row = pd()->is_fwd() ? group_size
+                                             : axis_size / group_size;
+    const int transpose_col = pd()->is_fwd() ? axis_size / group_size
+                                             : group_size;
+
+    offsets_ = (int *)malloc(C_padded * sizeof(int), 64);
+    shifts_ = (int *)malloc(C_padded * sizeof(int), 64);
+    mask_full_ = (int *)malloc(simd_w * sizeof(int), 64);
+    mask_tail_ = (int *)malloc(simd_w * sizeof(int), 64);
+
+    for (int c = 0; c < C_padded; ++c) {
+        int off = 0;
+        if (c < C) {
+            const int i = c % transpose_col;
+            const int j = c / transpose_col;
+            const int input_c = i * transpose_row + j;
+            off = jsp.blocked
+                ? (input_c / simd_w) * jsp.sp * simd_w + input_c % simd_w
+                : input_c;
+            off *= jsp.dt_size;
+        }
+        /* for 1-byte data types the dword is loaded at off - s, where s is
+         * chosen not to go below the beginning of the spatial point */
+        const int s = jsp.dt_size == 1 ? nstl::min(off, 3) : 0;
+        offsets_[c] = off - s;
+        shifts_[c] = 8 * s;
+    }
+
+    const int c_tail = jsp.c_tail ? jsp.c_tail : simd_w;
+    for (int i = 0; i < simd_w; ++i) {
+        mask_full_[i] = -1;
+        mask_tail_[i] = i < c_tail ? -1 : 0;
+    }
+
+    ker_ = new jit_uni_shuffle_kernel_t<isa>(jsp, false);
+    if (jsp.use_nt)
+        ker_nt_ = new jit_uni_shuffle_kernel_t<isa>(jsp, true);
+}
+
+template <cpu_isa_t isa>
+jit_uni_shuffle_t<isa>::~jit_uni_shuffle_t() {
+    delete ker_;
+    delete ker_nt_;
+    free(offsets_);
+    free(shifts_);
+    free(mask_full_);
+    free(mask_tail_);
+}
+
+template <cpu_isa_t isa>
+void jit_uni_shuffle_t<isa>::execute_(const exec_ctx_t &ctx) const {
+    auto i_arg = pd()->is_fwd() ? MKLDNN_ARG_SRC : MKLDNN_ARG_DIFF_DST;
+    auto o_arg = pd()->is_fwd() ? MKLDNN_ARG_DST : MKLDNN_ARG_DIFF_SRC;
+    auto input = CTX_IN_MEM(const char *, i_arg);
+    auto output = CTX_OUT_MEM(char *, o_arg);
+
+    const auto &jsp = pd()->jsp_;
+
+    const int MB = jsp.mb;
+    const int SP = jsp.sp;
+    const int simd_w = jsp.simd_w;
+    const int CB = jsp.blocked ? utils::div_up(jsp.c, simd_w) : 1;
+    const size_t dt_size = jsp.dt_size;
+    const size_t stride_mb = jsp.stride_mb * dt_size;
+    const size_t blk_stride = (size_t)SP * simd_w * dt_size;
+
+    /* non-temporal stores require aligned destination */
+    const bool use_nt = jsp.use_nt
+        && ((size_t)output % cpu_isa_traits<isa>::vlen) == 0;
+    auto ker = use_nt ? ker_nt_ : ker_;
+
+    parallel(0, [&](const int ithr, const int nthr) {
+        size_t start{0}, end{0};
+        balance211((size_t)MB * CB * SP, nthr, ithr, start, end);
+
+        int mb{0}, cb{0}, sp{0};
+        utils::nd_iterator_init(start, mb, MB, cb, CB, sp, SP);
+
+        while (start < end) {
+            const size_t work = nstl::min<size_t>(SP - sp, end - start);
+
+            auto p = typename jit_uni_shuffle_kernel_t<isa>::call_params_t();
+            p.src = input + mb * stride_mb + sp * jsp.sp_stride;
+            p.dst = output + mb * stride_mb + cb * blk_stride
+                + sp * jsp.sp_stride;
+            p.offsets = offsets_ + cb * simd_w;
+            p.shifts = shifts_ + cb * simd_w;
+            p.mask = cb == CB - 1 ? mask_tail_ : mask_full_;
+            p.work = work;
+            (*ker)(&p);
+
+            utils::nd_iterator_jump(start, end, mb, MB, cb, CB, sp, SP);
+        }
+    });
+}
+
+template struct jit_uni_shuffle_t<avx512_common>;
+template struct jit_uni_shuffle_t<avx2>;
+
+}
+}
+}
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -0,0 +1,93 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef CPU_JIT_UNI_SHUFFLE_HPP
+#define CPU_JIT_UNI_SHUFFLE_HPP
+
+#include <assert.h>
+
+#include "c_types_map.hpp"
+#include "type_helpers.hpp"
+#include "utils.hpp"
+
+#include "cpu_isa_traits.hpp"
+#include "cpu_primitive.hpp"
+#include "cpu_shuffle_pd.hpp"
+
+namespace mkldnn {
+namespace impl {
+namespace cpu {
+
+struct jit_shuffle_conf_t {
+    int mb, c, sp;
+    int simd_w;
+    int dt_size;
+    bool blocked; // nChw[8|16]c-like layout, otherwise n[d]hwc
+    int nb; // number of vectors handled per spatial point in one call
+    int c_tail; // number of valid lanes in the last vector (0 if none)
+    size_t stride_mb; // in elements
+    size_t sp_stride; // distance between spatial points (bytes)
+    bool use_nt; // non-temporal stores for tensors not fitting into LLC
+};
+
+template <cpu_isa_t isa>
+struct jit_uni_shuffle_kernel_t;
+
+/* Channel shuffle along the axis 1. The permutation is fixed at creation
+ * time, so every output vector is gathered from the source using the
+ * precomputed table of byte offsets. */
+template <cpu_isa_t isa>
+struct jit_uni_shuffle_t : public cpu_primitive_t {
+    struct pd_t : public cpu_shuffle_pd_t {
+        using cpu_shuffle_pd_t::cpu_shuffle_pd_t;
+
+        DECLARE_COMMON_PD_T(
+                JIT_IMPL_NAME_HELPER("jit:", isa, ""),
+                jit_uni_shuffle_t<isa>);
+
+        status_t init();
+
+        jit_shuffle_conf_t jsp_;
+    };
+
+    jit_uni_shuffle_t(const pd_t *apd);
+    ~jit_uni_shuffle_t();
+
+    virtual status_t execute(const exec_ctx_t &ctx) const override {
+        execute_(ctx);
+        return status::success;
+    }
+
+private:
+    void execute_(const exec_ctx_t &ctx) const;
+    const pd_t *pd() const { return (const pd_t *)primitive_t::pd(); }
+
+    jit_uni_shuffle_kernel_t<isa> *ker_;
+    jit_uni_shuffle_kernel_t<isa> *ker_nt_;
+
+    int *offsets_; // per output channel byte offsets within a spatial point
+    int *shifts_; // per output channel bit shifts (1-byte data types only)
+    int *mask_full_;
+    int *mask_tail_;
+};
+
+}
+}
+}
+
+#endif
+
+// vim: et ts=4 sw=4 cindent cino^=l0,\:0,N-s
@@ -38,7 +38,8 @@ void ref_deconvolution_fwd_t::compute_fwd_bias(const data_t *bias,
     const int OC = pd()->OC() / G;
     const int ndims = pd()->desc()->src_desc.ndims;
 
-    parallel_nd(MB, G, OC, OD, OH, OW,
+    /* off() is a multiplication and an addition per dimension */
+    parallel_nd_cost(2 * ndims, MB, G, OC, OD, OH, OW,
         [&](int mb, int g, int oc, int od, int oh, int ow) {
             auto b = bias[g * OC + oc];
             switch (ndims) {
@@ -58,7 +59,7 @@ void ref_deconvolution_fwd_t::compute_fwd_bias_ncdhw(const data_t *bias,
     const int OC = pd()->OC();
     const int SP = pd()->OW()*pd()->OH()*pd()->OD();
 
-    parallel_nd(MB, OC, [&](int mb, int oc) {
+    parallel_nd_cost(SP, MB, OC, [&](int mb, int oc) {
         PRAGMA_OMP_SIMD()
         for (int sp = 0; sp < SP; ++sp) {
             auto offset = (size_t)(mb * OC + oc) * SP + sp;
@@ -78,7 +79,7 @@ void ref_deconvolution_fwd_t::compute_fwd_bias_nCdhwXc(const data_t *bias,
 
     const ptrdiff_t stride_mb = dst_d.blocking_desc().strides[0];
 
-    parallel_nd(MB, utils::div_up(OC, blksize), SP,
+    parallel_nd_cost(blksize, MB, utils::div_up(OC, blksize), SP,
         [&](int mb, int oc_blk, int sp) {
         int oc = oc_blk * blksize;
         auto offset = mb * stride_mb + oc * SP + sp * blksize;
@@ -102,7 +103,8 @@ void ref_deconvolution_bwd_weights_t::compute_bwd_bias(const data_t *diff_dst,
     const int OD = pd()->OD();
     const int ndims = pd()->desc()->src_desc.ndims;
 
-    parallel_nd(G, OC, [&](int g, int oc) {
+    const size_t oc_cost = (size_t)MB * OD * OH * OW * 2 * ndims;
+    parallel_nd_cost(oc_cost, G, OC, [&](int g, int oc) {
         data_t db = 0;
         for (int mb = 0; mb < MB; ++mb) {
             for (int od = 0; od < OD; ++od) {
@@ -138,7 +140,7 @@ void ref_deconvolution_bwd_weights_t::compute_bwd_bias_ncdhw(
     const int MB = pd()->MB();
     const int SP = pd()->OH()*pd()->OW()*pd()->OD();
 
-    parallel_nd(OC, [&](int oc) {
+    parallel_nd_cost((size_t)MB * SP, OC, [&](int oc) {
         data_t db = 0;
         for (int mb = 0; mb < MB; ++mb) {
             PRAGMA_OMP_SIMD()
@@ -151,6 +153,41 @@ void ref_deconvolution_bwd_weights_t::compute_bwd_bias_ncdhw(
     });
 }
 
+void ref_deconvolution_bwd_weights_t::compute_bwd_bias_ndhwc(
+        const data_t *diff_dst, data_t *diff_bias) const {
+    const memory_desc_wrapper diff_dst_d(pd()->diff_dst_md());
+
+    const int OC = pd()->OC();
+    const int MB = pd()->MB();
+    const int SP = pd()->OH() * pd()->OW() * pd()->OD();
+
+    const ptrdiff_t stride_mb = diff_dst_d.blocking_desc().strides[0];
+
+    /* the channels are contiguous, so every thread reduces a block of them
+     * over all the points with unit-stride vector loads */
+    const int blksize = 16;
+    parallel_nd_cost((size_t)MB * SP * blksize, utils::div_up(OC, blksize),
+            [&](int ocb) {
+        const int oc = ocb * blksize;
+        const int blk = nstl::min(blksize, OC - oc);
+        data_t db[blksize] = {0};
+
+        for (int mb = 0; mb < MB; ++mb) {
+            for (int sp = 0; sp < SP; ++sp) {
+                auto offset = mb * stride_mb + (size_t)sp * OC + oc;
+
+                PRAGMA_OMP_SIMD()
+                for (int i = 0; i < blk; ++i)
+                    db[i] += diff_dst[offset + i];
+            }
+        }
+
+        PRAGMA_OMP_SIMD()
+        for (int i = 0; i < blk; ++i)
+            diff_bias[oc + i] = db[i];
+    });
+}
+
 template <int blksize>
 void ref_deconvolution_bwd_weights_t::compute_bwd_bias_nCdhwXc(
         const data_t *diff_dst, data_t *diff_bias) const {
@@ -162,7 +199,8 @@ void ref_deconvolution_bwd_weights_t::compute_bwd_bias_nCdhwXc(
 
     const ptrdiff_t stride_mb = diff_dst_d.blocking_desc().strides[0];
 
-    parallel_nd(utils::div_up(OC, blksize), [&](int ocb) {
+    parallel_nd_cost((size_t)MB * SP * blksize, utils::div_up(OC, blksize),
+            [&](int ocb) {
         data_t db[blksize] = {0};
 
         for (int mb = 0; mb < MB; ++mb) {
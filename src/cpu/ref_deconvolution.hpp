@@ -148,11 +148,21 @@ struct ref_deconvolution_fwd_t: public cpu_primitive_t {
                 bool output_f32 = utils::everyone_is(data_type::f32,
                         desc()->accum_data_type, desc()->dst_desc.data_type);
 
+                /* post-ops go after the bias, so both have to be applied
+                 * by the convolution itself */
+                bool post_ops_ok = IMPLICATION(
+                        !attr()->post_ops_.has_default_values(),
+                        true
+                        && static_cast<cpu_convolution_bwd_data_pd_t *>(
+                                conv_pd_)->support_post_ops()
+                        && IMPLICATION(with_bias(), conv_supports_bias_));
+
                 bool ok = true
                     && conv_pd_->weights_md()->extra.flags == 0
                     /* deconv reference code can process only f32 bias */
                     && IMPLICATION(with_bias(),
-                            conv_supports_bias_ || output_f32);
+                            conv_supports_bias_ || output_f32)
+                    && post_ops_ok;
                 if (ok) return status::success;
 
                 delete conv_pd_;
@@ -168,7 +178,7 @@ struct ref_deconvolution_fwd_t: public cpu_primitive_t {
                 && utils::one_of(desc()->alg_kind,
                         alg_kind::deconvolution_direct,
                         alg_kind::deconvolution_winograd)
-                && attr()->post_ops_.has_default_values();
+                && attr()->zero_points_default();
 
             if (ok) {
                 CHECK(init_convolution());
@@ -422,6 +432,7 @@ struct ref_deconvolution_bwd_weights_t: public cpu_primitive_t {
 
                 dst_tag_ = memory_desc_matches_one_of_tag(diff_dst_md_,
                         utils::pick(ndims() - 3, ncw, nchw, ncdhw),
+                        utils::pick(ndims() - 3, nwc, nhwc, ndhwc),
                         utils::pick(ndims() - 3, nCw8c, nChw8c, nCdhw8c),
                         utils::pick(ndims() - 3, nCw16c, nChw16c, nCdhw16c));
 
@@ -468,6 +479,9 @@ struct ref_deconvolution_bwd_weights_t: public cpu_primitive_t {
             case ncdhw: case nchw: case ncw:
                 compute_bwd_bias_ncdhw(diff_dst, diff_bias);
                 break;
+            case ndhwc: case nhwc: case nwc:
+                compute_bwd_bias_ndhwc(diff_dst, diff_bias);
+                break;
             case nCdhw8c: case nChw8c: case nCw8c:
                 compute_bwd_bias_nCdhwXc<8>(diff_dst, diff_bias);
                 break;
@@ -487,6 +501,8 @@ private:
     void compute_bwd_bias(const data_t *diff_dst, data_t *diff_bias) const;
     void compute_bwd_bias_ncdhw(const data_t *diff_dst,
             data_t *diff_bias) const;
+    void compute_bwd_bias_ndhwc(const data_t *diff_dst,
+            data_t *diff_bias) const;
     template <int blksize> void compute_bwd_bias_nCdhwXc(
             const data_t *diff_dst, data_t *diff_bias) const;
 
@@ -267,7 +267,7 @@ void ref_inner_product_bwd_weights_t<data_type>::execute_backward_weights(
     if (diff_bias) {
         diff_bias += diff_bias_d.offset0();
 
-        parallel_nd(OC, [&](int oc) {
+        parallel_nd_cost(MB, OC, [&](int oc) {
             data_t *db = &diff_bias[oc];
             *db = data_t(0);
             for (int mb = 0; mb < MB; ++mb)
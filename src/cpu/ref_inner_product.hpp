@@ -52,6 +52,7 @@ struct ref_inner_product_fwd_t: public cpu_primitive_t {
                 && IMPLICATION(with_bias(), utils::one_of(
                             weights_md(1)->data_type, f32, s32, s8, u8))
                 && attr()->output_scales_.has_default_values()
+                && attr()->zero_points_default()
                 && attr()->post_ops_.len_ <= 1
                 && IMPLICATION(attr()->post_ops_.len_ == 1,
                         attr()->post_ops_.entry_[0].is_relu(true, false));
@@ -61,6 +61,15 @@ void ref_pooling_fwd_t<data_type, acc_type>::execute_forward(
 
     const bool is_3d = pd()->desc()->src_desc.ndims == 5;
 
+    /* dst = zp_dst + pool(src - zp_src) */
+    const auto &zp_dst = pd()->attr()->zero_points_dst_;
+    const bool with_zero_points = !pd()->attr()->zero_points_default();
+    const acc_data_t src_zp = pd()->attr()->zero_points_src_.zero_points_[0];
+    const int dst_zp_idx_mult = zp_dst.mask_ == (1 << 1);
+    auto dst_zp = [=](int oc) {
+        return (acc_data_t)zp_dst.zero_points_[oc * dst_zp_idx_mult];
+    };
+
     auto apply_offset = [=](int index, int offset) {
         return (index > offset) ? index - offset : 0;
     };
@@ -112,6 +121,13 @@ void ref_pooling_fwd_t<data_type, acc_type>::execute_forward(
             }
         }
 
+        if (with_zero_points) {
+            dst -= src_zp * (ih_end - ih_start) * (iw_end - iw_start);
+            d[0] = math::saturate<data_t>(math::out_round<acc_data_t>(
+                        (float)dst / num_summands + dst_zp(oc)));
+            return;
+        }
+
         d[0] = math::out_round<data_t>((float)dst / num_summands);
     };
 
@@ -157,6 +173,14 @@ void ref_pooling_fwd_t<data_type, acc_type>::execute_forward(
             }
         }
 
+        if (with_zero_points) {
+            dst -= src_zp * (id_end - id_start) * (ih_end - ih_start)
+                * (iw_end - iw_start);
+            d[0] = math::saturate<data_t>(math::out_round<acc_data_t>(
+                        (float)dst / num_summands + dst_zp(oc)));
+            return;
+        }
+
         d[0] = math::out_round<data_t>((float)dst / num_summands);
     };
 
@@ -176,6 +200,9 @@ void ref_pooling_fwd_t<data_type, acc_type>::execute_forward(
                 set_ws(mb, oc, od, oh, ow, 0);
                 if (is_3d) ker_max_3d(d, mb, oc, od, oh, ow);
                 else ker_max(d, mb, oc, oh, ow);
+                if (with_zero_points)
+                    d[0] = math::saturate<data_t>(
+                            (acc_data_t)d[0] - src_zp + dst_zp(oc));
         });
     } else {
         parallel_nd(MB, OC, OD, OH, OW,
@@ -25,6 +25,7 @@
 
 #include "cpu_pooling_pd.hpp"
 #include "cpu_primitive.hpp"
+#include "cpu_zero_points_utils.hpp"
 
 namespace mkldnn {
 namespace impl {
@@ -44,7 +45,7 @@ struct ref_pooling_fwd_t: public cpu_primitive_t {
                 && utils::everyone_is(data_type, src_md()->data_type,
                         dst_md()->data_type)
                 && desc()->accum_data_type == acc_type
-                && attr()->has_default_values();
+                && (attr()->has_default_values() || zero_points_ok());
             if (!ok) return status::unimplemented;
 
             bool is_training = desc_.prop_kind == prop_kind::forward_training;
@@ -53,6 +54,18 @@ struct ref_pooling_fwd_t: public cpu_primitive_t {
 
             return status::success;
         }
+
+    protected:
+        /* int8 pooling supports zero points as the only attribute */
+        bool zero_points_ok() const {
+            return true
+                && utils::one_of(data_type, impl::data_type::s8,
+                        impl::data_type::u8)
+                && attr()->output_scales_.has_default_values()
+                && attr()->post_ops_.has_default_values()
+                && zero_points_utils::zero_points_valid(attr(), data_type,
+                        C());
+        }
     };
 
     ref_pooling_fwd_t(const pd_t *apd): cpu_primitive_t(apd) {}
@@ -44,7 +44,10 @@ void ref_softmax_fwd_t<data_type>::execute_forward_dense(
     const size_t ou_stride = axis > 0
         ? data_d.blocking_desc().strides[axis - 1] : 1u;
 
-    parallel_nd(outer_size_, [&](int ou) {
+    /* max, sub, sum and scale are a single operation per channel, exp is
+     * about a dozen */
+    const size_t ou_cost = (size_t)channels_ * 16;
+    parallel_nd_cost(ou_cost, outer_size_, [&](int ou) {
         const data_t *src_data = src + ou * ou_stride;
         data_t *dst_data = dst + ou * ou_stride;
         data_t scalar = 0;
@@ -170,7 +173,7 @@ void ref_softmax_fwd_t<data_type>::_exp(int n, const data_t *a,
         return;
     }
 #endif
-    parallel_nd(n, [&](int c) { r[c] = expf(a[c]); });
+    parallel_nd_cost(12, n, [&](int c) { r[c] = expf(a[c]); });
 }
 
 template <impl::data_type_t data_type>
@@ -199,7 +202,7 @@ void ref_softmax_fwd_t<data_type>::_scal(int n, data_t alpha, data_t *x) const {
         return;
     }
 #endif
-    parallel_nd(n, [&](int c) { x[c] *= alpha; });
+    parallel_nd_cost(1, n, [&](int c) { x[c] *= alpha; });
 }
 
 template struct ref_softmax_fwd_t<data_type::f32>;
@@ -218,7 +221,7 @@ void ref_softmax_bwd_t<data_type>::execute_backward_dense(
     const size_t ou_stride = axis > 0
         ? diff_d.blocking_desc().strides[axis - 1] : 1u;
 
-    parallel_nd(outer_size_, [&](int ou) {
+    parallel_nd_cost((size_t)channels_ * 4, outer_size_, [&](int ou) {
         data_t sbr = 0;
         size_t off = ou * ou_stride;
         for (int c = 0; c < channels_; ++c) {
@@ -247,7 +250,9 @@ void ref_softmax_bwd_t<data_type>::execute_backward_generic(
 
     const size_t dim = channels_ * inner_size_;
 
-    parallel_nd(outer_size_, [&](int ou) {
+    /* off_l() is a division and a multiplication per dimension */
+    const size_t ou_cost = (size_t)inner_size_ * channels_ * 32;
+    parallel_nd_cost(ou_cost, outer_size_, [&](int ou) {
         for (int in = 0; in < inner_size_; in++) {
             data_t sbr = 0;
             for (int c = 0; c < channels_; c++) {
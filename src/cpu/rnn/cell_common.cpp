@@ -17,13 +17,29 @@
 /*
  * Common for RNN and LSTM cell execution
  */
+#include "mkldnn_thread.hpp"
+
 #include "ref_rnn.hpp"
+#include "../gemm/gemm.hpp"
+#include "../simple_q10n.hpp"
 
 namespace mkldnn {
 namespace impl {
 namespace cpu {
 using namespace rnn_utils;
 
+namespace {
+/* the projection weights and the unprojected hidden state are always f32,
+ * whatever the data type of the rest of the cell */
+void gemm_f32(const rnn_conf_t &rnn, const char transA, const char transB,
+        int m, int n, int k, const float *a, int ldA, const float *b, int ldB,
+        const float beta, float *c, int ldC) {
+    const float alpha = 1.f;
+    extended_sgemm(&transA, &transB, &m, &n, &k, &alpha, a, &ldA, b, &ldB,
+            &beta, c, &ldC, nullptr, rnn.use_jit_gemm);
+}
+}
+
 template <prop_kind_t aprop, data_type_t src_type, data_type_t weights_type>
 rnn_cell_execution_sig(
         (_ref_rnn_common_t<aprop, src_type, weights_type>::cell_execution)) {
@@ -37,10 +53,51 @@ rnn_cell_execution_sig(
             1.0, w_iter_[0], rnn.weights_iter_ld, states_tm1_l_,
             rnn.states_ws_ld, 1.0, ws_gates_, rnn.gates_ws_ld);
 
-    rnn_postgemm_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
+    /* with projection the f32 postgemm leaves the hidden state in proj_ht_
+     * and the gemm below projects it into states_t_l_; the int8 one writes
+     * it quantized to states_t_l_ as usual */
+    const bool is_f32 = rnn.dt_conf == all_f32;
+    src_data_t *ht = rnn.is_lstm_projection && is_f32
+            ? (src_data_t *)proj_ht_
+            : states_t_l_;
+    rnn_postgemm_->execute(rnn, ws_gates_, ht, c_states_t_l_,
             states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
             diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], ws_grid_,
-            ws_cell_);
+            ws_cell_, weights_peephole_);
+
+    if (!rnn.is_lstm_projection)
+        return;
+
+    ws_states_aoc<src_data_t> states_t_l(rnn, states_t_l_);
+    ws_states_aoc_t proj_ht(rnn, proj_ht_);
+    float data_shift = pd()->attr()->rnn_data_qparams_.shift_;
+    float data_scale = pd()->attr()->rnn_data_qparams_.scale_;
+
+    if (!is_f32)
+        parallel_nd(rnn.mb, [&](int i) {
+            PRAGMA_OMP_SIMD()
+            for (int j = 0; j < rnn.dic; j++)
+                proj_ht(i, j)
+                        = ((float)states_t_l(i, j) - data_shift) / data_scale;
+        });
+
+    float *proj_dst = is_f32
+            ? (float *)states_t_l_
+            : proj_ht_ + rnn.states_nld * rnn.states_ws_ld;
+    gemm_f32(rnn, 'N', 'N', rnn.dhc, rnn.mb, rnn.dic, weights_projection_,
+            rnn.dhc, proj_ht_, rnn.states_ws_ld, 0.0, proj_dst,
+            rnn.states_ws_ld);
+
+    if (!is_f32) {
+        ws_states_aoc_t proj_res(rnn, proj_dst);
+        parallel_nd(rnn.mb, [&](int i) {
+            PRAGMA_OMP_SIMD()
+            for (int j = 0; j < rnn.dhc; j++) {
+                float qf = proj_res(i, j) * data_scale + data_shift;
+                states_t_l(i, j) = qz_a1b0<float, src_data_t>()(qf);
+            }
+        });
+    }
 }
 template rnn_cell_execution_sig(ref_rnn_fwd_f32_t::cell_execution);
 template rnn_cell_execution_sig(ref_rnn_fwd_u8s8_t::cell_execution);
@@ -48,10 +105,49 @@ template rnn_cell_execution_sig(ref_rnn_fwd_u8s8_t::cell_execution);
 template <>
 rnn_cell_execution_sig(ref_rnn_bwd_f32_t::cell_execution) {
     ws_diff_states_aoc_t diff_states_t_l(rnn, diff_states_t_l_);
+
+    /* with projection the diffs of the projected Ht are summed and brought
+     * back through the projection before the postgemm; the diff_states_t_l
+     * slots used for it are overwritten by the gemms below */
+    if (rnn.is_lstm_projection) {
+        ws_diff_states_aoc_t diff_states_tp1_l(rnn, diff_states_tp1_l_);
+        ws_diff_states_aoc_t diff_states_t_lp1(rnn, diff_states_t_lp1_);
+        parallel_nd(rnn.mb, [&](int i) {
+            PRAGMA_OMP_SIMD()
+            for (int j = 0; j < rnn.dhc; j++)
+                diff_states_t_l(rnn.n_states, i, j)
+                        = diff_states_tp1_l(0, i, j)
+                        + diff_states_t_lp1(rnn.n_states, i, j);
+        });
+        float *diff_proj = &diff_states_t_l(rnn.n_states, 0, 0);
+        gemm_f32(rnn, 'N', 'T', rnn.dhc, rnn.dic, rnn.mb, diff_proj,
+                rnn.states_ws_ld, proj_ht_, rnn.states_ws_ld, 1.0,
+                diff_weights_projection_, rnn.dhc);
+        gemm_f32(rnn, 'T', 'N', rnn.dic, rnn.mb, rnn.dhc,
+                weights_projection_, rnn.dhc, diff_proj, rnn.states_ws_ld,
+                0.0, &diff_states_t_l(0, 0, 0), rnn.states_ws_ld);
+    }
+
     rnn_postgemm_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
             states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
             diff_states_t_lp1_, diff_states_tp1_l_, bias_[0], ws_grid_,
-            ws_cell_);
+            ws_cell_, weights_peephole_);
+
+    if (rnn.is_lstm_peephole) {
+        ws_gates_aoc_t ws_gates(rnn, ws_gates_);
+        ws_states_aoc_t c_states_t_l(rnn, c_states_t_l_);
+        ws_states_aoc_t c_states_tm1_l(rnn, c_states_tm1_l_);
+        parallel_nd(rnn.dic, [&](int j) {
+            for (int i = 0; i < rnn.mb; i++) {
+                diff_weights_peephole_[j]
+                        += ws_gates(i, 0, j) * c_states_tm1_l(i, j);
+                diff_weights_peephole_[rnn.dic + j]
+                        += ws_gates(i, 1, j) * c_states_tm1_l(i, j);
+                diff_weights_peephole_[2 * rnn.dic + j]
+                        += ws_gates(i, 3, j) * c_states_t_l(i, j);
+            }
+        });
+    }
 
     /// bwd by data on the cell
     (this->*gemm_iter_func)('N', 'N', rnn.sic, rnn.mb, rnn.n_gates * rnn.dic,
@@ -47,6 +47,12 @@ protected:
             CHECK(memory_desc_init_by_tag(bias_md_, ldgo));
         if (with_dst_iter() && dst_iter_md_.format_kind == format_kind::any)
             CHECK(memory_desc_init_by_tag(dst_iter_md_, ldsnc));
+        if (with_peephole()
+                && weights_peephole_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(weights_peephole_md_, ldgo));
+        if (with_projection()
+                && weights_projection_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(weights_projection_md_, ldio));
 
         return status::success;
     }
@@ -82,6 +88,11 @@ protected:
 
         ok = ok && IMPLICATION(!is_zero_md(&bias_md_),
                            memory_desc_matches_tag(bias_md_, ldgo));
+        ok = ok && IMPLICATION(!is_zero_md(&weights_peephole_md_),
+                           memory_desc_matches_tag(weights_peephole_md_, ldgo))
+                && IMPLICATION(!is_zero_md(&weights_projection_md_),
+                           memory_desc_matches_tag(
+                                   weights_projection_md_, ldio));
 
         /* Int8 is supported only for packed weights */
         data_type_t weights_iter_dt = weights_iter_md_.data_type;
@@ -128,6 +139,12 @@ protected:
             CHECK(memory_desc_init_by_tag(bias_md_, ldgo));
         if (with_dst_iter() && dst_iter_md_.format_kind == format_kind::any)
             CHECK(memory_desc_init_by_tag(dst_iter_md_, ldsnc));
+        if (with_peephole()
+                && weights_peephole_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(weights_peephole_md_, ldgo));
+        if (with_projection()
+                && weights_projection_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(weights_projection_md_, ldio));
 
         if (with_src_iter() && diff_src_iter_md_.format_kind == format_kind::any)
             CHECK(memory_desc_init_by_tag(diff_src_iter_md_, ldsnc));
@@ -135,6 +152,12 @@ protected:
             CHECK(memory_desc_init_by_tag(diff_bias_md_, ldgo));
         if (with_dst_iter() && diff_dst_iter_md_.format_kind == format_kind::any)
             CHECK(memory_desc_init_by_tag(diff_dst_iter_md_, ldsnc));
+        if (with_peephole()
+                && diff_weights_peephole_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(diff_weights_peephole_md_, ldgo));
+        if (with_projection()
+                && diff_weights_projection_md_.format_kind == format_kind::any)
+            CHECK(memory_desc_init_by_tag(diff_weights_projection_md_, ldio));
 
         return status::success;
     }
@@ -169,6 +192,11 @@ protected:
 
         ok = ok && IMPLICATION(!is_zero_md(&bias_md_),
                            memory_desc_matches_tag(bias_md_, ldgo));
+        ok = ok && IMPLICATION(!is_zero_md(&weights_peephole_md_),
+                           memory_desc_matches_tag(weights_peephole_md_, ldgo))
+                && IMPLICATION(!is_zero_md(&weights_projection_md_),
+                           memory_desc_matches_tag(
+                                   weights_projection_md_, ldio));
 
         ok = ok && is_blocked(diff_src_layer_md_, 3)
                 && is_blocked(diff_dst_layer_md_, 3);
@@ -181,6 +209,12 @@ protected:
                 && rnn_utils::is_ldigo(&diff_weights_iter_md_);
         ok = ok && IMPLICATION(!is_zero_md(&diff_bias_md_),
                            memory_desc_matches_tag(diff_bias_md_, ldgo));
+        ok = ok && IMPLICATION(!is_zero_md(&diff_weights_peephole_md_),
+                           memory_desc_matches_tag(
+                                   diff_weights_peephole_md_, ldgo))
+                && IMPLICATION(!is_zero_md(&diff_weights_projection_md_),
+                           memory_desc_matches_tag(
+                                   diff_weights_projection_md_, ldio));
 
         return ok ? status::success : status::unimplemented;
     }
@@ -65,6 +65,7 @@ protected:
     size_t gate_dt_size = (src_data_t == data_type::u8) ? sizeof(uint32_t) : sizeof(float);
     size_t qscale_dt_size = sizeof(float);
     size_t bias_dt_size = sizeof(float);
+    size_t peephole_dt_size = sizeof(float);
 
     void generate() {
         using namespace Xbyak;
@@ -155,13 +156,17 @@ protected:
         auto addr_c_states_tm1_l_reg = abi_param4;
 #ifdef _WIN32
         auto addr_c_states_t_l_reg = r10;
+        auto addr_peephole_reg = r12;
         // Here we cannot use rbp to have initial stack pointer so we
         // use rsp and offset it with the size of pushed registers in
         // preamble
         mov(addr_c_states_t_l_reg, ptr[rsp + get_size_of_abi_save_regs() + 40]);
+        mov(addr_peephole_reg, ptr[rsp + get_size_of_abi_save_regs() + 48]);
 #else
         auto addr_c_states_t_l_reg = abi_param5;
+        auto addr_peephole_reg = abi_param6;
 #endif
+        const bool peephole = rnn_.is_lstm_peephole;
 
         // initialize registers with addresses and constants
         mov(table_reg, table_label);
@@ -195,11 +200,23 @@ protected:
             uni_vaddps(G2, G2, ptr[addr_bias_reg + 2 * rnn_.dic * bias_dt_size]);
             uni_vaddps(G3, G3, ptr[addr_bias_reg + 3 * rnn_.dic * bias_dt_size]);
 
+            // peephole connections of the input and forget gates
+            if (peephole) {
+                uni_vmovups(tmp1_vmm, ptr[addr_c_states_tm1_l_reg]);
+                uni_vmovups(tmp2_vmm, ptr[addr_peephole_reg
+                        + 0 * rnn_.dic * peephole_dt_size]);
+                uni_vfmadd231ps(G0, tmp2_vmm, tmp1_vmm);
+                uni_vmovups(tmp2_vmm, ptr[addr_peephole_reg
+                        + 1 * rnn_.dic * peephole_dt_size]);
+                uni_vfmadd231ps(G1, tmp2_vmm, tmp1_vmm);
+            }
+
             // inject eltwise code
             sigmoid_injector_->compute_vector(G0.getIdx());
             sigmoid_injector_->compute_vector(G1.getIdx());
             tanh_injector_->compute_vector(G2.getIdx());
-            sigmoid_injector_->compute_vector(G3.getIdx());
+            if (!peephole)
+                sigmoid_injector_->compute_vector(G3.getIdx());
 
             // compute c_states_t_l = G1 * c_tm1_l + G0 * G2
             uni_vmovups(tmp1_vmm, ptr[addr_c_states_tm1_l_reg]);
@@ -207,6 +224,14 @@ protected:
             uni_vfmadd231ps(tmp1_vmm, G0, G2);
             uni_vmovups(ptr[addr_c_states_t_l_reg], tmp1_vmm);
 
+            // the output gate looks at the new cell state
+            if (peephole) {
+                uni_vmovups(tmp2_vmm, ptr[addr_peephole_reg
+                        + 2 * rnn_.dic * peephole_dt_size]);
+                uni_vfmadd231ps(G3, tmp2_vmm, tmp1_vmm);
+                sigmoid_injector_->compute_vector(G3.getIdx());
+            }
+
             // states_t_l = G3 * tanh(c_states_t_l)
             tanh_injector_->compute_vector(tmp1_vmm.getIdx());
             uni_vmulps(tmp1_vmm, tmp1_vmm, G3);
@@ -234,6 +259,8 @@ protected:
             add(addr_states_t_l_reg, vlen_dst);
             add(addr_c_states_tm1_l_reg, vlen);
             add(addr_c_states_t_l_reg, vlen);
+            if (peephole)
+                add(addr_peephole_reg, vlen);
             if (mask != 0)
                 add(weights_scales_reg, vlen);
 
@@ -252,7 +279,7 @@ protected:
         {
             // remaping registers to Xmms
             Xmm G0s(G0.getIdx()), G1s(G1.getIdx()), G2s(G2.getIdx()), G3s(G3.getIdx());
-            Xmm tmp1s_vmm(tmp1_vmm.getIdx());
+            Xmm tmp1s_vmm(tmp1_vmm.getIdx()), tmp2s_vmm(tmp2_vmm.getIdx());
 
             // load G0 G1 G2 G3
             uni_vmovss(G0s, ptr[addr_ws_gates_reg + 0 * rnn_.dic * gate_dt_size]);
@@ -278,11 +305,23 @@ protected:
             uni_vmovss(tmp1s_vmm, ptr[addr_bias_reg + 3 * rnn_.dic * bias_dt_size]);
             uni_vaddps(G3s, G3s, tmp1s_vmm);
 
+            // peephole connections of the input and forget gates
+            if (peephole) {
+                uni_vmovss(tmp1s_vmm, ptr[addr_c_states_tm1_l_reg]);
+                uni_vmovss(tmp2s_vmm, ptr[addr_peephole_reg
+                        + 0 * rnn_.dic * peephole_dt_size]);
+                uni_vfmadd231ps(G0s, tmp2s_vmm, tmp1s_vmm);
+                uni_vmovss(tmp2s_vmm, ptr[addr_peephole_reg
+                        + 1 * rnn_.dic * peephole_dt_size]);
+                uni_vfmadd231ps(G1s, tmp2s_vmm, tmp1s_vmm);
+            }
+
             // inject eltwise code
             sigmoid_injector_->compute_vector(G0s.getIdx());
             sigmoid_injector_->compute_vector(G1s.getIdx());
             tanh_injector_->compute_vector(G2s.getIdx());
-            sigmoid_injector_->compute_vector(G3s.getIdx());
+            if (!peephole)
+                sigmoid_injector_->compute_vector(G3s.getIdx());
 
             // compute c_states_t_l = G1 * c_tm1_l + G0s * G2
             uni_vmovups(tmp1s_vmm, ptr[addr_c_states_tm1_l_reg]);
@@ -290,6 +329,14 @@ protected:
             uni_vfmadd231ps(tmp1s_vmm, G0s, G2s);
             uni_vmovss(ptr[addr_c_states_t_l_reg], tmp1s_vmm);
 
+            // the output gate looks at the new cell state
+            if (peephole) {
+                uni_vmovss(tmp2s_vmm, ptr[addr_peephole_reg
+                        + 2 * rnn_.dic * peephole_dt_size]);
+                uni_vfmadd231ps(G3s, tmp2s_vmm, tmp1s_vmm);
+                sigmoid_injector_->compute_vector(G3s.getIdx());
+            }
+
             // states_t_l = G3 * tanh(c_states_t_l)
             tanh_injector_->compute_vector(tmp1s_vmm.getIdx());
             uni_vmulps(tmp1s_vmm, tmp1s_vmm, G3s);
@@ -312,6 +359,8 @@ protected:
             add(addr_states_t_l_reg, hstate_dt_size);
             add(addr_c_states_tm1_l_reg, cstate_dt_size);
             add(addr_c_states_t_l_reg, cstate_dt_size);
+            if (peephole)
+                add(addr_peephole_reg, peephole_dt_size);
             if (mask != 0)
                 add(weights_scales_reg, qscale_dt_size);
 
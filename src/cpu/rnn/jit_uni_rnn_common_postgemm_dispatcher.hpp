@@ -39,7 +39,9 @@ template<prop_kind_t aprop, impl::data_type_t src_type>
 struct rnn_postgemm_dispatcher {
 
     typedef typename prec_traits<src_type>::type src_data_t;
-    typedef typename utils::conditional<src_type == data_type::u8, int32_t,
+    /* the C enumerator keeps the members external: data_type::u8 has internal
+     * linkage and gcc would give it to every member mentioning acc_data_t */
+    typedef typename utils::conditional<src_type == mkldnn_u8, int32_t,
             float>::type acc_data_t;
 
     using class_name = rnn_postgemm_dispatcher<aprop, src_type>;
@@ -176,12 +178,12 @@ struct rnn_postgemm_dispatcher {
         rnn_postgemm_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
                 states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
                 diff_states_t_lp1_, diff_states_tp1_l_, bias_, ws_grid_,
-                ws_cell_);
+                ws_cell_, weights_peephole_);
     else
         (this->*postgemm_func)(rnn, ws_gates_, states_t_l_, c_states_t_l_,
                 states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
                 diff_states_t_lp1_, diff_states_tp1_l_, bias_, ws_grid_,
-                ws_cell_);
+                ws_cell_, weights_peephole_);
 }
 
 // template <typename src_data_t, typename acc_data_t>
@@ -190,12 +192,12 @@ struct rnn_postgemm_dispatcher {
         rnn_postgemm_part2_->execute(rnn, ws_gates_, states_t_l_, c_states_t_l_,
                 states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
                 diff_states_t_lp1_, diff_states_tp1_l_, bias_, ws_grid_,
-                ws_cell_);
+                ws_cell_, weights_peephole_);
     else
         (this->*postgemm_part2_func)(rnn, ws_gates_, states_t_l_, c_states_t_l_,
                 states_tm1_l_, c_states_tm1_l_, diff_states_t_l_,
                 diff_states_t_lp1_, diff_states_tp1_l_, bias_, ws_grid_,
-                ws_cell_);
+                ws_cell_, weights_peephole_);
 }
 
 
@@ -39,17 +39,26 @@ rnn_postgemm_sig(rnn_postgemm_fwd_f32_t::lstm_postgemm) {
     ws_states_aoc_t states_t_l(rnn, states_t_l_);
     ws_states_aoc_t c_states_t_l(rnn, c_states_t_l_);
     ws_states_aoc_t c_states_tm1_l(rnn, c_states_tm1_l_);
+    const float *wp = weights_peephole_;
+    const bool peephole = rnn.is_lstm_peephole;
 
     parallel_nd(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
-            ws_gates(i, 0, j) = logistic_fwd(ws_gates(i, 0, j) + bias(0, j));
-            ws_gates(i, 1, j) = logistic_fwd(ws_gates(i, 1, j) + bias(1, j));
+            float c_tm1 = c_states_tm1_l(i, j);
+            float peep0 = peephole ? wp[j] * c_tm1 : 0.f;
+            float peep1 = peephole ? wp[rnn.dic + j] * c_tm1 : 0.f;
+            ws_gates(i, 0, j)
+                    = logistic_fwd(ws_gates(i, 0, j) + bias(0, j) + peep0);
+            ws_gates(i, 1, j)
+                    = logistic_fwd(ws_gates(i, 1, j) + bias(1, j) + peep1);
             ws_gates(i, 2, j) = tanh_fwd(ws_gates(i, 2, j) + bias(2, j));
-            ws_gates(i, 3, j) = logistic_fwd(ws_gates(i, 3, j) + bias(3, j));
 
-            float tmp = ws_gates(i, 1, j) * c_states_tm1_l(i, j)
+            float tmp = ws_gates(i, 1, j) * c_tm1
                     + ws_gates(i, 0, j) * ws_gates(i, 2, j);
+            float peep3 = peephole ? wp[2 * rnn.dic + j] * tmp : 0.f;
+            ws_gates(i, 3, j)
+                    = logistic_fwd(ws_gates(i, 3, j) + bias(3, j) + peep3);
             states_t_l(i, j) = ws_gates(i, 3, j) * tanh_fwd(tmp);
             c_states_t_l(i, j) = tmp;
         }
@@ -80,18 +89,25 @@ rnn_postgemm_sig(rnn_postgemm_fwd_u8_t::lstm_postgemm) {
                                                    * data_scale));
     };
 
+    const float *wp = weights_peephole_;
+    const bool peephole = rnn.is_lstm_peephole;
+
     parallel_nd(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
         for (int j = 0; j < rnn.dic; j++) {
+            float c_tm1 = c_states_tm1_l(i, j);
+            float peep0 = peephole ? wp[j] * c_tm1 : 0.f;
+            float peep1 = peephole ? wp[rnn.dic + j] * c_tm1 : 0.f;
             float G0 = logistic_fwd<float>(
-                    deq_w(ws_gates_s32(i, 0, j), 0, j) + bias(0, j));
+                    deq_w(ws_gates_s32(i, 0, j), 0, j) + bias(0, j) + peep0);
             float G1 = logistic_fwd<float>(
-                    deq_w(ws_gates_s32(i, 1, j), 1, j) + bias(1, j));
+                    deq_w(ws_gates_s32(i, 1, j), 1, j) + bias(1, j) + peep1);
             float G2 = tanh_fwd<float>(
                     deq_w(ws_gates_s32(i, 2, j), 2, j) + bias(2, j));
+            float tmp = G1 * c_tm1 + G0 * G2;
+            float peep3 = peephole ? wp[2 * rnn.dic + j] * tmp : 0.f;
             float G3 = logistic_fwd<float>(
-                    deq_w(ws_gates_s32(i, 3, j), 3, j) + bias(3, j));
-            float tmp = G1 * c_states_tm1_l(i, j) + G0 * G2;
+                    deq_w(ws_gates_s32(i, 3, j), 3, j) + bias(3, j) + peep3);
             states_t_l(i, j) = q_d(G3 * tanh_fwd(tmp));
             c_states_t_l(i, j) = tmp;
         }
@@ -107,6 +123,9 @@ rnn_postgemm_sig(rnn_postgemm_bwd_f32_t::lstm_postgemm) {
     ws_diff_states_aoc_t diff_states_t_l(rnn, diff_states_t_l_);
     ws_diff_states_aoc_t diff_states_tp1_l(rnn, diff_states_tp1_l_);
     ws_diff_states_aoc_t diff_states_t_lp1(rnn, diff_states_t_lp1_);
+    const float *wp = weights_peephole_;
+    const bool peephole = rnn.is_lstm_peephole;
+    const bool projection = rnn.is_lstm_projection;
 
     parallel_nd(rnn.mb, [&](int i) {
         PRAGMA_OMP_SIMD()
@@ -115,20 +134,28 @@ rnn_postgemm_sig(rnn_postgemm_bwd_f32_t::lstm_postgemm) {
             /// @todo save it in the workspace in fwd pass or recompute it to
             /// save bw
             float tanhCt = tanh_fwd(Ct);
-            // we have 2 incoming diffs on Ht
-            float dHt = diff_states_tp1_l(0, i, j)
-                    + diff_states_t_lp1(rnn.n_states, i, j);
+            // we have 2 incoming diffs on Ht, with projection the cell
+            // already brought their sum back to the unprojected Ht
+            float dHt = projection
+                    ? diff_states_t_l(0, i, j)
+                    : diff_states_tp1_l(0, i, j)
+                            + diff_states_t_lp1(rnn.n_states, i, j);
+            float dG3 = tanhCt * dHt * x_m_square(ws_gates(i, 3, j));
             float dCt = diff_states_tp1_l(1, i, j)
                     + one_m_square(tanhCt) * ws_gates(i, 3, j) * dHt;
+            if (peephole)
+                dCt += dG3 * wp[2 * rnn.dic + j];
 
             float dG1 = c_states_tm1_l(i, j) * dCt
                     * x_m_square(ws_gates(i, 1, j));
             float dG0 = ws_gates(i, 2, j) * dCt * x_m_square(ws_gates(i, 0, j));
-            float dG3 = tanhCt * dHt * x_m_square(ws_gates(i, 3, j));
             float dG2
                     = ws_gates(i, 0, j) * dCt * one_m_square(ws_gates(i, 2, j));
 
-            diff_states_t_l(1, i, j) = dCt * ws_gates(i, 1, j);
+            float dCtm1 = dCt * ws_gates(i, 1, j);
+            if (peephole)
+                dCtm1 += dG0 * wp[j] + dG1 * wp[rnn.dic + j];
+            diff_states_t_l(1, i, j) = dCtm1;
 
             ws_gates(i, 0, j) = dG0;
             ws_gates(i, 1, j) = dG1;
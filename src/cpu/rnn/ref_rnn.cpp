@@ -88,19 +88,11 @@ rnn_gemm_sig((_ref_rnn_common_t<aprop, src_type, weights_type>::packed_gemm)) {
             (transB == 'T') ? CblasTrans : CblasNoTrans, m, n, k, a_, ldA, b_,
             ldB, beta, c_, ldC);
 #else
-    UNUSED(transA);
-    UNUSED(transB);
-    UNUSED(m);
-    UNUSED(n);
-    UNUSED(k);
+    /* the weights reorder packed each part with packed_sgemm_pack() */
     UNUSED(alpha);
     UNUSED(ldA);
-    UNUSED(b_);
-    UNUSED(ldB);
-    UNUSED(beta);
-    UNUSED(c_);
-    UNUSED(ldC);
-    assert(!"packed gemm is disabled");
+    assert(transA == 'N');
+    packed_sgemm_compute(&transB, &m, &n, &k, a_, b_, &ldB, &beta, c_, &ldC);
 #endif
 }
 
@@ -113,19 +105,16 @@ rnn_gemm_sig((ref_rnn_fwd_u8s8_t::packed_gemm)) {
             CblasNoTrans, CblasFixOffset, m, n, k, alpha, a_, ldA, offseta, b_,
             ldB, offsetb, beta, c_, ldC, &offsetc);
 #else
-    UNUSED(transA);
-    UNUSED(transB);
-    UNUSED(m);
-    UNUSED(n);
-    UNUSED(k);
-    UNUSED(alpha);
+    /* the weights reorder leaves each part as a dense column-major m x k
+     * matrix of quantized weights; the compensation for the data shift is
+     * folded into the bias by bias_finalize */
     UNUSED(ldA);
-    UNUSED(b_);
-    UNUSED(ldB);
-    UNUSED(beta);
-    UNUSED(c_);
-    UNUSED(ldC);
-    assert(!"packed gemm is disabled");
+    assert(transA == 'N');
+    const int lda = m;
+    const int8_t offseta = 0, offsetb = 0;
+    const int32_t offsetc = 0;
+    gemm_s8x8s32<uint8_t>(&transA, &transB, "F", &m, &n, &k, &alpha, a_, &lda,
+            &offseta, b_, &ldB, &offsetb, &beta, c_, &ldC, &offsetc);
 #endif
 }
 
@@ -157,6 +146,16 @@ rnn_grid_execution_sig(
             diff_bias_, rnn.n_layer, rnn.n_dir, rnn.n_bias * rnn.dic);
     AOC<float, 4> ws_grid(
             ws_grid_, rnn.n_layer, rnn.n_dir, rnn.n_iter, (int)rnn.ws_per_cell);
+    AOC<const float, 3> weights_peephole(
+            weights_peephole_, rnn.n_layer, rnn.n_dir, 3 * rnn.dic);
+    AOC<const float, 3> weights_projection(
+            weights_projection_, rnn.n_layer, rnn.n_dir, rnn.dic * rnn.dhc);
+    AOC<float, 3> diff_weights_peephole(
+            diff_weights_peephole_, rnn.n_layer, rnn.n_dir, 3 * rnn.dic);
+    AOC<float, 3> diff_weights_projection(diff_weights_projection_,
+            rnn.n_layer, rnn.n_dir, rnn.dic * rnn.dhc);
+    AOC<float, 4> ws_proj_ht(ws_proj_ht_, rnn.n_layer, rnn.n_dir, rnn.n_iter,
+            rnn.states_nld * rnn.states_ws_ld);
 
     // We run the grid of computation
     for (int dir = 0; dir < rnn.n_dir; dir++) {
@@ -166,13 +165,20 @@ rnn_grid_execution_sig(
             if ((aprop == prop_kind::forward) && rnn.merge_gemm_layer) {
                 (this->*gemm_layer_func)('N', 'N', rnn.n_gates * rnn.dic,
                         rnn.mb * rnn.n_iter, rnn.slc, 1.0,
-                        weights_input(lay, dir, 0), rnn.weights_iter_ld,
+                        weights_input(lay, dir, 0), rnn.weights_layer_ld,
                         &(ws_states(lay, dir, 1, 0)), rnn.states_ws_ld, 0.0,
                         &(ws_gates(lay, dir, 0, 0)), rnn.gates_ws_ld);
             }
 
+            const bool peephole = rnn.is_lstm_peephole;
+            const bool projection = rnn.is_lstm_projection;
             for (int i = 0; i < rnn.n_iter; i++) {
                 int iter = (aprop == prop_kind::forward) ? i : rnn.n_iter - i - 1;
+                // inference reuses a single buffer for the unprojected state
+                float *proj_ht = !projection
+                        ? nullptr
+                        : rnn.is_training ? &(ws_proj_ht(lay, dir, iter, 0))
+                                          : ws_proj_ht_;
                 (this->*cell_func)(rnn,
                         &(ws_states(lay + 1, dir, iter + 1, 0)),
                         &(ws_c_states(lay + 1, dir, iter + 1, 0)),
@@ -190,7 +196,17 @@ rnn_grid_execution_sig(
                         &(diff_bias(lay, dir, 0)),
                         &(ws_gates(lay, dir, iter, 0)),
                         &(ws_grid(lay, dir, iter, 0)),
-                        ws_cell_);
+                        ws_cell_,
+                        peephole ? &(weights_peephole(lay, dir, 0)) : nullptr,
+                        projection ? &(weights_projection(lay, dir, 0))
+                                   : nullptr,
+                        proj_ht,
+                        peephole && aprop == prop_kind::backward
+                                ? &(diff_weights_peephole(lay, dir, 0))
+                                : nullptr,
+                        projection && aprop == prop_kind::backward
+                                ? &(diff_weights_projection(lay, dir, 0))
+                                : nullptr);
             }
 
             if ((aprop == prop_kind::backward) && rnn.merge_gemm_layer) {
@@ -263,12 +279,12 @@ void ref_rnn_bwd_f32_t::copy_init_layer(const rnn_conf_t &rnn,
         parallel_nd(rnn.n_iter, rnn.mb, [&](int it, int b) {
             auto diff_dst_layer_x
                     = diff_dst_layer_ + diff_dst_layer_d.blk_off(it, b);
-            for (int s = 0; s < rnn.dic; s++) {
+            for (int s = 0; s < rnn.dhc; s++) {
                 ws_diff_states(rnn.n_layer, 0, rnn.n_states, it, b, s)
                         = diff_dst_layer_x[s];
                 ws_diff_states(
                         rnn.n_layer, 1, rnn.n_states, rnn.n_iter - it - 1, b, s)
-                        = diff_dst_layer_x[rnn.dic + s];
+                        = diff_dst_layer_x[rnn.dhc + s];
             }
         });
         break;
@@ -276,7 +292,7 @@ void ref_rnn_bwd_f32_t::copy_init_layer(const rnn_conf_t &rnn,
         parallel_nd(rnn.n_iter, rnn.mb, [&](int it, int b) {
             auto diff_dst_layer_x
                     = diff_dst_layer_ + diff_dst_layer_d.blk_off(it, b);
-            for (int s = 0; s < rnn.dic; s++) {
+            for (int s = 0; s < rnn.dhc; s++) {
                 ws_diff_states(rnn.n_layer, 0, rnn.n_states, it, b, s)
                         = diff_dst_layer_x[s];
                 ws_diff_states(
@@ -289,7 +305,7 @@ void ref_rnn_bwd_f32_t::copy_init_layer(const rnn_conf_t &rnn,
         parallel_nd(rnn.n_iter, rnn.mb, [&](int it, int b) {
             auto diff_dst_layer_x
                     = diff_dst_layer_ + diff_dst_layer_d.blk_off(it, b);
-            for (int s = 0; s < rnn.dic; s++) {
+            for (int s = 0; s < rnn.dhc; s++) {
                 ws_diff_states(rnn.n_layer, 0, rnn.n_states, it, b, s)
                         = diff_dst_layer_x[s];
             }
@@ -299,7 +315,7 @@ void ref_rnn_bwd_f32_t::copy_init_layer(const rnn_conf_t &rnn,
         parallel_nd(rnn.n_iter, rnn.mb, [&](int it, int b) {
             auto diff_dst_layer_x = diff_dst_layer_
                     + diff_dst_layer_d.blk_off(rnn.n_iter - it - 1, b);
-            for (int s = 0; s < rnn.dic; s++) {
+            for (int s = 0; s < rnn.dhc; s++) {
                 ws_diff_states(rnn.n_layer, 0, rnn.n_states, it, b, s)
                         = diff_dst_layer_x[s];
             }
@@ -348,6 +364,8 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_init_iter(
             return (float)s;
     };
     auto firstit_states_d = memory_desc_wrapper(pd()->src_md(1));
+    // a projected LSTM keeps its dic wide cell state next to the hidden one
+    const int c_channels = rnn.is_lstm_projection ? rnn.dic : rnn.sic;
     if (firstit_states_) {
         parallel_nd(
                 rnn.n_layer, rnn.n_dir, rnn.mb, [&](int lay, int dir, int b) {
@@ -356,7 +374,7 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_init_iter(
                                 firstit_states_[firstit_states_d.blk_off(
                                         lay, dir, 0, b, s)]);
                     if (pd()->cell_kind() == alg_kind::vanilla_lstm)
-                        for (int s = 0; s < rnn.sic; s++)
+                        for (int s = 0; s < c_channels; s++)
                             ws_c_states(lay + 1, dir, 0, b, s) = maybe_deq(
                                     firstit_states_[firstit_states_d.blk_off(
                                             lay, dir, 1, b, s)]);
@@ -364,10 +382,10 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_init_iter(
     } else {
         parallel_nd(
                 rnn.n_layer, rnn.n_dir, rnn.mb, [&](int lay, int dir, int b) {
-                    for (int j = 0; j < rnn.sic; j++) {
+                    for (int j = 0; j < rnn.sic; j++)
                         ws_states(lay + 1, dir, 0, b, j) = (src_data_t)0;
+                    for (int j = 0; j < c_channels; j++)
                         ws_c_states(lay + 1, dir, 0, b, j) = 0.0f;
-                    }
         });
     }
 }
@@ -424,14 +442,14 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_res_layer(
     parallel_nd(rnn.n_iter, rnn.mb, [&](int it, int b) {
         int dir = 0;
         if (rnn.exec_dir != r2l) {
-            for (int s = 0; s < rnn.dic; s++) {
-                dst_layer_[dst_layer_d.blk_off(it, b, dir * rnn.dic + s)]
+            for (int s = 0; s < rnn.dhc; s++) {
+                dst_layer_[dst_layer_d.blk_off(it, b, dir * rnn.dhc + s)]
                         = maybe_deq(ws_states(rnn.n_layer, dir, it + 1, b, s));
             }
             dir = 1;
         }
         if (rnn.exec_dir != l2r) {
-            for (int s = 0; s < rnn.dic; s++)
+            for (int s = 0; s < rnn.dhc; s++)
                 switch (rnn.exec_dir) {
                 case bi_sum:
                     dst_layer_[dst_layer_d.blk_off(it, b, s)]
@@ -439,7 +457,7 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_res_layer(
                                     rnn.n_layer, dir, rnn.n_iter - it, b, s));
                     break;
                 default:
-                    dst_layer_[dst_layer_d.blk_off(it, b, dir * rnn.dic + s)]
+                    dst_layer_[dst_layer_d.blk_off(it, b, dir * rnn.dhc + s)]
                             = maybe_deq(ws_states(
                                     rnn.n_layer, dir, rnn.n_iter - it, b, s));
                 }
@@ -510,7 +528,7 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::copy_res_iter(
     if (dst_iter_) {
         parallel_nd(rnn.n_layer, rnn.n_dir, rnn.mb,
                 [&](int lay, int dir, int b) {
-            for (int s = 0; s < rnn.dic; s++) {
+            for (int s = 0; s < rnn.dhc; s++) {
                 dst_iter_[dst_iter_d.blk_off(lay, dir, 0, b, s)]
                         = maybe_deq(ws_states(lay + 1, dir, rnn.n_iter, b, s));
             }
@@ -537,7 +555,10 @@ void ref_rnn_bwd_f32_t::copy_res_iter(
     if (diff_src_iter_) {
         parallel_nd(rnn.n_layer, rnn.n_dir, rnn.n_states, rnn.mb,
                 [&](int lay, int dir, int state, int b) {
-                    for (int s = 0; s < rnn.sic; s++) {
+                    const int channels = state > 0 && rnn.is_lstm_projection
+                            ? rnn.dic
+                            : rnn.sic;
+                    for (int s = 0; s < channels; s++) {
                         diff_src_iter_[diff_src_iter_d.blk_off(
                                 lay, dir, state, b, s)]
                                 = ws_diff_states(lay, dir, state, 0, b, s);
@@ -644,6 +665,10 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::execute_(
     auto layer_weights_n_comp = CTX_IN_MEM(const char *, MKLDNN_ARG_WEIGHTS_LAYER);
     auto iter_weights_n_comp = CTX_IN_MEM(const char *, MKLDNN_ARG_WEIGHTS_ITER);
     auto bias = CTX_IN_MEM(const float *, MKLDNN_ARG_BIAS);
+    auto weights_peephole
+            = CTX_IN_MEM(const float *, MKLDNN_ARG_WEIGHTS_PEEPHOLE);
+    auto weights_projection
+            = CTX_IN_MEM(const float *, MKLDNN_ARG_WEIGHTS_PROJECTION);
 
     auto dst_last_layer = rnn.is_fwd
         ? CTX_OUT_MEM(char *, MKLDNN_ARG_DST_LAYER)
@@ -687,6 +712,7 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::execute_(
     float *ws_diff_states = (float *)(base_ptr + ws_diff_states_offset_);
     float *ws_grid = (float *)(base_ptr + ws_grid_comp_offset_);
     acc_data_t *ws_cell = (acc_data_t *)(base_ptr + ws_cell_comp_offset_);
+    float *ws_proj_ht = (float *)(base_ptr + ws_proj_ht_offset_);
 
     auto diff_src_layer = CTX_OUT_MEM(float *, MKLDNN_ARG_DIFF_SRC_LAYER);
     auto diff_src_iter = CTX_OUT_MEM(float *, MKLDNN_ARG_DIFF_SRC_ITER);
@@ -694,6 +720,10 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::execute_(
     auto diff_weights_layer = CTX_OUT_MEM(float *, MKLDNN_ARG_DIFF_WEIGHTS_LAYER);
     auto diff_weights_iter = CTX_OUT_MEM(float *, MKLDNN_ARG_DIFF_WEIGHTS_ITER);
     auto diff_bias = CTX_OUT_MEM(float *, MKLDNN_ARG_DIFF_BIAS);
+    auto diff_weights_peephole
+            = CTX_OUT_MEM(float *, MKLDNN_ARG_DIFF_WEIGHTS_PEEPHOLE);
+    auto diff_weights_projection
+            = CTX_OUT_MEM(float *, MKLDNN_ARG_DIFF_WEIGHTS_PROJECTION);
 
     // Fetching extra buffers from scratchpad
     float *ws_bias = (float *)(scratch_ptr + ws_bias_offset_);
@@ -734,7 +764,9 @@ void _ref_rnn_common_t<aprop, src_type, weights_type>::execute_(
     // run the execution on the grid
     (this->*grid_computation)(rnn, ptr_wei_layer, ptr_wei_iter, ptr_bias,
             ws_states, ws_c_states, ws_diff_states, ws_gates, ws_cell, ws_grid,
-            diff_weights_layer, diff_weights_iter, diff_bias);
+            diff_weights_layer, diff_weights_iter, diff_bias, weights_peephole,
+            weights_projection, ws_proj_ht, diff_weights_peephole,
+            diff_weights_projection);
 
     // Finally we copy the results to the result buffers
     if (rnn.dt_conf == u8u8u8f32 || rnn.dt_conf == f32u8f32f32
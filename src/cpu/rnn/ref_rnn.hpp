@@ -44,7 +44,9 @@ template <prop_kind_t aprop, impl::data_type_t src_type,
 struct _ref_rnn_common_t : public cpu_primitive_t {
     typedef typename prec_traits<src_type>::type src_data_t;
     typedef typename prec_traits<weights_type>::type weights_data_t;
-    typedef typename utils::conditional<src_type == data_type::u8, int32_t,
+    /* the C enumerator keeps the members external: data_type::u8 has internal
+     * linkage and gcc would give it to every member mentioning acc_data_t */
+    typedef typename utils::conditional<src_type == mkldnn_u8, int32_t,
             float>::type acc_data_t;
 
     using class_name = _ref_rnn_common_t<aprop, src_type, weights_type>;
@@ -210,7 +212,8 @@ struct _ref_rnn_common_t : public cpu_primitive_t {
         rnn_utils::set_offsets(pd()->rnn_, ws_gates_offset_, ws_states_offset_,
                 ws_c_states_offset_, ws_diff_states_offset_,
                 ws_grid_comp_offset_, ws_cell_comp_offset_,
-                ws_bias_offset_, scratchpad_size, workspace_size);
+                ws_proj_ht_offset_, ws_bias_offset_, scratchpad_size,
+                workspace_size);
     }
 
     ~_ref_rnn_common_t() {
@@ -272,6 +275,7 @@ private:
     size_t ws_diff_states_offset_;
     size_t ws_grid_comp_offset_;
     size_t ws_cell_comp_offset_;
+    size_t ws_proj_ht_offset_;
     rnn_postgemm_dispatcher<aprop,src_type> *rnn_postgemm_;
 
     grid_execution_f grid_computation;
@@ -24,7 +24,7 @@
 #include "utils.hpp"
 #include "simple_q10n.hpp"
 #include "cpu_reorder_pd.hpp"
-#include "../gemm/os_blas.hpp"
+#include "../gemm/gemm.hpp"
 
 namespace mkldnn {
 namespace impl {
@@ -94,9 +94,6 @@ struct rnn_weights_reorder_t : public cpu_primitive_t {
                 engine_t *engine, const primitive_attr_t *attr,
                 engine_t *src_engine, const memory_desc_t *src_md,
                 engine_t *dst_engine, const memory_desc_t *dst_md) {
-#if !USE_MKL_PACKED_GEMM
-            return status::unimplemented;
-#endif
             const memory_desc_wrapper id(src_md), od(dst_md);
             bool args_ok = true
                     && id.data_type() == type_i
@@ -159,7 +156,6 @@ private:
     rnn_weights_reorder_t(const pd_t *apd): cpu_primitive_t(apd) {}
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-#if USE_MKL_PACKED_GEMM
         auto input = CTX_IN_MEM(const in_data_t *, MKLDNN_ARG_FROM);
         auto output = CTX_OUT_MEM(char *, MKLDNN_ARG_TO);
         const memory_desc_wrapper &input_d = pd()->src_md();
@@ -248,6 +244,7 @@ private:
         const size_t *size_packed_cell
                 = output_d.rnn_packed_desc().part_pack_size;
         const int *parts = output_d.rnn_packed_desc().parts;
+#if USE_MKL_PACKED_GEMM
         const int n = output_d.rnn_packed_desc().n;
         char *to_pack = output;
         for (int l = 0; l < L; l++) {
@@ -265,6 +262,26 @@ private:
                 }
             }
         }
+#else
+        /* Without the MKL packed gemm every part becomes a dense
+         * column-major (parts[p] * O) x I matrix for gemm_s8x8s32 */
+        size_t size_packed_ld = 0;
+        for (int p = 0; p < n_parts; p++)
+            size_packed_ld += size_packed_cell[p];
+        parallel_nd(L, D, I, [&](int l, int d, int i) {
+            int8_t *to_pack = (int8_t *)output
+                    + (l * D + d) * size_packed_ld;
+            int g_s = 0;
+            for (int p = 0; p < n_parts; p++) {
+                const int m_p = parts[p] * O;
+                for (int g = g_s; g < g_s + parts[p]; g++)
+                for (int o = 0; o < O; o++)
+                    to_pack[i * m_p + (g - g_s) * O + o] = quantized[is_igo
+                            ? off_igo(l, d, i, g, o) : off_goi(l, d, i, g, o)];
+                to_pack += size_packed_cell[p];
+                g_s += parts[p];
+            }
+        });
 #endif
         return status::success;
     }
@@ -284,9 +301,6 @@ struct rnn_weights_reorder_t<data_type::f32, data_type::f32>
                 engine_t *engine, const primitive_attr_t *attr,
                 engine_t *src_engine, const memory_desc_t *src_md,
                 engine_t *dst_engine, const memory_desc_t *dst_md) {
-#if !USE_MKL_PACKED_GEMM
-            return status::unimplemented;
-#endif
             const memory_desc_wrapper id(src_md), od(dst_md);
             bool args_ok = true
                     && id.data_type() == data_type::f32
@@ -319,7 +333,6 @@ private:
     rnn_weights_reorder_t(const pd_t *apd): cpu_primitive_t(apd) {}
 
     virtual status_t execute(const exec_ctx_t &ctx) const override {
-#if USE_MKL_PACKED_GEMM
         auto input = CTX_IN_MEM(const float *, MKLDNN_ARG_FROM);
         auto output = CTX_OUT_MEM(float *, MKLDNN_ARG_TO);
         const memory_desc_wrapper &input_d = pd()->src_md();
@@ -338,7 +351,13 @@ private:
                     && rnn_pdata.format == mkldnn_ldgoi_p)
             || (pd()->itag_ == format_tag::ldgoi
                     && rnn_pdata.format == mkldnn_ldigo_p);
+#if USE_MKL_PACKED_GEMM
         auto trans = cross_case ? CblasTrans : CblasNoTrans;
+#else
+        /* the same layout as packed_sgemm_compute() expects */
+        const char trans = cross_case ? 'T' : 'N';
+        const float one = 1.0f;
+#endif
         int n_parts = rnn_pdata.n_parts;
         const size_t *size_packed_cell = rnn_pdata.part_pack_size;
         const int *parts = rnn_pdata.parts;
@@ -358,15 +377,20 @@ private:
                     int m_p = is_igo ? parts[p] * O : I;
                     int k_p = is_igo ? I : parts[p] * O;
                     int ld = is_igo ? G * O : I;
+                    const float *src = &input[is_igo
+                            ? off_igo(l, d, 0, g, 0) : off_goi(l, d, 0, g, 0)];
+#if USE_MKL_PACKED_GEMM
                     cblas_sgemm_pack(CblasColMajor, CblasAMatrix, trans, m_p, n,
-                            k_p, 1.0f, &input[is_igo ? off_igo(l, d, 0, g, 0) :
-                                                       off_goi(l, d, 0, g, 0)],
-                            ld, output);
+                            k_p, 1.0f, src, ld, output);
+#else
+                    UNUSED(n);
+                    packed_sgemm_pack(&trans, &m_p, &k_p, &one, src, &ld,
+                            output);
+#endif
                     output += size_packed_cell[p] / sizeof(float);
                 }
             }
         }
-#endif
         return status::success;
     }
 
@@ -19,6 +19,7 @@
 #include "mkldnn_thread.hpp"
 
 #include "ref_rnn.hpp"
+#include "../gemm/gemm.hpp"
 #include "rnn_utils.hpp"
 #include "type_helpers.hpp"
 
@@ -67,6 +68,10 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     rnn.is_training = utils::one_of(
             rd.prop_kind, prop_kind::forward_training, prop_kind::backward);
     rnn.is_lbr = rd.cell_desc.cell_kind == mkldnn_gru_linear_before_reset;
+    rnn.is_lstm_peephole = !memory_desc_wrapper(rd.weights_peephole_desc)
+            .is_zero();
+    rnn.is_lstm_projection = !memory_desc_wrapper(rd.weights_projection_desc)
+            .is_zero();
 
     switch (rd.direction) {
     case mkldnn_unidirectional_left2right: rnn.exec_dir = l2r; break;
@@ -102,6 +107,9 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     rnn.slc = weights_layer_d.dims()[2];
     rnn.dic = weights_layer_d.dims()[4];
     rnn.dlc = dst_layer_d.dims()[2];
+    rnn.dhc = rnn.is_lstm_projection
+            ? (int)rd.weights_projection_desc.dims[3]
+            : rnn.dic;
 
     rnn.gates_ld = rnn.dic * rnn.n_gates;
     rnn.gates_nld = rnn.mb;
@@ -138,7 +146,9 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
     /* Decide to copy bias */
     rnn.copy_bias = rnn.dt_conf != all_f32;
 
-#if USE_MKL_PACKED_GEMM
+    /* Without MKL the f32 weights are packed for packed_sgemm_compute() and
+     * the int8 weights are quantized and laid out for the library's own
+     * gemm_s8x8s32 by rnn_weights_reorder_t */
     rnn.use_layer_packed_gemm
             = (weights_layer_d.format_kind() == format_kind::any
                        && is_inference && rnn.n_iter == 1)
@@ -147,10 +157,6 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
             = (weights_layer_d.format_kind() == format_kind::any
                       && is_inference && rnn.mb >= 16)
             || is_int8;
-#else
-    rnn.use_layer_packed_gemm = false;
-    rnn.use_iter_packed_gemm = false;
-#endif
 
     /* Set packed gemm sizes */
     if (rnn.use_layer_packed_gemm) {
@@ -173,17 +179,17 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
                         = cblas_gemm_s8u8s32_pack_get_size(
                                 CblasAMatrix, m_p, n_p, k_p);
 #else
-            UNUSED(m_p);
-            UNUSED(k_p);
             UNUSED(n_p);
-            rnn.part_weights_layer_pack_size[p] = 0;
+            rnn.part_weights_layer_pack_size[p] = rnn.dt_conf == all_f32
+                ? packed_sgemm_get_size(&m_p, &k_p)
+                : get_s8_pack_size(m_p, k_p);
 #endif
             rnn.weights_layer_pack_size += rnn.n_layer * rnn.n_dir
                     * rnn.part_weights_layer_pack_size[p];
         }
         rnn.weights_layer_comp_offset = rnn.weights_layer_pack_size;
         rnn.weights_layer_pack_size += rnn.dt_conf == all_f32 ? 0 : rnn.n_layer
-                        * rnn.n_dir * rnn.n_gates * rnn.dlc * sizeof(float);
+                        * rnn.n_dir * rnn.n_gates * rnn.dic * sizeof(float);
     }
 
     if (rnn.use_iter_packed_gemm) {
@@ -204,10 +210,10 @@ void rnn_utils::init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
                         = cblas_gemm_s8u8s32_pack_get_size(
                                 CblasAMatrix, m_p, n_p, k_p);
 #else
-            UNUSED(m_p);
-            UNUSED(k_p);
             UNUSED(n_p);
-            rnn.part_weights_iter_pack_size[p] = 0;
+            rnn.part_weights_iter_pack_size[p] = rnn.dt_conf == all_f32
+                ? packed_sgemm_get_size(&m_p, &k_p)
+                : get_s8_pack_size(m_p, k_p);
 #endif
             rnn.weights_iter_pack_size += rnn.n_layer * rnn.n_dir
                     * rnn.part_weights_iter_pack_size[p];
@@ -292,6 +298,23 @@ void rnn_utils::set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
             * rnn.n_dir * rnn.n_iter * rnn.ws_per_cell * sizeof(float);
     rnn.ws_bias_size = (size_t)rnn.n_layer * rnn.n_dir * rnn.n_bias * rnn.dic
             * sizeof(float);
+
+    /* a projected LSTM keeps the hidden state before the projection: every
+     * cell's one is needed by the backward pass, otherwise a single buffer
+     * is reused (twice as large for int8 that also needs the f32 result of
+     * the projection before quantizing it) */
+    const int n_proj_ht = rnn.is_training
+            ? rnn.n_layer * rnn.n_dir * rnn.n_iter
+            : 1 + (rnn.dt_conf != all_f32);
+    rnn.ws_proj_ht_size = rnn.is_lstm_projection
+            ? (size_t)n_proj_ht * rnn.mb * rnn.states_ws_ld * sizeof(float)
+            : (size_t)0;
+}
+
+size_t rnn_utils::get_s8_pack_size(int m, int k) {
+    // a dense column-major m x k matrix; parts are kept 64-byte aligned so
+    // that the compensation that follows them is aligned as well
+    return utils::rnd_up((size_t)m * k * sizeof(int8_t), 64);
 }
 
 int rnn_utils::get_good_ld(int dim, int sizeof_dt) {
@@ -304,8 +327,9 @@ int rnn_utils::get_good_ld(int dim, int sizeof_dt) {
 void rnn_utils::set_offsets(const rnn_conf_t &rnn, size_t &ws_gates_offset,
         size_t &ws_states_offset, size_t &ws_c_states_offset,
         size_t &ws_diff_states_offset, size_t &ws_grid_comp_offset,
-        size_t &ws_cell_comp_offset, size_t &ws_bias_offset,
-        size_t &scratchpad_size, size_t &workspace_size) {
+        size_t &ws_cell_comp_offset, size_t &ws_proj_ht_offset,
+        size_t &ws_bias_offset, size_t &scratchpad_size,
+        size_t &workspace_size) {
 
     const size_t page_size = 4096; // 2097152;
     size_t current_offset;
@@ -335,6 +359,10 @@ void rnn_utils::set_offsets(const rnn_conf_t &rnn, size_t &ws_gates_offset,
     ws_cell_comp_offset = current_offset;
     current_offset += rnn.ws_cell_comp_size;
 
+    current_offset = utils::rnd_up(current_offset, page_size);
+    ws_proj_ht_offset = current_offset;
+    current_offset += rnn.ws_proj_ht_size;
+
     workspace_size = rnn.use_workspace ? current_offset : 0;
 
     /* Optional scratchpads */
@@ -356,10 +384,11 @@ void rnn_utils::get_scratchpad_and_workspace_sizes(const rnn_conf_t &rnn,
         size_t &scratchpad_size, size_t &workspace_size) {
     size_t ws_gates_offset, ws_states_offset, ws_c_states_offset,
             ws_diff_states_offset, ws_grid_comp_offset, ws_cell_comp_offset,
-            ws_bias_offset;
+            ws_proj_ht_offset, ws_bias_offset;
     set_offsets(rnn, ws_gates_offset, ws_states_offset, ws_diff_states_offset,
             ws_c_states_offset, ws_grid_comp_offset, ws_cell_comp_offset,
-            ws_bias_offset, scratchpad_size, workspace_size);
+            ws_proj_ht_offset, ws_bias_offset, scratchpad_size,
+            workspace_size);
 }
 
 status_t rnn_utils::set_good_strides(
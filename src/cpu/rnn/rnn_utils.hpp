@@ -27,7 +27,7 @@
             src_data_t *states_tm1_l_, float *c_states_tm1_l_,        \
             float *diff_states_t_l_, float *diff_states_t_lp1_,       \
             float *diff_states_tp1_l_, float *bias_, float *ws_grid_, \
-            acc_data_t *ws_cell_) const
+            acc_data_t *ws_cell_, const float *weights_peephole_) const
 
 #define rnn_cell_execution_sig(f)                                             \
     void f(const rnn_utils::rnn_conf_t &rnn, src_data_t *states_t_l_,     \
@@ -37,7 +37,10 @@
             src_data_t *states_tm1_l_, float *c_states_tm1_l_,            \
             float *diff_states_t_lp1_, float *diff_states_tp1_l_,         \
             float *diff_w_layer_, float *diff_w_iter_, float *diff_bias_, \
-            acc_data_t *ws_gates_, float *ws_grid_, acc_data_t *ws_cell_) const
+            acc_data_t *ws_gates_, float *ws_grid_, acc_data_t *ws_cell_, \
+            const float *weights_peephole_, const float *weights_projection_, \
+            float *proj_ht_, float *diff_weights_peephole_,               \
+            float *diff_weights_projection_) const
 
 #define rnn_grid_execution_sig(f)                                                 \
     void f(const rnn_utils::rnn_conf_t &rnn, weights_data_t **weights_layer_, \
@@ -45,7 +48,10 @@
             src_data_t *ws_states_, float *ws_c_states_,                      \
             float *ws_diff_states_, acc_data_t *ws_gates_, acc_data_t *ws_cell_,   \
             float *ws_grid_, float *diff_weights_layer_,                      \
-            float *diff_weights_iter_, float *diff_bias_) const
+            float *diff_weights_iter_, float *diff_bias_,                     \
+            const float *weights_peephole_, const float *weights_projection_, \
+            float *ws_proj_ht_, float *diff_weights_peephole_,                \
+            float *diff_weights_projection_) const
 
 #define rnn_gemm_sig(f)                                                     \
     void f(const char transA, const char transB, int m, int n, int k,   \
@@ -98,6 +104,9 @@ struct rnn_conf_t {
     int n_layer, n_iter, n_dir, n_gates, n_states;
     int mb;
     int slc, sic, dic, dlc;
+    /* channels of the hidden state passed to the next layer and iteration:
+     * the projection size for a projected LSTM, dic otherwise */
+    int dhc;
     int gates_ld, gates_nld, gates_ws_ld;
     int n_parts_weights_layer, parts_weights_layer[MKLDNN_RNN_MAX_N_PARTS];
     int n_parts_weights_iter, parts_weights_iter[MKLDNN_RNN_MAX_N_PARTS];
@@ -117,11 +126,13 @@ struct rnn_conf_t {
     int states_nld, states_ws_ld;
     int weights_iter_compensation_size, weights_layer_compensation_size;
     bool is_fwd, is_training, is_lbr;
+    bool is_lstm_peephole, is_lstm_projection;
     bool use_workspace;
 
     /* Size of workspace for each tensor in bytes */
     size_t ws_gates_size, ws_states_size, ws_c_states_size, ws_diff_states_size,
-            ws_cell_comp_size, ws_grid_comp_size, ws_per_cell, ws_bias_size;
+            ws_cell_comp_size, ws_grid_comp_size, ws_per_cell, ws_bias_size,
+            ws_proj_ht_size;
     bool merge_gemm_iter, merge_gemm_layer, use_jit_gemm, use_layer_packed_gemm,
         use_iter_packed_gemm;
 };
@@ -131,6 +142,10 @@ bool is_ldgoi(const memory_desc_wrapper &md);
 
 int get_good_ld(int dim, int sizeof_dt);
 
+/* Size in bytes of an int8 weights part laid out for gemm_s8x8s32 when the
+ * MKL packed gemm is unavailable */
+size_t get_s8_pack_size(int m, int k);
+
 void init_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
         const memory_desc_wrapper &src_layer_d,
         const memory_desc_wrapper &src_iter_d,
@@ -147,8 +162,9 @@ void set_conf(rnn_conf_t &rnn, const rnn_desc_t &rd,
 void set_offsets(const rnn_conf_t &rnn, size_t &ws_gates_offset,
         size_t &ws_h_state_offset, size_t &ws_c_state_offset,
         size_t &ws_diff_states_offset, size_t &ws_grid_comp_offset,
-        size_t &ws_cell_comp_offset, size_t &ws_bias_offset,
-        size_t &scratchpad_size, size_t &workspace_size);
+        size_t &ws_cell_comp_offset, size_t &ws_proj_ht_offset,
+        size_t &ws_bias_offset, size_t &scratchpad_size,
+        size_t &workspace_size);
 
 void get_scratchpad_and_workspace_sizes(const rnn_conf_t &rnn,
         size_t &scratchpad_size, size_t &workspace_size);
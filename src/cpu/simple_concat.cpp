@@ -53,6 +53,13 @@ status_t simple_concat_t<data_type>::execute(const exec_ctx_t &ctx) const {
         }
     }
 
+    // the sources that are the sub-memories of the destination are already
+    // in place (e.g. written there directly by the producers)
+    bool all_inplace = true;
+    for (int a = 0; a < num_arrs; ++a)
+        all_inplace = all_inplace && iptrs[a] == optrs[a];
+    if (all_inplace) return status::success;
+
     const memory_desc_wrapper o_d(pd()->src_image_md(0));
 
     strides_t os = { 0 };
@@ -66,6 +73,7 @@ status_t simple_concat_t<data_type>::execute(const exec_ctx_t &ctx) const {
 
     if (perm[concat_dim] == 0) {
         for (int a = 0; a < num_arrs; ++a) {
+            if (iptrs[a] == optrs[a]) continue;
             const data_t *i = &iptrs[a][0];
             data_t *o = &optrs[a][0];
             parallel_nd((ptrdiff_t)nelems_to_copy[a],
@@ -75,6 +83,7 @@ status_t simple_concat_t<data_type>::execute(const exec_ctx_t &ctx) const {
         parallel_nd(phys_dims[0], phys_dims[1], phys_dims[2], phys_dims[3],
             phys_dims[4], num_arrs,
             [&](dim_t n0, dim_t n1, dim_t n2, dim_t n3, dim_t n4, int a) {
+            if (iptrs[a] == optrs[a]) return;
             // XXX: this code may access uninitialized values in is[*][0-4] --
             // that's why we have to set them to zero although this is
             // probably benign
@@ -92,7 +101,7 @@ status_t simple_concat_t<data_type>::execute(const exec_ctx_t &ctx) const {
             const dim_t main_part =
                 nelems_to_copy[a] * sizeof(data_t) / sizeof(uint32_t);
             const dim_t tail_part =
-                nelems_to_copy[a] % sizeof(data_t) / sizeof(uint32_t);
+                nelems_to_copy[a] * sizeof(data_t) % sizeof(uint32_t);
 
             PRAGMA_OMP_SIMD()
             for (dim_t e = 0; e < main_part; ++e) {
@@ -112,6 +112,9 @@ struct simple_concat_t: public cpu_primitive_t {
             return nelems;
         }
 
+    protected:
+        virtual bool skips_inplace_srcs() const override { return true; }
+
     private:
         void format_perm() {
             const memory_desc_wrapper dst_d(dst_md());
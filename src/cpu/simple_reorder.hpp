@@ -115,7 +115,9 @@ typename utils::enable_if<tag_i == any && (false
         const int g = (tag_o == hwigo) ? (input_d.dims()[0]) : 1;
 
         return output_d.matches_tag(tag_o)
-            && (output_d.extra().flags & memory_extra_flags::compensation_conv_s8s8)
+            && (output_d.extra().flags & (0
+                        | memory_extra_flags::compensation_conv_s8s8
+                        | memory_extra_flags::compensation_conv_asymmetric_src))
             && (input_d.data_type() == f32 || input_d.data_type() == s8)
             && output_d.data_type() == s8
             && (D_mask == 1 || D_mask == (size_t)g * oc);
@@ -140,17 +142,22 @@ typename utils::enable_if<tag_i == any && (false
         const size_t D_mask = utils::array_product(input_d.dims(),
                 math::ilog2q(pd->attr()->output_scales_.mask_ + 1));
 
-        assert(output_d.extra().flags
-                & memory_extra_flags::compensation_conv_s8s8);
+        const bool req_comp = output_d.extra().flags
+            & memory_extra_flags::compensation_conv_s8s8;
+        const bool req_asymmetric_comp = output_d.extra().flags
+            & memory_extra_flags::compensation_conv_asymmetric_src;
+        assert(req_comp || req_asymmetric_comp);
+
         float adj_scale =
             (output_d.extra().flags & memory_extra_flags::scale_adjust)
             ? output_d.extra().scale_adjust : 1.f;
 
         size_t offset = G * pdims[w_groups + 0] * pdims[w_groups + 1] * H * W;
         int32_t *cp = reinterpret_cast<int32_t *>(output + offset);
+        int32_t *zp = cp + (req_comp ? G * OC : 0);
 
         parallel_nd(G, OC, [&](int g, int oc) {
-            cp[g * OC + oc] = 0;
+            int32_t acc = 0;
             for (int ic = 0; ic < IC; ic++)
             for (int h = 0; h < H; h++)
             for (int w = 0; w < W; w++) {
@@ -160,9 +167,10 @@ typename utils::enable_if<tag_i == any && (false
 
                 o = qz_b0<data_t<type_i>, data_t<type_o>>()(
                     i, s * adj_scale);
-                cp[g * OC + oc] -= (int32_t)o;
+                acc -= (int32_t)o;
             }
-            cp [g * OC + oc] *= 128;
+            if (req_comp) cp[g * OC + oc] = 128 * acc;
+            if (req_asymmetric_comp) zp[g * OC + oc] = acc;
         });
         return success;
     }
@@ -190,7 +198,9 @@ struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
 
         return input_d.matches_tag(tag_i)
             && output_d.matches_tag(tag_o)
-            && (output_d.extra().flags & memory_extra_flags::compensation_conv_s8s8)
+            && (output_d.extra().flags & (0
+                        | memory_extra_flags::compensation_conv_s8s8
+                        | memory_extra_flags::compensation_conv_asymmetric_src))
             && (input_d.data_type() == f32 || input_d.data_type() == s8)
             && output_d.data_type() == s8
             && (D_mask == 1 || D_mask == (size_t)g * oc);
@@ -228,14 +238,19 @@ struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
         const size_t D_mask = utils::array_product(input_d.dims(),
                             math::ilog2q(pd->attr()->output_scales_.mask_ + 1));
 
-        assert(output_d.extra().flags
-                & memory_extra_flags::compensation_conv_s8s8);
+        const bool req_comp = output_d.extra().flags
+            & memory_extra_flags::compensation_conv_s8s8;
+        const bool req_asymmetric_comp = output_d.extra().flags
+            & memory_extra_flags::compensation_conv_asymmetric_src;
+        assert(req_comp || req_asymmetric_comp);
+
         float adj_scale =
             (output_d.extra().flags & memory_extra_flags::scale_adjust)
             ? output_d.extra().scale_adjust : 1.f;
 
         auto ker = [&](const data_t<type_i> *inp, data_t<type_o> *out,
-            int32_t *c, const float *s, const int oc_block, const int ic_block) {
+            int32_t *c, int32_t *zp, const float *s, const int oc_block,
+            const int ic_block) {
 #           define index AB_or_BC_blk_off<tag_traits<tag_o>::inner_blks>
 
             for (int ic = 0; ic < ic_block; ++ic) {
@@ -246,7 +261,10 @@ struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
                 out[index(oc, ic)]
                     = qz_b0<data_t<type_i>, data_t<type_o>>()(
                             inp[_g_oihw_off], s[oc] * adj_scale);
-                c[oc] -= (128 * (int32_t)(out[index(oc, ic)]));
+                if (req_comp)
+                    c[oc] -= (128 * (int32_t)(out[index(oc, ic)]));
+                if (req_asymmetric_comp)
+                    zp[oc] -= (int32_t)(out[index(oc, ic)]);
             }
             }
 #           undef index
@@ -257,8 +275,10 @@ struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
 
         size_t offset = G * pdims[w_groups+0] * pdims[w_groups+1] * H * W;
         int32_t *cp = reinterpret_cast<int32_t *>(output + offset);
+        int32_t *zp = cp + (req_comp ? G * NB_OC * blksize : 0);
         parallel_nd(G * NB_OC * blksize, [&](int i) {
-            cp[i] = 0;
+            if (req_comp) cp[i] = 0;
+            if (req_asymmetric_comp) zp[i] = 0;
         });
 
 #       define wei_blk_off(md, g, o, i, h, w) \
@@ -278,6 +298,7 @@ struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
 
                     int _offset = (g * NB_OC + O) * blksize;
                     ker(i, o, (order_keep) ? &cp[_offset] : nullptr,
+                            (order_keep) ? &zp[_offset] : nullptr,
                             &scales[(D_mask == 1) ? 0 : _offset],
                                         oc_block, ic_block);
                 }
@@ -307,7 +328,9 @@ struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
             && order_keep
             && input_d.matches_tag(tag_i)
             && output_d.matches_tag(tag_o)
-            && (output_d.extra().flags & memory_extra_flags::compensation_conv_s8s8)
+            && (output_d.extra().flags & (0
+                        | memory_extra_flags::compensation_conv_s8s8
+                        | memory_extra_flags::compensation_conv_asymmetric_src))
             && (input_d.data_type() == f32 || input_d.data_type() == s8)
             && output_d.data_type() == s8
             && (D_mask == 1 || D_mask == (size_t)g * oc);
@@ -333,29 +356,39 @@ struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
                             math::ilog2q(pd->attr()->output_scales_.mask_ + 1));
         const float *scales = pd->attr()->output_scales_.scales_;
 
-        assert(output_d.extra().flags
-                & memory_extra_flags::compensation_conv_s8s8);
+        const bool req_comp = output_d.extra().flags
+            & memory_extra_flags::compensation_conv_s8s8;
+        const bool req_asymmetric_comp = output_d.extra().flags
+            & memory_extra_flags::compensation_conv_asymmetric_src;
+        assert(req_comp || req_asymmetric_comp);
+
         float adj_scale =
             (output_d.extra().flags & memory_extra_flags::scale_adjust)
             ? output_d.extra().scale_adjust : 1.f;
 
         auto ker = [&](const data_t<type_i> *inp, data_t<type_o> *out,
-                int32_t *cp, const float *s, const int g_block) {
+                int32_t *cp, int32_t *zp, const float *s, const int g_block) {
             PRAGMA_OMP_SIMD()
             for (int g = 0; g < g_block; g++) {
                 const auto i_off = g * input_d.blocking_desc().strides[0];
                 out[g] = qz_b0<data_t<type_i>, data_t<type_o>>()(
                         inp[i_off], s[g * OC] * adj_scale);
-                cp[g * OC] -= 128 * (int32_t)(out[g]);
+                if (req_comp)
+                    cp[g * OC] -= 128 * (int32_t)(out[g]);
+                if (req_asymmetric_comp)
+                    zp[g * OC] -= (int32_t)(out[g]);
             }
         };
 
         size_t cp_offset = output_d.size() - output_d.additional_buffer_size();
         int32_t *cp = reinterpret_cast<int32_t *>(output + cp_offset);
+        int32_t *zp = cp + (req_comp ? Gp * OC : 0);
         parallel_nd((Gp/blksize) * OC, [&](int ib) {
             PRAGMA_OMP_SIMD()
-            for (int i = 0; i < blksize; i++)
-                cp[ib * blksize + i] = 0;
+            for (int i = 0; i < blksize; i++) {
+                if (req_comp) cp[ib * blksize + i] = 0;
+                if (req_asymmetric_comp) zp[ib * blksize + i] = 0;
+            }
         });
 
 #       define wei_blk_off(md, g, o, i, h, w) \
@@ -372,7 +405,7 @@ struct simple_reorder_impl<SIMPLE_REORDER_TEMPL_CALL,
                         const auto out = &output[wei_blk_off(
                                 output_d, gb, O, I, h, w)];
                         int offset = gb * blksize + O;
-                        ker(inp, out, &cp[offset],
+                        ker(inp, out, &cp[offset], &zp[offset],
                             &scales[(D_mask == 1) ? 0 : offset], g_block);
                    }
                }
@@ -34,6 +34,12 @@
 #include "reorder/reorder.hpp"
 #include "bnorm/bnorm.hpp"
 #include "rnn/rnn.hpp"
+#include "pool/pool.hpp"
+#include "eltwise/eltwise.hpp"
+#include "softmax/softmax.hpp"
+#include "lrn/lrn.hpp"
+#include "concat/concat.hpp"
+#include "sum/sum.hpp"
 
 int verbose {0};
 bench_mode_t bench_mode {CORR};
@@ -42,9 +48,14 @@ stat_t benchdnn_stat {0};
 double max_ms_per_prb {3e3};
 int min_times_per_prb {5};
 int fix_times_per_prb {0};
+int instances {1};
+int threads_per_instance {0};
+bool cold_cache {false};
+int trials {0};
 
 int main(int argc, char **argv) {
     prim_t prim = DEF;
+    bool with_baseline = false;
     --argc; ++argv;
 
     while (argc > 0) {
@@ -56,10 +67,34 @@ int main(int argc, char **argv) {
         else if (!strcmp("--reorder", argv[0])) prim = REORDER;
         else if (!strcmp("--bnorm", argv[0])) prim = BNORM;
         else if (!strcmp("--rnn", argv[0])) prim = RNN;
+        else if (!strcmp("--pool", argv[0])) prim = POOL;
+        else if (!strcmp("--eltwise", argv[0])) prim = ELTWISE;
+        else if (!strcmp("--softmax", argv[0])) prim = SOFTMAX;
+        else if (!strcmp("--lrn", argv[0])) prim = LRN;
+        else if (!strcmp("--concat", argv[0])) prim = CONCAT;
+        else if (!strcmp("--sum", argv[0])) prim = SUM;
         else if (!strncmp("--mode=", argv[0], 7))
             bench_mode = str2bench_mode(argv[0] + 7);
         else if (!strncmp("--max-ms-per-prb=", argv[0], 17))
             sscanf(argv[0] + 17, "%lf", &max_ms_per_prb);
+        else if (!strncmp("--perf-format=", argv[0], 14))
+            perf_format = str2perf_format(argv[0] + 14);
+        else if (!strncmp("--instances=", argv[0], 12))
+            instances = atoi(argv[0] + 12);
+        else if (!strncmp("--threads-per-instance=", argv[0], 23))
+            threads_per_instance = atoi(argv[0] + 23);
+        else if (!strncmp("--cold-cache=", argv[0], 13))
+            cold_cache = str2bool(argv[0] + 13);
+        else if (!strncmp("--trials=", argv[0], 9))
+            trials = atoi(argv[0] + 9);
+        else if (!strncmp("--save-baseline=", argv[0], 16)) {
+            SAFE(save_baseline(argv[0] + 16), CRIT);
+            with_baseline = true;
+        } else if (!strncmp("--compare=", argv[0], 10)) {
+            SAFE(load_baseline(argv[0] + 10), CRIT);
+            with_baseline = true;
+        } else if (!strncmp("--compare-threshold=", argv[0], 20))
+            sscanf(argv[0] + 20, "%lf", &compare_threshold);
         else if (!strncmp("-v", argv[0], 2))
             verbose = atoi(argv[0] + 2);
         else if (!strncmp("--verbose=", argv[0], 10))
@@ -70,8 +105,14 @@ int main(int argc, char **argv) {
         ++argv;
     }
 
+    driver_name = prim2str(prim);
+
     if (max_ms_per_prb < 100 || max_ms_per_prb > 60e3)
         max_ms_per_prb = 3e3;
+    if (instances < 1) instances = 1;
+    if (threads_per_instance < 0) threads_per_instance = 0;
+    /* a baseline needs an estimate of the noise */
+    if (trials < 1) trials = with_baseline ? 5 : 1;
 
     init_fp_mode();
     init();
@@ -85,6 +126,12 @@ int main(int argc, char **argv) {
     case REORDER: reorder::bench(argc, argv); break;
     case BNORM: bnorm::bench(argc, argv); break;
     case RNN: rnn::bench(argc, argv); break;
+    case POOL: pool::bench(argc, argv); break;
+    case ELTWISE: eltwise::bench(argc, argv); break;
+    case SOFTMAX: softmax::bench(argc, argv); break;
+    case LRN: lrn::bench(argc, argv); break;
+    case CONCAT: concat::bench(argc, argv); break;
+    case SUM: sum::bench(argc, argv); break;
     default: fprintf(stderr, "err: unknown driver\n");
     }
 
@@ -101,6 +148,11 @@ int main(int argc, char **argv) {
                 benchdnn_stat.ms[benchdnn_timer_t::min],
                 benchdnn_stat.ms[benchdnn_timer_t::avg]);
     }
+    if (baseline_loaded()) {
+        printf("baseline: regressed:%d improved:%d new:%d\n",
+                benchdnn_stat.regressed, benchdnn_stat.improved,
+                benchdnn_stat.added);
+    }
 
-    return !!benchdnn_stat.failed;
+    return !!benchdnn_stat.failed || !!benchdnn_stat.regressed;
 }
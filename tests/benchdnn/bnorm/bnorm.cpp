@@ -633,6 +633,7 @@ int doit(const prb_t *p, res_t *r) {
     dnn_mem_t &ws_dt = *p_ws_dt;
 
     DNN_SAFE(mkldnn_primitive_create(&b, bpd), WARN);
+    set_perf_info(r, bpd);
     DNN_SAFE(mkldnn_primitive_desc_destroy(bpd), CRIT);
 
     args_t args;
@@ -718,20 +719,8 @@ int doit(const prb_t *p, res_t *r) {
         }
     }
 
-    if (bench_mode & PERF) {
-        auto &t = r->timer;
-        t.reset();
-        while (true) {
-            DNN_SAFE(mkldnn_primitive_execute(b, stream, args.size(), args), WARN);
-            t.stamp();
-            const bool stop = false
-                || (fix_times_per_prb && t.times() >= fix_times_per_prb)
-                || (!fix_times_per_prb
-                        && t.total_ms() >= max_ms_per_prb
-                        && t.times() >= min_times_per_prb);
-            if (stop) break;
-        }
-    }
+    if (bench_mode & PERF)
+        SAFE(measure_perf(r, b, args), WARN);
 
     delete p_ws_dt;
     DNN_SAFE(mkldnn_primitive_destroy(b), CRIT);
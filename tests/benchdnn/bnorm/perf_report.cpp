@@ -70,6 +70,11 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
         return 1e0;
     };
 
+    if (perf_format != PERF_TEMPLATE) {
+        perf_print_record(r, pstr, 0);
+        return;
+    }
+
     const char *pt = perf_template;
     char c;
 
@@ -108,8 +113,12 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
             DPRINT("%s", tag2str(p->tag));
         else if (c == 't')
             DPRINT("%g", t.ms(mode) / unit);
-        else
-            []() { SAFE(FAIL, CRIT); return 0; }();
+        else {
+            const int l = perf_print_common(buf, rem_len, c, mode, unit, r,
+                    0);
+            if (l < 0) []() { SAFE(FAIL, CRIT); return 0; }();
+            buf += l; rem_len -= l;
+        }
     }
 
     *buf = '\0';
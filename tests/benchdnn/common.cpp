@@ -21,6 +21,16 @@
 #include "mkldnn.h"
 
 #include "common.hpp"
+#include "src/common/mkldnn_thread.hpp"
+
+const char *prim2str(prim_t prim) {
+    const char *prims[] = { "self", "conv", "deconv", "ip", "shuffle",
+        "reorder", "bnorm", "rnn", "pool", "eltwise", "softmax", "lrn",
+        "concat", "sum", };
+    assert((size_t)prim < sizeof(prims) / sizeof(prims[0]));
+    return prims[(size_t)prim];
+}
+
 const char *bench_mode2str(bench_mode_t mode) {
     const char *modes[] = {
         "MODE_UNDEF", "CORR", "PERF", "CORR+PERF"
@@ -43,7 +53,7 @@ bench_mode_t str2bench_mode(const char *str) {
 /* perf */
 #include <chrono>
 
-static inline double ms_now() {
+double ms_now() {
     auto timePointTmp
         = std::chrono::high_resolution_clock::now().time_since_epoch();
     return std::chrono::duration<double, std::milli>(timePointTmp).count();
@@ -101,6 +111,21 @@ void benchdnn_timer_t::stop() {
     times_++;
 }
 
+void benchdnn_timer_t::merge(const benchdnn_timer_t &rhs) {
+    if (rhs.times_ == 0) return;
+    if (times_ == 0) { *this = rhs; return; }
+
+    ms_[min] = MIN2(ms_[min], rhs.ms_[min]);
+    ms_[avg] += rhs.ms_[avg];
+    ms_[max] = MAX2(ms_[max], rhs.ms_[max]);
+
+    ticks_[min] = MIN2(ticks_[min], rhs.ticks_[min]);
+    ticks_[avg] += rhs.ticks_[avg];
+    ticks_[max] = MAX2(ticks_[max], rhs.ticks_[max]);
+
+    times_ += rhs.times_;
+}
+
 benchdnn_timer_t &benchdnn_timer_t::operator=(const benchdnn_timer_t &rhs) {
     if (this == &rhs) return *this;
     times_ = rhs.times_;
@@ -175,7 +200,382 @@ void parse_result(res_t &res, bool &want_perf_report, bool allow_unimpl,
         using bt = benchdnn_timer_t;
         for (int mode = 0; mode < (int)bt::n_modes; ++mode)
             bs.ms[mode] += res.timer.ms((bt::mode_t)mode);
+        if (want_perf_report)
+            perf_baseline_record(res, pstr);
+    }
+}
+
+/* efficiency */
+perf_format_t perf_format {PERF_TEMPLATE};
+const char *driver_name = "conv";
+
+const char *perf_format2str(perf_format_t fmt) {
+    if (fmt == PERF_TEMPLATE) return "template";
+    if (fmt == PERF_CSV) return "csv";
+    if (fmt == PERF_JSON) return "json";
+    assert(!"unknown perf format");
+    return "unknown perf format";
+}
+
+perf_format_t str2perf_format(const char *str) {
+    if (!strcasecmp("template", str)) return PERF_TEMPLATE;
+    if (!strcasecmp("csv", str)) return PERF_CSV;
+    if (!strcasecmp("json", str)) return PERF_JSON;
+    []() { SAFE(FAIL, CRIT); return 0; }();
+    return PERF_TEMPLATE;
+}
+
+namespace {
+
+/* Independent accumulation chains keep all the fma ports busy: the number of
+ * chains covers the fma latency times the number of ports on the current
+ * cores. The loops return their result so that they are not optimized out. */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(_M_X64))
+#define BENCHDNN_PEAK_X86
+#include <immintrin.h>
+
+__attribute__((target("avx512f")))
+float fma_loop_avx512(int64_t iters) {
+    const int n = 16;
+    __m512 acc[n];
+    const __m512 b = _mm512_set1_ps(0.999f), c = _mm512_set1_ps(1e-3f);
+    for (int i = 0; i < n; ++i) acc[i] = _mm512_set1_ps((float)i);
+    for (int64_t it = 0; it < iters; ++it)
+        for (int i = 0; i < n; ++i) acc[i] = _mm512_fmadd_ps(acc[i], b, c);
+    for (int i = 1; i < n; ++i) acc[0] = _mm512_add_ps(acc[0], acc[i]);
+    float out[16];
+    _mm512_storeu_ps(out, acc[0]);
+    return out[0];
+}
+
+__attribute__((target("avx2,fma")))
+float fma_loop_avx2(int64_t iters) {
+    const int n = 12;
+    __m256 acc[n];
+    const __m256 b = _mm256_set1_ps(0.999f), c = _mm256_set1_ps(1e-3f);
+    for (int i = 0; i < n; ++i) acc[i] = _mm256_set1_ps((float)i);
+    for (int64_t it = 0; it < iters; ++it)
+        for (int i = 0; i < n; ++i) acc[i] = _mm256_fmadd_ps(acc[i], b, c);
+    for (int i = 1; i < n; ++i) acc[0] = _mm256_add_ps(acc[0], acc[i]);
+    float out[8];
+    _mm256_storeu_ps(out, acc[0]);
+    return out[0];
+}
+
+float fma_loop_sse(int64_t iters) {
+    const int n = 12;
+    __m128 acc[n];
+    const __m128 b = _mm_set1_ps(0.999f), c = _mm_set1_ps(1e-3f);
+    for (int i = 0; i < n; ++i) acc[i] = _mm_set1_ps((float)i);
+    for (int64_t it = 0; it < iters; ++it)
+        for (int i = 0; i < n; ++i)
+            acc[i] = _mm_add_ps(_mm_mul_ps(acc[i], b), c);
+    for (int i = 1; i < n; ++i) acc[0] = _mm_add_ps(acc[0], acc[i]);
+    return _mm_cvtss_f32(acc[0]);
+}
+#endif
+
+float fma_loop_scalar(int64_t iters) {
+    const int n = 8;
+    float acc[n];
+    for (int i = 0; i < n; ++i) acc[i] = (float)i;
+    for (int64_t it = 0; it < iters; ++it)
+        for (int i = 0; i < n; ++i) acc[i] = acc[i] * 0.999f + 1e-3f;
+    for (int i = 1; i < n; ++i) acc[0] += acc[i];
+    return acc[0];
+}
+
+void measure_compute_peak(machine_peak_t &mp) {
+    float (*loop)(int64_t) = fma_loop_scalar;
+    double ops_per_iter = 8 * 2;
+    mp.isa = "scalar";
+#if defined(BENCHDNN_PEAK_X86)
+    if (__builtin_cpu_supports("avx512f")) {
+        loop = fma_loop_avx512; ops_per_iter = 16 * 16 * 2; mp.isa = "avx512";
+    } else if (__builtin_cpu_supports("avx2")
+            && __builtin_cpu_supports("fma")) {
+        loop = fma_loop_avx2; ops_per_iter = 12 * 8 * 2; mp.isa = "avx2";
+    } else {
+        loop = fma_loop_sse; ops_per_iter = 12 * 4 * 2; mp.isa = "sse";
+    }
+#endif
+
+    const int64_t iters = 1 << 20;
+    const int nthr = mkldnn_get_max_threads();
+    volatile float sink = 0;
+
+    double best_ms = 0;
+    for (int rep = 0; rep < 5; ++rep) {
+        const double start = ms_now();
+        mkldnn::impl::parallel(nthr, [&](int, int) {
+            const float res = loop(iters);
+            if (res == -1.f) sink = res; /* never happens */
+        });
+        const double d_ms = ms_now() - start;
+        best_ms = rep ? MIN2(best_ms, d_ms) : d_ms;
+    }
+    (void)sink;
+
+    mp.ops_per_s = ops_per_iter * iters * nthr / best_ms * 1e3;
+}
+
+/* stream triad: a = b + s * c over arrays much larger than the caches */
+void measure_bandwidth_peak(machine_peak_t &mp) {
+    const int64_t n = (int64_t)1 << 24, blk = 1 << 14;
+    float *a = (float *)zmalloc(n * sizeof(float), 64);
+    float *b = (float *)zmalloc(n * sizeof(float), 64);
+    float *c = (float *)zmalloc(n * sizeof(float), 64);
+    if (!a || !b || !c) {
+        zfree(a); zfree(b); zfree(c);
+        mp.bytes_per_s = 0;
+        return;
+    }
+
+    /* first touch by the threads that use the data */
+    mkldnn::impl::parallel_nd(n / blk, [&](int64_t ib) {
+        for (int64_t i = ib * blk; i < (ib + 1) * blk; ++i) {
+            a[i] = 0.f; b[i] = 1.f; c[i] = 2.f;
+        }
+    });
+
+    const float s = 3.f;
+    double best_ms = 0;
+    for (int rep = 0; rep < 5; ++rep) {
+        const double start = ms_now();
+        mkldnn::impl::parallel_nd(n / blk, [&](int64_t ib) {
+            for (int64_t i = ib * blk; i < (ib + 1) * blk; ++i)
+                a[i] = b[i] + s * c[i];
+        });
+        const double d_ms = ms_now() - start;
+        best_ms = rep ? MIN2(best_ms, d_ms) : d_ms;
+    }
+
+    mp.bytes_per_s = 3. * n * sizeof(float) / best_ms * 1e3;
+
+    zfree(a); zfree(b); zfree(c);
+}
+
+}
+
+const machine_peak_t &machine_peak() {
+    static machine_peak_t mp = []() {
+        machine_peak_t mp;
+        measure_compute_peak(mp);
+        measure_bandwidth_peak(mp);
+        print(2, "machine peak: isa:%s threads:%d GFLOPS:%g GB/s:%g\n",
+                mp.isa, mkldnn_get_max_threads(), mp.ops_per_s * 1e-9,
+                mp.bytes_per_s * 1e-9);
+        return mp;
+    }();
+    return mp;
+}
+
+double roofline_efficiency(double ops, double bytes, double ms) {
+    const auto &mp = machine_peak();
+    if (ms <= 0) return 0;
+
+    const double s = ms * 1e-3;
+    if (ops > 0) {
+        double attainable = mp.ops_per_s;
+        if (bytes > 0)
+            attainable = MIN2(attainable, ops / bytes * mp.bytes_per_s);
+        return 100. * ops / s / attainable;
+    }
+    return mp.bytes_per_s > 0 ? 100. * bytes / s / mp.bytes_per_s : 0;
+}
+
+int perf_print_common(char *buf, int len, char c,
+        benchdnn_timer_t::mode_t mode, double unit, const res_t *r,
+        double ops) {
+    const auto &t = r->timer;
+    if (c == 'p')
+        return snprintf(buf, len, "%g", ops / t.ms(mode) / unit * 1e3);
+    if (c == 'b')
+        return snprintf(buf, len, "%g", r->bytes / t.ms(mode) / unit * 1e3);
+    if (c == 'e')
+        return snprintf(buf, len, "%g",
+                roofline_efficiency(ops, r->bytes, t.ms(mode)));
+    if (c == 'i')
+        return snprintf(buf, len, "%s", r->impl_name);
+    if (c == 'T')
+        return snprintf(buf, len, "%d", r->threads);
+    if (c == 'N')
+        return snprintf(buf, len, "%d", r->instances);
+    if (c == 'I')
+        return snprintf(buf, len, "%g", r->prb_per_s * r->mb / unit);
+    if (c == 'l')
+        return snprintf(buf, len, "%g", r->p50_ms);
+    if (c == 'L')
+        return snprintf(buf, len, "%g", r->p99_ms);
+    return -1;
+}
+
+/* csv fields are quoted, json strings are escaped */
+static void print_escaped(const char *str, bool csv, FILE *f = stdout) {
+    for (const char *s = str; *s; ++s) {
+        if (csv && *s == '"') fprintf(f, "\"\"");
+        else if (!csv && (*s == '"' || *s == '\\')) fprintf(f, "\\%c", *s);
+        else fputc(*s, f);
+    }
+}
+
+void perf_print_record(const res_t *r, const char *pstr, double ops) {
+    using bt = benchdnn_timer_t;
+    const auto &t = r->timer;
+    const auto &mp = machine_peak();
+
+    const double min_ms = t.ms(bt::min), avg_ms = t.ms(bt::avg);
+    const double max_ms = t.ms(bt::max);
+    const double gflops = ops / min_ms * 1e-6;
+    const double gbs = r->bytes / min_ms * 1e-6;
+    const double eff = roofline_efficiency(ops, r->bytes, min_ms);
+    const int nthr = r->threads;
+    const double images_per_s = r->prb_per_s * r->mb;
+
+    if (perf_format == PERF_CSV) {
+        static bool header_printed = false;
+        if (!header_printed) {
+            printf("driver,problem,impl,threads,ops,bytes,min_ms,avg_ms,"
+                    "max_ms,gflops,gbs,peak_gflops,peak_gbs,efficiency,"
+                    "instances,images_per_s,p50_ms,p99_ms,cold_cache\n");
+            header_printed = true;
+        }
+        printf("%s,\"", driver_name);
+        print_escaped(pstr, true);
+        printf("\",%s,%d,%g,%g,%g,%g,%g,%g,%g,%g,%g,%g,%d,%g,%g,%g,%s\n",
+                r->impl_name, nthr, ops, r->bytes, min_ms, avg_ms, max_ms,
+                gflops, gbs, mp.ops_per_s * 1e-9, mp.bytes_per_s * 1e-9, eff,
+                r->instances, images_per_s, r->p50_ms, r->p99_ms,
+                bool2str(cold_cache));
+    } else if (perf_format == PERF_JSON) {
+        /* one object per line (json lines) */
+        printf("{\"driver\":\"%s\",\"problem\":\"", driver_name);
+        print_escaped(pstr, false);
+        printf("\",\"impl\":\"%s\",\"threads\":%d,\"ops\":%g,"
+                "\"bytes\":%g,\"min_ms\":%g,\"avg_ms\":%g,\"max_ms\":%g,"
+                "\"gflops\":%g,\"gbs\":%g,\"peak_gflops\":%g,"
+                "\"peak_gbs\":%g,\"efficiency\":%g,\"isa\":\"%s\","
+                "\"instances\":%d,\"images_per_s\":%g,\"p50_ms\":%g,"
+                "\"p99_ms\":%g,\"cold_cache\":%s}\n",
+                r->impl_name, nthr, ops, r->bytes, min_ms, avg_ms, max_ms,
+                gflops, gbs, mp.ops_per_s * 1e-9, mp.bytes_per_s * 1e-9, eff,
+                mp.isa, r->instances, images_per_s, r->p50_ms, r->p99_ms,
+                bool2str(cold_cache));
+    }
+    fflush(0);
+}
+
+/* baseline */
+#include <map>
+#include <string>
+
+double compare_threshold {5.};
+
+namespace {
+struct baseline_entry_t { int trials; double mean_ms, ci_ms; };
+std::map<std::string, baseline_entry_t> baseline;
+bool baseline_is_loaded = false;
+FILE *baseline_out = NULL;
+
+std::string baseline_key(const char *driver, const char *pstr)
+{ return std::string(driver) + ":" + pstr; }
+}
+
+int save_baseline(const char *fname) {
+    baseline_out = fopen(fname, "w");
+    if (baseline_out == NULL) {
+        fprintf(stderr, "cannot open baseline file: %s\n", fname);
+        return FAIL;
+    }
+    fprintf(baseline_out, "driver,problem,trials,mean_ms,ci_ms\n");
+    return OK;
+}
+
+/* `driver,"problem",trials,mean_ms,ci_ms` (quotes in problem doubled) */
+static bool parse_baseline_line(char *line, std::string &key,
+        baseline_entry_t &e) {
+    char *s = strchr(line, ',');
+    if (s == NULL || s[1] != '"') return false;
+    *s = '\0';
+
+    std::string pstr;
+    for (s += 2; *s; ++s) {
+        if (*s == '"' && s[1] == '"') { pstr += '"'; ++s; }
+        else if (*s == '"') break;
+        else pstr += *s;
+    }
+    if (*s != '"' || sscanf(s + 1, ",%d,%lf,%lf", &e.trials, &e.mean_ms,
+                &e.ci_ms) != 3)
+        return false;
+
+    key = baseline_key(line, pstr.c_str());
+    return true;
+}
+
+int load_baseline(const char *fname) {
+    FILE *f = fopen(fname, "r");
+    if (f == NULL) {
+        fprintf(stderr, "cannot open baseline file: %s\n", fname);
+        return FAIL;
+    }
+
+    char line[4096];
+    int lineno = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (lineno++ == 0 || line[0] == '#' || line[0] == '\n') continue;
+
+        std::string key;
+        baseline_entry_t e;
+        if (!parse_baseline_line(line, key, e)) {
+            fprintf(stderr, "%s:%d: bad baseline line\n", fname, lineno);
+            fclose(f);
+            return FAIL;
+        }
+        baseline[key] = e;
     }
+
+    fclose(f);
+    baseline_is_loaded = true;
+    print(1, "baseline: %d problems from %s\n", (int)baseline.size(), fname);
+    return OK;
+}
+
+bool baseline_loaded() { return baseline_is_loaded; }
+
+void perf_baseline_record(const res_t &res, const char *pstr) {
+    if (baseline_out) {
+        fprintf(baseline_out, "%s,\"", driver_name);
+        print_escaped(pstr, true, baseline_out);
+        fprintf(baseline_out, "\",%d,%g,%g\n", res.trials, res.mean_ms,
+                res.ci_ms);
+        fflush(baseline_out);
+    }
+
+    if (!baseline_is_loaded) return;
+
+    auto &bs = benchdnn_stat;
+    auto it = baseline.find(baseline_key(driver_name, pstr));
+    if (it == baseline.end()) {
+        bs.added++;
+        print(1, "%d:NEW (no baseline) __REPRO: %s\n", bs.tests, pstr);
+        return;
+    }
+
+    /* a change counts only if it is larger than the threshold and than the
+     * noise of both measurements */
+    const auto &b = it->second;
+    const double delta = 100. * (res.mean_ms - b.mean_ms) / b.mean_ms;
+    const double gap = fabs(res.mean_ms - b.mean_ms) - res.ci_ms - b.ci_ms;
+    const bool significant = fabs(delta) > compare_threshold && gap > 0;
+
+    const char *state = "SAME";
+    if (significant && delta > 0) { state = "REGRESSED"; bs.regressed++; }
+    if (significant && delta < 0) { state = "IMPROVED"; bs.improved++; }
+
+    const int verbosity = significant ? 0 : 1;
+    print(verbosity, "%d:%s (baseline:%g+-%g ms current:%g+-%g ms "
+            "delta:%+.1f%%) __REPRO: %s\n", bs.tests, state, b.mean_ms, b.ci_ms,
+            res.mean_ms, res.ci_ms, delta, pstr);
 }
 
 /* misc */
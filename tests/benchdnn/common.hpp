@@ -94,7 +94,9 @@ extern int verbose;
     } \
 } while (0)
 
-enum prim_t { SELF, CONV, DECONV, IP, SHUFFLE, REORDER, BNORM, RNN, DEF = CONV, };
+enum prim_t { SELF, CONV, DECONV, IP, SHUFFLE, REORDER, BNORM, RNN, POOL,
+    ELTWISE, SOFTMAX, LRN, CONCAT, SUM, DEF = CONV, };
+const char *prim2str(prim_t prim);
 
 enum bench_mode_t { MODE_UNDEF = 0x0, CORR = 0x1, PERF = 0x2, };
 const char *bench_mode2str(bench_mode_t mode);
@@ -105,6 +107,12 @@ extern bench_mode_t bench_mode;
 extern double max_ms_per_prb; /** maximum time spends per prb in ms */
 extern int min_times_per_prb; /** minimal amount of runs per prb */
 extern int fix_times_per_prb; /** if non-zero run prb that many times */
+extern int instances; /** concurrent instances in the throughput mode */
+extern int threads_per_instance; /** if zero all threads are split evenly */
+extern bool cold_cache; /** if true caches are flushed between the runs */
+extern int trials; /** independent measurements of each prb */
+
+double ms_now();
 
 struct benchdnn_timer_t {
     enum mode_t { min = 0, avg = 1, max = 2, n_modes };
@@ -130,6 +138,9 @@ struct benchdnn_timer_t {
 
     benchdnn_timer_t &operator=(const benchdnn_timer_t &rhs);
 
+    /** adds the measurements of another timer, e.g. of another instance */
+    void merge(const benchdnn_timer_t &rhs);
+
     int times_;
     long long ticks_[n_modes], ticks_start_;
     double ms_[n_modes], ms_start_;
@@ -143,6 +154,9 @@ struct stat_t {
     int skipped;
     int mistrusted;
     int unimplemented;
+    int regressed; /** the three are against the baseline, see --compare */
+    int improved;
+    int added;
     double ms[benchdnn_timer_t::mode_t::n_modes];
 };
 extern stat_t benchdnn_stat;
@@ -156,11 +170,63 @@ struct res_t {
     res_state_t state;
     size_t errors, total;
     benchdnn_timer_t timer;
+    char impl_name[32]; /** implementation used, for the perf report */
+    double bytes; /** bytes of all the inputs and outputs of the primitive */
+    int instances; /** instances that ran concurrently in the perf mode */
+    int threads; /** threads of one instance */
+    int64_t mb; /** images processed by one run */
+    double prb_per_s; /** runs per second summed over all the instances */
+    double p50_ms, p99_ms; /** percentiles of the time of a single run */
+    int trials; /** independent measurements, see --trials */
+    double mean_ms, ci_ms; /** mean of the trials' best times and the
+                             half-width of its 95% confidence interval */
 };
 
 void parse_result(res_t &res, bool &want_perf_report, bool allow_unimpl,
         int status, char *pstr);
 
+/* efficiency */
+enum perf_format_t { PERF_TEMPLATE, PERF_CSV, PERF_JSON, };
+const char *perf_format2str(perf_format_t fmt);
+perf_format_t str2perf_format(const char *str);
+extern perf_format_t perf_format; /** template (default), csv, or json */
+extern const char *driver_name; /** the harness, for the csv/json output */
+
+struct machine_peak_t {
+    const char *isa; /** the widest fma (or mul+add) isa found */
+    double ops_per_s; /** fp32 ops per second over all the threads */
+    double bytes_per_s; /** stream triad bandwidth */
+};
+/** measured on the first call only (takes a fraction of a second) */
+const machine_peak_t &machine_peak();
+
+/** percent of the roofline: the attainable performance is the least of the
+ * compute peak and the bandwidth times the arithmetic intensity; problems
+ * without ops are measured against the bandwidth only */
+double roofline_efficiency(double ops, double bytes, double ms);
+
+/** prints terminals common to all the drivers' perf templates:
+ * %@p (ops per second), %@b (bytes per second), %@e (percent of peak),
+ * %i (implementation), %T (threads per instance), %N (instances), %@I (images per second
+ * over all the instances), and %l / %L (p50 / p99 time of a run in ms).
+ * Returns the number of printed chars or -1 if the terminal is unknown. */
+int perf_print_common(char *buf, int len, char c,
+        benchdnn_timer_t::mode_t mode, double unit, const res_t *r,
+        double ops);
+
+/** prints a csv or json record of the problem (see perf_format) */
+void perf_print_record(const res_t *r, const char *pstr, double ops);
+
+/* baseline: each problem's mean time with its confidence interval.
+ * --save-baseline=file writes it and --compare=file checks every problem
+ * against it: a problem regresses if it is slower by more than
+ * compare_threshold percent and the confidence intervals do not overlap */
+extern double compare_threshold;
+int save_baseline(const char *fname);
+int load_baseline(const char *fname);
+bool baseline_loaded();
+void perf_baseline_record(const res_t &res, const char *pstr);
+
 /* misc */
 void init_fp_mode();
 
@@ -0,0 +1,133 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+
+#include "mkldnn.h"
+
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "mkldnn_debug.hpp"
+
+#include "concat/concat.hpp"
+
+namespace concat {
+
+/* global driver parameters */
+mkldnn_data_type_t sdt = mkldnn_f32;
+mkldnn_data_type_t ddt = mkldnn_f32;
+std::vector<mkldnn_format_tag_t> stag = {mkldnn_format_tag_undef};
+mkldnn_format_tag_t dtag = mkldnn_format_tag_undef;
+int axis = 1;
+const char *pattern = NULL;
+const char *skip_impl = "";
+bool allow_unimpl = false;
+const char *perf_template = "perf,%q,%Q,%f,%F,%D,%a,%-t,%0t";
+
+void reset_parameters() {
+    sdt = mkldnn_f32;
+    ddt = mkldnn_f32;
+    stag = {mkldnn_format_tag_undef};
+    dtag = mkldnn_format_tag_undef;
+    axis = 1;
+    pattern = NULL;
+    skip_impl = "";
+    allow_unimpl = false;
+}
+
+void check_correctness(const std::vector<dims_t> &sdims) {
+    const prb_t p(sdims, sdt, ddt, stag, dtag, axis);
+    char pstr[max_prb_len];
+    prb2str(&p, pstr);
+
+    if (pattern && !match_regex(pstr, pattern))
+        return;
+    print(1, "run: %s\n", pstr);
+
+    res_t res{};
+    const int status = concat::doit(&p, &res);
+
+    bool want_perf_report = false;
+    parse_result(res, want_perf_report, allow_unimpl, status, pstr);
+
+    if (want_perf_report && bench_mode & PERF)
+        perf_report(&p, &res, pstr);
+
+    benchdnn_stat.tests++;
+}
+
+int bench(int argc, char **argv, bool main_bench) {
+    for (int arg = 0; arg < argc; ++arg) {
+        if (!strncmp("--batch=", argv[arg], 8))
+            SAFE(batch(argv[arg] + 8, bench), CRIT);
+        else if (!strncmp("--sdt=", argv[arg], 6))
+            sdt = str2dt(argv[arg] + 6);
+        else if (!strncmp("--ddt=", argv[arg], 6))
+            ddt = str2dt(argv[arg] + 6);
+        else if (!strncmp("--stag=", argv[arg], 7))
+            SAFE(str2tags(stag, argv[arg] + 7), CRIT);
+        else if (!strncmp("--dtag=", argv[arg], 7))
+            dtag = str2tag(argv[arg] + 7);
+        else if (!strncmp("--axis=", argv[arg], 7))
+            axis = atoi(argv[arg] + 7);
+        else if (!strncmp("--match=", argv[arg], 8))
+            pattern = argv[arg] + 8;
+        else if (!strncmp("--skip-impl=", argv[arg], 12))
+            skip_impl = argv[arg] + 12;
+        else if (!strncmp("--allow-unimpl=", argv[arg], 15))
+            allow_unimpl = str2bool(argv[arg] + 15);
+        else if (!strncmp("--perf-template=", argv[arg], 16))
+            perf_template = argv[arg] + 16;
+        else if (!strcmp("--reset", argv[arg]))
+            reset_parameters();
+        else if (!strncmp("--mode=", argv[arg], 7))
+            bench_mode = str2bench_mode(argv[arg] + 7);
+        else if (!strncmp("-v", argv[arg], 2))
+            verbose = atoi(argv[arg] + 2);
+        else if (!strncmp("--verbose=", argv[arg], 10))
+            verbose = atoi(argv[arg] + 10);
+        else {
+            std::vector<dims_t> sdims;
+            if (str2sdims(sdims, argv[arg]) != OK) {
+                fprintf(stderr, "driver: unknown option: `%s`, exiting...\n",
+                        argv[arg]);
+                exit(2);
+            }
+            if (axis < 0 || axis >= (int)sdims[0].size()) {
+                fprintf(stderr, "driver: axis %d is out of `%s`, exiting...\n",
+                        axis, argv[arg]);
+                exit(2);
+            }
+            for (const auto &dims: sdims)
+            for (int d = 0; d < (int)dims.size(); ++d) {
+                if (d != axis && dims[d] != sdims[0][d]) {
+                    fprintf(stderr, "driver: `%s` differ beyond axis %d, "
+                            "exiting...\n", argv[arg], axis);
+                    exit(2);
+                }
+            }
+            check_correctness(sdims);
+        }
+    }
+
+    return OK;
+}
+
+}
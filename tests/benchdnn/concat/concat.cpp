@@ -0,0 +1,176 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+
+#include "mkldnn.h"
+
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "src/common/mkldnn_thread.hpp"
+
+#include "concat/concat.hpp"
+
+namespace concat {
+
+static int init_pd(const prb_t *p, std::vector<mkldnn_memory_desc_t> &src_d,
+        mkldnn_primitive_desc_t &cpd, res_t *r) {
+    const int ndims = p->ndims();
+    mkldnn_dims_t dims;
+
+    for (int i = 0; i < p->n_inputs(); ++i) {
+        for (int d = 0; d < ndims; ++d) dims[d] = p->sdims[i][d];
+        DNN_SAFE(mkldnn_memory_desc_init_by_tag(&src_d[i], ndims, dims,
+                    p->sdt, p->stag_i(i)), WARN);
+    }
+
+    for (int d = 0; d < ndims; ++d) dims[d] = p->ddims[d];
+    mkldnn_memory_desc_t dst_d;
+    DNN_SAFE(mkldnn_memory_desc_init_by_tag(&dst_d, ndims, dims, p->ddt,
+                p->dtag == mkldnn_format_tag_undef
+                ? mkldnn_format_tag_any : p->dtag), WARN);
+
+    mkldnn_status_t init_status = mkldnn_concat_primitive_desc_create(&cpd,
+            &dst_d, p->n_inputs(), p->axis, src_d.data(), NULL, engine);
+
+    if (init_status == mkldnn_unimplemented)
+        return r->state = UNIMPLEMENTED, OK;
+    else
+        SAFE(init_status, WARN);
+
+    const char *impl_str = query_impl_info(cpd);
+    if (maybe_skip(skip_impl, impl_str)) {
+        print(2, "SKIPPED: mkldnn implementation: %s\n", impl_str);
+        DNN_SAFE(mkldnn_primitive_desc_destroy(cpd), WARN);
+        return r->state = SKIPPED, OK;
+    } else {
+        print(5, "mkldnn implementation: %s\n", impl_str);
+    }
+
+    return OK;
+}
+
+/* the values are exactly representable in both data types, so the reference
+ * is a plain copy */
+static int fill_src(const prb_t *p, int input_idx, dnn_mem_t &mem_fp,
+        dnn_mem_t &mem_dt) {
+    const int64_t nelems = mem_fp.nelems();
+
+    const bool is_int = p->sdt != mkldnn_f32 || p->ddt != mkldnn_f32;
+    const bool is_signed = p->sdt != mkldnn_u8 && p->ddt != mkldnn_u8;
+    const int64_t range = is_int ? (is_signed ? 255 : 128) : 1601;
+    const float shift = is_int ? (is_signed ? 127 : 0) : 800;
+    const float scale = is_int ? 1.f : 1.f / 50;
+
+    mkldnn::impl::parallel_nd(nelems, [&](int64_t i) {
+        ((float *)mem_fp)[i] = ((i * 13 + input_idx * 7) % range - shift)
+            * scale;
+    });
+
+    SAFE(mem_dt.reorder(mem_fp), WARN);
+
+    return OK;
+}
+
+static int compare(const prb_t *p, const dnn_mem_t &fp_mem,
+        const dnn_mem_t &dt_mem, res_t *r) {
+    const int64_t nelems = fp_mem.nelems();
+    r->errors = 0;
+    r->total = nelems;
+
+    for (int64_t i = 0; i < nelems; ++i) {
+        const float fp = ((const float *)fp_mem)[i];
+        const float dt = ((const float *)dt_mem)[i];
+        const bool ok = fp == dt;
+
+        r->errors += !ok;
+
+        const bool dump = false
+            || (!ok && (r->errors < 10 || verbose >= 10))
+            || (verbose >= 50 && i < 30);
+        if (dump)
+            print(0, "[%4ld][DST] fp:%8g dt:%8g\n", (long)i, fp, dt);
+    }
+
+    if (r->errors)
+        r->state = FAILED;
+
+    if (r->state == UNTESTED)
+        r->state = PASSED; /* optimism */
+
+    return r->state == FAILED ? FAIL : OK;
+}
+
+int doit(const prb_t *p, res_t *r) {
+    res_t res_zero{};
+    *r = res_zero;
+
+    std::vector<mkldnn_memory_desc_t> src_d(p->n_inputs());
+    mkldnn_primitive_desc_t cpd;
+    mkldnn_primitive_t c{};
+
+    SAFE(init_pd(p, src_d, cpd, r), WARN);
+    if (r->state == SKIPPED || r->state == UNIMPLEMENTED)
+        return OK;
+
+    const auto dst_dt_d = *mkldnn_primitive_desc_query_md(cpd,
+            mkldnn_query_dst_md, 0);
+
+    DNN_SAFE(mkldnn_primitive_create(&c, cpd), WARN);
+    set_perf_info(r, cpd);
+    DNN_SAFE(mkldnn_primitive_desc_destroy(cpd), CRIT);
+
+    const auto fp = mkldnn_f32;
+    const auto tag = get_default_tag(p->ndims());
+
+    args_t args;
+
+    std::vector<dnn_mem_t *> src_fp(p->n_inputs()), src_dt(p->n_inputs());
+    for (int i = 0; i < p->n_inputs(); ++i) {
+        src_fp[i] = new dnn_mem_t(src_d[i], fp, tag);
+        src_dt[i] = new dnn_mem_t(src_d[i]);
+        SAFE(fill_src(p, i, *src_fp[i], *src_dt[i]), WARN);
+        args.set(MKLDNN_ARG_MULTIPLE_SRC + i, src_dt[i]->m_);
+    }
+
+    dnn_mem_t dst_fp(dst_dt_d, fp, tag), dst_dt(dst_dt_d);
+    args.set(MKLDNN_ARG_DST, dst_dt.m_);
+
+    DNN_SAFE(mkldnn_primitive_execute(c, stream, args.size(), args), WARN);
+
+    if (bench_mode & CORR) {
+        compute_ref_fwd(p, src_fp, dst_fp);
+        dnn_mem_t dst(dst_dt, fp, tag);
+        SAFE(compare(p, dst_fp, dst, r), WARN);
+    }
+
+    if (bench_mode & PERF)
+        SAFE(measure_perf(r, c, args), WARN);
+
+    for (int i = 0; i < p->n_inputs(); ++i) {
+        delete src_fp[i];
+        delete src_dt[i];
+    }
+    DNN_SAFE_V(mkldnn_primitive_destroy(c));
+
+    return OK;
+}
+
+}
@@ -0,0 +1,84 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef _CONCAT_HPP
+#define _CONCAT_HPP
+
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+
+#include <vector>
+
+#include "common.hpp"
+#include "dnn_types.hpp"
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "mkldnn_debug.hpp"
+
+namespace concat {
+
+struct prb_t {
+    prb_t(const std::vector<dims_t> &sdims, mkldnn_data_type_t sdt,
+            mkldnn_data_type_t ddt,
+            const std::vector<mkldnn_format_tag_t> &stag,
+            mkldnn_format_tag_t dtag, int axis)
+        : sdims(sdims), sdt(sdt), ddt(ddt), stag(stag), dtag(dtag)
+        , axis(axis)
+    {
+        ddims = sdims[0];
+        ddims[axis] = 0;
+        for (const auto &d: sdims) ddims[axis] += d[axis];
+    }
+    ~prb_t() {}
+
+    std::vector<dims_t> sdims;
+    dims_t ddims;
+    mkldnn_data_type_t sdt, ddt;
+    std::vector<mkldnn_format_tag_t> stag; /* the last one is repeated */
+    mkldnn_format_tag_t dtag; /* format_tag_undef means `any` */
+    int axis;
+
+    int n_inputs() const { return (int)sdims.size(); }
+    int ndims() const { return (int)ddims.size(); }
+
+    /* format_tag_undef means plain */
+    mkldnn_format_tag_t stag_i(int i) const {
+        auto tag = stag[MIN2(i, (int)stag.size() - 1)];
+        return tag == mkldnn_format_tag_undef ? get_default_tag(ndims()) : tag;
+    }
+};
+
+const size_t max_prb_len = 512;
+int str2sdims(std::vector<dims_t> &sdims, const char *str);
+int str2tags(std::vector<mkldnn_format_tag_t> &tags, const char *str);
+void prb2str(const prb_t *p, char *buffer, bool canonical = false);
+
+/* some extra control parameters which shouldn't be placed in prb_t */
+extern const char *skip_impl; /* NULL or "" means do not skip anything */
+
+extern const char *perf_template; /* performance output template */
+void perf_report(const prb_t *p, const res_t *r, const char *pstr);
+
+void compute_ref_fwd(const prb_t *p, const std::vector<dnn_mem_t *> &src,
+        dnn_mem_t &dst);
+
+int doit(const prb_t *p, res_t *res);
+int bench(int argc, char **argv, bool main_bench = true);
+
+}
+
+#endif
@@ -0,0 +1,80 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include "concat/concat.hpp"
+
+namespace concat {
+
+int str2sdims(std::vector<dims_t> &sdims, const char *str) {
+    /* canonical form: dxdxd:dxdxd:... */
+    sdims.clear();
+    const char *s = str;
+    while (true) {
+        dims_t dims;
+        if (str2dims(dims, s, &s) != OK) return FAIL;
+        sdims.push_back(dims);
+        if (*s == '\0') break;
+        if (*s++ != ':') return FAIL;
+    }
+
+    for (const auto &dims: sdims)
+        if (dims.size() != sdims[0].size()) return FAIL;
+
+    return OK;
+}
+
+int str2tags(std::vector<mkldnn_format_tag_t> &tags, const char *str) {
+    tags.clear();
+    read_csv(str, [](){}, [&](const char *s) {
+        tags.push_back(str2tag(s));
+    }, ":");
+    return tags.empty() ? FAIL : OK;
+}
+
+void prb2str(const prb_t *p, char *buffer, bool canonical) {
+    int rem_len = max_prb_len;
+#   define DPRINT(...) do { \
+        int l = snprintf(buffer, rem_len, __VA_ARGS__); \
+        buffer += l; rem_len -= l; \
+    } while(0)
+
+    if (canonical || p->sdt != mkldnn_f32) DPRINT("--sdt=%s ", dt2str(p->sdt));
+    if (canonical || p->ddt != mkldnn_f32) DPRINT("--ddt=%s ", dt2str(p->ddt));
+
+    const bool stag_is_def = p->stag.size() == 1
+        && p->stag[0] == mkldnn_format_tag_undef;
+    if (canonical || !stag_is_def) {
+        DPRINT("--stag=");
+        for (size_t i = 0; i < p->stag.size(); ++i)
+            DPRINT("%s%s", i ? ":" : "", tag2str(p->stag[i]));
+        DPRINT(" ");
+    }
+    if (canonical || p->dtag != mkldnn_format_tag_undef)
+        DPRINT("--dtag=%s ", tag2str(p->dtag));
+    if (canonical || p->axis != 1) DPRINT("--axis=%d ", p->axis);
+
+    for (int i = 0; i < p->n_inputs(); ++i) {
+        char dims_buf[max_dims_len] = {0};
+        dims2str(p->sdims[i], dims_buf);
+        DPRINT("%s%s", i ? ":" : "", dims_buf);
+    }
+
+#   undef DPRINT
+}
+
+}
@@ -0,0 +1,47 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "src/common/mkldnn_thread.hpp"
+
+#include "concat/concat.hpp"
+
+namespace concat {
+
+void compute_ref_fwd(const prb_t *p, const std::vector<dnn_mem_t *> &src,
+        dnn_mem_t &dst) {
+    int64_t outer = 1, inner = 1;
+    for (int d = 0; d < p->axis; ++d) outer *= p->ddims[d];
+    for (int d = p->axis + 1; d < p->ndims(); ++d) inner *= p->ddims[d];
+
+    const int64_t dst_axis = p->ddims[p->axis];
+    int64_t axis_off = 0;
+
+    for (int i = 0; i < p->n_inputs(); ++i) {
+        const int64_t src_axis = p->sdims[i][p->axis];
+        const float *s = (const float *)*src[i];
+        float *d = (float *)dst;
+
+        mkldnn::impl::parallel_nd(outer, src_axis * inner,
+                [&](int64_t ou, int64_t ai) {
+            d[(ou * dst_axis + axis_off) * inner + ai]
+                = s[ou * src_axis * inner + ai];
+        });
+
+        axis_off += src_axis;
+    }
+}
+
+}
@@ -320,8 +320,9 @@ int fill_wei(const prb_t *p, dnn_mem_t &mem_dt, dnn_mem_t &mem_fp,
     res_t *r) {
     const bool wino_s8 = p->alg == WINO && p->cfg[WEI].dt == mkldnn_s8;
     const bool s8_s8 = p->cfg[WEI].dt == mkldnn_s8 && p->cfg[SRC].dt == mkldnn_s8;
+    const bool zp_src = p->attr.zero_points.src != 0;
     const bool diff_data_type = mem_dt.dt() != mem_fp.dt();
-    const bool check_reorder = diff_data_type && !wino_s8 && !s8_s8;
+    const bool check_reorder = diff_data_type && !wino_s8 && !s8_s8 && !zp_src;
 
     dnn_mem_t *p_mem_00 = check_reorder
         ? new dnn_mem_t(mem_dt.md_, mkldnn_f32,
@@ -584,6 +585,7 @@ int doit(const prb_t *p, res_t *r) {
     }
 
     DNN_SAFE(mkldnn_primitive_create(&c, cpd), WARN);
+    set_perf_info(r, cpd);
     DNN_SAFE(mkldnn_primitive_desc_destroy(cpd), CRIT);
 
     auto &src_dt_d = p->dir == BWD_D ? cd.diff_src_desc : cd.src_desc;
@@ -668,20 +670,8 @@ int doit(const prb_t *p, res_t *r) {
         SAFE(FAIL, CRIT);
     }
 
-    if (bench_mode & PERF) {
-        auto &t = r->timer;
-        t.reset();
-        while (true) {
-            DNN_SAFE(mkldnn_primitive_execute(c, stream, args.size(), args), WARN);
-            t.stamp();
-            const bool stop = false
-                || (fix_times_per_prb && t.times() >= fix_times_per_prb)
-                || (!fix_times_per_prb
-                        && t.total_ms() >= max_ms_per_prb
-                        && t.times() >= min_times_per_prb);
-            if (stop) break;
-        }
-    }
+    if (bench_mode & PERF)
+        SAFE(measure_perf(r, c, args), WARN);
 
     DNN_SAFE(mkldnn_primitive_destroy(c), CRIT);
 
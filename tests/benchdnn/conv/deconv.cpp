@@ -208,6 +208,7 @@ int doit(const prb_t *p, res_t *r) {
         return OK;
 
     DNN_SAFE(mkldnn_primitive_create(&c, dpd), WARN);
+    set_perf_info(r, dpd);
     DNN_SAFE_V(mkldnn_primitive_desc_destroy(dpd));
 
     auto &src_dt_d = p->dir == BWD_D ? cd.diff_src_desc : cd.src_desc;
@@ -303,20 +304,8 @@ int doit(const prb_t *p, res_t *r) {
         SAFE(FAIL, CRIT);
     }
 
-    if (bench_mode & PERF) {
-        auto &t = r->timer;
-        t.reset();
-        while (true) {
-            DNN_SAFE(mkldnn_primitive_execute(c, stream, args.size(), args), WARN);
-            t.stamp();
-            const bool stop = false
-                || (fix_times_per_prb && t.times() >= fix_times_per_prb)
-                || (!fix_times_per_prb
-                        && t.total_ms() >= max_ms_per_prb
-                        && t.times() >= min_times_per_prb);
-            if (stop) break;
-        }
-    }
+    if (bench_mode & PERF)
+        SAFE(measure_perf(r, c, args), WARN);
 
     DNN_SAFE_V(mkldnn_primitive_destroy(c));
 
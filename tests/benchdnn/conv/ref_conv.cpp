@@ -50,6 +50,9 @@ void compute_ref_bwd_w(const prb_t *p, dnn_mem_t &src_m, dnn_mem_t &diff_wei_m,
 
 void compute_ref_direct_fwd(const prb_t *p, dnn_mem_t &src_m,
         dnn_mem_t &wei_m, dnn_mem_t &bia_m, dnn_mem_t &dst_m) {
+    const float src_zp = p->attr.zero_points.src;
+    const float dst_zp = p->attr.zero_points.dst;
+
     auto ker = [&](float &d, int64_t g, int64_t mb,
             int64_t oc, int64_t od, int64_t oh, int64_t ow) {
         /* help compiler optimize the code */
@@ -74,7 +77,8 @@ void compute_ref_direct_fwd(const prb_t *p, dnn_mem_t &src_m,
                                     * ID + id) * IH + ih) * IW + iw;
                         int64_t wei_off = ((((g * OCG + oc) * ICG + ic)
                                     * KD + kd) * KH + kh) * KW + kw;
-                        d += ((float*)src_m)[src_off] * ((float*)wei_m)[wei_off];
+                        d += (((float*)src_m)[src_off] - src_zp)
+                            * ((float*)wei_m)[wei_off];
                     }
                 }
             }
@@ -137,9 +141,9 @@ void compute_ref_direct_fwd(const prb_t *p, dnn_mem_t &src_m,
             }
 
             maybe_scale(conv_res, g * p->oc / p->g + oc);
-            maybe_post_ops(conv_res, dst);
+            maybe_post_ops(conv_res, dst - dst_zp);
 
-            dst = conv_res;
+            dst = conv_res + dst_zp;
         }
     );
 }
@@ -55,6 +55,30 @@ const char *dir2str(dir_t dir) {
     return "DIR_UNDEF";
 }
 
+int str2dims(dims_t &dims, const char *str, const char **end_s) {
+    dims.clear();
+    while (true) {
+        int len;
+        int64_t dim;
+        int scan = sscanf(str, IFMT "%n", &dim, &len);
+        if (scan != 1 || dim <= 0) return FAIL;
+        dims.push_back(dim);
+        str += len;
+        if (*str != 'x') break;
+        ++str;
+    }
+    if (end_s) *end_s = str;
+    return OK;
+}
+
+void dims2str(const dims_t &dims, char *buffer) {
+    int rem_len = max_dims_len;
+    for (size_t d = 0; d < dims.size(); ++d) {
+        int l = snprintf(buffer, rem_len, d == 0 ? IFMT : "x" IFMT, dims[d]);
+        buffer += l; rem_len -= l;
+    }
+}
+
 const char *data_kind2str(data_kind_t kind) {
     switch (kind) {
     case SRC: return "SRC";
@@ -289,10 +313,48 @@ void attr_t::post_ops_t::to_str(char *buffer, char **end_b) const {
     if (end_b) *end_b = buffer;
 }
 
+int attr_t::zero_points_t::from_str(const char *str, const char **end_s) {
+    *this = zero_points_t();
+
+    if (str == NULL) return FAIL;
+
+    const char *s_;
+    const char * &s = end_s ? *end_s : s_;
+    s = str;
+
+    // src:<value>[_dst:<value>]
+    for (;;) {
+        int *zp = NULL;
+        if (!strncasecmp("src:", s, 4)) zp = &this->src;
+        else if (!strncasecmp("dst:", s, 4)) zp = &this->dst;
+        else return FAIL;
+        s += 4;
+
+        char *end;
+        *zp = (int)strtol(s, &end, 10);
+        if (end == s) return FAIL;
+        s = end;
+
+        if (*s != '_') break;
+        ++s;
+    }
+
+    assert(*s == '\0' || *s == ';');
+
+    return OK;
+}
+
+void attr_t::zero_points_t::to_str(char *buffer, char **end_b) const {
+    assert(buffer);
+    buffer += sprintf(buffer, "src:%d_dst:%d", this->src, this->dst);
+    if (end_b) *end_b = buffer;
+}
+
 bool attr_t::is_def() const {
     return true
         && oscale.is_def()
-        && post_ops.is_def();
+        && post_ops.is_def()
+        && zero_points.is_def();
 }
 
 int str2attr(attr_t *attr, const char *str) {
@@ -319,6 +381,13 @@ int str2attr(attr_t *attr, const char *str) {
             if (rc != OK) return rc;
         }
 
+        param = "zero_points=";
+        if (!strncasecmp(param, s, strlen(param))) {
+            s += strlen(param);
+            rc = attr->zero_points.from_str(s, &s);
+            if (rc != OK) return rc;
+        }
+
         if (rc != OK) return FAIL;
         if (*s == ';') ++s;
     }
@@ -331,6 +400,10 @@ void attr2str(const attr_t *attr, char *buffer) {
     attr->oscale.scale2str(buffer, &buffer);
     buffer += sprintf(buffer, ";post_ops=");
     attr->post_ops.to_str(buffer, &buffer);
+    if (!attr->zero_points.is_def()) {
+        buffer += sprintf(buffer, ";zero_points=");
+        attr->zero_points.to_str(buffer, &buffer);
+    }
 }
 
 mkldnn_primitive_attr_t create_mkldnn_attr(const attr_t &attr,
@@ -395,6 +468,15 @@ mkldnn_primitive_attr_t create_mkldnn_attr(const attr_t &attr,
         DNN_SAFE_V(mkldnn_post_ops_destroy(ops));
     }
 
+    if (!attr.zero_points.is_def()) {
+        const int32_t src_zp = attr.zero_points.src;
+        const int32_t dst_zp = attr.zero_points.dst;
+        DNN_SAFE_V(mkldnn_primitive_attr_set_zero_points(mkldnn_attr,
+                    MKLDNN_ARG_SRC, 1, 0, &src_zp));
+        DNN_SAFE_V(mkldnn_primitive_attr_set_zero_points(mkldnn_attr,
+                    MKLDNN_ARG_DST, 1, 0, &dst_zp));
+    }
+
     return mkldnn_attr;
 }
 
@@ -21,6 +21,8 @@
 #include <stddef.h>
 #include <string.h>
 
+#include <vector>
+
 #include "common.hpp"
 #include "mkldnn_types.h"
 
@@ -40,6 +42,12 @@ enum dir_t {
 dir_t str2dir(const char *str);
 const char *dir2str(dir_t dir);
 
+/* plain tensor dimensions in the `dxdxdxd` form */
+using dims_t = std::vector<int64_t>;
+const size_t max_dims_len = 64;
+int str2dims(dims_t &dims, const char *str, const char **end_s = NULL);
+void dims2str(const dims_t &dims, char *buffer);
+
 typedef int data_kind_t;
 enum {
     SRC = 0, WEI, BIA, DST, ACC,
@@ -100,8 +108,19 @@ struct attr_t {
         entry_t entry[4];
     };
 
+    struct zero_points_t {
+        int from_str(const char *str, const char **end_s);
+        void to_str(char *buffer, char **end_b) const;
+
+        bool is_def() const { return src == 0 && dst == 0; }
+
+        int src = 0;
+        int dst = 0;
+    };
+
     scale_t oscale;
     post_ops_t post_ops;
+    zero_points_t zero_points;
 
     bool is_def() const;
 };
@@ -0,0 +1,78 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef _ELTWISE_HPP
+#define _ELTWISE_HPP
+
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "common.hpp"
+#include "dnn_types.hpp"
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "mkldnn_debug.hpp"
+
+namespace eltwise {
+
+/* the algorithms share names with the eltwise post-ops: relu, tanh, ... */
+using alg_t = attr_t::post_ops_t::kind_t;
+alg_t str2alg(const char *str);
+inline const char *alg2str(alg_t alg)
+{ return attr_t::post_ops_t::kind2str(alg); }
+inline mkldnn_alg_kind_t alg2alg_kind(alg_t alg)
+{ return attr_t::post_ops_t::kind2mkldnn_kind(alg); }
+
+struct prb_t {
+    prb_t(const dims_t &dims, dir_t dir, mkldnn_data_type_t dt,
+            mkldnn_format_tag_t tag, alg_t alg, float alpha, float beta)
+        : dims(dims), dir(dir), dt(dt), tag(tag), alg(alg), alpha(alpha)
+        , beta(beta) {}
+    ~prb_t() {}
+
+    dims_t dims;
+    dir_t dir;
+    mkldnn_data_type_t dt;
+    mkldnn_format_tag_t tag; /* format_tag_undef means plain */
+    alg_t alg;
+    float alpha, beta;
+
+    int64_t nelems() const {
+        int64_t n = 1;
+        for (auto d: dims) n *= d;
+        return n;
+    }
+};
+
+const size_t max_prb_len = max_dims_len + 196;
+void prb2str(const prb_t *p, char *buffer, bool canonical = false);
+
+/* some extra control parameters which shouldn't be placed in prb_t */
+extern const char *skip_impl; /* NULL or "" means do not skip anything */
+
+extern const char *perf_template; /* performance output template */
+void perf_report(const prb_t *p, const res_t *r, const char *pstr);
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst);
+
+int fill_src(const prb_t *p, dnn_mem_t &mem_fp, dnn_mem_t &mem_dt);
+int doit(const prb_t *p, res_t *res);
+int bench(int argc, char **argv, bool main_bench = true);
+
+}
+
+#endif
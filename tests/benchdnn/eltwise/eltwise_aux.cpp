@@ -0,0 +1,56 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include "eltwise/eltwise.hpp"
+
+namespace eltwise {
+
+alg_t str2alg(const char *str) {
+    const alg_t alg = attr_t::post_ops_t::str2kind(str);
+    assert(alg != alg_t::SUM && "sum is not an eltwise algorithm");
+    return alg;
+}
+
+void prb2str(const prb_t *p, char *buffer, bool canonical) {
+    char dims_buf[max_dims_len] = {0};
+    dims2str(p->dims, dims_buf);
+
+    char dir_str[32] = {0};
+    char dt_str[16] = {0};
+    char tag_str[32] = {0};
+    char alg_str[32] = {0};
+    char alpha_str[32] = {0};
+    char beta_str[32] = {0};
+
+    snprintf(dir_str, sizeof(dir_str), "--dir=%s ", dir2str(p->dir));
+    snprintf(dt_str, sizeof(dt_str), "--dt=%s ", dt2str(p->dt));
+    snprintf(tag_str, sizeof(tag_str), "--tag=%s ", tag2str(p->tag));
+    snprintf(alg_str, sizeof(alg_str), "--alg=%s ", alg2str(p->alg));
+    snprintf(alpha_str, sizeof(alpha_str), "--alpha=%g ", p->alpha);
+    snprintf(beta_str, sizeof(beta_str), "--beta=%g ", p->beta);
+    snprintf(buffer, max_prb_len, "%s%s%s%s%s%s%s",
+            canonical || p->dir != FWD_D ? dir_str : "",
+            canonical || p->dt != mkldnn_f32 ? dt_str : "",
+            canonical || p->tag != mkldnn_format_tag_undef ? tag_str : "",
+            alg_str,
+            canonical || p->alpha != 0.f ? alpha_str : "",
+            canonical || p->beta != 0.f ? beta_str : "",
+            dims_buf);
+}
+
+}
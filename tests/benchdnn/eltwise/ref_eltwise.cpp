@@ -0,0 +1,56 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "src/common/mkldnn_thread.hpp"
+#include "src/common/math_utils.hpp"
+
+#include "eltwise/eltwise.hpp"
+
+namespace eltwise {
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst) {
+    using namespace mkldnn::impl::math;
+
+    const float a = p->alpha, b = p->beta;
+    const bool is_int = p->dt != mkldnn_f32;
+    const float lo = p->dt == mkldnn_u8 ? 0 : p->dt == mkldnn_s8 ? INT8_MIN
+        : -FLT_MAX;
+    const float hi = p->dt == mkldnn_u8 ? UINT8_MAX
+        : p->dt == mkldnn_s8 ? INT8_MAX : FLT_MAX;
+
+    mkldnn::impl::parallel_nd(p->nelems(), [&](int64_t i) {
+        const float s = ((const float *)src)[i];
+        float d = 0;
+        switch (p->alg) {
+        case alg_t::RELU: d = relu_fwd(s, a); break;
+        case alg_t::TANH: d = tanh_fwd(s); break;
+        case alg_t::ELU: d = elu_fwd(s, a); break;
+        case alg_t::SQUARE: d = square_fwd(s); break;
+        case alg_t::ABS: d = abs_fwd(s); break;
+        case alg_t::SQRT: d = sqrt_fwd(s); break;
+        case alg_t::LINEAR: d = linear_fwd(s, a, b); break;
+        case alg_t::BRELU: d = bounded_relu_fwd(s, a); break;
+        case alg_t::SRELU: d = soft_relu_fwd(s); break;
+        case alg_t::LOGISTIC: d = logistic_fwd(s); break;
+        default: assert(!"unknown eltwise algorithm");
+        }
+        /* the integer implementations convert the result with truncation */
+        if (is_int) d = MAX2(lo, MIN2(hi, truncf(d)));
+        ((float *)dst)[i] = d;
+    });
+}
+
+}
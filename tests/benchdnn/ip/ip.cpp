@@ -122,6 +122,30 @@ inline int init_pd(const prb_t *p, mkldnn_inner_product_desc_t &ipd,
     return OK;
 }
 
+inline bool post_ops_require_integral_check(const prb_t *p) {
+    if (p->attr.post_ops.len == 0) return false;
+
+    using pk = attr_t::post_ops_t::kind_t;
+    const auto &ops = p->attr.post_ops;
+
+    for (int idx = 0; idx < ops.len; ++idx) {
+        const auto &e = ops.entry[idx];
+        if (e.kind == pk::SUM || e.kind == pk::ABS) continue;
+        if (e.kind == pk::RELU && e.eltwise.alpha == 0.f) continue;
+        return true;
+    }
+
+    return false;
+}
+
+inline double get_eps(const prb_t *p, const data_kind_t kind) {
+    // post-ops specifics
+    if (post_ops_require_integral_check(p))
+        return MAX2(1e-5, p->cfg[kind].eps);
+
+    return p->cfg[kind].eps;
+}
+
 inline int compare_dat(const prb_t *p, data_kind_t kind, dnn_mem_t &mem_dt,
         dnn_mem_t &mem_fp, res_t *r) {
     size_t nelems = mem_dt.nelems();
@@ -148,7 +172,7 @@ inline int compare_dat(const prb_t *p, data_kind_t kind, dnn_mem_t &mem_dt,
         else if (fp > p->cfg[kind].max)
             ok = dt == p->cfg[kind].max;
         else
-            ok = (fabs(fp) > 1e-5 ? rel_diff : diff) <= p->cfg[kind].eps;
+            ok = (fabs(fp) > 1e-5 ? rel_diff : diff) <= get_eps(p, kind);
 
         if (!ok) {
             r->errors++;
@@ -279,6 +303,7 @@ int doit(const prb_t *p, res_t *r) {
         return OK;
 
     DNN_SAFE(mkldnn_primitive_create(&ip, ippd), WARN);
+    set_perf_info(r, ippd);
     DNN_SAFE(mkldnn_primitive_desc_destroy(ippd), CRIT);
 
     auto &src_dt_d = p->dir == BWD_D ? ipd.diff_src_desc : ipd.src_desc;
@@ -355,20 +380,8 @@ int doit(const prb_t *p, res_t *r) {
         }
     }
 
-    if (bench_mode & PERF) {
-        auto &t = r->timer;
-        t.reset();
-        while (true) {
-            DNN_SAFE(mkldnn_primitive_execute(ip, stream, args.size(), args), WARN);
-            t.stamp();
-            const bool stop = false
-                || (fix_times_per_prb && t.times() >= fix_times_per_prb)
-                || (!fix_times_per_prb
-                        && t.total_ms() >= max_ms_per_prb
-                        && t.times() >= min_times_per_prb);
-            if (stop) break;
-        }
-    }
+    if (bench_mode & PERF)
+        SAFE(measure_perf(r, ip, args), WARN);
 
     DNN_SAFE(mkldnn_primitive_destroy(ip), CRIT);
 
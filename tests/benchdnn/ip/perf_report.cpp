@@ -84,6 +84,11 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
 
     double ops = 2. * p->oc * p->mb * p->ic * p->ih * p->iw * p->id;
 
+    if (perf_format != PERF_TEMPLATE) {
+        perf_print_record(r, pstr, ops);
+        return;
+    }
+
     const char *pt = perf_template;
     char c;
 
@@ -122,8 +127,12 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
             DPRINT("%g", ops / unit);
         else if (c == 'p')
             DPRINT("%g", ops / t.ms(mode) / unit * 1e3);
-        else
-            []() { SAFE(FAIL, CRIT); return 0; }();
+        else {
+            const int l = perf_print_common(buf, rem_len, c, mode, unit, r,
+                    ops);
+            if (l < 0) []() { SAFE(FAIL, CRIT); return 0; }();
+            buf += l; rem_len -= l;
+        }
     }
 
     *buf = '\0';
@@ -14,7 +14,10 @@
 * limitations under the License.
 *******************************************************************************/
 
+#include <vector>
+
 #include "src/common/mkldnn_thread.hpp"
+#include "src/common/math_utils.hpp"
 
 #include "ip/ip.hpp"
 
@@ -27,6 +30,15 @@ void compute_ref_fwd(const prb_t *p, dnn_mem_t &src_m,
     int64_t N = p->oc;
     int64_t K = p->ic * p->id * p->ih * p->iw;
 
+    const auto &ops = p->attr.post_ops;
+    bool with_sum = false;
+    for (int idx = 0; idx < ops.len; ++idx)
+        with_sum = with_sum || ops.entry[idx].kind == attr_t::post_ops_t::SUM;
+
+    std::vector<float> dst_prev;
+    if (with_sum)
+        dst_prev.assign((float *)dst_m, (float *)dst_m + M * N);
+
     gemm("C", "N", "T", M, N, K, 1.f, (float *)src_m, K, (float *)wei_m, K,
         0.f, (float *)dst_m, N);
 
@@ -42,30 +54,55 @@ void compute_ref_fwd(const prb_t *p, dnn_mem_t &src_m,
         }
     };
 
-    auto maybe_post_ops = [&](float &res) {
-        const auto &ops = p->attr.post_ops;
+    auto maybe_post_ops = [&](float &res, float dst) {
+        using namespace mkldnn::impl::math;
+
         for (int idx = 0; idx < ops.len; ++idx) {
             using pk = attr_t::post_ops_t::kind_t;
             const auto &e = ops.entry[idx];
+
+            const auto &s = e.eltwise.scale;
+            const auto &a = e.eltwise.alpha;
+            const auto &b = e.eltwise.beta;
+
             switch (e.kind) {
-            case pk::RELU:
-                res = e.eltwise.scale * (res < 0 ? 0 : res);
-                break;
+            case pk::SUM: res += e.sum.scale * dst; break;
+            case pk::RELU: res = s*relu_fwd(res, a); break;
+            case pk::TANH: res = s*tanh_fwd(res); break;
+            case pk::ELU: res = s*elu_fwd(res, a); break;
+            case pk::SQUARE: res = s*square_fwd(res); break;
+            case pk::ABS: res = s*abs_fwd(res); break;
+            case pk::SQRT: res = s*sqrt_fwd(res); break;
+            case pk::LINEAR: res = s*linear_fwd(res, a, b); break;
+            case pk::BRELU: res = s*bounded_relu_fwd(res, a); break;
+            case pk::SRELU: res = s*soft_relu_fwd(res); break;
+            case pk::LOGISTIC: res = s*logistic_fwd(res); break;
             default:
                 assert(!"unknown attr::post_ops::kind");
             }
         }
     };
 
+    const float src_zp = p->attr.zero_points.src;
+    const float dst_zp = p->attr.zero_points.dst;
+
     mkldnn::impl::parallel_nd(p->mb, p->oc, [&](int64_t mb, int64_t oc) {
         size_t dst_off = dst_off_f(p, mb, oc);
         float &d = ((float *)dst_m)[dst_off];
+        if (src_zp != 0) {
+            /* sum{(src - zp) * wei} = sum{src * wei} - zp * sum{wei} */
+            float wei_sum = 0;
+            for (int64_t k = 0; k < K; ++k)
+                wei_sum += ((float *)wei_m)[oc * K + k];
+            d -= src_zp * wei_sum;
+        }
         if (p->dir & FLAG_BIA) {
             size_t bia_off = bia_off_f(p, oc);
             d += ((float *)bia_m)[bia_off];
         }
         maybe_scale(d, oc);
-        maybe_post_ops(d);
+        maybe_post_ops(d, with_sum ? dst_prev[dst_off] - dst_zp : 0.f);
+        d += dst_zp;
     });
 }
 
@@ -0,0 +1,171 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+
+#include "mkldnn.h"
+
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "src/common/mkldnn_thread.hpp"
+
+#include "lrn/lrn.hpp"
+
+namespace lrn {
+
+static int init_pd(const prb_t *p, mkldnn_lrn_desc_t &ld,
+        mkldnn_primitive_desc_t &lpd, res_t *r) {
+    mkldnn_dims_t data_dims = {p->mb, p->ic, p->ih, p->iw};
+
+    mkldnn_memory_desc_t data_d;
+    DNN_SAFE(mkldnn_memory_desc_init_by_tag(&data_d, 4, data_dims, p->dt,
+                p->tag), WARN);
+
+    auto prop = p->dir & FLAG_INF
+        ? mkldnn_forward_inference : mkldnn_forward_training;
+    DNN_SAFE(mkldnn_lrn_forward_desc_init(&ld, prop, alg2alg_kind(p->alg),
+                &data_d, p->ls, p->alpha, p->beta, p->k), WARN);
+
+    mkldnn_status_t init_status = mkldnn_primitive_desc_create(&lpd, &ld,
+            NULL, engine, NULL);
+
+    if (init_status == mkldnn_unimplemented)
+        return r->state = UNIMPLEMENTED, OK;
+    else
+        SAFE(init_status, WARN);
+
+    const char *impl_str = query_impl_info(lpd);
+    if (maybe_skip(skip_impl, impl_str)) {
+        print(2, "SKIPPED: mkldnn implementation: %s\n", impl_str);
+        DNN_SAFE(mkldnn_primitive_desc_destroy(lpd), WARN);
+        return r->state = SKIPPED, OK;
+    } else {
+        print(5, "mkldnn implementation: %s\n", impl_str);
+    }
+
+    return OK;
+}
+
+int fill_src(const prb_t *p, dnn_mem_t &mem_fp, dnn_mem_t &mem_dt) {
+    const int64_t nelems = mem_fp.nelems();
+
+    /* a grid over [-16, 16]; the alpha of the topologies is too small for
+     * the normalization to matter with small inputs */
+    mkldnn::impl::parallel_nd(nelems, [&](int64_t i) {
+        ((float *)mem_fp)[i] = ((i * 13) % 1601 - 800) / 50.f;
+    });
+
+    SAFE(mem_dt.reorder(mem_fp), WARN);
+
+    return OK;
+}
+
+static int compare(const prb_t *p, const dnn_mem_t &fp_mem,
+        const dnn_mem_t &dt_mem, res_t *r) {
+    const int64_t nelems = fp_mem.nelems();
+    r->errors = 0;
+    r->total = nelems;
+
+    /* the jit kernels use approximate powf() and rsqrt */
+    const float eps = 1e-6;
+
+    for (int64_t i = 0; i < nelems; ++i) {
+        const float fp = ((const float *)fp_mem)[i];
+        const float dt = ((const float *)dt_mem)[i];
+        const float diff = fabsf(fp - dt);
+        const float rel_diff = diff / (fabsf(fp) > FLT_MIN ? fabsf(fp) : 1);
+        const bool ok = (fabsf(fp) > 1e-5 ? rel_diff : diff) <= eps;
+
+        r->errors += !ok;
+
+        const bool dump = false
+            || (!ok && (r->errors < 10 || verbose >= 10))
+            || (verbose >= 50 && i < 30);
+        if (dump)
+            print(0, "[%4ld][DST] fp:%8g dt:%8g diff:%8g rdiff:%8g\n",
+                    (long)i, fp, dt, diff, rel_diff);
+    }
+
+    if (r->errors)
+        r->state = FAILED;
+
+    if (r->state == UNTESTED)
+        r->state = PASSED; /* optimism */
+
+    return r->state == FAILED ? FAIL : OK;
+}
+
+int doit(const prb_t *p, res_t *r) {
+    res_t res_zero{};
+    *r = res_zero;
+
+    mkldnn_lrn_desc_t ld;
+    mkldnn_primitive_desc_t lpd;
+    mkldnn_primitive_t l{};
+
+    SAFE(init_pd(p, ld, lpd, r), WARN);
+    if (r->state == SKIPPED || r->state == UNIMPLEMENTED)
+        return OK;
+
+    /* forward training keeps the normalization for the backward pass */
+    const auto ws_md = mkldnn_primitive_desc_query_md(lpd,
+            mkldnn_query_workspace_md, 0);
+    const bool with_ws = ws_md && ws_md->ndims != 0;
+    dnn_mem_t *p_ws_dt = with_ws ? new dnn_mem_t(*ws_md) : new dnn_mem_t();
+    dnn_mem_t &ws_dt = *p_ws_dt;
+
+    DNN_SAFE(mkldnn_primitive_create(&l, lpd), WARN);
+    set_perf_info(r, lpd);
+    DNN_SAFE(mkldnn_primitive_desc_destroy(lpd), CRIT);
+
+    const auto fp = mkldnn_f32;
+    const auto &data_dt_d = ld.data_desc;
+    const auto tag = mkldnn_nchw;
+
+    dnn_mem_t src_fp(data_dt_d, fp, tag), src_dt(data_dt_d);
+    dnn_mem_t dst_fp(data_dt_d, fp, tag), dst_dt(data_dt_d);
+
+    SAFE(fill_src(p, src_fp, src_dt), WARN);
+
+    args_t args;
+    args.set(MKLDNN_ARG_SRC, src_dt.m_);
+    args.set(MKLDNN_ARG_DST, dst_dt.m_);
+
+    if (with_ws)
+        args.set(MKLDNN_ARG_WORKSPACE, ws_dt.m_);
+
+    DNN_SAFE(mkldnn_primitive_execute(l, stream, args.size(), args), WARN);
+
+    if (bench_mode & CORR) {
+        compute_ref_fwd(p, src_fp, dst_fp);
+        dnn_mem_t dst(dst_dt, fp, tag);
+        SAFE(compare(p, dst_fp, dst, r), WARN);
+    }
+
+    if (bench_mode & PERF)
+        SAFE(measure_perf(r, l, args), WARN);
+
+    delete p_ws_dt;
+    DNN_SAFE_V(mkldnn_primitive_destroy(l));
+
+    return OK;
+}
+
+}
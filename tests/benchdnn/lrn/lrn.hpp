@@ -0,0 +1,81 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef _LRN_HPP
+#define _LRN_HPP
+
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "common.hpp"
+#include "dnn_types.hpp"
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "mkldnn_debug.hpp"
+
+namespace lrn {
+
+enum alg_t { ACROSS, WITHIN };
+alg_t str2alg(const char *str);
+const char *alg2str(alg_t alg);
+mkldnn_alg_kind_t alg2alg_kind(alg_t alg);
+
+struct desc_t {
+    int64_t mb, ic, ih, iw;
+    int64_t ls;
+    float alpha, beta, k;
+    const char *name;
+};
+const size_t max_desc_len = 196;
+int str2desc(desc_t *desc, const char *str);
+void desc2str(const desc_t *d, char *buffer, bool canonical = false);
+
+struct prb_t: public desc_t {
+    prb_t(const desc_t &desc, int64_t mb, dir_t dir, mkldnn_data_type_t dt,
+            mkldnn_format_tag_t tag, alg_t alg)
+        : desc_t(desc), dir(dir), dt(dt), tag(tag), alg(alg)
+    { if (mb) this->mb = mb; }
+    ~prb_t() {}
+
+    dir_t dir;
+    mkldnn_data_type_t dt;
+    mkldnn_format_tag_t tag;
+    alg_t alg;
+};
+const size_t max_prb_len = max_desc_len + 196;
+void prb2str(const prb_t *p, char *buffer, bool canonical = false);
+
+/* some extra control parameters which shouldn't be placed in prb_t */
+extern const char *skip_impl; /* NULL or "" means do not skip anything */
+
+extern const char *perf_template; /* performance output template */
+void perf_report(const prb_t *p, const res_t *r, const char *pstr);
+
+inline size_t data_off(const prb_t *p,
+        int64_t mb, int64_t c, int64_t h, int64_t w) {
+    return ((mb * p->ic + c) * p->ih + h) * p->iw + w;
+}
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst);
+
+int fill_src(const prb_t *p, dnn_mem_t &mem_fp, dnn_mem_t &mem_dt);
+int doit(const prb_t *p, res_t *res);
+int bench(int argc, char **argv, bool main_bench = true);
+
+}
+
+#endif
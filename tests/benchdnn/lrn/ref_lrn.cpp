@@ -0,0 +1,55 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "src/common/mkldnn_thread.hpp"
+
+#include "lrn/lrn.hpp"
+
+namespace lrn {
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst) {
+    const int64_t half_size = (p->ls - 1) / 2;
+    const int64_t summands = p->alg == ACROSS ? p->ls : p->ls * p->ls;
+
+    mkldnn::impl::parallel_nd(p->mb, p->ic, p->ih, p->iw,
+            [&](int64_t mb, int64_t c, int64_t h, int64_t w) {
+        float sum = 0;
+        if (p->alg == ACROSS) {
+            const int64_t c_st = MAX2(c - half_size, 0);
+            const int64_t c_en = MIN2(c + half_size + 1, p->ic);
+            for (int64_t cs = c_st; cs < c_en; ++cs) {
+                const float s = ((const float *)src)[data_off(p, mb, cs, h, w)];
+                sum += s * s;
+            }
+        } else {
+            const int64_t h_st = MAX2(h - half_size, 0);
+            const int64_t h_en = MIN2(h + half_size + 1, p->ih);
+            const int64_t w_st = MAX2(w - half_size, 0);
+            const int64_t w_en = MIN2(w + half_size + 1, p->iw);
+            for (int64_t hs = h_st; hs < h_en; ++hs)
+            for (int64_t ws = w_st; ws < w_en; ++ws) {
+                const float s = ((const float *)src)[data_off(p, mb, c, hs, ws)];
+                sum += s * s;
+            }
+        }
+
+        const size_t off = data_off(p, mb, c, h, w);
+        const float norm = p->k + p->alpha * sum / summands;
+        ((float *)dst)[off] = ((const float *)src)[off] * powf(norm, -p->beta);
+    });
+}
+
+}
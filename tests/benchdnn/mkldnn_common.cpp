@@ -15,9 +15,285 @@
 *******************************************************************************/
 
 #include <assert.h>
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
 #include "mkldnn.h"
 
+#include "src/common/mkldnn_thread.hpp"
+
 #include "mkldnn_common.hpp"
 
 mkldnn_engine_t engine;
 mkldnn_stream_t stream;
+
+/* performance measurements */
+namespace {
+
+/* touches a buffer twice as large as the last level cache, so that nothing
+ * the primitive has used survives till the next run */
+struct cache_flusher_t {
+    cache_flusher_t(): size_(0), buf_(NULL) {
+        if (!cold_cache) return;
+        long llc_size = 0;
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+        llc_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+        if (llc_size <= 0) llc_size = 32 << 20;
+        size_ = 2 * (size_t)llc_size;
+        buf_ = (char *)zmalloc(size_, 64);
+        if (buf_) memset(buf_, 0, size_);
+    }
+    ~cache_flusher_t() { zfree(buf_); }
+
+    void flush() {
+        if (!buf_) return;
+        for (size_t i = 0; i < size_; i += 64) buf_[i]++;
+    }
+
+private:
+    size_t size_;
+    char *buf_;
+};
+
+struct perf_instance_t {
+    mkldnn_primitive_t prim;
+    mkldnn_stream_t stream;
+    args_t args;
+    std::vector<mkldnn_memory_t> mem; /** own copies of the arguments */
+    benchdnn_timer_t timer;
+    std::vector<double> runs_ms;
+    int status;
+};
+
+/* a copy of the primitive with copies of all the memories it works on */
+int init_instance(perf_instance_t &inst, mkldnn_primitive_t prim,
+        const args_t &args) {
+    const_mkldnn_primitive_desc_t pd;
+    DNN_SAFE(mkldnn_primitive_get_primitive_desc(prim, &pd), WARN);
+    DNN_SAFE(mkldnn_primitive_create(&inst.prim, pd), WARN);
+    DNN_SAFE(mkldnn_stream_create(&inst.stream, engine,
+                mkldnn_stream_default_flags), WARN);
+
+    for (int a = 0; a < args.size(); ++a) {
+        const mkldnn_memory_t orig = args.args()[a].memory;
+
+        /* in-place arguments stay in-place */
+        int same = 0;
+        while (same < a && args.args()[same].memory != orig) ++same;
+        if (same < a) {
+            inst.args.set(args.args()[a].arg, inst.mem[same]);
+            inst.mem.push_back(inst.mem[same]);
+            continue;
+        }
+
+        const mkldnn_memory_desc_t *md;
+        DNN_SAFE(mkldnn_memory_get_memory_desc(orig, &md), WARN);
+        mkldnn_memory_t m;
+        DNN_SAFE(mkldnn_memory_create(&m, md, engine,
+                    MKLDNN_NATIVE_HANDLE_ALLOCATE), WARN);
+        inst.mem.push_back(m);
+        inst.args.set(args.args()[a].arg, m);
+
+        void *from, *to;
+        DNN_SAFE(mkldnn_memory_get_data_handle(orig, &from), WARN);
+        DNN_SAFE(mkldnn_memory_get_data_handle(m, &to), WARN);
+        if (from && to) memcpy(to, from, mkldnn_memory_desc_get_size(md));
+    }
+
+    return OK;
+}
+
+void fini_instance(perf_instance_t &inst) {
+    for (size_t a = 0; a < inst.mem.size(); ++a) {
+        bool seen = false;
+        for (size_t b = 0; b < a; ++b) seen = seen || inst.mem[b] == inst.mem[a];
+        if (!seen) mkldnn_memory_destroy(inst.mem[a]);
+    }
+    if (inst.stream) mkldnn_stream_destroy(inst.stream);
+    if (inst.prim) mkldnn_primitive_destroy(inst.prim);
+}
+
+int run_instance(perf_instance_t &inst, double budget_ms) {
+    cache_flusher_t flusher;
+    auto &t = inst.timer;
+    t.reset();
+
+    const double start_ms = ms_now();
+    while (true) {
+        flusher.flush();
+
+        const double total_ms = t.total_ms();
+        t.start();
+        DNN_SAFE(mkldnn_primitive_execute(inst.prim, inst.stream,
+                    inst.args.size(), inst.args), WARN);
+        t.stamp();
+        inst.runs_ms.push_back(t.total_ms() - total_ms);
+
+        /* with cold caches most of the time goes to flushing, so the wall
+         * clock limits the run instead */
+        const double spent_ms = cold_cache ? ms_now() - start_ms : t.total_ms();
+        const bool stop = false
+            || (fix_times_per_prb && t.times() >= fix_times_per_prb)
+            || (!fix_times_per_prb
+                    && spent_ms >= budget_ms
+                    && t.times() >= min_times_per_prb);
+        if (stop) break;
+    }
+
+    return OK;
+}
+
+/* pins the calling thread (and the threads it spawns) to the cores of the
+ * instance and limits the number of threads the library uses */
+void bind_instance(int ithr_base, int nthr, const std::vector<int> &cpus) {
+#if MKLDNN_THR == MKLDNN_THR_OMP
+    omp_set_num_threads(nthr);
+#endif
+#if defined(__linux__)
+    if (cpus.empty()) return;
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (int i = 0; i < nthr; ++i)
+        CPU_SET(cpus[(ithr_base + i) % cpus.size()], &mask);
+    sched_setaffinity(0, sizeof(mask), &mask);
+#else
+    (void)ithr_base; (void)cpus;
+#endif
+}
+
+/* the minibatch: the outermost dimension of the source (the second one for
+ * rnn, where the outermost is time) */
+int64_t query_mb(const_mkldnn_primitive_desc_t pd) {
+    const mkldnn_query_t queries[] = { mkldnn_query_src_md,
+        mkldnn_query_diff_src_md, mkldnn_query_dst_md, };
+    const mkldnn_memory_desc_t *md = NULL;
+    for (auto q: queries)
+        if ((md = mkldnn_primitive_desc_query_md(pd, q, 0)) != NULL) break;
+    if (md == NULL || md->ndims == 0) return 1;
+
+    mkldnn_primitive_kind_t kind;
+    mkldnn_primitive_desc_query(pd, mkldnn_query_primitive_kind, 0, &kind);
+    return kind == mkldnn_rnn && md->ndims > 1 ? md->dims[1] : md->dims[0];
+}
+
+/* mean and the half-width of its 95% confidence interval (Student's t) */
+void trial_stats(const std::vector<double> &v, double &mean, double &ci) {
+    static const double t95[] = { 0, 12.706, 4.303, 3.182, 2.776, 2.571,
+        2.447, 2.365, 2.306, 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131,
+        2.120, 2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060,
+        2.056, 2.052, 2.048, 2.045, 2.042, };
+    const int n = (int)v.size();
+    mean = ci = 0;
+    if (n == 0) return;
+    for (auto x: v) mean += x;
+    mean /= n;
+    if (n == 1) return;
+
+    double var = 0;
+    for (auto x: v) var += (x - mean) * (x - mean);
+    var /= n - 1;
+    const int df = n - 1;
+    const double t = df < (int)(sizeof(t95) / sizeof(t95[0])) ? t95[df] : 1.96;
+    ci = t * sqrt(var / n);
+}
+
+}
+
+int measure_perf(res_t *r, mkldnn_primitive_t prim, const args_t &args) {
+    const int n_inst = MAX2(instances, 1);
+    const int n_trials = MAX2(trials, 1);
+    const bool concurrent = n_inst > 1 || threads_per_instance > 0;
+    const int nthr = threads_per_instance > 0
+        ? threads_per_instance : MAX2(mkldnn_get_max_threads() / n_inst, 1);
+    /* the trials share the time of the problem */
+    const double budget_ms = max_ms_per_prb / n_trials;
+
+    std::vector<perf_instance_t> inst(n_inst);
+    for (auto &i: inst) { i.prim = NULL; i.stream = NULL; i.status = OK; }
+
+    int status = OK;
+    std::vector<int> cpus;
+    if (!concurrent) {
+        inst[0].prim = prim;
+        inst[0].stream = stream;
+        inst[0].args = args;
+    } else {
+        for (auto &i: inst)
+            if ((status = init_instance(i, prim, args)) != OK) break;
+#if defined(__linux__)
+        cpu_set_t allowed;
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+            for (int c = 0; c < CPU_SETSIZE; ++c)
+                if (CPU_ISSET(c, &allowed)) cpus.push_back(c);
+#endif
+    }
+
+    r->timer.reset();
+    r->prb_per_s = 0;
+    std::vector<double> trial_ms;
+    for (int trial = 0; trial < n_trials && status == OK; ++trial) {
+        if (!concurrent) {
+            status = run_instance(inst[0], budget_ms);
+        } else {
+            std::atomic<int> ready(0);
+            std::vector<std::thread> workers;
+            for (int k = 0; k < n_inst; ++k)
+                workers.emplace_back([&, k]() {
+                    bind_instance(k * nthr, nthr, cpus);
+                    /* start all the instances together */
+                    ready++;
+                    while (ready < n_inst) std::this_thread::yield();
+                    inst[k].status = run_instance(inst[k], budget_ms);
+                });
+            for (auto &w: workers) w.join();
+            for (auto &i: inst) if (i.status != OK) status = i.status;
+        }
+
+        benchdnn_timer_t trial_timer;
+        for (auto &i: inst) {
+            trial_timer.merge(i.timer);
+            if (i.timer.total_ms() > 0)
+                r->prb_per_s += i.timer.times() / i.timer.total_ms() * 1e3;
+        }
+        r->timer.merge(trial_timer);
+        trial_ms.push_back(trial_timer.ms());
+    }
+    r->prb_per_s /= MAX2((int)trial_ms.size(), 1);
+
+    std::vector<double> runs_ms;
+    for (auto &i: inst) {
+        runs_ms.insert(runs_ms.end(), i.runs_ms.begin(), i.runs_ms.end());
+        if (!concurrent) { i.prim = NULL; i.stream = NULL; } /* not ours */
+        fini_instance(i);
+    }
+
+    r->p50_ms = r->p99_ms = 0;
+    if (!runs_ms.empty()) {
+        std::sort(runs_ms.begin(), runs_ms.end());
+        const size_t n = runs_ms.size();
+        r->p50_ms = runs_ms[(n - 1) / 2];
+        r->p99_ms = runs_ms[MIN2((size_t)ceil(0.99 * n), n) - 1];
+    }
+
+    r->trials = (int)trial_ms.size();
+    trial_stats(trial_ms, r->mean_ms, r->ci_ms);
+
+    const_mkldnn_primitive_desc_t pd;
+    DNN_SAFE(mkldnn_primitive_get_primitive_desc(prim, &pd), WARN);
+    r->mb = query_mb(pd);
+    r->instances = n_inst;
+    r->threads = concurrent ? nthr : mkldnn_get_max_threads();
+
+    return status;
+}
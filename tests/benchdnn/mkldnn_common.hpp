@@ -94,6 +94,28 @@ inline const char *query_impl_info(const_mkldnn_primitive_desc_t pd) {
     return str;
 }
 
+/* saves what the performance report needs to know about the primitive: the
+ * implementation name and the size of all the memories it reads or writes */
+inline void set_perf_info(res_t *r, const_mkldnn_primitive_desc_t pd) {
+    strncpy(r->impl_name, query_impl_info(pd), sizeof(r->impl_name) - 1);
+    r->impl_name[sizeof(r->impl_name) - 1] = '\0';
+
+    const mkldnn_query_t queries[] = { mkldnn_query_src_md,
+        mkldnn_query_diff_src_md, mkldnn_query_weights_md,
+        mkldnn_query_diff_weights_md, mkldnn_query_dst_md,
+        mkldnn_query_diff_dst_md, mkldnn_query_workspace_md, };
+
+    r->bytes = 0;
+    for (auto q: queries) {
+        for (int idx = 0; ; ++idx) {
+            const mkldnn_memory_desc_t *md
+                = mkldnn_primitive_desc_query_md(pd, q, idx);
+            if (md == NULL) break;
+            r->bytes += mkldnn_memory_desc_get_size(md);
+        }
+    }
+}
+
 struct args_t {
     args_t &set(int arg, mkldnn_memory_t memory) {
         mkldnn_exec_arg_t a = {arg, memory};
@@ -109,4 +131,11 @@ private:
     std::vector<mkldnn_exec_arg_t> args_;
 };
 
+/** runs the primitive until max_ms_per_prb (or fix_times_per_prb) is reached
+ * and fills in the timer and the throughput fields of the result.
+ * With --instances=K the primitive is replicated K times, each copy with its
+ * own memories, and the copies run concurrently on disjoint cores. With
+ * --cold-cache=true the caches are flushed before every run. */
+int measure_perf(res_t *r, mkldnn_primitive_t prim, const args_t &args);
+
 #endif
@@ -51,6 +51,16 @@ mkldnn_format_tag_t str2tag(const char *str) {
             || !strcmp("mkldnn_" STRINGIFY(_tag), str)) \
         return CONCAT2(mkldnn_, _tag); \
 } while (0)
+    if (!strcmp("undef", str)) return mkldnn_format_tag_undef;
+    CASE(a);
+    CASE(ab);
+    CASE(abc);
+    CASE(abcd);
+    CASE(abcde);
+    CASE(abcdef);
+    CASE(acb);
+    CASE(acdb);
+    CASE(acdeb);
     CASE(x);
     CASE(nc);
     CASE(ncw);
@@ -135,6 +145,7 @@ mkldnn_format_tag_t str2tag(const char *str) {
     CASE(ldigo);
     CASE(ldgoi);
     CASE(ldgo);
+    CASE(ldio);
 #undef CASE
     assert(!"unknown memory format tag");
     return mkldnn_format_tag_undef;
@@ -0,0 +1,208 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+
+#include "mkldnn.h"
+
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "src/common/mkldnn_thread.hpp"
+
+#include "pool/pool.hpp"
+
+namespace pool {
+
+static int init_pd(const prb_t *p, mkldnn_pooling_desc_t &pd,
+        mkldnn_primitive_desc_t &ppd, res_t *r) {
+    const int ndims = is_3d(p) ? 5 : 4;
+    mkldnn_dims_t src_dims_2d = {p->mb, p->ic, p->ih, p->iw};
+    mkldnn_dims_t src_dims_3d = {p->mb, p->ic, p->id, p->ih, p->iw};
+    mkldnn_dims_t dst_dims_2d = {p->mb, p->ic, p->oh, p->ow};
+    mkldnn_dims_t dst_dims_3d = {p->mb, p->ic, p->od, p->oh, p->ow};
+    mkldnn_dims_t strides_2d = {p->sh, p->sw};
+    mkldnn_dims_t strides_3d = {p->sd, p->sh, p->sw};
+    mkldnn_dims_t kernel_2d = {p->kh, p->kw};
+    mkldnn_dims_t kernel_3d = {p->kd, p->kh, p->kw};
+    mkldnn_dims_t padding_l_2d = {p->ph, p->pw};
+    mkldnn_dims_t padding_l_3d = {p->pd, p->ph, p->pw};
+
+    auto compute_pad_r = [](int64_t o, int64_t i, int64_t k, int64_t s,
+            int64_t pl) { return (o - 1) * s - i + k - pl; };
+    mkldnn_dims_t padding_r_2d = {
+        compute_pad_r(p->oh, p->ih, p->kh, p->sh, p->ph),
+        compute_pad_r(p->ow, p->iw, p->kw, p->sw, p->pw)};
+    mkldnn_dims_t padding_r_3d = {
+        compute_pad_r(p->od, p->id, p->kd, p->sd, p->pd),
+        padding_r_2d[0], padding_r_2d[1]};
+
+    const bool is3d = ndims == 5;
+    const auto tag = p->tag == mkldnn_format_tag_undef
+        ? get_default_tag(ndims) : p->tag;
+
+    mkldnn_memory_desc_t src_d, dst_d;
+    DNN_SAFE(mkldnn_memory_desc_init_by_tag(&src_d, ndims,
+                is3d ? src_dims_3d : src_dims_2d, p->dt, tag), WARN);
+    DNN_SAFE(mkldnn_memory_desc_init_by_tag(&dst_d, ndims,
+                is3d ? dst_dims_3d : dst_dims_2d, p->dt, tag), WARN);
+
+    auto prop = p->dir & FLAG_INF
+        ? mkldnn_forward_inference : mkldnn_forward_training;
+    DNN_SAFE(mkldnn_pooling_forward_desc_init(&pd, prop, alg2alg_kind(p->alg),
+                &src_d, &dst_d,
+                is3d ? strides_3d : strides_2d,
+                is3d ? kernel_3d : kernel_2d,
+                is3d ? padding_l_3d : padding_l_2d,
+                is3d ? padding_r_3d : padding_r_2d,
+                mkldnn_padding_zero), WARN);
+
+    mkldnn_status_t init_status = mkldnn_primitive_desc_create(&ppd, &pd,
+            NULL, engine, NULL);
+
+    if (init_status == mkldnn_unimplemented)
+        return r->state = UNIMPLEMENTED, OK;
+    else
+        SAFE(init_status, WARN);
+
+    const char *impl_str = query_impl_info(ppd);
+    if (maybe_skip(skip_impl, impl_str)) {
+        print(2, "SKIPPED: mkldnn implementation: %s\n", impl_str);
+        DNN_SAFE(mkldnn_primitive_desc_destroy(ppd), WARN);
+        return r->state = SKIPPED, OK;
+    } else {
+        print(5, "mkldnn implementation: %s\n", impl_str);
+    }
+
+    return OK;
+}
+
+int fill_src(const prb_t *p, dnn_mem_t &mem_fp, dnn_mem_t &mem_dt) {
+    const int64_t nelems = mem_fp.nelems();
+
+    /* f32: a grid over [-16, 16] with a fractional step; integers: the whole
+     * range of the data type (at most [-128, 127]) */
+    const bool is_int = p->dt != mkldnn_f32;
+    const int64_t range = is_int ? (p->dt == mkldnn_u8 ? 256 : 255) : 1601;
+    const float shift = is_int ? (p->dt == mkldnn_u8 ? 0 : 127) : 800;
+    const float scale = is_int ? 1.f : 1.f / 50;
+
+    mkldnn::impl::parallel_nd(nelems, [&](int64_t i) {
+        ((float *)mem_fp)[i] = ((i * 13) % range - shift) * scale;
+    });
+
+    SAFE(mem_dt.reorder(mem_fp), WARN);
+
+    return OK;
+}
+
+static int compare(const prb_t *p, const dnn_mem_t &fp_mem,
+        const dnn_mem_t &dt_mem, res_t *r) {
+    const int64_t nelems = fp_mem.nelems();
+    r->errors = 0;
+    r->total = nelems;
+
+    /* averages may be accumulated in a different order; integer results are
+     * rounded the same way */
+    const float eps = p->dt == mkldnn_f32 && p->alg != MAX ? 1e-6 : 0.f;
+
+    for (int64_t i = 0; i < nelems; ++i) {
+        const float fp = ((const float *)fp_mem)[i];
+        const float dt = ((const float *)dt_mem)[i];
+        const float diff = fabsf(fp - dt);
+        const float rel_diff = diff / (fabsf(fp) > FLT_MIN ? fabsf(fp) : 1);
+        const bool ok = (fabsf(fp) > 1e-5 ? rel_diff : diff) <= eps;
+
+        r->errors += !ok;
+
+        const bool dump = false
+            || (!ok && (r->errors < 10 || verbose >= 10))
+            || (verbose >= 50 && i < 30);
+        if (dump)
+            print(0, "[%4ld][DST] fp:%8g dt:%8g diff:%8g rdiff:%8g\n",
+                    (long)i, fp, dt, diff, rel_diff);
+    }
+
+    if (r->errors)
+        r->state = FAILED;
+
+    if (r->state == UNTESTED)
+        r->state = PASSED; /* optimism */
+
+    return r->state == FAILED ? FAIL : OK;
+}
+
+int doit(const prb_t *p, res_t *r) {
+    res_t res_zero{};
+    *r = res_zero;
+
+    mkldnn_pooling_desc_t pd;
+    mkldnn_primitive_desc_t ppd;
+    mkldnn_primitive_t pl{};
+
+    SAFE(init_pd(p, pd, ppd, r), WARN);
+    if (r->state == SKIPPED || r->state == UNIMPLEMENTED)
+        return OK;
+
+    /* max pooling for training keeps the positions of the maxima */
+    const auto ws_md = mkldnn_primitive_desc_query_md(ppd,
+            mkldnn_query_workspace_md, 0);
+    const bool with_ws = ws_md && ws_md->ndims != 0;
+    dnn_mem_t *p_ws_dt = with_ws ? new dnn_mem_t(*ws_md) : new dnn_mem_t();
+    dnn_mem_t &ws_dt = *p_ws_dt;
+
+    DNN_SAFE(mkldnn_primitive_create(&pl, ppd), WARN);
+    set_perf_info(r, ppd);
+    DNN_SAFE(mkldnn_primitive_desc_destroy(ppd), CRIT);
+
+    const auto fp = mkldnn_f32;
+    const auto &src_dt_d = pd.src_desc;
+    const auto &dst_dt_d = pd.dst_desc;
+    const auto tag = get_default_tag(src_dt_d.ndims);
+
+    dnn_mem_t src_fp(src_dt_d, fp, tag), src_dt(src_dt_d);
+    dnn_mem_t dst_fp(dst_dt_d, fp, tag), dst_dt(dst_dt_d);
+
+    SAFE(fill_src(p, src_fp, src_dt), WARN);
+
+    args_t args;
+    args.set(MKLDNN_ARG_SRC, src_dt.m_);
+    args.set(MKLDNN_ARG_DST, dst_dt.m_);
+
+    if (with_ws)
+        args.set(MKLDNN_ARG_WORKSPACE, ws_dt.m_);
+
+    DNN_SAFE(mkldnn_primitive_execute(pl, stream, args.size(), args), WARN);
+
+    if (bench_mode & CORR) {
+        compute_ref_fwd(p, src_fp, dst_fp);
+        dnn_mem_t dst(dst_dt, fp, tag);
+        SAFE(compare(p, dst_fp, dst, r), WARN);
+    }
+
+    if (bench_mode & PERF)
+        SAFE(measure_perf(r, pl, args), WARN);
+
+    delete p_ws_dt;
+    DNN_SAFE_V(mkldnn_primitive_destroy(pl));
+
+    return OK;
+}
+
+}
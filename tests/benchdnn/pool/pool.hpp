@@ -0,0 +1,96 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef _POOL_HPP
+#define _POOL_HPP
+
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "common.hpp"
+#include "dnn_types.hpp"
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "mkldnn_debug.hpp"
+
+namespace pool {
+
+enum alg_t { MAX, AVG_NP, AVG_P };
+alg_t str2alg(const char *str);
+const char *alg2str(alg_t alg);
+mkldnn_alg_kind_t alg2alg_kind(alg_t alg);
+
+struct desc_t {
+    int64_t mb, ic;
+    int64_t id, ih, iw;
+    int64_t od, oh, ow;
+    int64_t kd, kh, kw;
+    int64_t sd, sh, sw;
+    int64_t pd, ph, pw;
+    const char *name;
+};
+const size_t max_desc_len = 196;
+int str2desc(desc_t *desc, const char *str);
+void desc2str(const desc_t *d, char *buffer, bool canonical = false);
+
+struct prb_t: public desc_t {
+    prb_t(const desc_t &desc, int64_t mb, dir_t dir, mkldnn_data_type_t dt,
+            mkldnn_format_tag_t tag, alg_t alg)
+        : desc_t(desc), dir(dir), dt(dt), tag(tag), alg(alg), ops(0)
+    {
+        if (mb) this->mb = mb;
+        ops = (double)this->mb * ic * od * oh * ow * kd * kh * kw;
+    }
+    ~prb_t() {}
+
+    dir_t dir;
+    mkldnn_data_type_t dt;
+    mkldnn_format_tag_t tag; /* format_tag_undef means plain */
+    alg_t alg;
+
+    double ops;
+};
+const size_t max_prb_len = max_desc_len + 196;
+void prb2str(const prb_t *p, char *buffer, bool canonical = false);
+
+/* some extra control parameters which shouldn't be placed in prb_t */
+extern const char *skip_impl; /* NULL or "" means do not skip anything */
+
+extern const char *perf_template; /* performance output template */
+void perf_report(const prb_t *p, const res_t *r, const char *pstr);
+
+inline bool is_3d(const prb_t *p) { return p->id > 1 || p->kd > 1; }
+
+inline size_t src_off_f(const prb_t *p,
+        int64_t mb, int64_t c, int64_t d, int64_t h, int64_t w) {
+    return (((mb * p->ic + c) * p->id + d) * p->ih + h) * p->iw + w;
+}
+
+inline size_t dst_off_f(const prb_t *p,
+        int64_t mb, int64_t c, int64_t d, int64_t h, int64_t w) {
+    return (((mb * p->ic + c) * p->od + d) * p->oh + h) * p->ow + w;
+}
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst);
+
+int fill_src(const prb_t *p, dnn_mem_t &mem_fp, dnn_mem_t &mem_dt);
+int doit(const prb_t *p, res_t *res);
+int bench(int argc, char **argv, bool main_bench = true);
+
+}
+
+#endif
@@ -0,0 +1,186 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <assert.h>
+#include "pool/pool.hpp"
+
+namespace pool {
+
+alg_t str2alg(const char *str) {
+#define CASE(_alg) if (!strcasecmp(STRINGIFY(_alg), str)) return _alg
+    CASE(MAX);
+    CASE(AVG_NP);
+    CASE(AVG_P);
+#undef CASE
+    assert(!"unknown algorithm");
+    return MAX;
+}
+
+const char *alg2str(alg_t alg) {
+    if (alg == MAX) return "MAX";
+    if (alg == AVG_NP) return "AVG_NP";
+    if (alg == AVG_P) return "AVG_P";
+    assert(!"unknown algorithm");
+    return "unknown algorithm";
+}
+
+mkldnn_alg_kind_t alg2alg_kind(alg_t alg) {
+    if (alg == MAX) return mkldnn_pooling_max;
+    if (alg == AVG_NP) return mkldnn_pooling_avg_exclude_padding;
+    if (alg == AVG_P) return mkldnn_pooling_avg_include_padding;
+    assert(!"unknown algorithm");
+    return mkldnn_alg_kind_undef;
+}
+
+int str2desc(desc_t *desc, const char *str) {
+    desc_t d{0};
+
+    /* canonical form:
+     * mbXicXidXihXiwXodXohXowXkdXkhXkwXsdXshXswXpdXphXpwXnS
+     *
+     * where: X is number, S - string
+     * note: symbol `_` is ignored
+     *
+     * implicit rules:
+     *  - default values:
+     *      mb = 2, sd = sh = sw = 1, pd = ph = pw = 0, S="wip"
+     *  - if W is undefined => W = H (including ow)
+     *  - if D is undefined => 2d pooling
+     *  - if `output` is undefined => compute output
+     */
+
+    d.mb = 2; d.pd = d.ph = d.pw = -1;
+    d.name = "\"wip\"";
+
+    const char *s = str;
+    assert(s);
+
+#   define CASE_NN(p, c) do { \
+        if (!strncmp(p, s, strlen(p))) { \
+            ok = 1; s += strlen(p); \
+            char *end_s; d. c = strtol(s, &end_s, 10); s += (end_s - s); \
+        } \
+    } while (0)
+#   define CASE_N(c) CASE_NN(#c, c)
+    while (*s) {
+        int ok = 0;
+        CASE_N(mb); CASE_N(ic);
+        CASE_N(id); CASE_N(ih); CASE_N(iw);
+        CASE_N(od); CASE_N(oh); CASE_N(ow);
+        CASE_N(kd); CASE_N(kh); CASE_N(kw);
+        CASE_N(sd); CASE_N(sh); CASE_N(sw);
+        CASE_N(pd); CASE_N(ph); CASE_N(pw);
+        if (*s == 'n') { d.name = s + 1; break; }
+        if (*s == '_') ++s;
+        if (!ok) return FAIL;
+    }
+#   undef CASE_NN
+#   undef CASE_N
+
+    if (d.ic == 0 || d.ih == 0 || d.kh == 0) return FAIL;
+
+    if (d.sh == 0) d.sh = 1;
+    if (d.ph < 0) d.ph = 0;
+
+    const bool no_w = (d.iw | d.ow | d.kw | d.sw) == 0 && d.pw < 0;
+    if (no_w) {
+        d.iw = d.ih; d.ow = d.oh; d.kw = d.kh; d.sw = d.sh; d.pw = d.ph;
+    } else {
+        if (d.iw == 0 || d.kw == 0) return FAIL;
+        if (d.sw == 0) d.sw = 1;
+        if (d.pw < 0) d.pw = 0;
+    }
+
+    if (d.id == 0) {
+        if (d.kd > 1 || d.od > 1) return FAIL;
+        d.id = d.od = d.kd = d.sd = 1;
+        d.pd = 0;
+    } else {
+        if (d.kd == 0) return FAIL;
+        if (d.sd == 0) d.sd = 1;
+        if (d.pd < 0) d.pd = 0;
+    }
+
+    if (d.sd < 0 || d.sh < 0 || d.sw < 0) return FAIL;
+
+    auto compute_out = [](int64_t i, int64_t k, int64_t s, int64_t p)
+    { return (i - k + 2 * p) / s + 1; };
+
+    if (d.od == 0) d.od = compute_out(d.id, d.kd, d.sd, d.pd);
+    if (d.oh == 0) d.oh = compute_out(d.ih, d.kh, d.sh, d.ph);
+    if (d.ow == 0) d.ow = compute_out(d.iw, d.kw, d.sw, d.pw);
+
+    if (d.od <= 0 || d.oh <= 0 || d.ow <= 0) return FAIL;
+
+    *desc = d;
+
+    return OK;
+}
+
+void desc2str(const desc_t *d, char *buffer, bool canonical) {
+    int rem_len = max_desc_len;
+#   define DPRINT(...) do { \
+        int l = snprintf(buffer, rem_len, __VA_ARGS__); \
+        buffer += l; rem_len -= l; \
+    } while(0)
+
+    const bool is_3d = d->id > 1 || d->kd > 1;
+    const bool square = d->iw == d->ih && d->ow == d->oh && d->kw == d->kh
+        && d->sw == d->sh && d->pw == d->ph;
+
+    if (canonical || d->mb != 2) DPRINT("mb" IFMT "", d->mb);
+    DPRINT("ic" IFMT "", d->ic);
+    if (is_3d) DPRINT("id" IFMT "", d->id);
+    DPRINT("ih" IFMT "", d->ih);
+    if (canonical || !square) DPRINT("iw" IFMT "", d->iw);
+    if (is_3d) DPRINT("od" IFMT "", d->od);
+    DPRINT("oh" IFMT "", d->oh);
+    if (canonical || !square) DPRINT("ow" IFMT "", d->ow);
+    if (is_3d) DPRINT("kd" IFMT "", d->kd);
+    DPRINT("kh" IFMT "", d->kh);
+    if (canonical || !square) DPRINT("kw" IFMT "", d->kw);
+    if (is_3d) DPRINT("sd" IFMT "", d->sd);
+    DPRINT("sh" IFMT "", d->sh);
+    if (canonical || !square) DPRINT("sw" IFMT "", d->sw);
+    if (is_3d) DPRINT("pd" IFMT "", d->pd);
+    DPRINT("ph" IFMT "", d->ph);
+    if (canonical || !square) DPRINT("pw" IFMT "", d->pw);
+    DPRINT("n%s", d->name);
+
+#   undef DPRINT
+}
+
+void prb2str(const prb_t *p, char *buffer, bool canonical) {
+    char desc_buf[max_desc_len];
+    char dir_str[32] = {0};
+    char dt_str[16] = {0};
+    char tag_str[32] = {0};
+    char alg_str[32] = {0};
+    desc2str(p, desc_buf, canonical);
+    snprintf(dir_str, sizeof(dir_str), "--dir=%s ", dir2str(p->dir));
+    snprintf(dt_str, sizeof(dt_str), "--dt=%s ", dt2str(p->dt));
+    snprintf(tag_str, sizeof(tag_str), "--tag=%s ", tag2str(p->tag));
+    snprintf(alg_str, sizeof(alg_str), "--alg=%s ", alg2str(p->alg));
+    snprintf(buffer, max_prb_len, "%s%s%s%s%s",
+            canonical || p->dir != FWD_D ? dir_str : "",
+            canonical || p->dt != mkldnn_f32 ? dt_str : "",
+            canonical || p->tag != mkldnn_format_tag_undef ? tag_str : "",
+            canonical || p->alg != MAX ? alg_str : "",
+            desc_buf);
+}
+
+}
@@ -0,0 +1,61 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "src/common/mkldnn_thread.hpp"
+
+#include "pool/pool.hpp"
+
+namespace pool {
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst) {
+    const bool is_int = p->dt != mkldnn_f32;
+    const float lo = p->dt == mkldnn_u8 ? 0 : p->dt == mkldnn_s8 ? INT8_MIN
+        : -FLT_MAX;
+    const float hi = p->dt == mkldnn_u8 ? UINT8_MAX
+        : p->dt == mkldnn_s8 ? INT8_MAX : FLT_MAX;
+
+    mkldnn::impl::parallel_nd(p->mb, p->ic, p->od, p->oh, p->ow,
+            [&](int64_t mb, int64_t ic, int64_t od, int64_t oh, int64_t ow) {
+        float max = -FLT_MAX;
+        float sum = 0;
+        int64_t num_summands = 0;
+
+        for (int64_t kd = 0; kd < p->kd; ++kd)
+        for (int64_t kh = 0; kh < p->kh; ++kh)
+        for (int64_t kw = 0; kw < p->kw; ++kw) {
+            const int64_t id = od * p->sd - p->pd + kd;
+            const int64_t ih = oh * p->sh - p->ph + kh;
+            const int64_t iw = ow * p->sw - p->pw + kw;
+            if (id < 0 || id >= p->id) continue;
+            if (ih < 0 || ih >= p->ih) continue;
+            if (iw < 0 || iw >= p->iw) continue;
+
+            const float s = ((const float *)src)[
+                src_off_f(p, mb, ic, id, ih, iw)];
+            max = MAX2(max, s);
+            sum += s;
+            ++num_summands;
+        }
+
+        if (p->alg == AVG_P) num_summands = p->kd * p->kh * p->kw;
+
+        float d = p->alg == MAX ? max : sum / num_summands;
+        if (is_int) d = MAX2(lo, MIN2(hi, (float)mxcsr_round(d)));
+        ((float *)dst)[dst_off_f(p, mb, ic, od, oh, ow)] = d;
+    });
+}
+
+}
@@ -88,6 +88,11 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
         return 1e0;
     };
 
+    if (perf_format != PERF_TEMPLATE) {
+        perf_print_record(r, pstr, 0);
+        return;
+    }
+
     const char *pt = perf_template;
     char c;
 
@@ -132,8 +137,12 @@ void perf_report(const prb_t *p, const res_t *r, const char *pstr) {
             DPRINT("%g", t.ms(mode) / unit);
         else if (c == 'p')
             DPRINT("%g", ops / t.ms(mode) / unit * 1e3);
-        else
-            SAFE_V(FAIL);
+        else {
+            const int l = perf_print_common(buf, rem_len, c, mode, unit, r,
+                    0);
+            if (l < 0) SAFE_V(FAIL);
+            buf += l; rem_len -= l;
+        }
     }
 
     *buf = '\0';
@@ -307,24 +307,14 @@ int check_reorder(const prb_t *p, res_t *res) {
 
         mkldnn_primitive_t perf_r;
         DNN_SAFE(mkldnn_primitive_create(&perf_r, perf_r_pd), WARN);
+        set_perf_info(res, perf_r_pd);
         DNN_SAFE_V(mkldnn_primitive_desc_destroy(perf_r_pd));
 
         args_t args;
         args.set(MKLDNN_ARG_FROM, mem_dt_in_fmt_in.m_);
         args.set(MKLDNN_ARG_TO, mem_dt_out_fmt_out.m_);
 
-        auto &t = res->timer;
-        t.reset();
-        while (true) {
-            DNN_SAFE(mkldnn_primitive_execute(perf_r, stream, args.size(), args), WARN);
-            t.stamp();
-            const bool stop = false
-                || (fix_times_per_prb && t.times() >= fix_times_per_prb)
-                || (!fix_times_per_prb
-                        && t.total_ms() >= max_ms_per_prb
-                        && t.times() >= min_times_per_prb);
-            if (stop) break;
-        }
+        SAFE(measure_perf(res, perf_r, args), WARN);
 
         DNN_SAFE_V(mkldnn_primitive_destroy(perf_r));
     }
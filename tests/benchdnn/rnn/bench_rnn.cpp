@@ -41,6 +41,8 @@ policy_t scale_policy = NONE;
 attr_t attr;
 bool allow_unimpl = false;
 int mb = 0;
+bool with_peephole = false;
+bool with_projection = false;
 
 void reset_parameters() {
     cfg = conf_f32;
@@ -52,6 +54,8 @@ void reset_parameters() {
     scale_policy = NONE;
     allow_unimpl = false;
     mb = 0;
+    with_peephole = false;
+    with_projection = false;
 }
 
 int bench(int argc, char **argv, bool main_bench) {
@@ -86,6 +90,10 @@ int bench(int argc, char **argv, bool main_bench) {
             perf_template = argv[arg] + 16;
         else if (!strncmp("--mb=", argv[arg], 5))
             mb = atoi(argv[arg] + 5);
+        else if (!strncmp("--with-peephole=", argv[arg], 16))
+            with_peephole = str2bool(argv[arg] + 16);
+        else if (!strncmp("--with-projection=", argv[arg], 18))
+            with_projection = str2bool(argv[arg] + 18);
         else if (!strncmp("-v", argv[arg], 2))
             verbose = atoi(argv[arg] + 2);
         else if (!strncmp("--verbose=", argv[arg], 10))
@@ -112,7 +120,7 @@ int bench(int argc, char **argv, bool main_bench) {
 
 void check(rnn_desc_t *d) {
     const rnn_prb_t p(*d, cfg, prop, alg, direction, activation, attr,
-        scale_policy, mb);
+        scale_policy, mb, with_peephole, with_projection);
     res_t res{};
     char pstr[max_prb_len];
 
@@ -52,6 +52,11 @@ void perf_report(const rnn_prb_t *p, const res_t *r, const char *pstr) {
         return 1e0;
     };
 
+    if (perf_format != PERF_TEMPLATE) {
+        perf_print_record(r, pstr, p->ops);
+        return;
+    }
+
     const char *pt = perf_template;
     char c;
 
@@ -93,8 +98,12 @@ void perf_report(const rnn_prb_t *p, const res_t *r, const char *pstr) {
             DPRINT("%g", p->ops / unit);
         else if (c == 'p')
             DPRINT("%g", p->ops / t.ms(mode) / unit * 1e3);
-        else
-            []() { SAFE(FAIL, CRIT); return 0; }();
+        else {
+            const int l = perf_print_common(buf, rem_len, c, mode, unit, r,
+                    p->ops);
+            if (l < 0) []() { SAFE(FAIL, CRIT); return 0; }();
+            buf += l; rem_len -= l;
+        }
     }
 
     *buf = '\0';
@@ -168,12 +168,15 @@ void lstm_fwd(const rnn_prb_t *p, int64_t sic, int64_t slc, int64_t dic, int64_t
         int64_t n_gates, float *dst_iter_h_, float *c_dst_, float *gates_,
         const float *weights_layer_, const float *weights_iter_h_,
         const float *bias_, const float *src_layer_, const float *src_iter_h_,
-        const float *src_iter_c_) {
+        const float *src_iter_c_, const float *weights_peephole_,
+        const float *weights_projection_, float *ht_) {
     AOC<float> h_dst(dst_iter_h_, batch, wc);
     AOC<float> c_dst(c_dst_, batch, wc);
     AOC<const float> bias(bias_, n_gates, dic);
     AOC<const float> src_iter_c(src_iter_c_, batch, wc);
     AOC<float> gates(gates_, batch, n_gates, dic);
+    AOC<const float> weights_peephole(weights_peephole_, 3, dic);
+    AOC<float> ht(ht_, batch, dic);
 
     const int64_t ohi = 0;
     const int64_t ohf = 1;
@@ -205,6 +208,19 @@ void lstm_fwd(const rnn_prb_t *p, int64_t sic, int64_t slc, int64_t dic, int64_t
                         = maybe_deq_w(gates(i, j, k), j * dic + k) + bias(j, k);
             }
 
+    // the input and forget gates peek at the previous cell state, the output
+    // gate waits for the new one so keep its pre-activation value around
+    float *oho_preact_ = nullptr;
+    if (weights_peephole_) {
+        oho_preact_ = new float[batch * dic];
+        for (int64_t i = 0; i < batch; i++)
+            for (int64_t k = 0; k < dic; k++) {
+                gates(i, ohi, k) += weights_peephole(0, k) * src_iter_c(i, k);
+                gates(i, ohf, k) += weights_peephole(1, k) * src_iter_c(i, k);
+                oho_preact_[i * dic + k] = gates(i, oho, k);
+            }
+    }
+
     // run the eltwise
     lstm_activation(dic, n_gates, batch, gates_);
 
@@ -226,15 +242,34 @@ void lstm_fwd(const rnn_prb_t *p, int64_t sic, int64_t slc, int64_t dic, int64_t
             float tmp = gates(i, ohf, j) * src_iter_c(i, j)
                     + gates(i, ohi, j) * gates(i, ohc, j);
             c_dst(i, j) = tmp;
+            if (weights_peephole_)
+                gates(i, oho, j) = logistic(oho_preact_[i * dic + j]
+                        + weights_peephole(2, j) * tmp);
             h_dst(i, j) = maybe_q_d(gates(i, oho, j) * tanhf(tmp));
         }
+    delete[] oho_preact_;
+
+    if (!weights_projection_)
+        return;
+
+    // the projection runs in f32 on the dequantized hidden state
+    for (int64_t i = 0; i < batch; i++)
+        for (int64_t j = 0; j < dic; j++)
+            ht(i, j) = h_dst(i, j) / p->data_scale;
+    gemm("C", "N", "N", batch, dic, dic, 1.0, ht_, dic, weights_projection_,
+            dic, 0.0, dst_iter_h_, wc);
+    for (int64_t i = 0; i < batch; i++)
+        for (int64_t j = 0; j < dic; j++)
+            h_dst(i, j) = maybe_q_d(h_dst(i, j));
 }
 
 void rnn_cell_fwd(const rnn_prb_t *p, alg_t alg, activation_t f, int64_t sic,
         int64_t slc, int64_t dic, int64_t wc, int64_t batch, int64_t n_gates, float *dst_iter_h,
         float *dst_iter_c, float *gates, const float *weights_layer,
         const float *weights_iter, const float *bias, const float *src_layer,
-        const float *src_iter_h, const float *src_iter_c, float *ws_local_) {
+        const float *src_iter_h, const float *src_iter_c, float *ws_local_,
+        const float *weights_peephole, const float *weights_projection,
+        float *ht) {
     switch (alg) {
     case VANILLA_GRU:
         gru_fwd(sic, slc, dic, wc, batch, n_gates, dst_iter_h, gates,
@@ -248,7 +283,7 @@ void rnn_cell_fwd(const rnn_prb_t *p, alg_t alg, activation_t f, int64_t sic,
     case VANILLA_LSTM:
         lstm_fwd(p, sic, slc, dic, wc, batch, n_gates, dst_iter_h, dst_iter_c,
                 gates, weights_layer, weights_iter, bias, src_layer, src_iter_h,
-                src_iter_c);
+                src_iter_c, weights_peephole, weights_projection, ht);
         break;
     case VANILLA_RNN:
         rnn_fwd(f, sic, slc, dic, wc, batch, n_gates, dst_iter_h, gates,
@@ -484,7 +519,8 @@ void rnn_linear_fwd(const rnn_prb_t *p, mkldnn_rnn_direction_t direction,
         const float *src_iter_, const float *src_layer_,
         const float *weights_layer_, const float *weights_iter_h_,
         const float *bias_, float *dst_iter_, float *dst_layer_, float *ws_,
-        float *gates_) {
+        float *gates_, const float *weights_peephole_,
+        const float *weights_projection_, float *ht_) {
 
     const alg_t alg = p->alg;
     const int64_t sic = p->sic;
@@ -510,6 +546,11 @@ void rnn_linear_fwd(const rnn_prb_t *p, mkldnn_rnn_direction_t direction,
             weights_iter_h_, n_layer, n_dir, n_gates * dic, sic);
     AOC<float> ws(ws_, n_layer + 2, n_dir, n_iter + 2, n_states, batch, wc);
     AOC<float> gates(gates_, n_layer, n_dir, n_iter, batch, n_gates, dic);
+    AOC<const float> weights_peephole(
+            weights_peephole_, n_layer, n_dir, 3 * dic);
+    AOC<const float> weights_projection(
+            weights_projection_, n_layer, n_dir, dic * dic);
+    AOC<float> ht(ht_, n_layer, n_dir, n_iter, batch * dic);
 
     int64_t ws_local_size = is_lbr * batch * n_gates * dic;
     float *ws_local_ = new float[ws_local_size];
@@ -539,7 +580,14 @@ void rnn_linear_fwd(const rnn_prb_t *p, mkldnn_rnn_direction_t direction,
                         &bias(lay - 1, dir_val, 0),
                         &ws(lay - 1, dir_val, iter, H, 0, 0),
                         &ws(lay, dir_val, prev_iter, H, 0, 0),
-                        &ws(lay, dir_val, prev_iter, C, 0, 0), ws_local_);
+                        &ws(lay, dir_val, prev_iter, C, 0, 0), ws_local_,
+                        weights_peephole_
+                                ? &weights_peephole(lay - 1, dir_val, 0)
+                                : nullptr,
+                        weights_projection_
+                                ? &weights_projection(lay - 1, dir_val, 0)
+                                : nullptr,
+                        &ht(lay - 1, dir_val, iter - 1, 0));
             }
         }
 
@@ -574,7 +622,8 @@ void compute_ref_fwd(const rnn_prb_t *p, dnn_mem_t &src_layer_m,
         dnn_mem_t &src_iter_m, dnn_mem_t &weights_src_layer_m,
         dnn_mem_t &weights_src_iter_m, dnn_mem_t &bias_m,
         dnn_mem_t &dst_last_layer_m, dnn_mem_t &dst_last_iteration_m,
-        mkldnn_rnn_direction_t direction) {
+        mkldnn_rnn_direction_t direction, dnn_mem_t *weights_peephole_m,
+        dnn_mem_t *weights_projection_m) {
 
     assert(direction == mkldnn_unidirectional_left2right
             || direction == mkldnn_unidirectional_right2left
@@ -588,14 +637,21 @@ void compute_ref_fwd(const rnn_prb_t *p, dnn_mem_t &src_layer_m,
     int64_t gates_size = p->n_layer * p->n_directions() * p->n_iter * p->mb
             * p->n_gates() * p->dic;
     auto *gates = new float[gates_size];
+    int64_t ht_size = p->n_layer * p->n_directions() * p->n_iter * p->mb
+            * p->dic;
+    auto *ht = new float[ht_size];
 
     rnn_linear_fwd(p, direction, (float *)src_iter_m, (float *)src_layer_m,
             (float *)weights_src_layer_m, (float *)weights_src_iter_m,
             (float *)bias_m, (float *)dst_last_iteration_m,
-            (float *)dst_last_layer_m, ws, gates);
+            (float *)dst_last_layer_m, ws, gates,
+            weights_peephole_m ? (float *)*weights_peephole_m : nullptr,
+            weights_projection_m ? (float *)*weights_projection_m : nullptr,
+            ht);
 
     delete[] ws;
     delete[] gates;
+    delete[] ht;
 }
 
 // =============================================================================
@@ -643,7 +699,9 @@ void lstm_bwd(alg_t alg, int64_t sic, int64_t slc, int64_t dic, int64_t wc, int6
         const float *weights_iter_h_, const float *bias_,
         const float *dst_iter_h_, const float *dst_iter_c_, const float *gates_,
         const float *diff_dst_layer_, const float *diff_dst_iter_h_,
-        const float *diff_dst_iter_c_) {
+        const float *diff_dst_iter_c_, const float *weights_peephole_,
+        const float *weights_projection_, const float *ht_,
+        float *diff_weights_peephole_, float *diff_weights_projection_) {
     // TODO: check sic and slc as last dimension in arrays and cycles
     // input
     AOC<const float> diff_dst_layer(diff_dst_layer_, batch, wc);
@@ -656,12 +714,30 @@ void lstm_bwd(alg_t alg, int64_t sic, int64_t slc, int64_t dic, int64_t wc, int6
 
     AOC<float> diff_src_iter_c(diff_src_iter_c_, batch, wc);
     AOC<float> b_gates(b_gates_, batch, n_gates, dic);
+    AOC<const float> weights_peephole(weights_peephole_, 3, dic);
+    AOC<float> diff_weights_peephole(diff_weights_peephole_, 3, dic);
 
     const int64_t ohi = 0;
     const int64_t ohf = 1;
     const int64_t ohc = 2;
     const int64_t oho = 3;
 
+    // the projection is applied last so its gradient goes first
+    float *dh_ = new float[batch * dic];
+    AOC<float> diff_h(dh_, batch, dic);
+    for (int64_t ib = 0; ib < batch; ib++)
+        for (int64_t ih = 0; ih < dic; ih++)
+            diff_h(ib, ih) = diff_dst_layer(ib, ih) + diff_dst_iter_h(ib, ih);
+    if (weights_projection_) {
+        float *dh_proj_ = new float[batch * dic];
+        copy(batch, dic, dic, dic, dh_, dh_proj_);
+        gemm("C", "T", "N", dic, dic, batch, 1.0, ht_, dic, dh_proj_, dic, 1.0,
+                diff_weights_projection_, dic);
+        gemm("C", "N", "T", batch, dic, dic, 1.0, dh_proj_, dic,
+                weights_projection_, dic, 0.0, dh_, dic);
+        delete[] dh_proj_;
+    }
+
     for (int64_t ib = 0; ib < batch; ib++)
         for (int64_t ih = 0; ih < dic; ih++) {
             print(80, "rnn_single_bwd: ib = " IFMT " ih = " IFMT "\n", ib, ih);
@@ -669,13 +745,15 @@ void lstm_bwd(alg_t alg, int64_t sic, int64_t slc, int64_t dic, int64_t wc, int6
             float hf = gates(ib, ohf, ih);
             float hc = gates(ib, ohc, ih);
             float hi = gates(ib, ohi, ih);
-            float dh = diff_dst_layer(ib, ih) + diff_dst_iter_h(ib, ih);
+            float dh = diff_h(ib, ih);
             float c = dst_iter_c(ib, ih);
             float dho = tanhf(c) * dh;
             b_gates(ib, oho, ih) = x_m_square(ho) * dho;
 
             float dc_next = diff_dst_iter_c(ib, ih);
             float dc = ho * dh * dtanhf(c) + dc_next;
+            if (weights_peephole_)
+                dc += b_gates(ib, oho, ih) * weights_peephole(2, ih);
             diff_src_iter_c(ib, ih) = hf * dc;
 
             float c_old = src_iter_c(ib, ih);
@@ -687,7 +765,17 @@ void lstm_bwd(alg_t alg, int64_t sic, int64_t slc, int64_t dic, int64_t wc, int6
 
             float dhc = hi * dc;
             b_gates(ib, ohc, ih) = one_m_square(hc) * dhc;
+
+            if (weights_peephole_) {
+                diff_src_iter_c(ib, ih)
+                        += b_gates(ib, ohi, ih) * weights_peephole(0, ih)
+                        + b_gates(ib, ohf, ih) * weights_peephole(1, ih);
+                diff_weights_peephole(0, ih) += b_gates(ib, ohi, ih) * c_old;
+                diff_weights_peephole(1, ih) += b_gates(ib, ohf, ih) * c_old;
+                diff_weights_peephole(2, ih) += b_gates(ib, oho, ih) * c;
+            }
         }
+    delete[] dh_;
 
     gemm("C", "T", "N", sic, n_gates * dic, batch, 1.0, src_iter_h_, wc, b_gates_,
             n_gates * dic, 1.0, diff_weights_iter_h_, n_gates * dic);
@@ -879,7 +967,10 @@ void rnn_cell_bwd(alg_t alg, activation_t f, int64_t sic, int64_t slc, int64_t d
         const float *weights_iter, const float *bias, const float *dst_iter_h,
         const float *dst_iter_c, const float *gates,
         const float *diff_dst_layer, const float *diff_dst_iter_h,
-        const float *diff_dst_iter_c, float *ws_local_) {
+        const float *diff_dst_iter_c, float *ws_local_,
+        const float *weights_peephole, const float *weights_projection,
+        const float *ht, float *diff_weights_peephole,
+        float *diff_weights_projection) {
 
     switch (alg) {
     case VANILLA_LSTM:
@@ -888,7 +979,8 @@ void rnn_cell_bwd(alg_t alg, activation_t f, int64_t sic, int64_t slc, int64_t d
                 diff_weights_iter, diff_bias, b_gates, src_layer, src_iter_h,
                 src_iter_c, weights_layer, weights_iter, bias, dst_iter_h,
                 dst_iter_c, gates, diff_dst_layer, diff_dst_iter_h,
-                diff_dst_iter_c);
+                diff_dst_iter_c, weights_peephole, weights_projection, ht,
+                diff_weights_peephole, diff_weights_projection);
         break;
     case VANILLA_RNN:
         rnn_bwd(alg, f, sic, slc, dic, wc, batch, n_gates, diff_src_layer,
@@ -919,7 +1011,10 @@ void rnn_linear_bwd(const rnn_prb_t *p, mkldnn_rnn_direction_t direction,
         const float *weights_layer_, const float *weights_iter_h_,
         const float *bias_, float *diff_src_iter_, float *diff_src_layer_,
         float *diff_weights_layer_, float *diff_weights_iter_h_,
-        float *diff_bias_, float *ws_, const float *gates_) {
+        float *diff_bias_, float *ws_, const float *gates_,
+        const float *weights_peephole_, const float *weights_projection_,
+        const float *ht_, float *diff_weights_peephole_,
+        float *diff_weights_projection_) {
 
     const alg_t alg = p->alg;
     const int64_t sic = p->sic;
@@ -956,6 +1051,16 @@ void rnn_linear_bwd(const rnn_prb_t *p, mkldnn_rnn_direction_t direction,
     AOC<float> ws(ws_, n_layer + 2, n_dir, n_iter + 2, n_states, batch, wc);
     AOC<const float> gates(gates_, n_layer, n_dir, n_iter, batch, n_gates, dic);
 
+    AOC<const float> weights_peephole(
+            weights_peephole_, n_layer, n_dir, 3 * dic);
+    AOC<const float> weights_projection(
+            weights_projection_, n_layer, n_dir, dic * dic);
+    AOC<const float> ht(ht_, n_layer, n_dir, n_iter, batch * dic);
+    AOC<float> diff_weights_peephole(
+            diff_weights_peephole_, n_layer, n_dir, 3 * dic);
+    AOC<float> diff_weights_projection(
+            diff_weights_projection_, n_layer, n_dir, dic * dic);
+
     int64_t wsb_size = (n_layer + 2) * n_dir * (n_iter + 2) * (n_states + 1) * batch
             * wc;
     auto *wsb_ = new float[wsb_size];
@@ -1016,7 +1121,20 @@ void rnn_linear_bwd(const rnn_prb_t *p, mkldnn_rnn_direction_t direction,
                         &wsb(prev_lay, dir_val, iter, X, 0, 0),
                         &wsb(lay, dir_val, prev_iter, H, 0, 0),
                         &wsb(lay, dir_val, prev_iter, C, 0, 0),
-                        ws_local_);
+                        ws_local_,
+                        weights_peephole_
+                                ? &weights_peephole(lay - 1, dir_val, 0)
+                                : nullptr,
+                        weights_projection_
+                                ? &weights_projection(lay - 1, dir_val, 0)
+                                : nullptr,
+                        &ht(lay - 1, dir_val, ws_iter - 1, 0),
+                        weights_peephole_
+                                ? &diff_weights_peephole(lay - 1, dir_val, 0)
+                                : nullptr,
+                        weights_projection_
+                                ? &diff_weights_projection(lay - 1, dir_val, 0)
+                                : nullptr);
             }
         }
 
@@ -1057,7 +1175,9 @@ void compute_ref_bwd(const rnn_prb_t *p, dnn_mem_t &input_m,
         dnn_mem_t &dst_diff_input_m, dnn_mem_t &dst_diff_states_m,
         dnn_mem_t &dst_diff_weights_input_m,
         dnn_mem_t &dst_diff_weights_states_m, dnn_mem_t &dst_diff_bias_m,
-        mkldnn_rnn_direction_t direction) {
+        mkldnn_rnn_direction_t direction, dnn_mem_t *weights_peephole_m,
+        dnn_mem_t *weights_projection_m, dnn_mem_t *dst_diff_weights_peephole_m,
+        dnn_mem_t *dst_diff_weights_projection_m) {
     // !! TODO: add support of strides
 
     assert(direction == mkldnn_unidirectional_left2right
@@ -1074,11 +1194,18 @@ void compute_ref_bwd(const rnn_prb_t *p, dnn_mem_t &input_m,
     int64_t gates_size = p->n_layer * p->n_directions() * p->n_iter * p->mb
             * p->n_gates() * p->dic;
     auto *gates = new float[gates_size];
+    int64_t ht_size = p->n_layer * p->n_directions() * p->n_iter * p->mb
+            * p->dic;
+    auto *ht = new float[ht_size];
+
+    auto peephole = weights_peephole_m ? (float *)*weights_peephole_m : nullptr;
+    auto projection
+            = weights_projection_m ? (float *)*weights_projection_m : nullptr;
 
     rnn_linear_fwd(p, direction, (float *)states_m, (float *)input_m,
             (float *)weights_input_m, (float *)weights_states_m,
             (float *)bias_m, (float *)dst_last_iteration_m,
-            (float *)dst_last_layer_m, ws, gates);
+            (float *)dst_last_layer_m, ws, gates, peephole, projection, ht);
 
     rnn_linear_bwd(p, direction, (float *)diff_last_iteration_m,
             (float *)diff_last_layer_m, (float *)weights_input_m,
@@ -1086,10 +1213,17 @@ void compute_ref_bwd(const rnn_prb_t *p, dnn_mem_t &input_m,
             (float *)dst_diff_states_m, (float *)dst_diff_input_m,
             (float *)dst_diff_weights_input_m,
             (float *)dst_diff_weights_states_m, (float *)dst_diff_bias_m, ws,
-            gates);
+            gates, peephole, projection, ht,
+            dst_diff_weights_peephole_m
+                    ? (float *)*dst_diff_weights_peephole_m
+                    : nullptr,
+            dst_diff_weights_projection_m
+                    ? (float *)*dst_diff_weights_projection_m
+                    : nullptr);
 
     delete[] ws;
     delete[] gates;
+    delete[] ht;
 }
 
 } // namespace rnn
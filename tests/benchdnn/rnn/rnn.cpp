@@ -96,7 +96,9 @@ inline int init_pd(const rnn_prb_t *p, mkldnn_rnn_desc_t rd[2],
     mkldnn_memory_desc_t input_d, states_d, weights_input_d, weights_states_d,
             bias_d, dst_last_layer_d, dst_last_iteration_d, diff_input_d,
             diff_states_d, diff_weights_input_d, diff_weights_states_d,
-            diff_bias_d, diff_last_layer_d, diff_last_iteration_d;
+            diff_bias_d, diff_last_layer_d, diff_last_iteration_d,
+            weights_peephole_d, weights_projection_d,
+            diff_weights_peephole_d, diff_weights_projection_d;
 
     // dimensions with ref
     mkldnn_dims_t input_dims = { p->n_iter, p->mb, p->slc };
@@ -107,6 +109,10 @@ inline int init_pd(const rnn_prb_t *p, mkldnn_rnn_desc_t rd[2],
             = { p->n_layer, p->n_directions(), p->sic, p->n_gates(), p->dic };
     mkldnn_dims_t bias_dims
             = { p->n_layer, p->n_directions(), p->n_gates() + is_gru_lbr, p->dic };
+    mkldnn_dims_t weights_peephole_dims
+            = { p->n_layer, p->n_directions(), 3, p->dic };
+    mkldnn_dims_t weights_projection_dims
+            = { p->n_layer, p->n_directions(), p->dic, p->dic };
     // mkldnn_tnc
     int64_t lastlay_dlc = (p->direction == mkldnn_bidirectional_concat)
             ? 2 * p->dlc
@@ -145,6 +151,16 @@ inline int init_pd(const rnn_prb_t *p, mkldnn_rnn_desc_t rd[2],
                      &bias_d, 4, bias_dims, p->cfg[bias].dt, mkldnn_format_tag_any),
             WARN);
 
+    DNN_SAFE(mkldnn_memory_desc_init_by_tag(&weights_peephole_d, 4,
+                     weights_peephole_dims, p->cfg[weights_peephole].dt,
+                     mkldnn_format_tag_any),
+            WARN);
+
+    DNN_SAFE(mkldnn_memory_desc_init_by_tag(&weights_projection_d, 4,
+                     weights_projection_dims, p->cfg[weights_projection].dt,
+                     mkldnn_format_tag_any),
+            WARN);
+
     DNN_SAFE(mkldnn_memory_desc_init_by_tag(&dst_last_layer_d, 3, dst_last_layer_dims,
                      p->cfg[dst_last_layer].dt, mkldnn_tnc),
             WARN);
@@ -178,10 +194,18 @@ inline int init_pd(const rnn_prb_t *p, mkldnn_rnn_desc_t rd[2],
     // When training, we use forward_training
     {
         mkldnn_status_t init_status = mkldnn_success;
-        init_status = mkldnn_rnn_forward_desc_init(&rd[0], fwd_prop, &rcd,
-                         p->direction, &input_d, &states_d, &weights_input_d,
-                         &weights_states_d, &bias_d, &dst_last_layer_d,
-                         &dst_last_iteration_d);
+        if (p->with_peephole || p->with_projection)
+            init_status = mkldnn_lstm_forward_desc_init(&rd[0], fwd_prop,
+                    &rcd, p->direction, &input_d, &states_d, &weights_input_d,
+                    &weights_states_d,
+                    p->with_peephole ? &weights_peephole_d : NULL,
+                    p->with_projection ? &weights_projection_d : NULL,
+                    &bias_d, &dst_last_layer_d, &dst_last_iteration_d);
+        else
+            init_status = mkldnn_rnn_forward_desc_init(&rd[0], fwd_prop, &rcd,
+                    p->direction, &input_d, &states_d, &weights_input_d,
+                    &weights_states_d, &bias_d, &dst_last_layer_d,
+                    &dst_last_iteration_d);
         if (init_status == mkldnn_unimplemented)
             return r->state = UNIMPLEMENTED, OK;
         else
@@ -214,14 +238,41 @@ inline int init_pd(const rnn_prb_t *p, mkldnn_rnn_desc_t rd[2],
                          dst_last_iteration_dims,
                          p->cfg[diff_last_iteration].dt, mkldnn_format_tag_any),
                 WARN);
-        DNN_SAFE(mkldnn_rnn_backward_desc_init(&rd[1], p->prop, &rcd,
-                         p->direction, &input_d, &states_d, &weights_input_d,
-                         &weights_states_d, &bias_d, &dst_last_layer_d,
-                         &dst_last_iteration_d, &diff_input_d, &diff_states_d,
-                         &diff_weights_input_d, &diff_weights_states_d,
-                         &diff_bias_d, &diff_last_layer_d,
-                         &diff_last_iteration_d),
+        DNN_SAFE(mkldnn_memory_desc_init_by_tag(&diff_weights_peephole_d, 4,
+                         weights_peephole_dims,
+                         p->cfg[dst_diff_weights_peephole].dt,
+                         mkldnn_format_tag_any),
+                WARN);
+        DNN_SAFE(mkldnn_memory_desc_init_by_tag(&diff_weights_projection_d, 4,
+                         weights_projection_dims,
+                         p->cfg[dst_diff_weights_projection].dt,
+                         mkldnn_format_tag_any),
                 WARN);
+        if (p->with_peephole || p->with_projection)
+            DNN_SAFE(mkldnn_lstm_backward_desc_init(&rd[1], p->prop, &rcd,
+                             p->direction, &input_d, &states_d,
+                             &weights_input_d, &weights_states_d,
+                             p->with_peephole ? &weights_peephole_d : NULL,
+                             p->with_projection ? &weights_projection_d : NULL,
+                             &bias_d, &dst_last_layer_d, &dst_last_iteration_d,
+                             &diff_input_d, &diff_states_d,
+                             &diff_weights_input_d, &diff_weights_states_d,
+                             p->with_peephole ? &diff_weights_peephole_d : NULL,
+                             p->with_projection ? &diff_weights_projection_d
+                                                : NULL,
+                             &diff_bias_d, &diff_last_layer_d,
+                             &diff_last_iteration_d),
+                    WARN);
+        else
+            DNN_SAFE(mkldnn_rnn_backward_desc_init(&rd[1], p->prop, &rcd,
+                             p->direction, &input_d, &states_d,
+                             &weights_input_d, &weights_states_d, &bias_d,
+                             &dst_last_layer_d, &dst_last_iteration_d,
+                             &diff_input_d, &diff_states_d,
+                             &diff_weights_input_d, &diff_weights_states_d,
+                             &diff_bias_d, &diff_last_layer_d,
+                             &diff_last_iteration_d),
+                    WARN);
     }
     auto mkldnn_attr = create_mkldnn_rnn_attr(p);
     mkldnn_status_t init_status = mkldnn_success;
@@ -246,6 +297,10 @@ inline int init_pd(const rnn_prb_t *p, mkldnn_rnn_desc_t rd[2],
         rd[i].bias_desc = q(mkldnn_query_weights_md, i, 2);
         rd[i].dst_layer_desc = q(mkldnn_query_dst_md, i);
         rd[i].dst_iter_desc = q(mkldnn_query_dst_md, i, 1);
+        if (p->with_peephole)
+            rd[i].weights_peephole_desc = q(mkldnn_query_weights_md, i, 3);
+        if (p->with_projection)
+            rd[i].weights_projection_desc = q(mkldnn_query_weights_md, i, 4);
     }
     if (is_bwd) {
         rd[1].diff_src_layer_desc = q(mkldnn_query_diff_src_md, 1);
@@ -255,6 +310,12 @@ inline int init_pd(const rnn_prb_t *p, mkldnn_rnn_desc_t rd[2],
         rd[1].diff_bias_desc = q(mkldnn_query_diff_weights_md, 1, 2);
         rd[1].diff_dst_layer_desc = q(mkldnn_query_diff_dst_md, 1);
         rd[1].diff_dst_iter_desc = q(mkldnn_query_diff_dst_md, 1, 1);
+        if (p->with_peephole)
+            rd[1].diff_weights_peephole_desc
+                    = q(mkldnn_query_diff_weights_md, 1, 3);
+        if (p->with_projection)
+            rd[1].diff_weights_projection_desc
+                    = q(mkldnn_query_diff_weights_md, 1, 4);
     }
 
     return OK;
@@ -273,6 +334,17 @@ int doit(const rnn_prb_t *p, res_t *r) {
         return OK;
     }
 
+    if ((p->with_peephole || p->with_projection) && p->alg != VANILLA_LSTM) {
+        r->state = UNIMPLEMENTED;
+        return OK;
+    }
+
+    // the projected hidden state is fed back into the next iteration
+    if (p->with_projection && p->sic != p->dic) {
+        r->state = SKIPPED;
+        return OK;
+    }
+
     const bool is_bwd = p->prop == mkldnn_backward;
 
     dnn_mem_t *input_dt = nullptr;
@@ -309,6 +381,15 @@ int doit(const rnn_prb_t *p, res_t *r) {
     dnn_mem_t *diff_last_layer_fp = nullptr;
     dnn_mem_t *diff_last_iteration_fp = nullptr;
 
+    dnn_mem_t *weights_peephole_dt = nullptr;
+    dnn_mem_t *weights_projection_dt = nullptr;
+    dnn_mem_t *dst_diff_weights_peephole_dt = nullptr;
+    dnn_mem_t *dst_diff_weights_projection_dt = nullptr;
+    dnn_mem_t *weights_peephole_fp = nullptr;
+    dnn_mem_t *weights_projection_fp = nullptr;
+    dnn_mem_t *dst_diff_weights_peephole_fp = nullptr;
+    dnn_mem_t *dst_diff_weights_projection_fp = nullptr;
+
     dnn_mem_t *workspace_dt = nullptr;
 
     mkldnn_rnn_desc_t rd[2];
@@ -369,6 +450,31 @@ int doit(const rnn_prb_t *p, res_t *r) {
     dst_last_iteration_fp
             = new dnn_mem_t(dst_last_iteration_dt_d, fp, mkldnn_ldsnc);
 
+    if (p->with_peephole) {
+        weights_peephole_dt = new dnn_mem_t(rd[0].weights_peephole_desc,
+                p->cfg[weights_peephole].dt);
+        weights_peephole_fp
+                = new dnn_mem_t(rd[0].weights_peephole_desc, fp, mkldnn_ldgo);
+        if (is_bwd) {
+            dst_diff_weights_peephole_dt
+                    = new dnn_mem_t(rd[1].diff_weights_peephole_desc, fp);
+            dst_diff_weights_peephole_fp = new dnn_mem_t(
+                    rd[1].diff_weights_peephole_desc, fp, mkldnn_ldgo);
+        }
+    }
+    if (p->with_projection) {
+        weights_projection_dt = new dnn_mem_t(rd[0].weights_projection_desc,
+                p->cfg[weights_projection].dt);
+        weights_projection_fp = new dnn_mem_t(
+                rd[0].weights_projection_desc, fp, mkldnn_ldio);
+        if (is_bwd) {
+            dst_diff_weights_projection_dt
+                    = new dnn_mem_t(rd[1].diff_weights_projection_desc, fp);
+            dst_diff_weights_projection_fp = new dnn_mem_t(
+                    rd[1].diff_weights_projection_desc, fp, mkldnn_ldio);
+        }
+    }
+
     if (is_bwd) {
         dst_diff_input_fp = new dnn_mem_t(diff_src_layer_dt_d, fp, mkldnn_tnc);
         dst_diff_states_fp
@@ -400,6 +506,14 @@ int doit(const rnn_prb_t *p, res_t *r) {
     SAFE(fill_memory(p, dst_last_iteration, *dst_last_iteration_dt,
                  *dst_last_iteration_fp),
             WARN);
+    if (p->with_peephole)
+        SAFE(fill_memory(p, weights_peephole, *weights_peephole_dt,
+                     *weights_peephole_fp),
+                WARN);
+    if (p->with_projection)
+        SAFE(fill_memory(p, weights_projection, *weights_projection_dt,
+                     *weights_projection_fp),
+                WARN);
 
     if (is_bwd) {
         SAFE(bwd_weights_states_dt->reorder(*weights_states_dt), WARN);
@@ -425,6 +539,16 @@ int doit(const rnn_prb_t *p, res_t *r) {
         SAFE(fill_memory(p, diff_last_iteration, *diff_last_iteration_dt,
                      *diff_last_iteration_fp),
                 WARN);
+        if (p->with_peephole)
+            SAFE(fill_memory(p, dst_diff_weights_peephole,
+                         *dst_diff_weights_peephole_dt,
+                         *dst_diff_weights_peephole_fp),
+                    WARN);
+        if (p->with_projection)
+            SAFE(fill_memory(p, dst_diff_weights_projection,
+                         *dst_diff_weights_projection_dt,
+                         *dst_diff_weights_projection_fp),
+                    WARN);
     }
 
     args_t args;
@@ -432,6 +556,7 @@ int doit(const rnn_prb_t *p, res_t *r) {
     // Running the forward pass
     {
         DNN_SAFE(mkldnn_primitive_create(&c, rpd[0]), WARN);
+        set_perf_info(r, rpd[0]);
         DNN_SAFE(mkldnn_primitive_desc_destroy(rpd[0]), CRIT);
 
         args.set(MKLDNN_ARG_SRC_LAYER, input_dt->m_);
@@ -439,6 +564,10 @@ int doit(const rnn_prb_t *p, res_t *r) {
         args.set(MKLDNN_ARG_WEIGHTS_LAYER, weights_input_dt->m_);
         args.set(MKLDNN_ARG_WEIGHTS_ITER, weights_states_dt->m_);
         args.set(MKLDNN_ARG_BIAS, bias_dt->m_);
+        if (p->with_peephole)
+            args.set(MKLDNN_ARG_WEIGHTS_PEEPHOLE, weights_peephole_dt->m_);
+        if (p->with_projection)
+            args.set(MKLDNN_ARG_WEIGHTS_PROJECTION, weights_projection_dt->m_);
 
         args.set(MKLDNN_ARG_DST_LAYER, dst_last_layer_dt->m_);
         args.set(MKLDNN_ARG_DST_ITER, dst_last_iteration_dt->m_);
@@ -451,7 +580,8 @@ int doit(const rnn_prb_t *p, res_t *r) {
         if ((p->prop == mkldnn_forward) && (bench_mode & CORR)) {
             compute_ref_fwd(p, *input_fp, *states_fp, *weights_input_fp,
                     *weights_states_fp, *bias_fp, *dst_last_layer_fp,
-                    *dst_last_iteration_fp, p->direction);
+                    *dst_last_iteration_fp, p->direction, weights_peephole_fp,
+                    weights_projection_fp);
             dnn_mem_t dst_last_layer(*dst_last_layer_dt, fp, mkldnn_tnc);
             dnn_mem_t dst_last_iteration(
                     *dst_last_iteration_dt, fp, mkldnn_ldsnc);
@@ -469,6 +599,7 @@ int doit(const rnn_prb_t *p, res_t *r) {
         DNN_SAFE(mkldnn_primitive_destroy(c), CRIT);
 
         DNN_SAFE(mkldnn_primitive_create(&c, rpd[1]), WARN);
+        set_perf_info(r, rpd[1]);
         DNN_SAFE(mkldnn_primitive_desc_destroy(rpd[1]), CRIT);
 
         args.set(MKLDNN_ARG_SRC_LAYER, input_dt->m_);
@@ -476,6 +607,10 @@ int doit(const rnn_prb_t *p, res_t *r) {
         args.set(MKLDNN_ARG_WEIGHTS_LAYER, bwd_weights_input_dt->m_);
         args.set(MKLDNN_ARG_WEIGHTS_ITER, bwd_weights_states_dt->m_);
         args.set(MKLDNN_ARG_BIAS, bias_dt->m_);
+        if (p->with_peephole)
+            args.set(MKLDNN_ARG_WEIGHTS_PEEPHOLE, weights_peephole_dt->m_);
+        if (p->with_projection)
+            args.set(MKLDNN_ARG_WEIGHTS_PROJECTION, weights_projection_dt->m_);
         args.set(MKLDNN_ARG_DST_LAYER, dst_last_layer_dt->m_);
         args.set(MKLDNN_ARG_DST_ITER, dst_last_iteration_dt->m_);
         args.set(MKLDNN_ARG_DIFF_DST_LAYER, diff_last_layer_dt->m_);
@@ -487,6 +622,12 @@ int doit(const rnn_prb_t *p, res_t *r) {
         args.set(MKLDNN_ARG_DIFF_WEIGHTS_LAYER, dst_diff_weights_input_dt->m_);
         args.set(MKLDNN_ARG_DIFF_WEIGHTS_ITER, dst_diff_weights_states_dt->m_);
         args.set(MKLDNN_ARG_DIFF_BIAS, dst_diff_bias_dt->m_);
+        if (p->with_peephole)
+            args.set(MKLDNN_ARG_DIFF_WEIGHTS_PEEPHOLE,
+                    dst_diff_weights_peephole_dt->m_);
+        if (p->with_projection)
+            args.set(MKLDNN_ARG_DIFF_WEIGHTS_PROJECTION,
+                    dst_diff_weights_projection_dt->m_);
 
 #ifdef CALL_MKLDNN_RNN
         DNN_SAFE(mkldnn_primitive_execute(c, stream, args.size(), args), WARN);
@@ -499,7 +640,9 @@ int doit(const rnn_prb_t *p, res_t *r) {
                     *dst_last_iteration_fp, *dst_diff_input_fp,
                     *dst_diff_states_fp, *dst_diff_weights_input_fp,
                     *dst_diff_weights_states_fp, *dst_diff_bias_fp,
-                    p->direction);
+                    p->direction, weights_peephole_fp, weights_projection_fp,
+                    dst_diff_weights_peephole_fp,
+                    dst_diff_weights_projection_fp);
 
             dnn_mem_t dst_last_layer(*dst_last_layer_dt, fp, mkldnn_tnc);
             dnn_mem_t dst_last_iteration(
@@ -531,25 +674,30 @@ int doit(const rnn_prb_t *p, res_t *r) {
 
             dnn_mem_t diff_bias(*dst_diff_bias_dt, fp, mkldnn_ldgo);
             SAFE(compare_bias(p, diff_bias, *dst_diff_bias_fp, r, true), WARN);
+
+            if (p->with_peephole) {
+                dnn_mem_t diff_weights_peephole(
+                        *dst_diff_weights_peephole_dt, fp, mkldnn_ldgo);
+                SAFE(compare_dat(p, dst_diff_weights_peephole,
+                             diff_weights_peephole,
+                             *dst_diff_weights_peephole_fp, r, true),
+                        WARN);
+            }
+            if (p->with_projection) {
+                dnn_mem_t diff_weights_projection(
+                        *dst_diff_weights_projection_dt, fp, mkldnn_ldio);
+                SAFE(compare_dat(p, dst_diff_weights_projection,
+                             diff_weights_projection,
+                             *dst_diff_weights_projection_fp, r, true),
+                        WARN);
+            }
         }
     }
 
-    if (bench_mode & PERF) {
-        auto &t = r->timer;
-        t.reset();
-        while (true) {
 #ifdef CALL_MKLDNN_RNN
-            DNN_SAFE(mkldnn_primitive_execute(c, stream, args.size(), args), WARN);
+    if (bench_mode & PERF)
+        SAFE(measure_perf(r, c, args), WARN);
 #endif
-            t.stamp();
-            const bool stop = false
-                    || (fix_times_per_prb && t.times() >= fix_times_per_prb)
-                    || (!fix_times_per_prb && t.total_ms() >= max_ms_per_prb
-                               && t.times() >= min_times_per_prb);
-            if (stop)
-                break;
-        }
-    }
 
     // cleanup
     delete input_fp;
@@ -590,6 +738,15 @@ int doit(const rnn_prb_t *p, res_t *r) {
         delete diff_last_iteration_dt;
     }
 
+    delete weights_peephole_dt;
+    delete weights_projection_dt;
+    delete dst_diff_weights_peephole_dt;
+    delete dst_diff_weights_projection_dt;
+    delete weights_peephole_fp;
+    delete weights_projection_fp;
+    delete dst_diff_weights_peephole_fp;
+    delete dst_diff_weights_projection_fp;
+
     delete workspace_dt;
 
     DNN_SAFE(mkldnn_primitive_destroy(c), CRIT);
@@ -111,6 +111,8 @@ enum rnn_data_kind_t {
     bias,
     dst_last_iteration,
     dst_last_layer,
+    weights_peephole,
+    weights_projection,
     dst_diff_input,
     dst_diff_states,
     dst_diff_weights_input,
@@ -118,6 +120,8 @@ enum rnn_data_kind_t {
     dst_diff_bias,
     diff_last_iteration,
     diff_last_layer,
+    dst_diff_weights_peephole,
+    dst_diff_weights_projection,
     data_kind_total // should be last to provide the total number of data kinds
 };
 
@@ -130,6 +134,10 @@ inline const char *rnn_data_kind2str(rnn_data_kind_t kind) {
     case bias: return "BIAS";
     case dst_last_layer: return "DST_LAST_LAYER";
     case dst_last_iteration: return "DST_LAST_ITERATION";
+    case weights_peephole: return "WEIGHTS_PEEPHOLE";
+    case weights_projection: return "WEIGHTS_PROJECTION";
+    case dst_diff_weights_peephole: return "DIFF_WEIGHTS_PEEPHOLE";
+    case dst_diff_weights_projection: return "DIFF_WEIGHTS_PROJECTION";
     default:
         assert(!"incorrect rnn data kind");
         return "incorrect rnn data kind";
@@ -175,7 +183,8 @@ struct rnn_prb_t : public rnn_desc_t {
     rnn_prb_t(const rnn_desc_t desc, const dt_conf_t *cfg,
             mkldnn_prop_kind_t prop, alg_t alg,
             mkldnn_rnn_direction_t direction, activation_t activation,
-            const attr_t &attr, policy_t scale_policy, int mb = 0)
+            const attr_t &attr, policy_t scale_policy, int mb = 0,
+            bool with_peephole = false, bool with_projection = false)
         : rnn_desc_t(desc)
         , cfg(cfg)
         , prop(prop)
@@ -184,6 +193,8 @@ struct rnn_prb_t : public rnn_desc_t {
         , activation(activation)
         , attr(attr)
         , scale_policy(scale_policy)
+        , with_peephole(with_peephole)
+        , with_projection(with_projection)
         , ops(0.0) {
         count_ops();
         if (mb) this->mb = mb;
@@ -203,6 +214,8 @@ struct rnn_prb_t : public rnn_desc_t {
         // theoretical number of ops for the post-gemm operations
         int64_t num_cells = (int64_t) n_directions() * n_layer * n_iter;
         int64_t cell_ops = (int64_t) 2 * (n_gates() * dic) * mb * (sic + slc);
+        if (with_projection)
+            cell_ops += (int64_t) 2 * dic * dic * mb;
         ops = num_cells * cell_ops;
     }
 
@@ -230,6 +243,8 @@ struct rnn_prb_t : public rnn_desc_t {
     activation_t activation;
     attr_t attr;
     policy_t scale_policy;
+    bool with_peephole;
+    bool with_projection; // the projection keeps dic channels
 
     double ops;
 
@@ -250,7 +265,8 @@ void compute_ref_fwd(const rnn_prb_t *p, dnn_mem_t &input_m,
         dnn_mem_t &states_m, dnn_mem_t &weights_input_m,
         dnn_mem_t &weights_states_m, dnn_mem_t &bias_m,
         dnn_mem_t &dst_last_layer_m, dnn_mem_t &dst_last_iteration_m,
-        mkldnn_rnn_direction_t direction);
+        mkldnn_rnn_direction_t direction, dnn_mem_t *weights_peephole_m,
+        dnn_mem_t *weights_projection_m);
 
 void compute_ref_bwd(const rnn_prb_t *p, dnn_mem_t &input_m,
         dnn_mem_t &states_m, dnn_mem_t &diff_last_layer_m,
@@ -260,7 +276,9 @@ void compute_ref_bwd(const rnn_prb_t *p, dnn_mem_t &input_m,
         dnn_mem_t &dst_diff_input_m, dnn_mem_t &dst_diff_states_m,
         dnn_mem_t &dst_diff_weights_input_m,
         dnn_mem_t &dst_diff_weights_states_m, dnn_mem_t &dst_diff_bias_m,
-        mkldnn_rnn_direction_t direction);
+        mkldnn_rnn_direction_t direction, dnn_mem_t *weights_peephole_m,
+        dnn_mem_t *weights_projection_m, dnn_mem_t *dst_diff_weights_peephole_m,
+        dnn_mem_t *dst_diff_weights_projection_m);
 
 // mkldnn_ntc
 inline size_t ntc_off_f(const rnn_prb_t *p, int64_t n, int64_t t, int64_t c) {
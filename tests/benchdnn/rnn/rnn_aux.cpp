@@ -227,6 +227,10 @@ void prb2str(const rnn_prb_t *p, const res_t *res, char *buffer) {
             prop2str(p->prop), alg2str(p->alg), activation2str(p->activation),
             direction2str(p->direction), cfg2str(p->cfg),
             policy2str(p->scale_policy));
+    if (p->with_peephole)
+        DPRINT("--with-peephole=true ");
+    if (p->with_projection)
+        DPRINT("--with-projection=true ");
     DPRINT("l" IFMT "", p->n_layer);
     DPRINT("t" IFMT "", p->n_iter);
     DPRINT("mb" IFMT "", p->mb);
@@ -351,6 +355,16 @@ int compare_dat(const rnn_prb_t *p, rnn_data_kind_t kind, dnn_mem_t &mem_dt,
                             final_compare == false ? "REORDER " : "", skind, l,
                             d, s, n, c, fp, dt, diff, rel_diff);
                     break;
+                case weights_peephole:
+                case weights_projection:
+                case dst_diff_weights_peephole:
+                case dst_diff_weights_projection:
+                    print(0, "%lu, %s, [%s] "
+                             "fp:%8g dt:%8g diff:%8g rdiff:%8g\n",
+                            (unsigned long)i,
+                            final_compare == false ? "REORDER " : "", skind,
+                            fp, dt, diff, rel_diff);
+                    break;
                 default: assert("unknown data kind"); return FAIL;
                 }
             }
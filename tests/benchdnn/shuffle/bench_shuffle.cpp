@@ -95,12 +95,12 @@ int bench(int argc, char **argv, bool main_bench) {
         else if (!strncmp("--verbose=", argv[arg], 10))
             verbose = atoi(argv[arg] + 10);
         else {
-            if (!strncmp("--", argv[arg], 2)) {
+            const char *end_s;
+            if (str2dims(dims, argv[arg], &end_s) != OK || *end_s != '\0') {
                 fprintf(stderr, "driver: unknown option: `%s`, exiting...\n",
                         argv[arg]);
                 exit(2);
             }
-            dims = str2dims(argv[arg]);
             check_correctness();
         }
     }
@@ -136,6 +136,7 @@ int doit(const prb_t *p, res_t *r) {
         return OK;
 
     DNN_SAFE(mkldnn_primitive_create(&s, spd), WARN);
+    set_perf_info(r, spd);
     DNN_SAFE(mkldnn_primitive_desc_destroy(spd), CRIT);
 
     const auto fp = p->dt;
@@ -164,20 +165,8 @@ int doit(const prb_t *p, res_t *r) {
         SAFE(compare(p, dst_fp, data, r), WARN);
     }
 
-    if (bench_mode & PERF) {
-        auto &t = r->timer;
-        t.reset();
-        while (true) {
-            DNN_SAFE(mkldnn_primitive_execute(s, stream, args.size(), args), WARN);
-            t.stamp();
-            const bool stop = false
-                || (fix_times_per_prb && t.times() >= fix_times_per_prb)
-                || (!fix_times_per_prb
-                        && t.total_ms() >= max_ms_per_prb
-                        && t.times() >= min_times_per_prb);
-            if (stop) break;
-        }
-    }
+    if (bench_mode & PERF)
+        SAFE(measure_perf(r, s, args), WARN);
 
     DNN_SAFE_V(mkldnn_primitive_destroy(s));
 
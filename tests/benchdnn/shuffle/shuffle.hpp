@@ -20,7 +20,6 @@
 #include <stdint.h>
 #include <limits.h>
 #include <assert.h>
-#include <vector>
 
 #include "common.hpp"
 #include "dnn_types.hpp"
@@ -30,8 +29,6 @@
 
 namespace shuffle {
 
-using dims_t = std::vector<int64_t>;
-
 struct dt_conf_t {
     mkldnn_data_type_t dt;
     int min;
@@ -61,9 +58,6 @@ struct prb_t {
     int64_t g;
 };
 
-const size_t max_dims_len = 20;
-dims_t str2dims(const char *str);
-void dims2str(const dims_t &dims, char *buffer);
 const size_t max_prb_len = max_desc_len + 196;
 void prb2str(const prb_t *p, char *buffer, bool canonical = false);
 
@@ -20,32 +20,6 @@
 
 namespace shuffle {
 
-#define DPRINT(...) do { \
-    int l = snprintf(buffer, rem_len, __VA_ARGS__); \
-    buffer += l; rem_len -= l; \
-} while(0)
-
-dims_t str2dims(const char *str) {
-    dims_t dims;
-    do {
-        int len;
-        int64_t dim;
-        int scan = sscanf(str, IFMT "%n", &dim, &len);
-        SAFE_V(scan == 1 ? OK : FAIL);
-        dims.push_back(dim);
-        str += len;
-        SAFE_V(*str == 'x' || *str == '\0' ? OK : FAIL);
-    } while (*str++ != '\0');
-    return dims;
-}
-
-void dims2str(const dims_t &dims, char *buffer) {
-    int rem_len = max_dims_len;
-    for (size_t d = 0; d < dims.size() - 1; ++d)
-        DPRINT(IFMT "x", dims[d]);
-    DPRINT(IFMT, dims[dims.size() - 1]);
-}
-
 void prb2str(const prb_t *p, char *buffer, bool canonical) {
     char dims_buf[max_dims_len] = {0};
     dims2str(p->dims, dims_buf);
@@ -0,0 +1,49 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "src/common/mkldnn_thread.hpp"
+
+#include "softmax/softmax.hpp"
+
+namespace softmax {
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst) {
+    int64_t outer, axis, inner;
+    get_sizes(p, outer, axis, inner);
+
+    const float *s = (const float *)src;
+    float *d = (float *)dst;
+
+    mkldnn::impl::parallel_nd(outer, inner, [&](int64_t ou, int64_t in) {
+        const int64_t base = ou * axis * inner + in;
+
+        float max = -FLT_MAX;
+        for (int64_t a = 0; a < axis; ++a)
+            max = MAX2(max, s[base + a * inner]);
+
+        double sum = 0;
+        for (int64_t a = 0; a < axis; ++a) {
+            const float e = expf(s[base + a * inner] - max);
+            d[base + a * inner] = e;
+            sum += e;
+        }
+
+        for (int64_t a = 0; a < axis; ++a)
+            d[base + a * inner] = (float)(d[base + a * inner] / sum);
+    });
+}
+
+}
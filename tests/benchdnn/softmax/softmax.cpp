@@ -0,0 +1,167 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+
+#include "mkldnn.h"
+
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "src/common/mkldnn_thread.hpp"
+
+#include "softmax/softmax.hpp"
+
+namespace softmax {
+
+static int init_pd(const prb_t *p, mkldnn_softmax_desc_t &sd,
+        mkldnn_primitive_desc_t &spd, res_t *r) {
+    const int ndims = (int)p->dims.size();
+    mkldnn_dims_t data_dims;
+    for (int d = 0; d < ndims; ++d) data_dims[d] = p->dims[d];
+
+    const auto tag = p->tag == mkldnn_format_tag_undef
+        ? get_default_tag(ndims) : p->tag;
+
+    mkldnn_memory_desc_t data_d;
+    DNN_SAFE(mkldnn_memory_desc_init_by_tag(&data_d, ndims, data_dims, p->dt,
+                tag), WARN);
+
+    auto prop = p->dir & FLAG_INF
+        ? mkldnn_forward_inference : mkldnn_forward_training;
+    DNN_SAFE(mkldnn_softmax_forward_desc_init(&sd, prop, &data_d, p->axis),
+            WARN);
+
+    mkldnn_status_t init_status = mkldnn_primitive_desc_create(&spd, &sd,
+            NULL, engine, NULL);
+
+    if (init_status == mkldnn_unimplemented)
+        return r->state = UNIMPLEMENTED, OK;
+    else
+        SAFE(init_status, WARN);
+
+    const char *impl_str = query_impl_info(spd);
+    if (maybe_skip(skip_impl, impl_str)) {
+        print(2, "SKIPPED: mkldnn implementation: %s\n", impl_str);
+        DNN_SAFE(mkldnn_primitive_desc_destroy(spd), WARN);
+        return r->state = SKIPPED, OK;
+    } else {
+        print(5, "mkldnn implementation: %s\n", impl_str);
+    }
+
+    return OK;
+}
+
+int fill_src(const prb_t *p, dnn_mem_t &mem_fp, dnn_mem_t &mem_dt) {
+    const int64_t nelems = mem_fp.nelems();
+
+    /* a grid over [-16, 16]; every 37th value is large enough to overflow
+     * expf() unless the maximum is subtracted first */
+    mkldnn::impl::parallel_nd(nelems, [&](int64_t i) {
+        float value = ((i * 13) % 1601 - 800) / 50.f;
+        if (i % 37 == 0) value = 100.f;
+        ((float *)mem_fp)[i] = value;
+    });
+
+    SAFE(mem_dt.reorder(mem_fp), WARN);
+
+    return OK;
+}
+
+static int compare(const prb_t *p, const dnn_mem_t &fp_mem,
+        const dnn_mem_t &dt_mem, res_t *r) {
+    const int64_t nelems = fp_mem.nelems();
+    r->errors = 0;
+    r->total = nelems;
+
+    /* the sums along the axis may be accumulated in a different order */
+    const float eps = 1e-6;
+
+    for (int64_t i = 0; i < nelems; ++i) {
+        const float fp = ((const float *)fp_mem)[i];
+        const float dt = ((const float *)dt_mem)[i];
+        const float diff = fabsf(fp - dt);
+        const float rel_diff = diff / (fabsf(fp) > FLT_MIN ? fabsf(fp) : 1);
+        const bool ok = (fabsf(fp) > 1e-5 ? rel_diff : diff) <= eps;
+
+        r->errors += !ok;
+
+        const bool dump = false
+            || (!ok && (r->errors < 10 || verbose >= 10))
+            || (verbose >= 50 && i < 30);
+        if (dump)
+            print(0, "[%4ld][DST] fp:%8g dt:%8g diff:%8g rdiff:%8g\n",
+                    (long)i, fp, dt, diff, rel_diff);
+    }
+
+    if (r->errors)
+        r->state = FAILED;
+
+    if (r->state == UNTESTED)
+        r->state = PASSED; /* optimism */
+
+    return r->state == FAILED ? FAIL : OK;
+}
+
+int doit(const prb_t *p, res_t *r) {
+    res_t res_zero{};
+    *r = res_zero;
+
+    mkldnn_softmax_desc_t sd;
+    mkldnn_primitive_desc_t spd;
+    mkldnn_primitive_t s{};
+
+    SAFE(init_pd(p, sd, spd, r), WARN);
+    if (r->state == SKIPPED || r->state == UNIMPLEMENTED)
+        return OK;
+
+    DNN_SAFE(mkldnn_primitive_create(&s, spd), WARN);
+    set_perf_info(r, spd);
+    DNN_SAFE(mkldnn_primitive_desc_destroy(spd), CRIT);
+
+    const auto fp = mkldnn_f32;
+    const auto &data_dt_d = sd.data_desc;
+    const auto tag = get_default_tag((int)p->dims.size());
+
+    dnn_mem_t src_fp(data_dt_d, fp, tag), src_dt(data_dt_d);
+    dnn_mem_t dst_fp(data_dt_d, fp, tag), dst_dt(data_dt_d);
+
+    SAFE(fill_src(p, src_fp, src_dt), WARN);
+
+    args_t args;
+    args.set(MKLDNN_ARG_SRC, src_dt.m_);
+    args.set(MKLDNN_ARG_DST, dst_dt.m_);
+
+    DNN_SAFE(mkldnn_primitive_execute(s, stream, args.size(), args), WARN);
+
+    if (bench_mode & CORR) {
+        compute_ref_fwd(p, src_fp, dst_fp);
+        dnn_mem_t dst(dst_dt, fp, tag);
+        SAFE(compare(p, dst_fp, dst, r), WARN);
+    }
+
+    if (bench_mode & PERF)
+        SAFE(measure_perf(r, s, args), WARN);
+
+    DNN_SAFE_V(mkldnn_primitive_destroy(s));
+
+    return OK;
+}
+
+}
@@ -0,0 +1,72 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#ifndef _SOFTMAX_HPP
+#define _SOFTMAX_HPP
+
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "common.hpp"
+#include "dnn_types.hpp"
+#include "mkldnn_common.hpp"
+#include "mkldnn_memory.hpp"
+#include "mkldnn_debug.hpp"
+
+namespace softmax {
+
+struct prb_t {
+    prb_t(const dims_t &dims, dir_t dir, mkldnn_data_type_t dt,
+            mkldnn_format_tag_t tag, int axis)
+        : dims(dims), dir(dir), dt(dt), tag(tag), axis(axis) {}
+    ~prb_t() {}
+
+    dims_t dims;
+    dir_t dir;
+    mkldnn_data_type_t dt;
+    mkldnn_format_tag_t tag; /* format_tag_undef means plain */
+    int axis;
+};
+
+const size_t max_prb_len = max_dims_len + 196;
+void prb2str(const prb_t *p, char *buffer, bool canonical = false);
+
+/* some extra control parameters which shouldn't be placed in prb_t */
+extern const char *skip_impl; /* NULL or "" means do not skip anything */
+
+extern const char *perf_template; /* performance output template */
+void perf_report(const prb_t *p, const res_t *r, const char *pstr);
+
+/* the data viewed as outer x axis x inner */
+inline void get_sizes(const prb_t *p, int64_t &outer, int64_t &axis,
+        int64_t &inner) {
+    outer = inner = 1;
+    axis = p->dims[p->axis];
+    for (int d = 0; d < p->axis; ++d) outer *= p->dims[d];
+    for (int d = p->axis + 1; d < (int)p->dims.size(); ++d)
+        inner *= p->dims[d];
+}
+
+void compute_ref_fwd(const prb_t *p, const dnn_mem_t &src, dnn_mem_t &dst);
+
+int fill_src(const prb_t *p, dnn_mem_t &mem_fp, dnn_mem_t &mem_dt);
+int doit(const prb_t *p, res_t *res);
+int bench(int argc, char **argv, bool main_bench = true);
+
+}
+
+#endif
@@ -0,0 +1,47 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <float.h>
+
+#include "src/common/mkldnn_thread.hpp"
+
+#include "sum/sum.hpp"
+
+namespace sum {
+
+void compute_ref_fwd(const prb_t *p, const std::vector<dnn_mem_t *> &src,
+        dnn_mem_t &dst) {
+    const int64_t nelems = dst.nelems();
+    float *d = (float *)dst;
+
+    const bool is_int = p->ddt != mkldnn_f32;
+    const float lo = p->ddt == mkldnn_u8 ? 0 : p->ddt == mkldnn_s8 ? INT8_MIN
+        : p->ddt == mkldnn_s32 ? INT32_MIN : -FLT_MAX;
+    const float hi = p->ddt == mkldnn_u8 ? UINT8_MAX
+        : p->ddt == mkldnn_s8 ? INT8_MAX
+        : p->ddt == mkldnn_s32 ? INT32_MAX : FLT_MAX;
+
+    mkldnn::impl::parallel_nd(nelems, [&](int64_t i) {
+        float res = 0;
+        for (int k = 0; k < p->n_inputs(); ++k)
+            res += p->scales[k] * ((const float *)*src[k])[i];
+
+        if (is_int) res = MAX2(lo, MIN2(hi, (float)mxcsr_round(res)));
+        d[i] = res;
+    });
+}
+
+}
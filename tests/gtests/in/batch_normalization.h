@@ -35,6 +35,7 @@
 #define PARAMS_B16_3D(...) EXPAND_ARGS(PARAMS_3D(nCdhw16c, nCdhw16c, __VA_ARGS__, false, mkldnn_success))
 #define PARAMS_N(...) EXPAND_ARGS(PARAMS(nchw, nchw, __VA_ARGS__, false, mkldnn_success))
 #define PARAMS_NHWC(...) EXPAND_ARGS(PARAMS(nhwc, nhwc, __VA_ARGS__, false, mkldnn_success))
+#define PARAMS_NDHWC(...) EXPAND_ARGS(PARAMS_3D(ndhwc, ndhwc, __VA_ARGS__, false, mkldnn_success))
 #define PARAMS_NC(...) EXPAND_ARGS(PARAMS(nc, nc, __VA_ARGS__, false, mkldnn_success))
 #define PARAMS_B8(...) EXPAND_ARGS(PARAMS(nChw8c, nChw8c, __VA_ARGS__, false, mkldnn_success))
 #define PARAMS_B16(...) EXPAND_ARGS(PARAMS(nChw16c, nChw16c, __VA_ARGS__, false, mkldnn_success))
@@ -124,6 +125,18 @@ INST_TEST_CASE(Simple_NHWC,
     PARAMS_NHWC(2, 10, 4, 4, EPS)
 );
 
+INST_TEST_CASE(Simple_NHWC_Tail,
+    PARAMS_NHWC(2, 17, 5, 5, EPS),
+    PARAMS_NHWC(3, 70, 7, 7, EPS),
+    PARAMS_NHWC(2, 128, 6, 6, EPS),
+    PARAMS_NHWC(1, 3, 13, 11, EPS)
+);
+
+INST_TEST_CASE(Simple_NDHWC,
+    PARAMS_NDHWC(2, 10, 4, 4, 4, EPS),
+    PARAMS_NDHWC(2, 33, 3, 5, 4, EPS)
+);
+
 INST_TEST_CASE(Simple_Blocked,
     PARAMS_B8(2, 8, 1, 1, EPS),
     PARAMS_B8(2, 8, 4, 4, EPS),
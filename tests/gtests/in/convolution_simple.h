@@ -75,6 +75,21 @@ INST_TEST_CASE(Simple_NCHW,
         2, 2, 4, 4, 4, 6, 4, 4, 3, 3, 1, 1, 1, 1)
 );
 
+INST_TEST_CASE(Simple_NHWC,
+    PARAMS(nhwc, hwio, FMT_BIAS, nhwc,
+        2, 1, 19, 11, 23, 70, 11, 23, 3, 3, 1, 1, 1, 1),
+    PARAMS(nhwc, hwio, FMT_BIAS, nhwc,
+        2, 1, 13, 12, 17, 21, 6, 9, 3, 3, 1, 1, 2, 2),
+    PARAMS(nhwc, hwio, FMT_BIAS, nhwc,
+        2, 1, 35, 7, 9, 33, 7, 9, 1, 1, 0, 0, 1, 1),
+    PARAMS(nhwc, hwio, FMT_BIAS, nhwc,
+        1, 1, 8, 10, 20, 16, 4, 7, 5, 5, 2, 2, 3, 3),
+    PARAMS(nhwc, hwigo, FMT_BIAS, nhwc,
+        2, 3, 30, 9, 9, 21, 9, 9, 3, 3, 1, 1, 1, 1),
+    PARAMS(nhwc, hwio, FMT_BIAS, nhwc,
+        2, 1, 17, 13, 15, 20, 11, 13, 3, 3, 1, 1, 1, 1, 1, 1)
+);
+
 INST_TEST_CASE(Simple_Dilated_NCHW,
     PARAMS(nchw, oihw, FMT_BIAS, nchw,
         2, 1, 4, 8, 8, 6, 8, 8, 3, 3, 2, 2, 1, 1, 1, 1),
@@ -14,6 +14,8 @@ INST_TEST_CASE(TestGEMM,
     test_params{'t', 'n', 2, 100, 100, 1.0, 2.0, 100, 100, 100, {}, false},
     test_params{'t', 't', 2, 100, 100, 1.0, 2.0, 100, 100, 100, {}, false},
     test_params{'n', 'n', 2, 2, 10000, 1.0, 2.0, 2, 10000, 2, {}, false},
+    test_params{'n', 'n', 17, 5, 3, 1.0, 0.0, 19, 4, 18, {}, false},
+    test_params{'n', 't', 33, 7, 13, 0.5, 2.0, 33, 9, 35, {}, false},
 
     test_params{'n', 'n', 2000, 2000, 2000, 1.0, 0.0, 2000, 2000, 2000, {}, false},
     test_params{'n', 'n', 3000, 3000, 3000, 1.0, 0.0, 3000, 3000, 3000, {}, false},
@@ -107,6 +109,8 @@ INST_TEST_CASE(TestGEMM_general_cases_col_offset,
     test_params{'t', 'n', 2, 100, 100, 1.0, 2.0, 100, 100, 100, col_use_all_offsets, false},
     test_params{'t', 't', 2, 100, 100, 1.0, 2.0, 100, 100, 100, col_use_all_offsets, false},
     test_params{'n', 'n', 2, 2, 10000, 1.0, 2.0, 2, 10000, 2, col_use_all_offsets, false},
+    test_params{'n', 'n', 17, 5, 3, 1.0, 0.0, 19, 4, 18, col_use_all_offsets, false},
+    test_params{'n', 't', 33, 7, 13, 1.0, 1.0, 33, 9, 35, col_use_all_offsets, false},
 
     test_params{'N', 'n', 30, 20, 10, 2.0, 1.0, 60, 50, 80, col_no_offsets, false},
     test_params{'n', 'T', 30, 20, 10, 2.0, 1.0, 60, 50, 80, col_no_offsets,false},
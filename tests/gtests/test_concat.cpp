@@ -296,4 +296,79 @@ INSTANTIATE_TEST_SUITE_P(TestConcat, concat_test_s8, ::testing::Values(
     {{2, 8, 3, 4}, {2, 8, 3, 4}}, {2, 16, 3, 4}}
     ));
 
+TEST(concat_inplace_test, TestsConcatInplace) {
+    // The producers (pooling and convolution) write directly into the
+    // sub-memories of the concat destination, so the concat is a no-op
+    auto eng = engine(engine::kind::cpu, 0);
+    auto strm = stream(eng);
+    const auto dt = memory::data_type::f32;
+    const auto tag = memory::format_tag::nChw16c;
+
+    const memory::dim mb = 2, c0 = 16, c1 = 32, hw = 6;
+    auto dst_md = memory::desc({mb, c0 + c1, hw, hw}, dt, tag);
+    auto dst0_md = dst_md.submemory_desc({mb, c0, hw, hw}, {0, 0, 0, 0});
+    auto dst1_md = dst_md.submemory_desc({mb, c1, hw, hw}, {0, c0, 0, 0});
+
+    auto pool_src_md = memory::desc({mb, c0, hw + 2, hw + 2}, dt, tag);
+    auto conv_src_md = memory::desc({mb, c0, hw, hw}, dt, tag);
+    auto conv_wei_md = memory::desc({c1, c0, 3, 3}, dt,
+            memory::format_tag::OIhw16i16o);
+    auto pool_src = memory(pool_src_md, eng);
+    auto conv_src = memory(conv_src_md, eng);
+    auto conv_wei = memory(conv_wei_md, eng);
+    fill_data<float>(pool_src_md.get_size() / sizeof(float),
+            (float *)pool_src.get_data_handle());
+    fill_data<float>(conv_src_md.get_size() / sizeof(float),
+            (float *)conv_src.get_data_handle());
+    fill_data<float>(conv_wei_md.get_size() / sizeof(float),
+            (float *)conv_wei.get_data_handle());
+
+    auto produce = [&](const memory &dst0, const memory &dst1) {
+        auto pool_pd = pooling_forward::primitive_desc(
+                pooling_forward::desc(prop_kind::forward_inference,
+                    algorithm::pooling_max, pool_src_md, dst0.get_desc(),
+                    {1, 1}, {3, 3}, {0, 0}, {0, 0}, padding_kind::zero), eng);
+        pooling_forward(pool_pd).execute(strm,
+                {{MKLDNN_ARG_SRC, pool_src}, {MKLDNN_ARG_DST, dst0}});
+
+        auto conv_pd = convolution_forward::primitive_desc(
+                convolution_forward::desc(prop_kind::forward_inference,
+                    algorithm::convolution_direct, conv_src_md, conv_wei_md,
+                    dst1.get_desc(), {1, 1}, {1, 1}, {1, 1},
+                    padding_kind::zero), eng);
+        convolution_forward(conv_pd).execute(strm,
+                {{MKLDNN_ARG_SRC, conv_src}, {MKLDNN_ARG_WEIGHTS, conv_wei},
+                {MKLDNN_ARG_DST, dst1}});
+    };
+
+    auto run_concat = [&](const std::vector<memory> &srcs,
+            const memory &dst) {
+        std::vector<memory::desc> srcs_md;
+        std::unordered_map<int, memory> args = {{MKLDNN_ARG_DST, dst}};
+        for (int i = 0; i < (int)srcs.size(); i++) {
+            srcs_md.push_back(srcs[i].get_desc());
+            args.insert({MKLDNN_ARG_MULTIPLE_SRC + i, srcs[i]});
+        }
+        auto concat_pd = concat::primitive_desc(dst.get_desc(), 1, srcs_md,
+                eng);
+        concat(concat_pd).execute(strm, args);
+        return concat_pd.is_inplace();
+    };
+
+    // out-of-place reference
+    auto ref_dst0 = memory({{mb, c0, hw, hw}, dt, tag}, eng);
+    auto ref_dst1 = memory({{mb, c1, hw, hw}, dt, tag}, eng);
+    auto ref_dst = memory(dst_md, eng);
+    produce(ref_dst0, ref_dst1);
+    EXPECT_FALSE(run_concat({ref_dst0, ref_dst1}, ref_dst));
+
+    auto dst = memory(dst_md, eng);
+    auto dst0 = memory(dst0_md, eng, dst.get_data_handle());
+    auto dst1 = memory(dst1_md, eng, dst.get_data_handle());
+    produce(dst0, dst1);
+    EXPECT_TRUE(run_concat({dst0, dst1}, dst));
+
+    compare_data<float>(ref_dst, dst);
+}
+
 }
@@ -98,4 +98,10 @@ TEST_P(convolution_test, TestConvolutionEltwise)
         PARAMS(nChw16c, OIhw16i16o, x, nChw16c, 2, 1, 32, 32, 32, 32, 32, 32, 3, 3, 0, 0, 1, 1)
     );
 
+    INST_TEST_CASE(SimpleSmall_NHWC_Tail,
+        PARAMS(nhwc, hwio, x, nhwc, 1, 1, 47, 20, 20, 47, 20, 20, 3, 3, 1, 1, 1, 1),
+        PARAMS(nhwc, hwio, x, nhwc, 1, 1, 47, 20, 20, 47, 20, 20, 1, 1, 0, 0, 1, 1),
+        PARAMS(nhwc, hwigo, x, nhwc, 2, 2, 38, 13, 13, 70, 11, 11, 3, 3, 0, 0, 1, 1)
+    );
+
 }
@@ -90,6 +90,130 @@ TEST_F(attr_test, TestIntOutputScales) {
     EXPECT_EQ(scales[2], 3.);
 }
 
+TEST_F(attr_test, TestZeroPoints) {
+    mkldnn::primitive_attr attr;
+
+    int mask;
+    std::vector<int32_t> zero_points;
+
+    // default zero points
+    for (int arg: {MKLDNN_ARG_SRC, MKLDNN_ARG_DST}) {
+        attr.get_zero_points(arg, mask, zero_points);
+        EXPECT_EQ(mask, 0);
+        EXPECT_EQ(zero_points.size(), 1U);
+        EXPECT_EQ(zero_points[0], 0);
+    }
+
+    // common source zero point
+    attr.set_zero_points(MKLDNN_ARG_SRC, 0, {128});
+    attr.get_zero_points(MKLDNN_ARG_SRC, mask, zero_points);
+    EXPECT_EQ(mask, 0);
+    EXPECT_EQ(zero_points.size(), 1U);
+    EXPECT_EQ(zero_points[0], 128);
+
+    // per output channel destination zero points
+    attr.set_zero_points(MKLDNN_ARG_DST, 1 << 1, {-1, 0, 1});
+    attr.get_zero_points(MKLDNN_ARG_DST, mask, zero_points);
+    EXPECT_EQ(mask, 1 << 1);
+    EXPECT_EQ(zero_points.size(), 3U);
+    EXPECT_EQ(zero_points[0], -1);
+    EXPECT_EQ(zero_points[1], 0);
+    EXPECT_EQ(zero_points[2], 1);
+
+    // source zero point must be common
+    EXPECT_THROW(attr.set_zero_points(MKLDNN_ARG_SRC, 1 << 1, {1, 2}),
+            mkldnn::error);
+    // weights cannot have zero points
+    EXPECT_THROW(attr.set_zero_points(MKLDNN_ARG_WEIGHTS, 0, {1}),
+            mkldnn::error);
+}
+
+TEST_F(attr_test, TestRuntimeParams) {
+    engine eng(engine::cpu, 0);
+    stream strm(eng);
+
+    const memory::dim MB = 2, IC = 32, OC = 16;
+
+    memory::desc src_md({MB, IC}, memory::u8, memory::nc);
+    memory::desc wei_md({OC, IC}, memory::s8, memory::oi);
+    memory::desc dst_md({MB, OC}, memory::f32, memory::nc);
+    auto ip_d = inner_product_forward::desc(forward_inference, src_md, wei_md,
+            dst_md);
+
+    std::vector<float> scales(OC);
+    for (memory::dim oc = 0; oc < OC; ++oc)
+        scales[oc] = 0.5f + 0.25f * oc;
+    float eltwise_params[2] = {0.125f, 0.f}; // alpha, beta
+
+    // parameters known at creation time
+    mkldnn::primitive_attr attr;
+    mkldnn::post_ops ops;
+    attr.set_output_scales(1 << 1, scales);
+    ops.append_eltwise(1.f, algorithm::eltwise_relu, eltwise_params[0], 0.f);
+    attr.set_post_ops(ops);
+
+    // the same parameters passed at execution time
+    mkldnn::primitive_attr attr_rt;
+    mkldnn::post_ops ops_rt;
+    attr_rt.set_output_scales(1 << 1, {MKLDNN_RUNTIME_F32_VAL});
+    ops_rt.append_eltwise(1.f, algorithm::eltwise_relu,
+            MKLDNN_RUNTIME_F32_VAL, 0.f);
+    attr_rt.set_post_ops(ops_rt);
+
+    // runtime scales are specified with a single value only
+    EXPECT_THROW(attr_rt.set_output_scales(1 << 1,
+                {MKLDNN_RUNTIME_F32_VAL, MKLDNN_RUNTIME_F32_VAL}),
+            mkldnn::error);
+
+    auto ip_pd = inner_product_forward::primitive_desc(ip_d, attr, eng);
+    auto ip_pd_rt = inner_product_forward::primitive_desc(ip_d, attr_rt, eng);
+
+    memory src(ip_pd.src_desc(), eng);
+    memory wei(ip_pd.weights_desc(), eng);
+    memory dst(ip_pd.dst_desc(), eng);
+    memory dst_rt(ip_pd_rt.dst_desc(), eng);
+
+    auto src_data = (uint8_t *)src.get_data_handle();
+    for (memory::dim i = 0; i < MB * IC; ++i)
+        src_data[i] = (uint8_t)(i % 7);
+    auto wei_data = (int8_t *)wei.get_data_handle();
+    for (memory::dim i = 0; i < OC * IC; ++i)
+        wei_data[i] = (int8_t)(i % 5 - 2);
+
+    memory scales_m({{OC}, memory::f32, memory::x}, eng, scales.data());
+    memory eltwise_m({{2}, memory::f32, memory::x}, eng, eltwise_params);
+
+    inner_product_forward(ip_pd).execute(strm, {
+            {MKLDNN_ARG_SRC, src},
+            {MKLDNN_ARG_WEIGHTS, wei},
+            {MKLDNN_ARG_DST, dst}});
+    inner_product_forward(ip_pd_rt).execute(strm, {
+            {MKLDNN_ARG_SRC, src},
+            {MKLDNN_ARG_WEIGHTS, wei},
+            {MKLDNN_ARG_DST, dst_rt},
+            {MKLDNN_ARG_ATTR_OUTPUT_SCALES, scales_m},
+            {MKLDNN_ARG_ATTR_POST_OP_0, eltwise_m}});
+
+    auto dst_data = (const float *)dst.get_data_handle();
+    auto dst_rt_data = (const float *)dst_rt.get_data_handle();
+    for (memory::dim i = 0; i < MB * OC; ++i)
+        EXPECT_EQ(dst_data[i], dst_rt_data[i]);
+
+    // the runtime parameters must be passed at execution time
+    EXPECT_THROW(inner_product_forward(ip_pd_rt).execute(strm, {
+                {MKLDNN_ARG_SRC, src},
+                {MKLDNN_ARG_WEIGHTS, wei},
+                {MKLDNN_ARG_DST, dst_rt}}),
+            mkldnn::error);
+
+    // reorder does not support runtime scales
+    memory::desc src_f32_md({MB, IC}, memory::f32, memory::nc);
+    mkldnn::primitive_attr attr_rt_reorder;
+    attr_rt_reorder.set_output_scales(0, {MKLDNN_RUNTIME_F32_VAL});
+    EXPECT_THROW(reorder::primitive_desc(eng, src_f32_md, eng, src_md,
+                attr_rt_reorder), mkldnn::error);
+}
+
 TEST_F(attr_test, TestPostOps) {
     mkldnn::primitive_attr attr;
     mkldnn::post_ops ops;
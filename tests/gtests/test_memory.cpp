@@ -89,4 +89,56 @@ INSTANTIATE_TEST_SUITE_P(TestMemory, memory_test,
             memory_test_params{{15, 16, 16, 3, 3}, fmt::Goihw8g}
             )
         );
+
+TEST(memory_zero_pad_test, TestsSetDataHandle) {
+    auto e = engine(engine::kind::cpu, 0);
+    memory::desc md({2, 15, 3, 2}, memory::data_type::f32, fmt::nChw16c);
+    const memory::dim phys_size = md.get_size() / sizeof(data_t);
+    const memory::dim pad_off = 15; // the first padded channel
+
+    std::vector<data_t> buf0(phys_size, 1.f), buf1(phys_size, 1.f);
+    mkldnn::memory mem(md, e, &buf0[0]);
+    EXPECT_EQ(buf0[pad_off], 0.f);
+
+    // the buffer is declared to be padded already, so it is not touched
+    mem.set_data_handle(&buf1[0], true);
+    EXPECT_EQ(buf1[pad_off], 1.f);
+
+    // the handle is the same and the padding is known to be intact
+    mem.set_data_handle(&buf1[0]);
+    EXPECT_EQ(buf1[pad_off], 1.f);
+
+    // the user might have spoiled the padding via the handle
+    mem.get_data_handle();
+    mem.set_data_handle(&buf1[0]);
+    check_zero_tail<data_t>(0, mem);
+
+    // the padding is restored for a different buffer
+    buf0[pad_off] = 1.f;
+    mem.set_data_handle(&buf0[0]);
+    check_zero_tail<data_t>(0, mem);
+}
+
+TEST(memory_zero_pad_test, TestsGenericBlocked) {
+    // 32-channel blocking is not covered by the specialized zero padding
+    auto e = engine(engine::kind::cpu, 0);
+    memory::desc md({2, 20, 3, 2}, memory::data_type::f32, fmt::nChw16c);
+    auto &blk = md.data.format_desc.blocking;
+    md.data.padded_dims[1] = 32;
+    blk.inner_blks[0] = 32;
+    blk.strides[3] = 32;
+    blk.strides[2] = 2 * blk.strides[3];
+    blk.strides[1] = 3 * blk.strides[2];
+    blk.strides[0] = blk.strides[1];
+
+    const memory::dim phys_size = md.get_size() / sizeof(data_t);
+    std::vector<data_t> buf(phys_size, 1.f);
+    mkldnn::memory mem(md, e, &buf[0]);
+    check_zero_tail<data_t>(0, mem);
+
+    memory::dim nzeros = 0;
+    for (memory::dim i = 0; i < phys_size; ++i)
+        nzeros += buf[i] == 0.f;
+    EXPECT_EQ(nzeros, 2 * (32 - 20) * 3 * 2);
+}
 }
@@ -240,4 +240,139 @@ INSTANTIATE_TEST_SUITE_P(Case, test_parallel_nd, ::testing::Values(
     np_t{{4, 3, 0, 3, 0, 1}}, np_t{{2, 1, 3, 1, 2, 1}}, np_t{{4, 1, 4, 3, 2, 2}}
 ));
 
+
+TEST(test_nthr_for_work, Test) {
+    const int max_nthr = mkldnn_get_max_threads();
+    EXPECT_EQ(impl::nthr_for_work(0, 1), 1);
+    EXPECT_EQ(impl::nthr_for_work(1, 1 << 30), 1);
+    EXPECT_EQ(impl::nthr_for_work(16, 1), 1);
+    EXPECT_EQ(impl::nthr_for_work(1 << 20, 1 << 20), max_nthr);
+    EXPECT_EQ(impl::nthr_for_work(1 << 20, 1 << 20, 1), 1);
+    EXPECT_LE(impl::nthr_for_work(2, 1 << 20), 2);
+    impl::parallel(0, [&](int, int) {
+        EXPECT_EQ(impl::nthr_for_work(1 << 20, 1 << 20), 1);
+    });
+}
+
+class test_parallel_nd_cost: public test_nd {
+protected:
+    void emit_parallel_nd_cost(size_t item_cost) {
+        switch ((int)p.dims.size()) {
+        case 1:
+            impl::parallel_nd_cost(item_cost, p.dims[0], [&](ptrdiff_t d0) {
+                ASSERT_TRUE(0 <= d0 && d0 < p.dims[0]);
+                data[d0] = d0;
+            });
+            break;
+        case 2:
+            impl::parallel_nd_cost(item_cost, p.dims[0], p.dims[1], [&](ptrdiff_t d0, ptrdiff_t d1) {
+                ASSERT_TRUE(0 <= d0 && d0 < p.dims[0]);
+                ASSERT_TRUE(0 <= d1 && d1 < p.dims[1]);
+                const ptrdiff_t idx = d0 * p.dims[1] + d1;
+                data[idx] = idx;
+            });
+            break;
+        case 3:
+            impl::parallel_nd_cost(item_cost, p.dims[0], p.dims[1], p.dims[2], [&](ptrdiff_t d0, ptrdiff_t d1, ptrdiff_t d2) {
+                ASSERT_TRUE(0 <= d0 && d0 < p.dims[0]);
+                ASSERT_TRUE(0 <= d1 && d1 < p.dims[1]);
+                ASSERT_TRUE(0 <= d2 && d2 < p.dims[2]);
+                const ptrdiff_t idx = (d0 * p.dims[1] + d1) * p.dims[2] + d2;
+                data[idx] = idx;
+            });
+            break;
+        default:
+            ASSERT_TRUE(false);
+        }
+    }
+};
+
+TEST_P(test_parallel_nd_cost, Cheap) {
+    emit_parallel_nd_cost(1);
+    CheckID();
+}
+
+TEST_P(test_parallel_nd_cost, Expensive) {
+    emit_parallel_nd_cost(1 << 20);
+    CheckID();
+}
+
+INSTANTIATE_TEST_SUITE_P(Case, test_parallel_nd_cost, ::testing::Values(
+    np_t{{0}}, np_t{{1}}, np_t{{100}},
+    np_t{{0, 0}}, np_t{{1, 2}}, np_t{{10, 10}},
+    np_t{{0, 1, 0}}, np_t{{1, 2, 1}}, np_t{{4, 4, 10}}
+));
+
+
+class test_parallel_nd_dynamic: public test_nd {
+protected:
+    void emit_parallel_nd_dynamic() {
+        switch ((int)p.dims.size()) {
+        case 1:
+            impl::parallel_nd_dynamic(p.dims[0], [&](ptrdiff_t d0) {
+                ASSERT_TRUE(0 <= d0 && d0 < p.dims[0]);
+                data[d0] = d0;
+            });
+            break;
+        case 2:
+            impl::parallel_nd_dynamic(p.dims[0], p.dims[1], [&](ptrdiff_t d0, ptrdiff_t d1) {
+                ASSERT_TRUE(0 <= d0 && d0 < p.dims[0]);
+                ASSERT_TRUE(0 <= d1 && d1 < p.dims[1]);
+                const ptrdiff_t idx = d0 * p.dims[1] + d1;
+                data[idx] = idx;
+            });
+            break;
+        case 3:
+            impl::parallel_nd_dynamic(p.dims[0], p.dims[1], p.dims[2], [&](ptrdiff_t d0, ptrdiff_t d1, ptrdiff_t d2) {
+                ASSERT_TRUE(0 <= d0 && d0 < p.dims[0]);
+                ASSERT_TRUE(0 <= d1 && d1 < p.dims[1]);
+                ASSERT_TRUE(0 <= d2 && d2 < p.dims[2]);
+                const ptrdiff_t idx = (d0 * p.dims[1] + d1) * p.dims[2] + d2;
+                data[idx] = idx;
+            });
+            break;
+        default:
+            ASSERT_TRUE(false);
+        }
+    }
+
+    void emit_work_scheduler(bool dynamic) {
+        // the dynamic schedule does not depend on the actual number of
+        // threads, so ask for more than there may be to get several chunks
+        impl::work_scheduler_t sched((size_t)size, 4, dynamic);
+        impl::parallel(0, [&](int ithr, int nthr) {
+            auto thr_sched = sched.thread(ithr, nthr);
+            ptrdiff_t start{0}, end{0};
+            while (thr_sched.next(start, end)) {
+                ASSERT_TRUE(0 <= start && start <= end && end <= size);
+                for (ptrdiff_t i = start; i < end; ++i)
+                    data[i] += i + 1;
+            }
+        });
+        for (ptrdiff_t i = 0; i < size; ++i)
+            data[i] -= 1;
+    }
+};
+
+TEST_P(test_parallel_nd_dynamic, Test) {
+    emit_parallel_nd_dynamic();
+    CheckID();
+}
+
+TEST_P(test_parallel_nd_dynamic, StaticScheduler) {
+    emit_work_scheduler(false);
+    CheckID();
+}
+
+TEST_P(test_parallel_nd_dynamic, DynamicScheduler) {
+    emit_work_scheduler(true);
+    CheckID();
+}
+
+INSTANTIATE_TEST_SUITE_P(Case, test_parallel_nd_dynamic, ::testing::Values(
+    np_t{{0}}, np_t{{1}}, np_t{{100}},
+    np_t{{0, 0}}, np_t{{1, 2}}, np_t{{10, 10}},
+    np_t{{0, 1, 0}}, np_t{{1, 2, 1}}, np_t{{4, 4, 10}}
+));
+
 }
@@ -0,0 +1,144 @@
+/*******************************************************************************
+* Copyright 2019 Intel Corporation
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include "mkldnn_test_common.hpp"
+#include "gtest/gtest.h"
+
+#include "mkldnn.hpp"
+
+namespace mkldnn {
+
+struct plan_test_params {
+    memory::dim mb, ic, oc, h, w, k, pad;
+};
+
+/* relu -> convolution -> relu, run once primitive by primitive and once as a
+ * plan; the plan must produce the same results */
+class plan_test: public ::testing::TestWithParam<plan_test_params> {
+protected:
+    virtual void SetUp() {
+        auto p = ::testing::TestWithParam<plan_test_params>::GetParam();
+        auto eng = engine(engine::kind::cpu, 0);
+        auto strm = stream(eng);
+
+        using dt = memory::data_type;
+        using tag = memory::format_tag;
+
+        memory::dim oh = p.h - p.k + 1 + 2 * p.pad;
+        memory::dim ow = p.w - p.k + 1 + 2 * p.pad;
+
+        auto src_md_any = memory::desc({p.mb, p.ic, p.h, p.w}, dt::f32,
+                tag::any);
+        auto wei_md_any = memory::desc({p.oc, p.ic, p.k, p.k}, dt::f32,
+                tag::any);
+        auto bia_md = memory::desc({p.oc}, dt::f32, tag::x);
+        auto dst_md_any = memory::desc({p.mb, p.oc, oh, ow}, dt::f32,
+                tag::any);
+
+        auto conv_desc = convolution_forward::desc(prop_kind::forward_inference,
+                algorithm::convolution_direct, src_md_any, wei_md_any, bia_md,
+                dst_md_any, {1, 1}, {p.pad, p.pad}, {p.pad, p.pad},
+                padding_kind::zero);
+        auto conv_pd = convolution_forward::primitive_desc(conv_desc, eng);
+
+        auto src_md = conv_pd.src_desc();
+        auto dst_md = conv_pd.dst_desc();
+
+        auto relu_src_pd = eltwise_forward::primitive_desc(
+                eltwise_forward::desc(prop_kind::forward_inference,
+                    algorithm::eltwise_relu, src_md, 0.f), eng);
+        auto relu_dst_pd = eltwise_forward::primitive_desc(
+                eltwise_forward::desc(prop_kind::forward_inference,
+                    algorithm::eltwise_relu, dst_md, 0.f), eng);
+
+        auto relu_src = eltwise_forward(relu_src_pd);
+        auto conv = convolution_forward(conv_pd);
+        auto relu_dst = eltwise_forward(relu_dst_pd);
+
+        auto src = memory(src_md, eng);
+        auto wei = memory(conv_pd.weights_desc(), eng);
+        auto bia = memory(bia_md, eng);
+
+        fill_data<float>(src_md.get_size() / sizeof(float),
+                (float *)src.get_data_handle(), 1., true);
+        fill_data<float>(conv_pd.weights_desc().get_size() / sizeof(float),
+                (float *)wei.get_data_handle(), 1., true);
+        fill_data<float>(bia_md.get_size() / sizeof(float),
+                (float *)bia.get_data_handle(), 1., true);
+
+        auto run = [&](bool use_plan, memory &dst) {
+            auto src_copy = memory(src_md, eng);
+            memcpy(src_copy.get_data_handle(), src.get_data_handle(),
+                    src_md.get_size());
+            auto conv_dst = memory(dst_md, eng);
+
+            std::unordered_map<int, memory> relu_src_args = {
+                {MKLDNN_ARG_SRC, src_copy}, {MKLDNN_ARG_DST, src_copy}};
+            std::unordered_map<int, memory> conv_args = {
+                {MKLDNN_ARG_SRC, src_copy}, {MKLDNN_ARG_WEIGHTS, wei},
+                {MKLDNN_ARG_BIAS, bia}, {MKLDNN_ARG_DST, conv_dst}};
+            std::unordered_map<int, memory> relu_dst_args = {
+                {MKLDNN_ARG_SRC, conv_dst}, {MKLDNN_ARG_DST, dst}};
+
+            if (use_plan) {
+                plan pl(eng);
+                pl.append(relu_src, relu_src_args);
+                pl.append(conv, conv_args);
+                pl.append(relu_dst, relu_dst_args);
+                pl.execute(strm);
+                /* a plan can be executed again */
+                pl.execute(strm);
+            } else {
+                relu_src.execute(strm, relu_src_args);
+                conv.execute(strm, conv_args);
+                relu_dst.execute(strm, relu_dst_args);
+            }
+        };
+
+        auto dst_ref = memory(dst_md, eng);
+        auto dst_plan = memory(dst_md, eng);
+        run(false, dst_ref);
+        run(true, dst_plan);
+
+        compare_data<float>(dst_ref, dst_plan);
+    }
+};
+
+TEST_P(plan_test, TestsPlan) {}
+
+INSTANTIATE_TEST_SUITE_P(TestPlan, plan_test, ::testing::Values(
+            plan_test_params{2, 32, 32, 13, 13, 3, 1},
+            plan_test_params{2, 16, 64, 10, 10, 1, 0},
+            plan_test_params{1, 3, 16, 9, 9, 3, 0},
+            plan_test_params{3, 64, 20, 7, 7, 3, 1}));
+
+TEST(plan_test_iface, TestsPlanEngineMismatch) {
+    auto eng = engine(engine::kind::cpu, 0);
+    auto other_eng = engine(engine::kind::cpu, 0);
+
+    auto md = memory::desc({2, 16, 4, 4}, memory::data_type::f32,
+            memory::format_tag::nchw);
+    auto relu = eltwise_forward(eltwise_forward::primitive_desc(
+                eltwise_forward::desc(prop_kind::forward_inference,
+                    algorithm::eltwise_relu, md, 0.f), eng));
+    auto mem = memory(md, eng);
+
+    plan pl(other_eng);
+    EXPECT_ANY_THROW(pl.append(relu,
+                {{MKLDNN_ARG_SRC, mem}, {MKLDNN_ARG_DST, mem}}));
+}
+
+}
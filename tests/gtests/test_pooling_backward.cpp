@@ -500,6 +500,27 @@ INSTANTIATE_TEST_SUITE_P(
             memory::format_tag::ncdhw, EXPAND_SIZES_3D(2, 32, 30, 30, 30, 30, 30, 30, 3, 3, 3, 1, 1, 1, 1, 1, 1) }
             ));
 
+INSTANTIATE_TEST_SUITE_P(
+        TestPoolingBackwardNHWC_Tail, pooling_bwd_test_float, ::testing::Values(
+            pool_bwd_test_params_float{ engine::kind::cpu, pooling_max,
+            memory::format_tag::nhwc, memory::format_tag::nhwc,
+            EXPAND_SIZES_2D(2, 17, 9, 9, 5, 5, 3, 3, 1, 1, 2, 2) },
+            pool_bwd_test_params_float{ engine::kind::cpu, pooling_max,
+            memory::format_tag::nhwc, memory::format_tag::nhwc,
+            EXPAND_SIZES_2D(2, 70, 8, 8, 4, 4, 2, 2, 0, 0, 2, 2) },
+            pool_bwd_test_params_float{ engine::kind::cpu,
+            pooling_avg_include_padding,
+            memory::format_tag::nhwc, memory::format_tag::nhwc,
+            EXPAND_SIZES_2D(2, 70, 9, 9, 5, 5, 3, 3, 1, 1, 2, 2) },
+            pool_bwd_test_params_float{ engine::kind::cpu,
+            pooling_avg_exclude_padding,
+            memory::format_tag::nhwc, memory::format_tag::nhwc,
+            EXPAND_SIZES_2D(1, 3, 9, 9, 5, 5, 3, 3, 1, 1, 2, 2) },
+            pool_bwd_test_params_float{ engine::kind::cpu, pooling_max,
+            memory::format_tag::nhwc, memory::format_tag::nhwc,
+            EXPAND_SIZES_2D(1, 33, 20, 20, 2, 2, 17, 17, 0, 0, 3, 3) }
+            ));
+
 INSTANTIATE_TEST_SUITE_P(
         TestPooling3D_ndhwc, pooling_bwd_test_float, ::testing::Values(
             pool_bwd_test_params_float{
@@ -724,6 +724,27 @@ INSTANTIATE_TEST_SUITE_P(
             memory::format_tag::nhwc,  EXPAND_SIZES_2D( 2, 4, 4, 4, 2, 2, 3, 3, 0, 0, 1, 1 ) }
             ));
 
+INSTANTIATE_TEST_SUITE_P(
+        TestPoolingForwardNHWC_Tail, pooling_test_float, ::testing::Values(
+            pool_test_params_float{ prop_kind::forward_training,
+            engine::kind::cpu, algorithm::pooling_max, memory::format_tag::nhwc,
+            memory::format_tag::nhwc,  EXPAND_SIZES_2D( 2, 17, 9, 9, 5, 5, 3, 3, 1, 1, 2, 2 ) },
+            pool_test_params_float{ prop_kind::forward_inference,
+            engine::kind::cpu, algorithm::pooling_max, memory::format_tag::nhwc,
+            memory::format_tag::nhwc,  EXPAND_SIZES_2D( 2, 70, 9, 9, 5, 5, 3, 3, 1, 1, 2, 2 ) },
+            pool_test_params_float{ prop_kind::forward_training,
+            engine::kind::cpu, algorithm::pooling_avg_include_padding,
+            memory::format_tag::nhwc, memory::format_tag::nhwc,
+            EXPAND_SIZES_2D( 2, 70, 9, 9, 5, 5, 3, 3, 1, 1, 2, 2 ) },
+            pool_test_params_float{ prop_kind::forward_training,
+            engine::kind::cpu, algorithm::pooling_avg_exclude_padding,
+            memory::format_tag::nhwc, memory::format_tag::nhwc,
+            EXPAND_SIZES_2D( 1, 3, 9, 9, 5, 5, 3, 3, 1, 1, 2, 2 ) },
+            pool_test_params_float{ prop_kind::forward_training,
+            engine::kind::cpu, algorithm::pooling_max, memory::format_tag::nhwc,
+            memory::format_tag::nhwc,  EXPAND_SIZES_2D( 1, 33, 20, 20, 2, 2, 17, 17, 0, 0, 3, 3 ) }
+            ));
+
 INSTANTIATE_TEST_SUITE_P(
         TestPoolingForwardMaxBlocked, pooling_test_float, ::testing::Values(
             pool_test_params_float{ prop_kind::forward_training,
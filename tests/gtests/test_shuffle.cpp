@@ -198,6 +198,10 @@ INSTANTIATE_TEST_SUITE_P(TestShuffle_nChw16c_Tail, \
             , shuffle_test_params{ prop_kind::forward_training, \
             engine::kind::cpu, memory::format_tag::nChw16c, {2, 66, 4, 4}, 1, 2 } \
             , shuffle_test_params{ prop_kind::forward_training, \
+            engine::kind::cpu, memory::format_tag::nChw16c, {2, 24, 3, 5}, 1, 3 } \
+            , shuffle_test_params{ prop_kind::forward_training, \
+            engine::kind::cpu, memory::format_tag::nChw8c, {2, 20, 3, 5}, 1, 5 } \
+            , shuffle_test_params{ prop_kind::forward_training, \
             engine::kind::cpu, memory::format_tag::nChw16c, {2, 34, 4, 4}, 2, 2 } \
             , shuffle_test_params{ prop_kind::forward_training, \
             engine::kind::cpu, memory::format_tag::nChw16c, {2, 12, 10, 10}, 1, 2 } \
@@ -241,6 +245,10 @@ INSTANTIATE_TEST_SUITE_P(TestShuffleNHWC, test, \
             engine::kind::cpu, memory::format_tag::nhwc, {2, 10, 4, 4}, 1, 2 } \
             , shuffle_test_params{ prop_kind::forward_training, \
             engine::kind::cpu, memory::format_tag::nhwc, {2, 10, 4, 4}, 1, 2 } \
+            , shuffle_test_params{ prop_kind::forward_training, \
+            engine::kind::cpu, memory::format_tag::nhwc, {2, 36, 3, 5}, 1, 4 } \
+            , shuffle_test_params{ prop_kind::forward_training, \
+            engine::kind::cpu, memory::format_tag::nhwc, {3, 48, 2, 3}, 1, 3 } \
             )); \
  \
 INSTANTIATE_TEST_SUITE_P(TestShuffle_nChw8c, test, \